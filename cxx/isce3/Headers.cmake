@@ -47,6 +47,8 @@ core/LookSide.h
 core/LUT1d.h
 core/LUT1d.icc
 core/LUT2d.h
+core/LUT2dView.h
+core/LUT2dView.icc
 core/Matrix.h
 core/Metadata.h
 core/Orbit.h
@@ -74,6 +76,7 @@ fft/FFT.h
 fft/FFT.icc
 fft/FFTPlan.h
 fft/FFTPlan.icc
+fft/FFTPlanCache.h
 fft/FFTUtil.h
 fft/FFTUtil.icc
 focus/Backproject.h
@@ -82,13 +85,16 @@ focus/BistaticDelay.icc
 focus/Chirp.h
 focus/DryTroposphereModel.h
 focus/DryTroposphereModel.icc
+focus/FactorizedBackproject.h
 focus/GapMask.h
 focus/Presum.h
 focus/Presum.icc
 focus/RangeComp.h
 geocode/baseband.h
+geocode/geo2rdrBlock.h
 geocode/geocodeSlc.h
 geometry/DEMInterpolator.h
+geometry/DEMTileCache.h
 geometry/loadDem.h
 geometry/forward.h
 geometry/Shapes.h
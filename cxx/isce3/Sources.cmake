@@ -36,15 +36,19 @@ geometry/boundingbox.cpp
 fft/detail/ConfigureFFTLayout.cpp
 fft/detail/FFTWWrapper.cpp
 fft/detail/Threads.cpp
+fft/FFTPlanCache.cpp
 focus/Backproject.cpp
 focus/Chirp.cpp
 focus/DryTroposphereModel.cpp
+focus/FactorizedBackproject.cpp
 focus/GapMask.cpp
 focus/Presum.cpp
 focus/RangeComp.cpp
 geocode/baseband.cpp
+geocode/geo2rdrBlock.cpp
 geocode/geocodeSlc.cpp
 geometry/DEMInterpolator.cpp
+geometry/DEMTileCache.cpp
 geometry/loadDem.cpp
 geometry/Geo2rdr.cpp
 geocode/GeocodeCov.cpp
@@ -25,6 +25,30 @@ template<typename KernelType, typename DataType>
 DataType interp1d(const Kernel<KernelType>& kernel, const DataType* x,
         size_t length, size_t stride, double t, bool periodic = false);
 
+/** Interpolate sequence x at many points t
+ *
+ * @tparam KernelType kernel element type
+ * @tparam DataType data element type
+ *
+ * @param[in]  kernel   Kernel function to use for interpolation.
+ * @param[in]  x        Sequence to interpolate.
+ * @param[in]  length   Length of sequence.
+ * @param[in]  stride   Stride between elements of sequence.
+ * @param[in]  t        Desired time samples, size n.
+ * @param[out] out      Interpolated values (0 where kernel would run off
+ *                      array), size n.
+ * @param[in]  n        Number of time samples.
+ * @param[in]  periodic Use periodic boundary condition.  Default = false.
+ *
+ * Gives the same result as calling the single-point interp1d for each t[i],
+ * but kernel weights are computed for blocks of points with a single call
+ * to Kernel::evaluate and applied while they are still in cache.
+ */
+template<typename KernelType, typename DataType>
+void interp1d(const Kernel<KernelType>& kernel, const DataType* x,
+        size_t length, size_t stride, const double* t, DataType* out,
+        size_t n, bool periodic = false);
+
 /** Interpolate sequence x at point t
  *
  * @tparam KernelType kernel element type
@@ -174,6 +174,16 @@ public:
     // Inherit overloads for other datatypes
     using super_t::interpolate;
 
+    /** Get normalized filter table, one row of kernelLength() taps for each
+     * of decimationFactor() fractional offsets. */
+    const Matrix<double>& kernel() const { return _kernel; }
+
+    /** Get number of fractional offsets tabulated in kernel() */
+    int decimationFactor() const { return _decimationFactor; }
+
+    /** Get number of taps of sinc kernel */
+    int kernelLength() const { return _kernelLength; }
+
 private:
     // Compute sinc coefficients
     void _sinc_coef(double beta, double relfiltlen, int decfactor,
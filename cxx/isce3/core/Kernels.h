@@ -28,6 +28,23 @@ public:
     /** Evaluate kernel at given location in [-halfwidth, halfwidth] */
     virtual T operator()(double x) const = 0;
 
+    /** Evaluate kernel at a batch of locations.
+     *
+     * The default implementation calls operator() at each location.
+     * Derived kernels may override it with a loop that the compiler can
+     * vectorize, which amortizes the virtual call over many samples.
+     *
+     * @param[in]  x    Locations to evaluate, size n.
+     * @param[out] out  Kernel values, size n.
+     * @param[in]  n    Number of locations.
+     */
+    virtual void evaluate(const double x[], T out[], size_t n) const
+    {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = (*this)(x[i]);
+        }
+    }
+
     /** Get width of kernel.
      *
      * Units are the same as are used for calls to operator().
@@ -46,6 +63,8 @@ public:
     BartlettKernel(double width) : Kernel<T>(width) {}
 
     T operator()(double x) const override;
+
+    void evaluate(const double x[], T out[], size_t n) const override;
 };
 
 /** Linear kernel, which is just a special case of Bartlett. */
@@ -76,6 +95,8 @@ public:
 
     T operator()(double x) const override;
 
+    void evaluate(const double x[], T out[], size_t n) const override;
+
     /** Get bandwidth of kernel. */
     double bandwidth() const { return _bandwidth; }
 
@@ -142,6 +163,8 @@ public:
 
     T operator()(double x) const override;
 
+    void evaluate(const double x[], T out[], size_t n) const override;
+
     const std::vector<T>& table() const { return _table; }
 
 private:
@@ -164,6 +187,8 @@ public:
 
     T operator()(double x) const override;
 
+    void evaluate(const double x[], T out[], size_t n) const override;
+
     const std::vector<T>& coeffs() const { return _coeffs; }
 
 private:
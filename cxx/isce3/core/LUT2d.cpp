@@ -6,10 +6,12 @@
 
 #include "LUT2d.h"
 
+#include <algorithm>
 #include <complex>
 #include <pyre/journal.h>
 
 #include "Interpolator.h"
+#include "LUT2dView.h"
 
 // Constructor with coordinate starting values and spacing
 /** @param[in] xstart Starting X-coordinate
@@ -164,9 +166,14 @@ eval(double y, const Eigen::Ref<const Eigen::VectorXd>& x) const
 {
     const auto n = x.size();
     Eigen::Matrix<T, Eigen::Dynamic, 1> out(n);
+
+    // Evaluate in chunks through a view of the LUT so that the weights
+    // along Y are shared and the interpolation is inlined
+    const LUT2dView<T> view(*this);
+    const long chunk = 256;
     _Pragma("omp parallel for")
-    for (long i = 0; i < n; ++i) {
-        out(i) = eval(y, x(i));
+    for (long i = 0; i < n; i += chunk) {
+        view.eval(y, x.data() + i, out.data() + i, std::min(chunk, n - i));
     }
     return out;
 }
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "forward.h"
+
+#include <cstddef>
+
+#include "Constants.h"
+
+namespace isce3 { namespace core {
+
+/**
+ * Lightweight, non-owning view of a LUT2d for evaluation in hot loops.
+ *
+ * LUT2d::eval() goes through a heap-allocated Interpolator and a virtual
+ * call for every evaluation. A LUT2dView copies the grid parameters of the
+ * LUT and evaluates nearest-neighbor, bilinear and bicubic interpolation
+ * inline on the LUT data, with the same boundary behavior as LUT2d::eval().
+ * Other interpolation methods are forwarded to the viewed LUT2d.
+ *
+ * Unlike the generic bicubic Interpolator, the bicubic stencil is clamped
+ * to the LUT edges, so that evaluation within one sample of the boundary
+ * does not read outside of the LUT data.
+ *
+ * The view does not copy the data: the LUT2d must outlive the view and must
+ * not be modified while it is in use.
+ */
+template<typename T>
+class LUT2dView {
+public:
+    /** Construct a view of a LUT2d */
+    explicit LUT2dView(const LUT2d<T>& lut);
+
+    /** Get starting X-coordinate */
+    double xStart() const { return _xstart; }
+    /** Get starting Y-coordinate */
+    double yStart() const { return _ystart; }
+    /** Get X-spacing */
+    double xSpacing() const { return _dx; }
+    /** Get Y-spacing */
+    double ySpacing() const { return _dy; }
+    /** Get LUT length (number of lines) */
+    size_t length() const { return _length; }
+    /** Get LUT width (number of samples) */
+    size_t width() const { return _width; }
+    /** Get the reference value */
+    T refValue() const { return _refValue; }
+    /** Get flag for having data */
+    bool haveData() const { return _haveData; }
+    /** Get bounds error flag */
+    bool boundsError() const { return _boundsError; }
+    /** Get interpolation method */
+    dataInterpMethod interpMethod() const { return _method; }
+
+    /** Check if point resides in domain of LUT */
+    bool contains(double y, double x) const;
+
+    /**
+     * Evaluate the LUT
+     *
+     * \param[in] y Y-coordinate for evaluation
+     * \param[in] x X-coordinate for evaluation
+     * \returns     Interpolated value
+     */
+    T eval(double y, double x) const;
+
+    /**
+     * Evaluate the LUT with the interpolation method fixed at compile time
+     *
+     * The behavior is undefined if \p Method differs from interpMethod().
+     * Only NEAREST_METHOD, BILINEAR_METHOD and BICUBIC_METHOD are
+     * supported.
+     *
+     * \param[in] y Y-coordinate for evaluation
+     * \param[in] x X-coordinate for evaluation
+     * \returns     Interpolated value
+     */
+    template<dataInterpMethod Method>
+    T evalWith(double y, double x) const;
+
+    /**
+     * Evaluate the LUT at several points with the same Y-coordinate
+     *
+     * The interpolation weights and rows along Y are computed once and
+     * reused for all points.
+     *
+     * \param[in]  y   Y-coordinate for evaluation
+     * \param[in]  x   X-coordinates for evaluation
+     * \param[out] out Interpolated values
+     * \param[in]  n   Number of points
+     */
+    void eval(double y, const double* x, T* out, size_t n) const;
+
+private:
+    // Viewed LUT, used to report out-of-bounds evaluation and for methods
+    // without an inline implementation
+    const LUT2d<T>* _lut;
+    const T* _data;
+    double _xstart, _ystart, _dx, _dy;
+    long _length, _width;
+    T _refValue;
+    bool _haveData, _boundsError;
+    dataInterpMethod _method;
+
+    // Rows and weights of the interpolation stencil along Y
+    struct RowStencil;
+
+    template<dataInterpMethod Method>
+    RowStencil _rowStencil(double y_idx) const;
+
+    template<dataInterpMethod Method>
+    T _interpRow(const RowStencil& rows, double x_idx) const;
+
+    template<dataInterpMethod Method>
+    void _evalRow(double y, const double* x, T* out, size_t n) const;
+
+    // Fractional index of a coordinate, clamped to the LUT
+    double _xIndex(double x) const;
+    double _yIndex(double y) const;
+};
+
+}} // namespace isce3::core
+
+#define ISCE_CORE_LUT2DVIEW_ICC
+#include "LUT2dView.icc"
+#undef ISCE_CORE_LUT2DVIEW_ICC
@@ -85,6 +85,23 @@ ErrorCode Orbit::interpolate(Vec3* position, Vec3* velocity, double t,
     return status;
 }
 
+ErrorCode Orbit::interpolate(Vec3* position, Vec3* velocity, const double* t,
+                             size_t n, OrbitInterpBorderMode border_mode) const {
+    // interpolate
+    ErrorCode status = detail::interpolateOrbit(
+            position, velocity, *this, t, n, border_mode);
+
+    // check for errors
+    if (status != ErrorCode::Success and
+            border_mode == OrbitInterpBorderMode::Error) {
+
+        std::string errmsg = getErrorString(status);
+        throw isce3::except::OutOfRange(ISCE_SRCINFO(), errmsg);
+    }
+
+    return status;
+}
+
 bool operator==(const Orbit & lhs, const Orbit & rhs)
 {
     return lhs.referenceEpoch() == rhs.referenceEpoch() &&
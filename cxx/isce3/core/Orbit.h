@@ -190,6 +190,32 @@ public:
                    OrbitInterpBorderMode border_mode =
                            OrbitInterpBorderMode::Error) const;
 
+    /**
+     * Interpolate platform position and/or velocity at multiple times
+     *
+     * Gives the same result as calling interpolate() for each time, but
+     * the interpolation coefficients that only depend on the state vectors
+     * bracketing each time are reused across consecutive times in the same
+     * interval.  This is most effective when \p t is sorted (or nearly so),
+     * as is typical for the azimuth times of a radar block.
+     *
+     * If either \p position or \p velocity is a null pointer, that output
+     * will not be computed.
+     *
+     * \param[out] position Interpolated positions, size n
+     * \param[out] velocity Interpolated velocities, size n
+     * \param[in] t Interpolation times, size n
+     * \param[in] n Number of interpolation times
+     * \param[in] border_mode Mode for handling interpolation outside orbit
+     * domain
+     * \return Error code of the first time that could not be interpolated,
+     * or Success
+     */
+    isce3::error::ErrorCode
+    interpolate(Vec3* position, Vec3* velocity, const double* t, size_t n,
+                   OrbitInterpBorderMode border_mode =
+                           OrbitInterpBorderMode::Error) const;
+
 private:
     DateTime _reference_epoch;
     Linspace<double> _time;
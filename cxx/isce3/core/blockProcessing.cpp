@@ -240,4 +240,173 @@ void getBlockProcessingParametersXY(const int array_length, const int array_widt
     }
 }
 
+std::vector<Tile2d> getTiles2d(const int array_length, const int array_width,
+        const int tile_length, const int tile_width,
+        const int halo_y, const int halo_x)
+{
+    if (array_length < 0 || array_width < 0) {
+        std::string error_message = ("ERROR array dimensions cannot be"
+                                     " negative");
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_message);
+    }
+    if (tile_length < 1 || tile_width < 1) {
+        std::string error_message = ("ERROR tile dimensions must be"
+                                     " positive");
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_message);
+    }
+    if (halo_y < 0 || halo_x < 0) {
+        std::string error_message = "ERROR tile halo cannot be negative";
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_message);
+    }
+
+    const int ntiles_y = (array_length + tile_length - 1) / tile_length;
+    const int ntiles_x = (array_width + tile_width - 1) / tile_width;
+
+    std::vector<Tile2d> tiles;
+    tiles.reserve(static_cast<size_t>(ntiles_y) * ntiles_x);
+
+    for (int tile_y = 0; tile_y < ntiles_y; ++tile_y) {
+        for (int tile_x = 0; tile_x < ntiles_x; ++tile_x) {
+            Tile2d tile;
+            tile.index = tile_y * ntiles_x + tile_x;
+            tile.offset_y = tile_y * tile_length;
+            tile.offset_x = tile_x * tile_width;
+            tile.length = std::min(tile_length, array_length - tile.offset_y);
+            tile.width = std::min(tile_width, array_width - tile.offset_x);
+
+            tile.halo_offset_y = std::max(tile.offset_y - halo_y, 0);
+            tile.halo_offset_x = std::max(tile.offset_x - halo_x, 0);
+            tile.halo_length = std::min(tile.offset_y + tile.length + halo_y,
+                                        array_length) - tile.halo_offset_y;
+            tile.halo_width = std::min(tile.offset_x + tile.width + halo_x,
+                                       array_width) - tile.halo_offset_x;
+            tiles.push_back(tile);
+        }
+    }
+    return tiles;
+}
+
+TileScheduler::TileScheduler(const int array_length, const int array_width,
+        const int nbands, const int type_size, const int halo_y,
+        const int halo_x, const long long max_memory,
+        const long long min_block_size, const int tiles_per_thread,
+        const int snap, int n_threads, pyre::journal::info_t* channel)
+{
+    if (n_threads < 0) {
+        std::string error_message = ("ERROR number of threads cannot be"
+                                     " negative");
+        throw isce3::except::OutOfRange(ISCE_SRCINFO(), error_message);
+    }
+    if (nbands < 1 || type_size < 1 || tiles_per_thread < 1 || snap < 1) {
+        std::string error_message = ("ERROR number of bands, type size,"
+                                     " tiles per thread, and snap must be"
+                                     " positive");
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_message);
+    }
+    if (min_block_size > max_memory) {
+        std::string error_message = ("ERROR minimum block size cannot be"
+                                     " greater than the memory budget");
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), error_message);
+    }
+
+    if (n_threads == 0) {
+        n_threads = _omp_thread_count();
+    }
+    _n_threads = std::max(n_threads, 1);
+
+    const long long bytes_per_sample =
+            static_cast<long long>(nbands) * type_size;
+
+    // maximum number of samples (including halo) of each tile so that all
+    // tiles processed concurrently fit in the memory budget
+    const double max_tile_samples = std::max(
+            static_cast<double>(max_memory) / (_n_threads * bytes_per_sample),
+            1.0);
+
+    /*
+    largest square tile side `s` such that the tile and its halo fit in
+    the budget: (s + 2 * halo_y) * (s + 2 * halo_x) <= max_tile_samples
+    */
+    const double halo_a = 2.0 * halo_y;
+    const double halo_b = 2.0 * halo_x;
+    const double max_side = (-(halo_a + halo_b) +
+            std::sqrt(std::pow(halo_a - halo_b, 2) + 4 * max_tile_samples)) / 2;
+
+    // tile side for load balancing, bounded by the minimum block size
+    const double n_samples = static_cast<double>(array_length) * array_width;
+    const double balanced_side = std::sqrt(
+            n_samples / (static_cast<double>(tiles_per_thread) * _n_threads));
+    const double min_side = std::sqrt(
+            static_cast<double>(min_block_size) / bytes_per_sample);
+
+    double side = std::max(std::min(max_side, balanced_side), min_side);
+    side = std::max(std::min(side, max_side), 1.0);
+
+    // keep the number of samples per tile if the array is narrower than
+    // the tile side
+    int tile_width = std::min(static_cast<int>(side), array_width);
+    tile_width = std::max(tile_width, 1);
+
+    // snap (tile dimensions multiple of snap). The width is snapped first
+    // so that the length fits in the budget with the snapped width.
+    if (snap > 1) {
+        tile_width = std::max((tile_width / snap) * snap, snap);
+        tile_width = std::min(tile_width, array_width);
+    }
+
+    const double tile_samples = side * side;
+    // longest tile (with its halo) that fits in the budget, bounded by the
+    // array length so that it can be converted to int
+    const int max_tile_length = static_cast<int>(std::min(
+            std::floor(max_tile_samples / (tile_width + halo_b) - halo_a),
+            static_cast<double>(array_length)));
+    int tile_length = std::ceil(tile_samples / tile_width);
+    tile_length = std::min({tile_length, max_tile_length, array_length});
+    if (snap > 1) {
+        tile_length = (tile_length / snap) * snap;
+    }
+    if (tile_length < 1) {
+        tile_length = std::min(snap, array_length);
+    }
+
+    if (tile_length > max_tile_length) {
+        std::string error_message = ("ERROR memory budget too small for"
+                                     " the smallest tile allowed by snap"
+                                     " and halo");
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), error_message);
+    }
+    _tile_length = tile_length;
+    _tile_width = tile_width;
+
+    _tiles = getTiles2d(array_length, array_width, _tile_length, _tile_width,
+                        halo_y, halo_x);
+
+    if (channel != nullptr) {
+        *channel << "array length: " << array_length << pyre::journal::newline;
+        *channel << "array width: " << array_width << pyre::journal::newline;
+        *channel << "number of available thread(s): " << _n_threads
+                 << pyre::journal::newline;
+        *channel << "number of tile(s): " << _tiles.size()
+                 << pyre::journal::newline;
+        *channel << "tile length: " << _tile_length << pyre::journal::newline;
+        *channel << "tile width: " << _tile_width << pyre::journal::newline;
+        *channel << "tile halo (Y x X): " << halo_y << " x " << halo_x
+                 << pyre::journal::newline;
+
+        long long tile_size_bytes =
+                (static_cast<long long>(_tile_length) + 2 * halo_y) *
+                (static_cast<long long>(_tile_width) + 2 * halo_x) *
+                bytes_per_sample;
+
+        std::string tile_size_bytes_str =
+                isce3::core::getNbytesStr(tile_size_bytes);
+        if (nbands > 1)
+            tile_size_bytes_str += " (" + std::to_string(nbands) + " bands)";
+
+        *channel << "tile size (with halo): " << tile_size_bytes_str
+                 << pyre::journal::endl;
+    }
+}
+
 }}
+
@@ -2,6 +2,9 @@
 
 #include "forward.h"
 
+#include <exception>
+#include <vector>
+
 #include <pyre/journal.h>
 
 namespace isce3 { namespace core {
@@ -95,4 +98,166 @@ void getBlockProcessingParametersXY(const int array_length, const int array_widt
         const long long max_block_size = DEFAULT_MAX_BLOCK_SIZE,
         const int snap = 1, int n_threads = 0);
 
+/** 2D tile of an array, and the region (tile plus halo) that has to be
+ * available in order to process it
+ *
+ * The halo region is clipped to the array boundaries.
+ */
+struct Tile2d {
+    /** Tile index (row-major order over the tile grid) */
+    int index = 0;
+
+    /** First line of the tile */
+    int offset_y = 0;
+    /** First column of the tile */
+    int offset_x = 0;
+    /** Number of lines of the tile */
+    int length = 0;
+    /** Number of columns of the tile */
+    int width = 0;
+
+    /** First line of the tile including halo */
+    int halo_offset_y = 0;
+    /** First column of the tile including halo */
+    int halo_offset_x = 0;
+    /** Number of lines of the tile including halo */
+    int halo_length = 0;
+    /** Number of columns of the tile including halo */
+    int halo_width = 0;
+};
+
+/** Split a 2D array into tiles of (at most) `tile_length` x `tile_width`
+ * samples with halos of `halo_y` lines and `halo_x` columns
+ *
+ * @param[in]  array_length        Length of the data to be processed
+ * @param[in]  array_width         Width of the data to be processed
+ * @param[in]  tile_length         Tile length
+ * @param[in]  tile_width          Tile width
+ * @param[in]  halo_y              Halo (margin) in the Y direction
+ * @param[in]  halo_x              Halo (margin) in the X direction
+ * @returns    Tiles in row-major order
+ */
+std::vector<Tile2d> getTiles2d(const int array_length, const int array_width,
+        const int tile_length, const int tile_width,
+        const int halo_y = 0, const int halo_x = 0);
+
+/** Tile scheduler for 2D block processing
+ *
+ * The scheduler cuts a 2D array into tiles whose size is derived from a
+ * global memory budget, shared by all threads, and from the halo required
+ * to process each tile. Tiles are smaller than the budget alone would allow
+ * so that there are several tiles per thread, and they are executed as
+ * OpenMP tasks: a thread that finishes an inexpensive tile (e.g. a tile
+ * outside the DEM or without layover) picks up pending tiles instead of
+ * waiting at a barrier at the end of each block.
+ *
+ * The per-tile function is called with a Tile2d and is expected to be
+ * serial, i.e., parallelism comes from processing tiles concurrently.
+ */
+class TileScheduler {
+public:
+    /** Constructor
+     *
+     * @param[in]  array_length        Length of the data to be processed
+     * @param[in]  array_width         Width of the data to be processed
+     * @param[in]  nbands              Number of the bands to be processed
+     * @param[in]  type_size           Type size of the data to be processed,
+     * in bytes
+     * @param[in]  halo_y              Halo (margin) in the Y direction
+     * required to process each tile
+     * @param[in]  halo_x              Halo (margin) in the X direction
+     * required to process each tile
+     * @param[in]  max_memory          Global memory budget in bytes, i.e.
+     * the maximum memory held by all tiles (including halos) processed
+     * concurrently
+     * @param[in]  min_block_size      Minimum tile size in bytes
+     * @param[in]  tiles_per_thread    Target number of tiles per thread
+     * used for load balancing
+     * @param[in]  snap                Round tile length and width to be
+     * multiples of this value. Tiles are rounded down to fit in the memory
+     * budget; an exception is thrown if a tile of snap x snap samples (or
+     * the array, if smaller) and its halo do not fit.
+     * @param[in]  n_threads           Number of available threads (0 for
+     * auto)
+     * @param[in]  channel             Pyre info channel
+     */
+    TileScheduler(const int array_length, const int array_width,
+            const int nbands = 1,
+            const int type_size = 4, // Float32
+            const int halo_y = 0, const int halo_x = 0,
+            const long long max_memory = DEFAULT_MAX_BLOCK_SIZE,
+            const long long min_block_size = DEFAULT_MIN_BLOCK_SIZE,
+            const int tiles_per_thread = 4, const int snap = 1,
+            int n_threads = 0,
+            pyre::journal::info_t* channel = nullptr);
+
+    /** Tiles in row-major order */
+    const std::vector<Tile2d>& tiles() const { return _tiles; }
+
+    /** Number of tiles */
+    int numTiles() const { return static_cast<int>(_tiles.size()); }
+
+    /** Nominal tile length (tiles on the last row may be shorter) */
+    int tileLength() const { return _tile_length; }
+
+    /** Nominal tile width (tiles on the last column may be narrower) */
+    int tileWidth() const { return _tile_width; }
+
+    /** Number of threads used to process tiles */
+    int numThreads() const { return _n_threads; }
+
+    /** Process all tiles
+     *
+     * Each tile is processed exactly once. If the function throws, the
+     * remaining pending tiles are skipped and the first exception is
+     * re-thrown once all running tiles have finished.
+     *
+     * @param[in]  func    Function called as `func(const Tile2d&)`
+     */
+    template<class Func>
+    void run(Func&& func) const;
+
+private:
+    std::vector<Tile2d> _tiles;
+    int _tile_length;
+    int _tile_width;
+    int _n_threads;
+};
+
+template<class Func>
+void TileScheduler::run(Func&& func) const
+{
+    std::exception_ptr first_exception = nullptr;
+    bool cancelled = false;
+    const int n_tiles = numTiles();
+
+    _Pragma("omp parallel num_threads(_n_threads)")
+    _Pragma("omp single")
+    for (int i = 0; i < n_tiles; ++i) {
+        _Pragma("omp task firstprivate(i) shared(func, first_exception, cancelled)")
+        {
+            bool skip;
+            _Pragma("omp atomic read")
+            skip = cancelled;
+
+            if (!skip) {
+                try {
+                    func(_tiles[i]);
+                } catch (...) {
+                    _Pragma("omp critical(isce3_core_tile_scheduler)")
+                    {
+                        if (!first_exception)
+                            first_exception = std::current_exception();
+                    }
+                    _Pragma("omp atomic write")
+                    cancelled = true;
+                }
+            }
+        }
+    }
+
+    if (first_exception)
+        std::rethrow_exception(first_exception);
+}
+
 }}
@@ -3,9 +3,27 @@
 #include <isce3/math/complexOperations.h>
 
 #include "../Kernels.h"
+#include "SSOBuffer.h"
 
 namespace isce3::core::detail {
 
+/** Get offset of first kernel tap for a given time sample.
+ *
+ * @param[in] width  Number of kernel taps, ceil(kernel.width()).
+ * @param[in] t      Desired time sample.
+ * @returns Index in input array of the first tap.
+ */
+inline long interp1d_low(const int width, const double t)
+{
+    long i0 = 0;
+    if (width % 2 == 0) {
+        i0 = static_cast<long>(ceil(t));
+    } else {
+        i0 = static_cast<long>(round(t));
+    }
+    return i0 - width / 2; // integer division implicit floor()
+}
+
 /** Get interpolator coefficents for a given offset.
  *
  * @param[in]  kernel Kernel function to use for interpolation.
@@ -24,17 +42,13 @@ void interp1d_coeffs(const Kernel<KernelType>& kernel, const double t,
         long* low, KernelType coeffs[])
 {
     int width = int(ceil(kernel.width()));
-    long i0 = 0;
-    if (width % 2 == 0) {
-        i0 = static_cast<long>(ceil(t));
-    } else {
-        i0 = static_cast<long>(round(t));
-    }
-    *low = i0 - width / 2; // integer division implicit floor()
+    *low = interp1d_low(width, t);
+    // Evaluate all taps with a single (batch) kernel call.
+    SSOBuffer<double> ti(width);
     for (int i = 0; i < width; ++i) {
-        double ti = i + (*low) - t;
-        coeffs[i] = kernel(ti);
+        ti[i] = i + (*low) - t;
     }
+    kernel.evaluate(ti.data(), coeffs, width);
 }
 
 /** Return a pointer to a contiguous block of memory for a given selection,
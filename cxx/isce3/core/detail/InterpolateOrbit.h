@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 #include <isce3/error/ErrorCode.h>
 
 #include "../Common.h"
@@ -17,6 +19,23 @@ interpolateOrbit(Vec3 * position,
                  double t,
                  OrbitInterpBorderMode border_mode);
 
+/**
+ * Interpolate orbit at n times, reusing the state vector window and the
+ * coefficients that only depend on it across consecutive times.
+ *
+ * Returns the error code of the first time that could not be interpolated,
+ * or Success.  Unlike the scalar version, processing continues past errors
+ * so that every output is written (NaN with FillNaN mode).
+ */
+template<class Orbit>
+isce3::error::ErrorCode
+interpolateOrbit(Vec3 * position,
+                 Vec3 * velocity,
+                 const Orbit & orbit,
+                 const double * t,
+                 std::size_t n,
+                 OrbitInterpBorderMode border_mode);
+
 }}}
 
 #define ISCE_CORE_DETAIL_INTERPOLATEORBIT_ICC
@@ -27,6 +27,7 @@ namespace isce3 {
         template<typename> class Linspace;
         template<class> class LUT1d;
         template<class> class LUT2d;
+        template<class> class LUT2dView;
         template<class> class Matrix;
         // interpolator classes
         template<class> class Interpolator;
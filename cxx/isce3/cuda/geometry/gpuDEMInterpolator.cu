@@ -27,6 +27,11 @@ gpuDEMInterpolator(const isce3::geometry::DEMInterpolator & demInterp) :
     _epsgcode(demInterp.epsgCode()), _interpMethod(demInterp.interpMethod()),
     _owner(true)
 {
+    if (demInterp.isTiled()) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "tiled DEMs must be loaded into memory before use on GPU");
+    }
+
     if (_haveRaster) {
         // allocate memory on device for DEM data
         size_t bytes = length() * width() * sizeof(float);
@@ -0,0 +1,330 @@
+#include "FFTPlanCache.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include <isce3/except/Error.h>
+
+#include "detail/FFTWWrapper.h"
+
+namespace isce3 { namespace fft {
+
+namespace {
+
+// FFTW planner routines (including wisdom import/export) are not
+// thread-safe, so all planning goes through this lock
+std::mutex & plannerMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+using Key = std::vector<long>;
+
+template<typename PlanT>
+struct CacheEntry {
+    std::shared_ptr<PlanT> plan;
+    // value of the cache clock when the plan was last requested
+    unsigned long lastUse;
+};
+
+template<typename PlanT>
+using PlanCache = std::map<Key, CacheEntry<PlanT>>;
+
+template<typename PlanT>
+PlanCache<PlanT> & planCache()
+{
+    static PlanCache<PlanT> cache;
+    return cache;
+}
+
+// Incremented on every plan request, used to find the least recently used
+// plan. Must be accessed with the planner lock held.
+unsigned long & cacheClock()
+{
+    static unsigned long clock = 0;
+    return clock;
+}
+
+template<typename T> struct IsComplex : std::false_type {};
+template<typename T> struct IsComplex<std::complex<T>> : std::true_type {};
+
+template<typename T> struct RealType { using type = T; };
+template<typename T> struct RealType<std::complex<T>> { using type = T; };
+
+std::string readFile(const std::string & filename)
+{
+    std::ifstream file(filename);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+// Split a wisdom file into its top-level s-expressions
+std::vector<std::string> splitWisdom(const std::string & s)
+{
+    std::vector<std::string> exprs;
+    int depth = 0;
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        if (s[i] == '(') {
+            if (depth == 0) { start = i; }
+            ++depth;
+        } else if (s[i] == ')' and depth > 0) {
+            --depth;
+            if (depth == 0) { exprs.push_back(s.substr(start, i - start + 1)); }
+        }
+    }
+    return exprs;
+}
+
+bool importWisdomLocked(const std::string & filename)
+{
+    std::ifstream file(filename);
+    if (not file) {
+        return false;
+    }
+
+    bool ok = true;
+    for (const auto & expr : splitWisdom(readFile(filename))) {
+        if (expr.find("fftwf_wisdom") != std::string::npos) {
+            ok = fftwf_import_wisdom_from_string(expr.c_str()) and ok;
+        } else if (expr.find("fftw_wisdom") != std::string::npos) {
+            ok = fftw_import_wisdom_from_string(expr.c_str()) and ok;
+        }
+    }
+    return ok;
+}
+
+bool exportWisdomLocked(const std::string & filename)
+{
+    char * fwisdom = fftwf_export_wisdom_to_string();
+    char * dwisdom = fftw_export_wisdom_to_string();
+
+    bool ok = false;
+    if (fwisdom and dwisdom) {
+        std::ofstream file(filename);
+        file << fwisdom << "\n" << dwisdom << "\n";
+        ok = bool(file);
+    }
+
+    std::free(fwisdom);
+    std::free(dwisdom);
+    return ok;
+}
+
+void exportWisdomAtExit()
+{
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    exportWisdomLocked(std::getenv(wisdomEnvVar));
+}
+
+// Import wisdom from the file set through the environment before the first
+// plan is created & export it back at exit. Must be called with the planner
+// lock held.
+void initWisdom()
+{
+    static bool initialized = false;
+    if (initialized) {
+        return;
+    }
+    initialized = true;
+
+    const char * filename = std::getenv(wisdomEnvVar);
+    if (filename == nullptr or filename[0] == '\0') {
+        return;
+    }
+    importWisdomLocked(filename);
+    std::atexit(exportWisdomAtExit);
+}
+
+template<typename PlanT, typename In, typename Out>
+std::shared_ptr<PlanT>
+getCachedPlan(int rank, const int * n, int howmany,
+              In * in, const int * inembed, int istride, int idist,
+              Out * out, const int * onembed, int ostride, int odist,
+              int sign, unsigned flags, int threads)
+{
+    using R = typename RealType<In>::type;
+
+    // transform type: c2c, r2c or c2r
+    const long type = IsComplex<In>::value ? (IsComplex<Out>::value ? 0 : 2) : 1;
+
+    Key key = {type, long(sizeof(R)), rank};
+    for (const int * dims : {n, inembed, onembed}) {
+        for (int i = 0; i < rank; ++i) {
+            key.push_back(dims ? dims[i] : -1);
+        }
+    }
+    key.insert(key.end(), {howmany, istride, idist, ostride, odist, sign,
+                           long(flags), threads,
+                           static_cast<const void *>(in) == static_cast<const void *>(out),
+                           detail::alignmentOf(reinterpret_cast<const R *>(in)),
+                           detail::alignmentOf(reinterpret_cast<const R *>(out))});
+
+    // The plan deleter takes the planner lock, so a plan evicted from the
+    // cache must be released after the lock (declared below) is unlocked.
+    std::shared_ptr<PlanT> evicted;
+
+    std::lock_guard<std::mutex> lock(plannerMutex());
+
+    const unsigned long now = ++cacheClock();
+
+    auto & cache = planCache<PlanT>();
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        it->second.lastUse = now;
+        return it->second.plan;
+    }
+
+    initWisdom();
+
+    PlanT rawPlan = detail::initPlan(rank, n, howmany, in, inembed, istride, idist,
+                                     out, onembed, ostride, odist, sign, flags, threads);
+
+    // make sure plan creation was successful
+    if (!rawPlan) {
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), "FFT plan creation failed");
+    }
+
+    // construct shared pointer with custom deleter to destroy the plan
+    // (FFTW plan destruction isn't thread-safe either)
+    auto plan = std::shared_ptr<PlanT>(new PlanT(rawPlan),
+                [](PlanT * plan) noexcept {
+                    {
+                        std::lock_guard<std::mutex> lock(plannerMutex());
+                        detail::destroyPlan(*plan);
+                    }
+                    delete plan;
+                });
+
+    // evict the least recently used plan once the cache is full
+    if (cache.size() >= maxCachedPlans) {
+        auto lru = cache.begin();
+        for (auto i = cache.begin(); i != cache.end(); ++i) {
+            if (i->second.lastUse < lru->second.lastUse) {
+                lru = i;
+            }
+        }
+        evicted = std::move(lru->second.plan);
+        cache.erase(lru);
+    }
+
+    cache.emplace(std::move(key), CacheEntry<PlanT>{plan, now});
+    return plan;
+}
+
+}
+
+std::size_t planCacheSize()
+{
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    return planCache<fftwf_plan>().size() + planCache<fftw_plan>().size();
+}
+
+void clearPlanCache()
+{
+    // move the plans out of the cache & release them after unlocking, since
+    // the plan deleter takes the planner lock
+    PlanCache<fftwf_plan> fplans;
+    PlanCache<fftw_plan> dplans;
+
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    fplans.swap(planCache<fftwf_plan>());
+    dplans.swap(planCache<fftw_plan>());
+}
+
+bool importWisdom(const std::string & filename)
+{
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    return importWisdomLocked(filename);
+}
+
+bool exportWisdom(const std::string & filename)
+{
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    return exportWisdomLocked(filename);
+}
+
+namespace detail {
+
+std::shared_ptr<fftwf_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<float> * in,
+        const int * inembed, int istride, int idist,
+        std::complex<float> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads)
+{
+    return getCachedPlan<fftwf_plan>(rank, n, howmany, in, inembed, istride, idist,
+                                     out, onembed, ostride, odist, sign, flags, threads);
+}
+
+std::shared_ptr<fftw_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<double> * in,
+        const int * inembed, int istride, int idist,
+        std::complex<double> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads)
+{
+    return getCachedPlan<fftw_plan>(rank, n, howmany, in, inembed, istride, idist,
+                                    out, onembed, ostride, odist, sign, flags, threads);
+}
+
+std::shared_ptr<fftwf_plan>
+getPlan(int rank, const int * n, int howmany,
+        float * in,
+        const int * inembed, int istride, int idist,
+        std::complex<float> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads)
+{
+    return getCachedPlan<fftwf_plan>(rank, n, howmany, in, inembed, istride, idist,
+                                     out, onembed, ostride, odist, sign, flags, threads);
+}
+
+std::shared_ptr<fftw_plan>
+getPlan(int rank, const int * n, int howmany,
+        double * in,
+        const int * inembed, int istride, int idist,
+        std::complex<double> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads)
+{
+    return getCachedPlan<fftw_plan>(rank, n, howmany, in, inembed, istride, idist,
+                                    out, onembed, ostride, odist, sign, flags, threads);
+}
+
+std::shared_ptr<fftwf_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<float> * in,
+        const int * inembed, int istride, int idist,
+        float * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads)
+{
+    return getCachedPlan<fftwf_plan>(rank, n, howmany, in, inembed, istride, idist,
+                                     out, onembed, ostride, odist, sign, flags, threads);
+}
+
+std::shared_ptr<fftw_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<double> * in,
+        const int * inembed, int istride, int idist,
+        double * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads)
+{
+    return getCachedPlan<fftw_plan>(rank, n, howmany, in, inembed, istride, idist,
+                                    out, onembed, ostride, odist, sign, flags, threads);
+}
+
+}
+
+}}
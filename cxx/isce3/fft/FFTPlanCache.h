@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace isce3 { namespace fft {
+
+/**
+ * \file FFTPlanCache.h
+ *
+ * FFT plans are shared through a process-wide cache keyed on transform type,
+ * precision, sizes, batch, data layout, direction, planner flags, thread
+ * count, in-place-ness and array alignment. Constructing a FwdFFTPlan or
+ * InvFFTPlan whose configuration matches a cached plan reuses it (executed on
+ * the new arrays) instead of planning from scratch, so that FFTW_MEASURE
+ * planning costs once per process rather than once per block.
+ *
+ * The cache holds at most maxCachedPlans plans of each precision; beyond
+ * that the least recently requested plan is evicted. Cached plans are
+ * otherwise kept until clearPlanCache() is called or the process exits.
+ *
+ * Planning effort can further be saved across runs with FFTW wisdom. If the
+ * environment variable ISCE3_FFTW_WISDOM is set to a file name, wisdom is
+ * imported from that file (if it exists) before the first plan is created,
+ * and the accumulated wisdom is exported back to it when the process exits.
+ */
+
+/** Name of the environment variable holding the FFTW wisdom file path */
+constexpr const char * wisdomEnvVar = "ISCE3_FFTW_WISDOM";
+
+/** Max number of plans of each precision kept in the plan cache */
+constexpr std::size_t maxCachedPlans = 256;
+
+/** Number of plans in the process-wide plan cache */
+std::size_t planCacheSize();
+
+/**
+ * Remove all plans from the process-wide plan cache
+ *
+ * Plans still referenced by FwdFFTPlan or InvFFTPlan objects are destroyed
+ * once these objects go out of scope.
+ */
+void clearPlanCache();
+
+/**
+ * Import single & double precision FFTW wisdom from a file written by
+ * exportWisdom()
+ *
+ * \param[in] filename Wisdom file path
+ * \returns            True if the wisdom was successfully imported
+ */
+bool importWisdom(const std::string & filename);
+
+/**
+ * Export the single & double precision FFTW wisdom accumulated so far to a
+ * file
+ *
+ * \param[in] filename Wisdom file path
+ * \returns            True if the wisdom was successfully exported
+ */
+bool exportWisdom(const std::string & filename);
+
+}}
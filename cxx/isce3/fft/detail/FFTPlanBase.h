@@ -106,6 +106,12 @@ protected:
                 int threads);
 
     std::shared_ptr<fftw_plan_t> _plan;
+
+    // arrays the plan is executed on (the plan may be shared with other
+    // FFTPlanBase objects through the plan cache)
+    void * _in = nullptr;
+    void * _out = nullptr;
+    void (*_execute)(const fftw_plan_t, void *, void *) = nullptr;
 };
 
 template<int N>
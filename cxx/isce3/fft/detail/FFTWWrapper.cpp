@@ -162,6 +162,40 @@ void executePlan(const fftw_plan plan)
     return fftw_execute(plan);
 }
 
+void executePlan(const fftwf_plan plan, std::complex<float> * in, std::complex<float> * out)
+{
+    fftwf_execute_dft(plan,
+            reinterpret_cast<fftwf_complex *>(in),
+            reinterpret_cast<fftwf_complex *>(out));
+}
+
+void executePlan(const fftw_plan plan, std::complex<double> * in, std::complex<double> * out)
+{
+    fftw_execute_dft(plan,
+            reinterpret_cast<fftw_complex *>(in),
+            reinterpret_cast<fftw_complex *>(out));
+}
+
+void executePlan(const fftwf_plan plan, float * in, std::complex<float> * out)
+{
+    fftwf_execute_dft_r2c(plan, in, reinterpret_cast<fftwf_complex *>(out));
+}
+
+void executePlan(const fftw_plan plan, double * in, std::complex<double> * out)
+{
+    fftw_execute_dft_r2c(plan, in, reinterpret_cast<fftw_complex *>(out));
+}
+
+void executePlan(const fftwf_plan plan, std::complex<float> * in, float * out)
+{
+    fftwf_execute_dft_c2r(plan, reinterpret_cast<fftwf_complex *>(in), out);
+}
+
+void executePlan(const fftw_plan plan, std::complex<double> * in, double * out)
+{
+    fftw_execute_dft_c2r(plan, reinterpret_cast<fftw_complex *>(in), out);
+}
+
 void destroyPlan(fftwf_plan plan)
 {
     if (plan) {
@@ -176,4 +210,14 @@ void destroyPlan(fftw_plan plan)
     }
 }
 
+int alignmentOf(const float * p)
+{
+    return fftwf_alignment_of(const_cast<float *>(p));
+}
+
+int alignmentOf(const double * p)
+{
+    return fftw_alignment_of(const_cast<double *>(p));
+}
+
 }}}
@@ -2,6 +2,7 @@
 
 #include <complex>
 #include <fftw3.h>
+#include <memory>
 
 namespace isce3 { namespace fft { namespace detail {
 
@@ -60,7 +61,79 @@ initPlan(int rank, const int * n, int howmany,
 void executePlan(const fftwf_plan);
 void executePlan(const fftw_plan);
 
+// Execute a plan on new arrays, which must have the same alignment and
+// in-place-ness as the arrays the plan was created with
+void executePlan(const fftwf_plan, std::complex<float> * in, std::complex<float> * out);
+void executePlan(const fftw_plan, std::complex<double> * in, std::complex<double> * out);
+void executePlan(const fftwf_plan, float * in, std::complex<float> * out);
+void executePlan(const fftw_plan, double * in, std::complex<double> * out);
+void executePlan(const fftwf_plan, std::complex<float> * in, float * out);
+void executePlan(const fftw_plan, std::complex<double> * in, double * out);
+
 void destroyPlan(fftwf_plan);
 void destroyPlan(fftw_plan);
 
+// SIMD alignment offset of an array (see fftw_alignment_of). A plan can be
+// executed on arrays with the same offset as the arrays it was created with.
+int alignmentOf(const float *);
+int alignmentOf(const double *);
+
+/**
+ * Get a plan from the process-wide plan cache, creating it if needed
+ *
+ * Plans are keyed on transform type & precision, sizes, batch, layout,
+ * direction, flags, thread count, in-place-ness and array alignment, so that
+ * a cached plan can be executed on the arrays passed here using
+ * executePlan(plan, in, out). Calls are thread-safe.
+ *
+ * \throws RuntimeError if plan creation fails
+ */
+std::shared_ptr<fftwf_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<float> * in,
+        const int * inembed, int istride, int idist,
+        std::complex<float> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads);
+
+std::shared_ptr<fftw_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<double> * in,
+        const int * inembed, int istride, int idist,
+        std::complex<double> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads);
+
+std::shared_ptr<fftwf_plan>
+getPlan(int rank, const int * n, int howmany,
+        float * in,
+        const int * inembed, int istride, int idist,
+        std::complex<float> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads);
+
+std::shared_ptr<fftw_plan>
+getPlan(int rank, const int * n, int howmany,
+        double * in,
+        const int * inembed, int istride, int idist,
+        std::complex<double> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads);
+
+std::shared_ptr<fftwf_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<float> * in,
+        const int * inembed, int istride, int idist,
+        float * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads);
+
+std::shared_ptr<fftw_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<double> * in,
+        const int * inembed, int istride, int idist,
+        double * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads);
+
 }}}
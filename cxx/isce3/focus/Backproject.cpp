@@ -1,5 +1,6 @@
 #include "Backproject.h"
 
+#include <algorithm>
 #include <cmath>
 #include <isce3/container/RadarGeometry.h>
 #include <isce3/core/Constants.h>
@@ -27,7 +28,10 @@ using isce3::container::RadarGeometry;
 namespace isce3 {
 namespace focus {
 
-inline std::complex<float> sumCoherent(const std::complex<float>* data,
+// Sum the contributions of pulses [kstart, kstop) to target x. The range
+// lines in data and the platform position & velocity in pos & vel start at
+// pulse first_pulse.
+inline std::complex<double> sumCoherent(const std::complex<float>* data,
                                        const Linspace<double>& sampling_window,
                                        const std::vector<Vec3>& pos,
                                        const std::vector<Vec3>& vel,
@@ -35,17 +39,20 @@ inline std::complex<float> sumCoherent(const std::complex<float>* data,
                                        double fc,
                                        double tau_atm,
                                        const Kernel<float>& kernel,
-                                       int kstart, int kstop)
+                                       int kstart, int kstop,
+                                       int first_pulse = 0)
 {
     // loop over pulses within integration window
     std::complex<double> sum(0., 0.);
     for (int k = kstart; k < kstop; ++k) {
 
         // compute round-trip delay to target
-        double tau = tau_atm + bistaticDelay(pos[k], vel[k], x);
+        double tau = tau_atm + bistaticDelay(pos[k - first_pulse],
+                                             vel[k - first_pulse], x);
 
         // interpolate range-compressed data
-        auto data_line = &data[size_t(k) * sampling_window.size()];
+        auto data_line =
+                &data[size_t(k - first_pulse) * sampling_window.size()];
         double u = (tau - sampling_window.first()) / sampling_window.spacing();
         std::complex<double> s =
                 interp1d(kernel, data_line, sampling_window.size(), 1, u);
@@ -59,21 +66,219 @@ inline std::complex<float> sumCoherent(const std::complex<float>* data,
         sum += s;
     }
 
-    return std::complex<float>(sum);
+    return sum;
 }
 
+// Number of pulses whose phase compensation is vectorized together and whose
+// sum is accumulated in single precision
+constexpr int single_precision_block = 64;
+
+/**
+ * Compute cos(2*pi*(f + q/4)) and sin(2*pi*(f + q/4))
+ *
+ * \param[in]  f  Fraction of a cycle, |f| <= 1/8
+ * \param[in]  q  Number of quarter cycles in [0, 4)
+ * \param[out] c  Cosine
+ * \param[out] s  Sine
+ *
+ * Uses Taylor polynomials on [-pi/4, pi/4] (truncation error below 3.2e-7)
+ * followed by an exact rotation by q quarter cycles. Written without
+ * branches so that it can be vectorized.
+ */
+inline void sincos2pi(float f, int q, float& c, float& s)
+{
+    const float x = static_cast<float>(2. * M_PI) * f;
+    const float x2 = x * x;
+    const float sx =
+            x * (1.f + x2 * (-1.f / 6.f +
+                             x2 * (1.f / 120.f + x2 * (-1.f / 5040.f))));
+    const float cx =
+            1.f + x2 * (-0.5f +
+                        x2 * (1.f / 24.f +
+                              x2 * (-1.f / 720.f + x2 * (1.f / 40320.f))));
+
+    // rotate by q quarter cycles
+    const bool swap = q & 1;
+    const float a = swap ? sx : cx;
+    const float b = swap ? cx : sx;
+    c = (q == 1 or q == 2) ? -a : a;
+    s = (q >= 2) ? -b : b;
+}
+
+inline std::complex<double>
+sumCoherentSingle(const std::complex<float>* data,
+                  const Linspace<double>& sampling_window,
+                  const std::vector<Vec3>& pos,
+                  const std::vector<Vec3>& vel,
+                  const Vec3& x,
+                  double fc,
+                  double tau_atm,
+                  const Kernel<float>& kernel,
+                  int kstart, int kstop,
+                  int first_pulse = 0)
+{
+    constexpr int block = single_precision_block;
+    float re[block], im[block], frac[block];
+    int quadrant[block];
+
+    std::complex<double> sum(0., 0.);
+    for (int k0 = kstart; k0 < kstop; k0 += block) {
+        const int n = std::min(block, kstop - k0);
+
+        for (int b = 0; b < n; ++b) {
+            const int k = k0 + b;
+
+            // compute round-trip delay to target in double precision
+            double tau = tau_atm + bistaticDelay(pos[k - first_pulse],
+                                                 vel[k - first_pulse], x);
+
+            // interpolate range-compressed data
+            auto data_line =
+                    &data[size_t(k - first_pulse) * sampling_window.size()];
+            double u = (tau - sampling_window.first()) /
+                       sampling_window.spacing();
+            std::complex<float> z =
+                    interp1d(kernel, data_line, sampling_window.size(), 1, u);
+            re[b] = z.real();
+            im[b] = z.imag();
+
+            // split the carrier phase (in quarter cycles) into a whole number
+            // of quarter cycles modulo 4 and a remainder within +/- 1/8 cycle
+            double quarters = 4. * fc * tau;
+            double q = std::round(quarters);
+            frac[b] = static_cast<float>(0.25 * (quarters - q));
+            quadrant[b] = static_cast<int>(q - 4. * std::floor(0.25 * q));
+        }
+
+        // apply phase migration compensation & sum in single precision
+        float sum_re = 0.f, sum_im = 0.f;
+#pragma omp simd reduction(+ : sum_re, sum_im)
+        for (int b = 0; b < n; ++b) {
+            float c, s;
+            sincos2pi(frac[b], quadrant[b], c, s);
+            sum_re += re[b] * c - im[b] * s;
+            sum_im += re[b] * s + im[b] * c;
+        }
+
+        // limit the growth of rounding errors by accumulating the partial
+        // sums in double precision
+        sum += std::complex<double>(sum_re, sum_im);
+    }
+
+    return sum;
+}
+
+std::string toString(BackprojectPrecision p)
+{
+    switch (p) {
+        case BackprojectPrecision::Double : return "double";
+        case BackprojectPrecision::Single : return "single";
+    }
+
+    throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+            "unexpected backprojection precision");
+}
+
+BackprojectPrecision parseBackprojectPrecision(const std::string& s)
+{
+    if (s == "double") {
+        return BackprojectPrecision::Double;
+    }
+    if (s == "single") {
+        return BackprojectPrecision::Single;
+    }
+
+    std::string errmsg = "expected one of {'double', 'single'}, instead got '"
+        + s + "'";
+    throw isce3::except::InvalidArgument(ISCE_SRCINFO(), errmsg);
+}
+
+namespace detail {
+
 ErrorCode
-backproject(std::complex<float>* out, const RadarGeometry& out_geometry,
-        const std::complex<float>* in, const RadarGeometry& in_geometry,
-        const DEMInterpolator& dem, double fc, double ds,
-        const Kernel<float>& kernel, DryTroposphereModel dry_tropo_model,
+locateTarget(BackprojectTarget& target, double t, double r,
+        const RadarGeometry& out_geometry, const RadarGeometry& in_geometry,
+        const DEMInterpolator& dem, const Ellipsoid& ellipsoid, double fc,
+        double ds, DryTroposphereModel dry_tropo_model,
         const isce3::geometry::detail::Rdr2GeoBracketParams& r2g_params,
-        const isce3::geometry::detail::Geo2RdrBracketParams& g2r_params,
-        float* height)
+        const isce3::geometry::detail::Geo2RdrBracketParams& g2r_params)
 {
     static constexpr double c = isce3::core::speed_of_light;
-    static constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+    static constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+
+    // carrier wavelength
+    const double wvl = c / fc;
+
+    // Run rdr2geo using orbit and Doppler associated with output grid to get
+    // target position.  Only need LLH if dumping height or using TSX
+    // atmosphere model, but just compute it unconditionally.
+    {
+        double fD = out_geometry.doppler().eval(t, r);
+
+        const int converged = rdr2geo_bracket(t, r, fD, out_geometry.orbit(),
+                dem, target.x, wvl, out_geometry.lookSide(),
+                r2g_params.tol_height, r2g_params.look_min,
+                r2g_params.look_max);
+
+        if (not converged) {
+            target.x = target.llh = {nan, nan, nan};
+            return ErrorCode::FailedToConverge;
+        }
+        target.llh = ellipsoid.xyzToLonLat(target.x);
+    }
+
+    // run geo2rdr using input data's orbit and azimuth carrier to estimate
+    // the center of the coherent processing window for the target
+    double t_in, r_in;
+    {
+        auto converged = geo2rdr_bracket(target.x, in_geometry.orbit(),
+                in_geometry.doppler(), t_in, r_in, wvl,
+                in_geometry.lookSide(), g2r_params.tol_aztime,
+                g2r_params.time_start, g2r_params.time_end);
+
+        if (not converged) {
+            return ErrorCode::FailedToConverge;
+        }
+    }
+
+    // get platform position and velocity at center of CPI
+    Vec3 p, v;
+    in_geometry.orbit().interpolate(&p, &v, t_in);
+
+    // estimate synthetic aperture length required to achieve the desired
+    // azimuth resolution
+    double l = wvl * r_in * (p.norm() / target.x.norm()) / (2. * ds);
+
+    // approximate CPI duration (assuming constant platform velocity)
+    double cpi = l / v.norm();
+
+    // get coherent integration bounds (pulse indices)
+    const Linspace<double> in_azimuth_time = in_geometry.sensingTime();
+    double tstart = t_in - 0.5 * cpi;
+    double tstop = t_in + 0.5 * cpi;
+    double t0 = in_azimuth_time.first();
+    double dt = in_azimuth_time.spacing();
+    auto kstart = static_cast<int>(std::floor((tstart - t0) / dt));
+    auto kstop = static_cast<int>(std::ceil((tstop - t0) / dt));
+    target.kstart = std::max(kstart, 0);
+    target.kstop = std::min(kstop, in_azimuth_time.size());
+
+    // estimate dry troposphere delay
+    target.tau_atm = 0.;
+    if (dry_tropo_model == DryTroposphereModel::TSX) {
+        target.tau_atm = dryTropoDelayTSX(p, target.llh, ellipsoid);
+    }
+
+    return ErrorCode::Success;
+}
+
+} // namespace detail
 
+// Check that the backprojection inputs are supported
+static void checkInputs(const RadarGeometry& out_geometry,
+                        const RadarGeometry& in_geometry,
+                        DryTroposphereModel dry_tropo_model)
+{
     // check that dry_tropo_model is supported internally
     if (not(dry_tropo_model == DryTroposphereModel::NoDelay or
             dry_tropo_model == DryTroposphereModel::TSX)) {
@@ -90,6 +295,21 @@ backproject(std::complex<float>* out, const RadarGeometry& out_geometry,
                              "reference epoch";
         throw isce3::except::RuntimeError(ISCE_SRCINFO(), errmsg);
     }
+}
+
+ErrorCode
+backproject(std::complex<float>* out, const RadarGeometry& out_geometry,
+        const std::complex<float>* in, const RadarGeometry& in_geometry,
+        const DEMInterpolator& dem, double fc, double ds,
+        const Kernel<float>& kernel, DryTroposphereModel dry_tropo_model,
+        const isce3::geometry::detail::Rdr2GeoBracketParams& r2g_params,
+        const isce3::geometry::detail::Geo2RdrBracketParams& g2r_params,
+        float* height, BackprojectPrecision precision)
+{
+    static constexpr double c = isce3::core::speed_of_light;
+    static constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+
+    checkInputs(out_geometry, in_geometry, dry_tropo_model);
 
     // get input & output radar grid azimuth time & slant range
     Linspace<double> in_azimuth_time = in_geometry.sensingTime();
@@ -115,93 +335,40 @@ backproject(std::complex<float>* out, const RadarGeometry& out_geometry,
     int epsg = dem.epsgCode();
     Ellipsoid ellipsoid = makeProjection(epsg)->ellipsoid();
 
-    // carrier wavelength
-    double wvl = c / fc;
-
     // loop over targets in output grid
     bool all_converged = true;
 #pragma omp parallel for collapse(2)
     for (int j = 0; j < out_azimuth_time.size(); ++j) {
         for (int i = 0; i < out_slant_range.size(); ++i) {
 
-            // Run rdr2geo using orbit and Doppler associated with output grid
-            // to get target position.  Only need LLH if dumping height or
-            // using TSX atmosphere model, but just compute it unconditionally.
-            Vec3 x, llh;
-            {
-                double t = out_azimuth_time[j];
-                double r = out_slant_range[i];
-                double fD = out_geometry.doppler().eval(t, r);
-
-                const int converged = rdr2geo_bracket(t, r, fD,
-                        out_geometry.orbit(), dem, x, wvl,
-                        out_geometry.lookSide(), r2g_params.tol_height,
-                        r2g_params.look_min, r2g_params.look_max);
-
-                llh = ellipsoid.xyzToLonLat(x);
-
-                if (height != nullptr) {
-                    height[j * out_geometry.gridWidth() + i] = llh[2];
-                }
-                if (not converged) {
-                    all_converged = false;
-                    out[j * out_geometry.gridWidth() + i] = {nan, nan};
-                    if (height != nullptr) {
-                        height[j * out_geometry.gridWidth() + i] = nan;
-                    }
-                    continue;
-                }
-            }
+            detail::BackprojectTarget target;
+            const ErrorCode status = detail::locateTarget(target,
+                    out_azimuth_time[j], out_slant_range[i], out_geometry,
+                    in_geometry, dem, ellipsoid, fc, ds, dry_tropo_model,
+                    r2g_params, g2r_params);
 
-            // run geo2rdr using input data's orbit and azimuth carrier to
-            // estimate the center of the coherent processing window for the
-            // target
-            double t, r;
-            {
-                auto converged =
-                        geo2rdr_bracket(x, in_geometry.orbit(),
-                                in_geometry.doppler(), t, r, wvl,
-                                in_geometry.lookSide(), g2r_params.tol_aztime,
-                                g2r_params.time_start, g2r_params.time_end);
-
-                if (not converged) {
-                    all_converged = false;
-                    out[j * out_geometry.gridWidth() + i] = {nan, nan};
-                    continue;
-                }
+            if (height != nullptr) {
+                height[j * out_geometry.gridWidth() + i] = target.llh[2];
             }
-
-            // get platform position and velocity at center of CPI
-            Vec3 p, v;
-            in_geometry.orbit().interpolate(&p, &v, t);
-
-            // estimate synthetic aperture length required to achieve the
-            // desired azimuth resolution
-            double l = wvl * r * (p.norm() / x.norm()) / (2. * ds);
-
-            // approximate CPI duration (assuming constant platform velocity)
-            double cpi = l / v.norm();
-
-            // get coherent integration bounds (pulse indices)
-            double tstart = t - 0.5 * cpi;
-            double tstop = t + 0.5 * cpi;
-            double t0 = in_azimuth_time.first();
-            double dt = in_azimuth_time.spacing();
-            auto kstart = static_cast<int>(std::floor((tstart - t0) / dt));
-            auto kstop = static_cast<int>(std::ceil((tstop - t0) / dt));
-            kstart = std::max(kstart, 0);
-            kstop = std::min(kstop, in_azimuth_time.size());
-
-            // estimate dry troposphere delay
-            double tau_atm = 0.;
-            if (dry_tropo_model == DryTroposphereModel::TSX) {
-                tau_atm = dryTropoDelayTSX(p, llh, ellipsoid);
+            if (status != ErrorCode::Success) {
+                all_converged = false;
+                out[j * out_geometry.gridWidth() + i] = {nan, nan};
+                continue;
             }
 
             // integrate pulses
-            out[j * out_geometry.gridWidth() + i] =
-                    sumCoherent(in, sampling_window, pos, vel, x, fc, tau_atm,
-                                kernel, kstart, kstop);
+            if (precision == BackprojectPrecision::Single) {
+                out[j * out_geometry.gridWidth() + i] =
+                        std::complex<float>(sumCoherentSingle(in,
+                                sampling_window, pos, vel, target.x, fc,
+                                target.tau_atm, kernel, target.kstart,
+                                target.kstop));
+            } else {
+                out[j * out_geometry.gridWidth() + i] =
+                        std::complex<float>(sumCoherent(in, sampling_window,
+                                pos, vel, target.x, fc, target.tau_atm,
+                                kernel, target.kstart, target.kstop));
+            }
         }
     }
 
@@ -211,5 +378,144 @@ backproject(std::complex<float>* out, const RadarGeometry& out_geometry,
     return ErrorCode::Success;
 }
 
+Backprojector::Backprojector(const RadarGeometry& out_geometry,
+        const RadarGeometry& in_geometry, const DEMInterpolator& dem,
+        double fc, double ds, const Kernel<float>& kernel,
+        DryTroposphereModel dry_tropo_model,
+        const isce3::geometry::detail::Rdr2GeoBracketParams& r2g_params,
+        const isce3::geometry::detail::Geo2RdrBracketParams& g2r_params,
+        BackprojectPrecision precision)
+    : _out_geometry(out_geometry),
+      _in_geometry(in_geometry),
+      _fc(fc),
+      _kernel(kernel),
+      _precision(precision)
+{
+    checkInputs(out_geometry, in_geometry, dry_tropo_model);
+
+    const Linspace<double> out_azimuth_time = out_geometry.sensingTime();
+    const Linspace<double> out_slant_range = out_geometry.slantRange();
+    const size_t num_pixels = size_t(out_geometry.gridLength()) *
+                              size_t(out_geometry.gridWidth());
+
+    // reference ellipsoid
+    int epsg = dem.epsgCode();
+    Ellipsoid ellipsoid = makeProjection(epsg)->ellipsoid();
+
+    _targets.resize(num_pixels);
+    _converged.resize(num_pixels);
+    _sums.assign(num_pixels, {0., 0.});
+
+    // locate the target & coherent processing interval of each pixel
+    bool all_converged = true;
+#pragma omp parallel for collapse(2) reduction(&& : all_converged)
+    for (int j = 0; j < out_azimuth_time.size(); ++j) {
+        for (int i = 0; i < out_slant_range.size(); ++i) {
+            const size_t idx = size_t(j) * out_slant_range.size() + i;
+            const ErrorCode status = detail::locateTarget(_targets[idx],
+                    out_azimuth_time[j], out_slant_range[i], out_geometry,
+                    in_geometry, dem, ellipsoid, fc, ds, dry_tropo_model,
+                    r2g_params, g2r_params);
+
+            _converged[idx] = (status == ErrorCode::Success);
+            all_converged = all_converged and _converged[idx];
+        }
+    }
+    _all_converged = all_converged;
+}
+
+void Backprojector::addPulses(const std::complex<float>* pulses,
+                              int first_pulse, int num_pulses)
+{
+    static constexpr double c = isce3::core::speed_of_light;
+
+    const Linspace<double> in_azimuth_time = _in_geometry.sensingTime();
+    if (first_pulse < 0 or num_pulses < 0 or
+        first_pulse + num_pulses > in_azimuth_time.size()) {
+
+        std::string errmsg = "pulses [" + std::to_string(first_pulse) + ", " +
+                std::to_string(first_pulse + num_pulses) +
+                ") are out of bounds of the input radar grid";
+        throw isce3::except::OutOfRange(ISCE_SRCINFO(), errmsg);
+    }
+    if (num_pulses == 0) {
+        return;
+    }
+    const int last_pulse = first_pulse + num_pulses;
+
+    // interpolate platform position & velocity at each pulse of the batch
+    std::vector<Vec3> pos(num_pulses);
+    std::vector<Vec3> vel(num_pulses);
+    for (int k = 0; k < num_pulses; ++k) {
+        double t = in_azimuth_time[first_pulse + k];
+        _in_geometry.orbit().interpolate(&pos[k], &vel[k], t);
+    }
+
+    // range sampling window
+    const Linspace<double> in_slant_range = _in_geometry.slantRange();
+    double swst = 2. * in_slant_range.first() / c;
+    double dtau = 2. * in_slant_range.spacing() / c;
+    int nr = in_slant_range.size();
+    Linspace<double> sampling_window(swst, dtau, nr);
+
+    // accumulate the contributions of the batch to each target whose
+    // coherent processing interval overlaps it
+    const long num_pixels = static_cast<long>(_sums.size());
+#pragma omp parallel for schedule(dynamic, 64)
+    for (long idx = 0; idx < num_pixels; ++idx) {
+        if (not _converged[idx]) {
+            continue;
+        }
+        const detail::BackprojectTarget& target = _targets[idx];
+        const int kstart = std::max(target.kstart, first_pulse);
+        const int kstop = std::min(target.kstop, last_pulse);
+        if (kstart >= kstop) {
+            continue;
+        }
+
+        if (_precision == BackprojectPrecision::Single) {
+            _sums[idx] += sumCoherentSingle(pulses, sampling_window, pos, vel,
+                    target.x, _fc, target.tau_atm, _kernel, kstart, kstop,
+                    first_pulse);
+        } else {
+            _sums[idx] += sumCoherent(pulses, sampling_window, pos, vel,
+                    target.x, _fc, target.tau_atm, _kernel, kstart, kstop,
+                    first_pulse);
+        }
+    }
+
+    _num_pulses_added += num_pulses;
+}
+
+ErrorCode Backprojector::finalize(std::complex<float>* out,
+                                  float* height) const
+{
+    static constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+
+    const long num_pixels = static_cast<long>(_sums.size());
+#pragma omp parallel for
+    for (long idx = 0; idx < num_pixels; ++idx) {
+        if (height != nullptr) {
+            height[idx] = _targets[idx].llh[2];
+        }
+        if (_converged[idx]) {
+            out[idx] = std::complex<float>(_sums[idx]);
+        } else {
+            out[idx] = {nan, nan};
+        }
+    }
+
+    if (not _all_converged) {
+        return ErrorCode::FailedToConverge;
+    }
+    return ErrorCode::Success;
+}
+
+void Backprojector::reset()
+{
+    std::fill(_sums.begin(), _sums.end(), std::complex<double>(0., 0.));
+    _num_pulses_added = 0;
+}
+
 } // namespace focus
 } // namespace isce3
@@ -5,7 +5,11 @@
 #include <isce3/geometry/forward.h>
 
 #include <complex>
+#include <string>
+#include <vector>
 
+#include <isce3/container/RadarGeometry.h>
+#include <isce3/core/Vector.h>
 #include <isce3/error/ErrorCode.h>
 #include <isce3/geometry/detail/Geo2Rdr.h>
 #include <isce3/geometry/detail/Rdr2Geo.h>
@@ -15,6 +19,99 @@
 namespace isce3 {
 namespace focus {
 
+/** Arithmetic precision of the backprojection coherent sum */
+enum class BackprojectPrecision {
+    /**
+     * Phase compensation and summation over pulses in double precision
+     * (reference)
+     */
+    Double = 0,
+
+    /**
+     * Phase compensation and summation in single precision
+     *
+     * Radar-target delays are still computed in double precision and the
+     * carrier phase is reduced to a fraction of a cycle before conversion to
+     * single precision, so the phase error of each pulse does not depend on
+     * the delay. The phase is evaluated with a polynomial approximation of
+     * sin/cos whose error is below 1e-6 rad, and pulses are summed in blocks
+     * of 64 in single precision whose partial sums are accumulated in double
+     * precision. The error of each output pixel relative to the Double
+     * policy is therefore bounded by about 1e-5 times the sum of the
+     * magnitudes of the interpolated samples over the aperture (typically
+     * much less, since rounding errors are uncorrelated).
+     */
+    Single,
+};
+
+/** Convert to string */
+std::string toString(BackprojectPrecision);
+
+/**
+ * Convert from string
+ *
+ * \param[in] s Input string in {"double", "single"}
+ * \returns     BackprojectPrecision enumeration value
+ */
+BackprojectPrecision parseBackprojectPrecision(const std::string& s);
+
+namespace detail {
+
+/** Geometry of an output pixel required to focus it by backprojection */
+struct BackprojectTarget {
+    /** Target position (ECEF m) */
+    isce3::core::Vec3 x;
+
+    /** Target Lon/Lat/HAE (rad/rad/m) */
+    isce3::core::Vec3 llh;
+
+    /** Index of the first pulse of the coherent processing interval */
+    int kstart;
+
+    /** Index past the last pulse of the coherent processing interval */
+    int kstop;
+
+    /** Dry troposphere path delay (s) */
+    double tau_atm;
+};
+
+/**
+ * Locate the target of an output pixel and estimate its coherent processing
+ * interval
+ *
+ * Runs rdr2geo using the output orbit & Doppler to get the target position,
+ * then geo2rdr using the input orbit & Doppler to find the center of the
+ * coherent processing interval whose length is set by the desired azimuth
+ * resolution.
+ *
+ * \param[out] target          Target geometry. If rdr2geo fails, the
+ *                             target position & LLH are set to NaN.
+ * \param[in]  t               Output pixel azimuth time (s)
+ * \param[in]  r               Output pixel slant range (m)
+ * \param[in]  out_geometry    Output data grid, orbit, & doppler
+ * \param[in]  in_geometry     Input data grid, orbit, & doppler
+ * \param[in]  dem             DEM
+ * \param[in]  ellipsoid       Reference ellipsoid of the DEM
+ * \param[in]  fc              Center frequency (Hz)
+ * \param[in]  ds              Desired azimuth resolution (m)
+ * \param[in]  dry_tropo_model Dry troposphere path delay model
+ * \param[in]  r2g_params      rdr2geo configuration parameters
+ * \param[in]  g2r_params      geo2rdr configuration parameters
+ *
+ * \returns Non-zero error code if rdr2geo or geo2rdr fails to converge
+ */
+isce3::error::ErrorCode
+locateTarget(BackprojectTarget& target, double t, double r,
+        const isce3::container::RadarGeometry& out_geometry,
+        const isce3::container::RadarGeometry& in_geometry,
+        const isce3::geometry::DEMInterpolator& dem,
+        const isce3::core::Ellipsoid& ellipsoid, double fc, double ds,
+        DryTroposphereModel dry_tropo_model,
+        const isce3::geometry::detail::Rdr2GeoBracketParams& r2g_params,
+        const isce3::geometry::detail::Geo2RdrBracketParams& g2r_params);
+
+} // namespace detail
+
 /**
  * Focus in azimuth via time-domain backprojection
  *
@@ -30,6 +127,7 @@ namespace focus {
  * \param[in]  r2g_params      rdr2geo configuration parameters
  * \param[in]  g2r_params      geo2rdr configuration parameters
  * \param[out] height          Height of each pixel in meters above ellipsoid
+ * \param[in]  precision       Arithmetic precision of the coherent sum
  *
  * \returns Non-zero error code if geometry fails to converge for any pixel,
  *          and the values for these pixels are set to NaN.
@@ -44,7 +142,118 @@ backproject(std::complex<float>* out,
         DryTroposphereModel dry_tropo_model = DryTroposphereModel::TSX,
         const isce3::geometry::detail::Rdr2GeoBracketParams& r2g_params = {},
         const isce3::geometry::detail::Geo2RdrBracketParams& g2r_params = {},
-        float* height = nullptr);
+        float* height = nullptr,
+        BackprojectPrecision precision = BackprojectPrecision::Double);
+
+/**
+ * Incremental (pulse-streaming) time-domain backprojection
+ *
+ * Focuses the same output as backproject() from range-compressed pulses
+ * supplied in batches, e.g. as they are produced by range compression, so
+ * that the whole input block need not be held in memory at once. The
+ * geometry of each output pixel (target position & coherent processing
+ * interval) is computed once on construction. Each batch of pulses is then
+ * backprojected to the pixels whose coherent processing interval overlaps it
+ * and accumulated in double precision, and finalize() writes out the focused
+ * image.
+ *
+ * Pulses may be added in any order, but each pulse of the input grid should
+ * be added exactly once to reproduce the output of backproject().
+ * addPulses() is parallelized over output pixels with OpenMP and must not be
+ * called concurrently on the same object.
+ */
+class Backprojector {
+public:
+    /**
+     * Constructor
+     *
+     * The DEM is only used to locate the targets during construction. The
+     * kernel is held by reference and must outlive the Backprojector.
+     *
+     * \param[in] out_geometry    Target output grid, orbit, & doppler to
+     *                            focus to
+     * \param[in] in_geometry     Input data grid, orbit, & doppler
+     * \param[in] dem             DEM
+     * \param[in] fc              Center frequency (Hz)
+     * \param[in] ds              Desired azimuth resolution (m)
+     * \param[in] kernel          1-D interpolation kernel
+     * \param[in] dry_tropo_model Dry troposphere path delay model
+     * \param[in] r2g_params      rdr2geo configuration parameters
+     * \param[in] g2r_params      geo2rdr configuration parameters
+     * \param[in] precision       Arithmetic precision of the coherent sum
+     */
+    Backprojector(const isce3::container::RadarGeometry& out_geometry,
+            const isce3::container::RadarGeometry& in_geometry,
+            const isce3::geometry::DEMInterpolator& dem, double fc, double ds,
+            const isce3::core::Kernel<float>& kernel,
+            DryTroposphereModel dry_tropo_model = DryTroposphereModel::TSX,
+            const isce3::geometry::detail::Rdr2GeoBracketParams& r2g_params =
+                    {},
+            const isce3::geometry::detail::Geo2RdrBracketParams& g2r_params =
+                    {},
+            BackprojectPrecision precision = BackprojectPrecision::Double);
+
+    /** Output data grid, orbit, & doppler */
+    const isce3::container::RadarGeometry& outGeometry() const
+    {
+        return _out_geometry;
+    }
+
+    /** Input data grid, orbit, & doppler */
+    const isce3::container::RadarGeometry& inGeometry() const
+    {
+        return _in_geometry;
+    }
+
+    /** Number of pulses added since construction or the last reset() */
+    long numPulsesAdded() const { return _num_pulses_added; }
+
+    /**
+     * Backproject a batch of consecutive range-compressed pulses and
+     * accumulate them into the output image
+     *
+     * \param[in] pulses      Range-compressed pulses (num_pulses x input
+     *                        grid width, row major)
+     * \param[in] first_pulse Index of the first pulse in the input grid
+     * \param[in] num_pulses  Number of pulses in the batch
+     */
+    void addPulses(const std::complex<float>* pulses, int first_pulse,
+                   int num_pulses);
+
+    /**
+     * Write the focused image
+     *
+     * May be called at any time to get the image focused from the pulses
+     * added so far.
+     *
+     * \param[out] out    Output focused signal data
+     * \param[out] height Height of each pixel in meters above ellipsoid
+     *
+     * \returns Non-zero error code if geometry failed to converge for any
+     *          pixel, and the values for these pixels are set to NaN.
+     */
+    isce3::error::ErrorCode finalize(std::complex<float>* out,
+                                     float* height = nullptr) const;
+
+    /** Discard the pulses added so far, keeping the pixel geometry */
+    void reset();
+
+private:
+    isce3::container::RadarGeometry _out_geometry;
+    isce3::container::RadarGeometry _in_geometry;
+    double _fc;
+    const isce3::core::Kernel<float>& _kernel;
+    BackprojectPrecision _precision;
+
+    // geometry & convergence status of each output pixel
+    std::vector<detail::BackprojectTarget> _targets;
+    std::vector<char> _converged;
+    bool _all_converged = true;
+
+    // coherent sum of each output pixel over the pulses added so far
+    std::vector<std::complex<double>> _sums;
+    long _num_pulses_added = 0;
+};
 
 } // namespace focus
 } // namespace isce3
@@ -0,0 +1,494 @@
+#include "FactorizedBackproject.h"
+
+#include <algorithm>
+#include <cmath>
+#include <isce3/container/RadarGeometry.h>
+#include <isce3/core/Constants.h>
+#include <isce3/core/Ellipsoid.h>
+#include <isce3/core/Interp1d.h>
+#include <isce3/core/Interp2d.h>
+#include <isce3/core/Kernels.h>
+#include <isce3/core/Projections.h>
+#include <isce3/except/Error.h>
+#include <isce3/geometry/DEMInterpolator.h>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "Backproject.h"
+#include "BistaticDelay.h"
+
+using namespace isce3::core;
+using isce3::error::ErrorCode;
+using isce3::geometry::DEMInterpolator;
+
+using isce3::container::RadarGeometry;
+
+namespace isce3 {
+namespace focus {
+
+namespace {
+
+constexpr double c = isce3::core::speed_of_light;
+
+/** Image of a subaperture on a polar grid centered on its phase center */
+struct Subaperture {
+    // pulses [kstart, kstop) of the subaperture
+    int kstart, kstop;
+
+    // phase center position and orthonormal basis: along-track, towards
+    // nadir, and towards the look side
+    Vec3 p, e1, e2, e3;
+
+    // geocentric radius of the ellipsoid below the phase center (m)
+    double earth_radius;
+
+    // extent of the polar coordinates where the image is needed
+    double rmin = std::numeric_limits<double>::infinity();
+    double rmax = -std::numeric_limits<double>::infinity();
+    double umin = std::numeric_limits<double>::infinity();
+    double umax = -std::numeric_limits<double>::infinity();
+
+    // polar grid: slant range r0 + i * dr and direction cosine u0 + j * du
+    double r0 = 0., dr = 0., u0 = 0., du = 0.;
+    int nr = 0, nu = 0;
+
+    // image samples with the phase 4 pi fc r / c removed, indexed by
+    // [j * nr + i]
+    std::vector<std::complex<float>> image;
+
+    bool used() const { return rmin <= rmax; }
+
+    void extend(double r, double u)
+    {
+        rmin = std::min(rmin, r);
+        rmax = std::max(rmax, r);
+        umin = std::min(umin, u);
+        umax = std::max(umax, u);
+    }
+
+    void extend(const Subaperture& other)
+    {
+        if (other.used()) {
+            extend(other.rmin, other.umin);
+            extend(other.rmax, other.umax);
+        }
+    }
+
+    // polar coordinates of a point
+    void toPolar(const Vec3& x, double& r, double& u) const
+    {
+        const Vec3 d = x - p;
+        r = d.norm();
+        u = d.dot(e1) / r;
+    }
+
+    // Radius (distance to the Earth center) of the points at slant range r
+    // and height h, found by solving for the point at u = 0 on the
+    // ellipsoid. The points of a range line of the grid are then placed on
+    // the sphere of that radius.
+    double surfaceRadius(double r, double h, const Ellipsoid& ellipsoid) const
+    {
+        double psi = elevation(r, 0., earth_radius + h);
+        Vec3 x;
+        for (int iter = 0; iter < 4; ++iter) {
+            x = point(r, 0., psi);
+            const Vec3 dx = r * (-std::sin(psi) * e2 + std::cos(psi) * e3);
+            const double dh = dx.dot(x.normalized());
+            if (dh == 0.) {
+                break;
+            }
+            psi -= (ellipsoid.xyzToLonLat(x)[2] - h) / dh;
+        }
+        return point(r, 0., psi).norm();
+    }
+
+    // Elevation angle (from nadir, around the along-track axis) of the point
+    // at slant range r and direction cosine u at distance rho from the
+    // Earth center
+    double elevation(double r, double u, double rho) const
+    {
+        const double w = std::sqrt(std::max(0., 1. - u * u));
+        const double cos_psi =
+                (rho * rho - p.squaredNorm() - r * r - 2. * r * u * p.dot(e1)) /
+                (2. * r * w * p.dot(e2));
+        return std::acos(std::clamp(cos_psi, -1., 1.));
+    }
+
+    // position of a point from its polar coordinates & elevation angle
+    Vec3 point(double r, double u, double psi) const
+    {
+        const double w = std::sqrt(std::max(0., 1. - u * u));
+        return p + r * (u * e1 +
+                        w * (std::cos(psi) * e2 + std::sin(psi) * e3));
+    }
+
+    // interpolate the image (with phase removed) at polar coordinates
+    std::complex<float> interpolate(const Kernel<float>& kernel, double r,
+                                    double u) const
+    {
+        return interp2d(kernel, kernel, image.data(), nr, 1, nu, nr,
+                        (r - r0) / dr, (u - u0) / du);
+    }
+};
+
+/**
+ * Split the pulses [kstart, kstop) into the longest aligned subapertures of
+ * the hierarchy that fit in the interval, calling add_subaperture(level,
+ * index) for each of them and add_pulse(k) for the remaining pulses, which
+ * are fewer than leaf_size at either end of the interval.
+ */
+template<class F, class G>
+void decompose(int kstart, int kstop, int leaf_size, int depth,
+               F&& add_subaperture, G&& add_pulse)
+{
+    int k = kstart;
+    while (k < kstop) {
+        int level = depth;
+        while (level >= 0 and (k % (leaf_size << level) != 0 or
+                               k + (leaf_size << level) > kstop)) {
+            --level;
+        }
+        if (level < 0) {
+            add_pulse(k);
+            ++k;
+        } else {
+            add_subaperture(level, k / (leaf_size << level));
+            k += leaf_size << level;
+        }
+    }
+}
+
+} // namespace
+
+ErrorCode
+factorizedBackproject(std::complex<float>* out,
+        const RadarGeometry& out_geometry, const std::complex<float>* in,
+        const RadarGeometry& in_geometry, const DEMInterpolator& dem,
+        double fc, double ds, const Kernel<float>& kernel,
+        DryTroposphereModel dry_tropo_model, const FFBPParams& ffbp_params,
+        const isce3::geometry::detail::Rdr2GeoBracketParams& r2g_params,
+        const isce3::geometry::detail::Geo2RdrBracketParams& g2r_params,
+        float* height)
+{
+    static constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+
+    // check that dry_tropo_model is supported internally
+    if (not(dry_tropo_model == DryTroposphereModel::NoDelay or
+            dry_tropo_model == DryTroposphereModel::TSX)) {
+
+        std::string errmsg = "unexpected dry troposphere model";
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), errmsg);
+    }
+
+    const int leaf_size = ffbp_params.leaf_size;
+    const int depth = ffbp_params.depth;
+    if (leaf_size < 1) {
+        std::string errmsg = "leaf subaperture size must be positive";
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), errmsg);
+    }
+    if (depth < 0 or depth > 24) {
+        std::string errmsg = "factorization depth must be in [0, 24]";
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), errmsg);
+    }
+    if (not(ffbp_params.angular_oversampling >= 1.)) {
+        std::string errmsg = "angular oversampling must be >= 1";
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), errmsg);
+    }
+
+    if (out_geometry.referenceEpoch() != in_geometry.referenceEpoch()) {
+        std::string errmsg = "input reference epoch must match output "
+                             "reference epoch";
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), errmsg);
+    }
+
+    // get input & output radar grid azimuth time & slant range
+    const Linspace<double> in_azimuth_time = in_geometry.sensingTime();
+    const Linspace<double> in_slant_range = in_geometry.slantRange();
+    const Linspace<double> out_azimuth_time = out_geometry.sensingTime();
+    const Linspace<double> out_slant_range = out_geometry.slantRange();
+    const int num_pulses = in_azimuth_time.size();
+
+    // interpolate platform position & velocity at each pulse
+    std::vector<Vec3> pos(num_pulses);
+    std::vector<Vec3> vel(num_pulses);
+    for (int k = 0; k < num_pulses; ++k) {
+        in_geometry.orbit().interpolate(&pos[k], &vel[k], in_azimuth_time[k]);
+    }
+
+    // range sampling window
+    const double swst = 2. * in_slant_range.first() / c;
+    const double dtau = 2. * in_slant_range.spacing() / c;
+    const int nr = in_slant_range.size();
+
+    // reference ellipsoid
+    const int epsg = dem.epsgCode();
+    const Ellipsoid ellipsoid = makeProjection(epsg)->ellipsoid();
+
+    const double wvl = c / fc;
+    const double kr = 4. * M_PI * fc / c;
+
+    // locate targets in output grid
+    const size_t out_width = out_geometry.gridWidth();
+    const size_t num_targets = out_geometry.gridLength() * out_width;
+    std::vector<detail::BackprojectTarget> targets(num_targets);
+    std::vector<char> valid(num_targets);
+    bool all_converged = true;
+
+#pragma omp parallel for collapse(2) reduction(&& : all_converged)
+    for (int j = 0; j < out_azimuth_time.size(); ++j) {
+        for (int i = 0; i < out_slant_range.size(); ++i) {
+            const size_t index = j * out_width + i;
+            auto& target = targets[index];
+            const ErrorCode status = detail::locateTarget(target,
+                    out_azimuth_time[j], out_slant_range[i], out_geometry,
+                    in_geometry, dem, ellipsoid, fc, ds, dry_tropo_model,
+                    r2g_params, g2r_params);
+
+            if (height != nullptr) {
+                height[index] = target.llh[2];
+            }
+            valid[index] = (status == ErrorCode::Success);
+            all_converged = all_converged and valid[index];
+        }
+    }
+
+    // Set up the hierarchy of subapertures. Subapertures of level l span
+    // leaf_size * 2^l pulses and only those that fit in the input data are
+    // formed.
+    std::vector<std::vector<Subaperture>> levels(depth + 1);
+    for (int level = 0; level <= depth; ++level) {
+        const int n = leaf_size << level;
+        levels[level].resize(num_pulses / n);
+
+#pragma omp parallel for
+        for (size_t m = 0; m < levels[level].size(); ++m) {
+            auto& sub = levels[level][m];
+            sub.kstart = m * n;
+            sub.kstop = sub.kstart + n;
+
+            const double tc = 0.5 * (in_azimuth_time[sub.kstart] +
+                                     in_azimuth_time[sub.kstop - 1]);
+            Vec3 v;
+            in_geometry.orbit().interpolate(&sub.p, &v, tc);
+            sub.e1 = v.normalized();
+            sub.e2 = -(sub.p - sub.p.dot(sub.e1) * sub.e1).normalized();
+            sub.e3 = (in_geometry.lookSide() == LookSide::Left)
+                             ? sub.e1.cross(sub.e2)
+                             : sub.e2.cross(sub.e1);
+
+            Vec3 nadir = ellipsoid.xyzToLonLat(sub.p);
+            nadir[2] = 0.;
+            sub.earth_radius = ellipsoid.lonLatToXyz(nadir).norm();
+
+            // slant range sampling of the input data, angular sampling at
+            // the Nyquist rate of the subaperture times the oversampling
+            const double length = v.norm() * n * in_azimuth_time.spacing();
+            sub.dr = in_slant_range.spacing();
+            sub.du = wvl / (2. * length * ffbp_params.angular_oversampling);
+        }
+    }
+
+    // Find the extent of the subaperture images required by the targets.
+    // Delays are shifted by the dry troposphere delay of each target, which
+    // is constant over its coherent processing interval.
+    auto for_each_subaperture = [&](const detail::BackprojectTarget& target,
+                                    auto&& f) {
+        decompose(target.kstart, target.kstop, leaf_size, depth,
+                  [&](int level, int m) {
+                      auto& sub = levels[level][m];
+                      double r, u;
+                      sub.toPolar(target.x, r, u);
+                      f(level, sub, r + 0.5 * c * target.tau_atm, u);
+                  },
+                  [](int) {});
+    };
+
+#pragma omp parallel
+    {
+        std::vector<std::vector<Subaperture>> local(depth + 1);
+        for (int level = 0; level <= depth; ++level) {
+            local[level].resize(levels[level].size());
+        }
+
+#pragma omp for schedule(dynamic, 64)
+        for (size_t index = 0; index < num_targets; ++index) {
+            if (not valid[index]) {
+                continue;
+            }
+            for_each_subaperture(targets[index],
+                    [&](int level, const Subaperture& sub, double r,
+                        double u) {
+                        const size_t m = sub.kstart / (leaf_size << level);
+                        local[level][m].extend(r, u);
+                    });
+        }
+
+#pragma omp critical
+        for (int level = 0; level <= depth; ++level) {
+            for (size_t m = 0; m < levels[level].size(); ++m) {
+                levels[level][m].extend(local[level][m]);
+            }
+        }
+    }
+
+    // Define the polar grids from the top of the hierarchy down, so that
+    // the images of each subaperture also cover the grid of its parent.
+    const int margin = static_cast<int>(std::ceil(kernel.width() / 2.)) + 2;
+    for (int level = depth; level >= 0; --level) {
+
+#pragma omp parallel for schedule(dynamic)
+        for (size_t m = 0; m < levels[level].size(); ++m) {
+            auto& sub = levels[level][m];
+            if (not sub.used()) {
+                continue;
+            }
+            sub.r0 = sub.rmin - margin * sub.dr;
+            sub.u0 = sub.umin - margin * sub.du;
+            sub.nr = static_cast<int>(std::ceil((sub.rmax - sub.rmin) / sub.dr))
+                     + 2 * margin + 1;
+            sub.nu = static_cast<int>(std::ceil((sub.umax - sub.umin) / sub.du))
+                     + 2 * margin + 1;
+
+            if (level == 0) {
+                continue;
+            }
+
+            // map samples along the border of the grid to the children
+            const double h = dem.refHeight();
+            for (auto child : {2 * m, 2 * m + 1}) {
+                auto& sub_child = levels[level - 1][child];
+                auto add_point = [&](int i, int j) {
+                    const double r = sub.r0 + i * sub.dr;
+                    const double u = sub.u0 + j * sub.du;
+                    const double rho = sub.surfaceRadius(r, h, ellipsoid);
+                    const Vec3 x = sub.point(r, u, sub.elevation(r, u, rho));
+                    double r_child, u_child;
+                    sub_child.toPolar(x, r_child, u_child);
+                    sub_child.extend(r_child, u_child);
+                };
+                const int step_r = std::max(1, (sub.nr - 1) / 8);
+                const int step_u = std::max(1, (sub.nu - 1) / 8);
+                for (int i = 0; i < sub.nr; i += step_r) {
+                    add_point(i, 0);
+                    add_point(i, sub.nu - 1);
+                }
+                for (int j = 0; j < sub.nu; j += step_u) {
+                    add_point(0, j);
+                    add_point(sub.nr - 1, j);
+                }
+                add_point(sub.nr - 1, sub.nu - 1);
+            }
+        }
+    }
+
+    // Form the subaperture images from the bottom of the hierarchy up. Each
+    // level is accumulated into the output as soon as it is formed, and the
+    // level below is released.
+    std::vector<std::complex<double>> sums(num_targets, 0.);
+    for (int level = 0; level <= depth; ++level) {
+        for (auto& sub : levels[level]) {
+            if (not sub.used()) {
+                continue;
+            }
+            sub.image.resize(size_t(sub.nr) * sub.nu);
+
+#pragma omp parallel for
+            for (int i = 0; i < sub.nr; ++i) {
+                const double r = sub.r0 + i * sub.dr;
+                const double rho = sub.surfaceRadius(r, dem.refHeight(),
+                                                     ellipsoid);
+                for (int j = 0; j < sub.nu; ++j) {
+                    const double u = sub.u0 + j * sub.du;
+                    const Vec3 x = sub.point(r, u, sub.elevation(r, u, rho));
+
+                    std::complex<double> sum(0., 0.);
+                    if (level == 0) {
+                        // backproject the pulses of the leaf subaperture
+                        for (int k = sub.kstart; k < sub.kstop; ++k) {
+                            const double tau = bistaticDelay(pos[k], vel[k], x);
+                            const double t = (tau - swst) / dtau;
+                            std::complex<double> s = interp1d(kernel,
+                                    &in[size_t(k) * nr], nr, 1, t);
+                            const double phi = 2. * M_PI * fc * tau - kr * r;
+                            sum += s * std::complex<double>(std::cos(phi),
+                                                            std::sin(phi));
+                        }
+                    } else {
+                        // merge the images of the two halves
+                        for (int child : {0, 1}) {
+                            const auto& sub_child =
+                                    levels[level - 1][2 * (sub.kstart /
+                                            (leaf_size << level)) + child];
+                            double r_child, u_child;
+                            sub_child.toPolar(x, r_child, u_child);
+                            std::complex<double> s = sub_child.interpolate(
+                                    kernel, r_child, u_child);
+                            const double phi = kr * (r_child - r);
+                            sum += s * std::complex<double>(std::cos(phi),
+                                                            std::sin(phi));
+                        }
+                    }
+                    sub.image[size_t(j) * sub.nr + i] = sum;
+                }
+            }
+        }
+
+        if (level > 0) {
+            for (auto& sub : levels[level - 1]) {
+                sub.image = std::vector<std::complex<float>>();
+            }
+        }
+
+        // add the contributions of this level to the output pixels, along
+        // with the pulses which don't fill a leaf subaperture
+#pragma omp parallel for schedule(dynamic, 64)
+        for (size_t index = 0; index < num_targets; ++index) {
+            if (not valid[index]) {
+                continue;
+            }
+            const auto& target = targets[index];
+            decompose(target.kstart, target.kstop, leaf_size, depth,
+                    [&](int l, int m) {
+                        if (l != level) {
+                            return;
+                        }
+                        const auto& sub = levels[l][m];
+                        double r, u;
+                        sub.toPolar(target.x, r, u);
+                        r += 0.5 * c * target.tau_atm;
+                        std::complex<double> s =
+                                sub.interpolate(kernel, r, u);
+                        const double phi = kr * r;
+                        sums[index] += s * std::complex<double>(
+                                std::cos(phi), std::sin(phi));
+                    },
+                    [&](int k) {
+                        if (level != 0) {
+                            return;
+                        }
+                        const double tau = target.tau_atm +
+                                bistaticDelay(pos[k], vel[k], target.x);
+                        const double t = (tau - swst) / dtau;
+                        std::complex<double> s = interp1d(kernel,
+                                &in[size_t(k) * nr], nr, 1, t);
+                        const double phi = 2. * M_PI * fc * tau;
+                        sums[index] += s * std::complex<double>(
+                                std::cos(phi), std::sin(phi));
+                    });
+        }
+    }
+
+    for (size_t index = 0; index < num_targets; ++index) {
+        out[index] = valid[index] ? std::complex<float>(sums[index])
+                                  : std::complex<float>(nan, nan);
+    }
+
+    if (not all_converged) {
+        return ErrorCode::FailedToConverge;
+    }
+    return ErrorCode::Success;
+}
+
+} // namespace focus
+} // namespace isce3
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <isce3/container/forward.h>
+#include <isce3/core/forward.h>
+#include <isce3/geometry/forward.h>
+
+#include <complex>
+
+#include <isce3/error/ErrorCode.h>
+#include <isce3/geometry/detail/Geo2Rdr.h>
+#include <isce3/geometry/detail/Rdr2Geo.h>
+
+#include "DryTroposphereModel.h"
+
+namespace isce3 {
+namespace focus {
+
+/** Factorization parameters of fast factorized backprojection */
+struct FFBPParams {
+    /** Number of pulses of the shortest (leaf) subapertures */
+    int leaf_size = 16;
+
+    /**
+     * Factorization depth: number of times pairs of adjacent subapertures
+     * are merged, so that the longest subapertures span
+     * leaf_size * 2^depth pulses
+     */
+    int depth = 4;
+
+    /**
+     * Oversampling factor of the angular grid of subaperture images with
+     * respect to their Nyquist rate
+     */
+    double angular_oversampling = 2.;
+};
+
+/**
+ * Focus in azimuth via fast factorized backprojection (FFBP)
+ *
+ * Approximates the output of backproject() using a hierarchy of
+ * subaperture images. The input pulses are grouped into subapertures of
+ * leaf_size pulses which are backprojected onto polar grids (slant range &
+ * direction cosine w.r.t. the along-track direction) centered on the
+ * subaperture phase center. Pairs of adjacent subapertures are recursively
+ * merged into subapertures twice as long by interpolating their images onto
+ * polar grids with twice the angular resolution. The angular sampling of
+ * each image is proportional to its subaperture length, so that each level
+ * of the hierarchy costs about the same as backprojecting leaf_size pulses
+ * to a single grid, bringing the cost of focusing an N x N image from
+ * O(N^3) down to O(N^2 log N).
+ *
+ * The coherent processing interval of each output pixel is split into the
+ * longest subapertures of the hierarchy that fit in it; their images are
+ * interpolated at the pixel and the few pulses at either end which do not
+ * fill a leaf subaperture are backprojected directly.
+ *
+ * The result is an approximation of direct backprojection: every merge
+ * interpolates the subaperture images, so the error grows with the
+ * factorization depth and shrinks with the angular oversampling. On a
+ * simulated L-band point target with depth 4 and 2x angular oversampling
+ * the error stays within 3% of the focused peak.
+ *
+ * Polar grid samples are placed at the DEM reference height. For a straight
+ * flight path the polar coordinates of a target fully determine its delay
+ * to every pulse of a subaperture so the result does not depend on terrain
+ * height; with a curved orbit the phase error grows with the subaperture
+ * length and with the height difference to the reference, and can be kept
+ * small by limiting the factorization depth.
+ *
+ * \param[out] out             Output focused signal data
+ * \param[in]  out_geometry    Target output grid, orbit, & doppler to focus to
+ * \param[in]  in              Input range-compressed signal data
+ * \param[in]  in_geometry     Input data grid, orbit, & doppler
+ * \param[in]  dem             DEM
+ * \param[in]  fc              Center frequency (Hz)
+ * \param[in]  ds              Desired azimuth resolution (m)
+ * \param[in]  kernel          1-D interpolation kernel, used in range for
+ *                             the input data and in range & angle for the
+ *                             subaperture images. Its passband must cover
+ *                             1 / angular_oversampling of the band.
+ * \param[in]  dry_tropo_model Dry troposphere path delay model
+ * \param[in]  ffbp_params     Factorization parameters
+ * \param[in]  r2g_params      rdr2geo configuration parameters
+ * \param[in]  g2r_params      geo2rdr configuration parameters
+ * \param[out] height          Height of each pixel in meters above ellipsoid
+ *
+ * \returns Non-zero error code if geometry fails to converge for any pixel,
+ *          and the values for these pixels are set to NaN.
+ */
+isce3::error::ErrorCode
+factorizedBackproject(std::complex<float>* out,
+        const isce3::container::RadarGeometry& out_geometry,
+        const std::complex<float>* in,
+        const isce3::container::RadarGeometry& in_geometry,
+        const isce3::geometry::DEMInterpolator& dem, double fc, double ds,
+        const isce3::core::Kernel<float>& kernel,
+        DryTroposphereModel dry_tropo_model = DryTroposphereModel::TSX,
+        const FFBPParams& ffbp_params = {},
+        const isce3::geometry::detail::Rdr2GeoBracketParams& r2g_params = {},
+        const isce3::geometry::detail::Geo2RdrBracketParams& g2r_params = {},
+        float* height = nullptr);
+
+} // namespace focus
+} // namespace isce3
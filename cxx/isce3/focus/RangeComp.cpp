@@ -2,8 +2,10 @@
 
 #include <algorithm>
 #include <limits>
+#include <utility>
 
 #include <isce3/except/Error.h>
+#include <isce3/fft/detail/Threads.h>
 
 namespace isce3 { namespace focus {
 
@@ -19,6 +21,35 @@ int getOutputSize(int m, int n, RangeComp::Mode mode)
     throw isce3::except::RuntimeError(ISCE_SRCINFO(), "unexpected range compression mode");
 }
 
+// Index of the first output sample in the full discrete convolution
+inline
+int getOutputOffset(int chirpsize, RangeComp::Mode mode)
+{
+    switch (mode) {
+        case RangeComp::Mode::Full  : return 0;
+        case RangeComp::Mode::Valid : return chirpsize - 1;
+        case RangeComp::Mode::Same  : return chirpsize / 2;
+    }
+
+    throw isce3::except::RuntimeError(ISCE_SRCINFO(), "unexpected range compression mode");
+}
+
+// Overlap-save segment FFT length (0 if segmentation is disabled or would not
+// reduce the FFT length)
+static
+int getSegmentFFTSize(int segmentsize, int chirpsize, int fftsize)
+{
+    if (segmentsize < 0) {
+        throw isce3::except::DomainError(ISCE_SRCINFO(), "segment size must be >= 0");
+    }
+    if (segmentsize == 0) {
+        return 0;
+    }
+
+    int segfftsize = fft::nextFastPower(std::max(segmentsize, 2 * chirpsize));
+    return (segfftsize < fftsize) ? segfftsize : 0;
+}
+
 static
 std::vector<std::complex<float>>
 formRangeReference(const std::vector<std::complex<float>> & chirp, int fftsize)
@@ -39,7 +70,8 @@ formRangeReference(const std::vector<std::complex<float>> & chirp, int fftsize)
 RangeComp::RangeComp(const std::vector<std::complex<float>> & chirp,
                      int inputsize,
                      int maxbatch,
-                     Mode mode)
+                     Mode mode,
+                     int segmentsize)
 :
     _chirpsize([=]()
         {
@@ -66,17 +98,36 @@ RangeComp::RangeComp(const std::vector<std::complex<float>> & chirp,
             return maxbatch;
         }()),
     _mode(mode),
-    _reffn(formRangeReference(chirp, _fftsize)),
-    _wkspc(std::size_t(maxbatch) * _fftsize),
-    _fftplan(fft::planfft1d(_wkspc.data(), _wkspc.data(), {maxbatch, _fftsize}, 1)),
-    _ifftplan(fft::planifft1d(_wkspc.data(), _wkspc.data(), {maxbatch, _fftsize}, 1))
-{}
+    _segfftsize(getSegmentFFTSize(segmentsize, _chirpsize, _fftsize))
+{
+    if (isSegmented()) {
+        // lines are compressed using the workspace pool, so there's no need
+        // for a full-length batch workspace
+        _segreffn = formRangeReference(chirp, _segfftsize);
+    } else {
+        _reffn = formRangeReference(chirp, _fftsize);
+        _wkspc.resize(std::size_t(maxbatch) * _fftsize);
+        _fftplan = fft::planfft1d(_wkspc.data(), _wkspc.data(), {maxbatch, _fftsize}, 1);
+        _ifftplan = fft::planifft1d(_wkspc.data(), _wkspc.data(), {maxbatch, _fftsize}, 1);
+    }
+}
 
 int RangeComp::outputSize() const
 {
     return getOutputSize(chirpSize(), inputSize(), mode());
 }
 
+int RangeComp::numSegments() const
+{
+    if (not isSegmented()) {
+        return 1;
+    }
+
+    // number of output samples per segment
+    int step = segmentFFTSize() - chirpSize() + 1;
+    return (outputSize() + step - 1) / step;
+}
+
 int RangeComp::firstValidSample() const
 {
     switch (mode()) {
@@ -96,6 +147,11 @@ void RangeComp::rangecompress(std::complex<float> * out,
         throw isce3::except::LengthError(ISCE_SRCINFO(), "batch size exceeds max batch");
     }
 
+    if (isSegmented()) {
+        rangecompressParallel(out, in, batch);
+        return;
+    }
+
     // copy input data to internal workspace buffer & zero pad to FFT length
     int padding = fftSize() - inputSize();
     #pragma omp parallel for
@@ -118,9 +174,7 @@ void RangeComp::rangecompress(std::complex<float> * out,
     _ifftplan.execute();
 
     // crop to output range & copy result to output buffer
-    int offset = (mode() == Mode::Full) ? 0 :
-                 (mode() == Mode::Valid) ? chirpSize() - 1 :
-                 chirpSize() / 2;
+    int offset = getOutputOffset(chirpSize(), mode());
     #pragma omp parallel for
     for (int b = 0; b < batch; ++b) {
         const std::complex<float> * src = &_wkspc[std::size_t(b) * fftSize()];
@@ -129,4 +183,125 @@ void RangeComp::rangecompress(std::complex<float> * out,
     }
 }
 
+std::unique_ptr<RangeComp::Workspace> RangeComp::acquireWorkspace() const
+{
+    {
+        std::lock_guard<std::mutex> lock(_workspaces_mutex);
+        if (not _workspaces.empty()) {
+            auto ws = std::move(_workspaces.back());
+            _workspaces.pop_back();
+            return ws;
+        }
+    }
+
+    // each line is transformed as one batch of segments by a single thread
+    // (plan creation is serialized by the process-wide FFT planner lock, so
+    // the pool lock doesn't need to be held here)
+    int n = isSegmented() ? segmentFFTSize() : fftSize();
+    int nseg = numSegments();
+    auto ws = std::make_unique<Workspace>();
+    ws->data.resize(std::size_t(nseg) * n);
+    ws->fftplan = fft::FwdFFTPlan<float>(ws->data.data(), ws->data.data(), n, nseg, FFTW_MEASURE, 1);
+    ws->ifftplan = fft::InvFFTPlan<float>(ws->data.data(), ws->data.data(), n, nseg, FFTW_MEASURE, 1);
+    return ws;
+}
+
+void RangeComp::releaseWorkspace(std::unique_ptr<Workspace> ws) const
+{
+    std::lock_guard<std::mutex> lock(_workspaces_mutex);
+    _workspaces.push_back(std::move(ws));
+}
+
+void RangeComp::compressLine(Workspace & ws,
+                             std::complex<float> * out,
+                             const std::complex<float> * in) const
+{
+    const int n = isSegmented() ? segmentFFTSize() : fftSize();
+    const auto & reffn = isSegmented() ? _segreffn : _reffn;
+    const int nseg = numSegments();
+
+    // number of output samples per segment
+    const int step = isSegmented() ? n - chirpSize() + 1 : outputSize();
+
+    // index of the first output sample in the full discrete convolution
+    const int offset = getOutputOffset(chirpSize(), mode());
+
+    // Copy the input samples of each segment to the workspace, zero-filling
+    // outside of the input signal. With overlap-save, the first
+    // (chirpsize - 1) samples of each circular convolution are corrupted by
+    // wrap-around and are discarded. Without segmentation, the whole line is
+    // zero-padded to the FFT length so there's no wrap-around.
+    auto segmentStart = [&](int s) {
+        return isSegmented() ? offset + s * step - (chirpSize() - 1) : 0;
+    };
+    for (int s = 0; s < nseg; ++s) {
+        std::complex<float> * dest = &ws.data[std::size_t(s) * n];
+        const int start = segmentStart(s);
+        const int i0 = std::max(0, -start);
+        const int i1 = std::max(i0, std::min(n, inputSize() - start));
+        std::fill_n(dest, i0, std::complex<float>(0.f));
+        std::copy(in + start + i0, in + start + i1, dest + i0);
+        std::fill(dest + i1, dest + n, std::complex<float>(0.f));
+    }
+
+    // FFT convolve
+    const float scale = 1. / n;
+    ws.fftplan.execute();
+    for (int s = 0; s < nseg; ++s) {
+        std::complex<float> * z = &ws.data[std::size_t(s) * n];
+        for (int i = 0; i < n; ++i) {
+            z[i] *= reffn[i] * scale;
+        }
+    }
+    ws.ifftplan.execute();
+
+    // copy the valid part of each segment to the output
+    for (int s = 0; s < nseg; ++s) {
+        const int first = offset + s * step - segmentStart(s);
+        const int count = std::min(step, outputSize() - s * step);
+        const std::complex<float> * src = &ws.data[std::size_t(s) * n + first];
+        std::copy_n(src, count, &out[std::size_t(s) * step]);
+    }
+}
+
+void RangeComp::rangecompressParallel(std::complex<float> * out,
+                                      const std::complex<float> * in,
+                                      int nlines) const
+{
+    if (nlines <= 0) {
+        return;
+    }
+
+    // Get a workspace for each thread up front so that any plan creation
+    // happens outside of the parallel region
+    const int nthreads = std::min(fft::detail::getMaxThreads(), nlines);
+    std::vector<std::unique_ptr<Workspace>> workspaces;
+    for (int i = 0; i < nthreads; ++i) {
+        workspaces.push_back(acquireWorkspace());
+    }
+
+    #pragma omp parallel num_threads(nthreads)
+    {
+        std::unique_ptr<Workspace> ws;
+        #pragma omp critical(rangecomp_workspaces)
+        {
+            ws = std::move(workspaces.back());
+            workspaces.pop_back();
+        }
+
+        #pragma omp for schedule(dynamic)
+        for (int b = 0; b < nlines; ++b) {
+            compressLine(*ws, &out[std::size_t(b) * outputSize()],
+                         &in[std::size_t(b) * inputSize()]);
+        }
+
+        #pragma omp critical(rangecomp_workspaces)
+        workspaces.push_back(std::move(ws));
+    }
+
+    for (auto & ws : workspaces) {
+        releaseWorkspace(std::move(ws));
+    }
+}
+
 }}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <complex>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <isce3/fft/FFT.h>
@@ -44,15 +46,28 @@ public:
      * chirp replica and creates FFT plans for frequency domain convolution
      * with the matched filter.
      *
-     * \param[in] chirp     Time-domain replica of the transmitted chirp waveform
-     * \param[in] inputsize Number of range samples in the signal to be compressed
-     * \param[in] maxbatch  Max batch size
-     * \param[in] mode      Convolution output mode
+     * If \p segmentsize is positive, range lines are compressed by
+     * overlap-save convolution over segments whose FFT length is
+     * \p segmentsize rounded up to a fast FFT size (and to at least twice the
+     * chirp size). Each segment yields (segment FFT size - chirp size + 1)
+     * output samples, so that the transforms stay cache-resident instead of
+     * being padded to the full swath. Segmentation is disabled if it would
+     * not reduce the FFT size.
+     *
+     * \param[in] chirp       Time-domain replica of the transmitted chirp
+     *                        waveform
+     * \param[in] inputsize   Number of range samples in the signal to be
+     *                        compressed
+     * \param[in] maxbatch    Max batch size
+     * \param[in] mode        Convolution output mode
+     * \param[in] segmentsize Overlap-save segment FFT length (0 to use a
+     *                        single FFT spanning the whole range line)
      */
     RangeComp(const std::vector<std::complex<float>> & chirp,
               int inputsize,
               int maxbatch = 1,
-              Mode mode = Mode::Full);
+              Mode mode = Mode::Full,
+              int segmentsize = 0);
 
     /** Number of samples in chirp */
     int chirpSize() const { return _chirpsize; }
@@ -66,6 +81,15 @@ public:
     /** Max batch size */
     int maxBatch() const { return _maxbatch; }
 
+    /** Whether range lines are compressed by overlap-save segments */
+    bool isSegmented() const { return _segfftsize > 0; }
+
+    /** Overlap-save segment FFT length (0 if not segmented) */
+    int segmentFFTSize() const { return _segfftsize; }
+
+    /** Number of overlap-save segments per range line (1 if not segmented) */
+    int numSegments() const;
+
     /** Output mode */
     Mode mode() const { return _mode; }
 
@@ -92,7 +116,42 @@ public:
      */
     void rangecompress(std::complex<float> * out, const std::complex<float> * in, int batch = 1);
 
+    /**
+     * Perform pulse compression on a block of input signals in parallel
+     *
+     * Range lines are distributed over OpenMP threads, each of which uses its
+     * own workspace & single-threaded FFT plans drawn from a pool owned by
+     * the processor. Unlike rangecompress(), the number of lines is not
+     * limited by the max batch size and the method may be called
+     * concurrently from multiple threads.
+     *
+     * \param[out] out      Range-compressed data
+     * \param[in]  in       Input data
+     * \param[in]  nlines   Number of range lines
+     */
+    void rangecompressParallel(std::complex<float> * out,
+                               const std::complex<float> * in,
+                               int nlines) const;
+
 private:
+    // Buffer & FFT plans used to compress one range line at a time (as one
+    // batch of numSegments() transforms)
+    struct Workspace {
+        std::vector<std::complex<float>> data;
+        isce3::fft::FwdFFTPlan<float> fftplan;
+        isce3::fft::InvFFTPlan<float> ifftplan;
+    };
+
+    // Get a workspace from the pool, creating one if none is available
+    std::unique_ptr<Workspace> acquireWorkspace() const;
+
+    // Return a workspace to the pool
+    void releaseWorkspace(std::unique_ptr<Workspace> ws) const;
+
+    // Compress a single range line
+    void compressLine(Workspace & ws, std::complex<float> * out,
+                      const std::complex<float> * in) const;
+
     int _chirpsize;
     int _inputsize;
     int _fftsize;
@@ -102,6 +161,14 @@ private:
     std::vector<std::complex<float>> _wkspc;
     isce3::fft::FwdFFTPlan<float> _fftplan;
     isce3::fft::InvFFTPlan<float> _ifftplan;
+
+    // overlap-save segment FFT length & matched filter spectrum
+    int _segfftsize;
+    std::vector<std::complex<float>> _segreffn;
+
+    // pool of per-thread workspaces
+    mutable std::vector<std::unique_ptr<Workspace>> _workspaces;
+    mutable std::mutex _workspaces_mutex;
 };
 
 }}
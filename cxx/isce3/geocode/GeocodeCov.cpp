@@ -4,6 +4,7 @@
 #include <chrono>
 #include <cmath>
 #include <cpl_virtualmem.h>
+#include <future>
 #include <limits>
 
 #include <isce3/core/Basis.h>
@@ -22,6 +23,7 @@
 #include <isce3/signal/signalUtils.h>
 
 #include "GeocodeHelpers.h"
+#include "geo2rdrBlock.h"
 
 using isce3::core::OrbitInterpBorderMode;
 using isce3::core::Vec3;
@@ -512,23 +514,70 @@ void Geocode<T>::geocodeInterp(
 
     info << "number of blocks: " << nBlocks << pyre::journal::newline;
     info << "block length: " << block_length << pyre::journal::newline;
+    info << "asynchronous block I/O (0:false, 1:true): " << _asyncBlockIO
+         << pyre::journal::newline;
     info << pyre::journal::newline;
 
-    info << "starting geocoding" << pyre::journal::endl;
-    // loop over the blocks of the geocoded Grid
-    for (int block = 0; block < nBlocks; ++block) {
-        info << "block: " << block << pyre::journal::endl;
+    // set NaN values according to T_out, i.e. real (NaN) or complex (NaN,
+    // NaN)
+    using T_out_real = typename isce3::real<T_out>::type;
+    T_out nan_t_out = 0;
+    nan_t_out *= std::numeric_limits<T_out_real>::quiet_NaN();
+
+    /*
+    State of a geogrid block as it moves through the processing stages:
+    geo2rdr (compute) -> read radar data (I/O) -> interpolate (compute) ->
+    write (I/O). Each stage only touches the members of its own block, so
+    that different blocks can be in different stages at the same time.
+    */
+    struct GeoBlock {
+        int lineStart = 0;
+        int geoBlockLength = 0;
+
+        // X and Y indices (in the radar coordinates) for the
+        // geocoded pixels (after geo2rdr computation)
+        std::valarray<double> radarX;
+        std::valarray<double> radarY;
+
+        // radar-grid bounding box (including interpolation margin)
+        int azimuthFirstLine = 0;
+        int rangeFirstPixel = 0;
+        int rdrBlockLength = 0;
+        int rdrBlockWidth = 0;
+        bool flag_has_radar_data = false;
+
+        isce3::core::Matrix<float> out_geo_rdr_a;
+        isce3::core::Matrix<float> out_geo_rdr_r;
+        isce3::core::Matrix<float> out_geo_dem_array;
+
+        // one radar-grid and one geogrid array per band
+        std::vector<isce3::core::Matrix<T_out>> rdrDataBlocks;
+        std::vector<isce3::core::Matrix<T_out>> geoDataBlocks;
+
+        isce3::core::Matrix<float> out_geo_rtc_array;
+        isce3::core::Matrix<float> out_geo_rtc_gamma0_to_sigma0_array;
+        isce3::core::Matrix<uint8_t> out_mask_array;
+    };
+
+    /*
+    Stage 1 (compute): run geo2rdr over the geogrid block and determine
+    the radar-grid bounding box required for interpolation.
+    */
+    auto run_geo2rdr = [&](GeoBlock& geo_block, int block) {
+
         // Get block extents (of the geocoded grid)
-        int lineStart = block * block_length;
+        const int lineStart = block * block_length;
         int geoBlockLength = block_length;
         if (block == (nBlocks - 1)) {
             geoBlockLength = geogrid.length() - lineStart;
         }
+        geo_block.lineStart = lineStart;
+        geo_block.geoBlockLength = geoBlockLength;
 
         int blockSize = geoBlockLength * geogrid.width();
 
-        isce3::core::Matrix<float> out_geo_rdr_a;
-        isce3::core::Matrix<float> out_geo_rdr_r;
+        isce3::core::Matrix<float>& out_geo_rdr_a = geo_block.out_geo_rdr_a;
+        isce3::core::Matrix<float>& out_geo_rdr_r = geo_block.out_geo_rdr_r;
         if (out_geo_rdr != nullptr) {
             out_geo_rdr_a.resize(geoBlockLength, geogrid.width());
             out_geo_rdr_r.resize(geoBlockLength, geogrid.width());
@@ -536,13 +585,14 @@ void Geocode<T>::geocodeInterp(
             out_geo_rdr_r.fill(std::numeric_limits<float>::quiet_NaN());
         }
 
-        isce3::core::Matrix<float> out_geo_dem_array;
+        isce3::core::Matrix<float>& out_geo_dem_array =
+                geo_block.out_geo_dem_array;
         if (out_geo_dem != nullptr) {
             out_geo_dem_array.resize(geoBlockLength, geogrid.width());
             out_geo_dem_array.fill(std::numeric_limits<float>::quiet_NaN());
         }
 
-       // load a block of DEM for the current geocoded grid with a margin of
+        // load a block of DEM for the current geocoded grid with a margin of
         // 50 DEM pixels
         int dem_margin_in_pixels = 50;
         isce3::geometry::DEMInterpolator demInterp =
@@ -550,124 +600,133 @@ void Geocode<T>::geocodeInterp(
                 demRaster, geogrid, lineStart, geoBlockLength, geogrid.width(),
                 dem_margin_in_pixels, dem_interp_method);
 
-        // X and Y indices (in the radar coordinates) for the
-        // geocoded pixels (after geo2rdr computation)
-        std::valarray<double> radarX(blockSize);
-        std::valarray<double> radarY(blockSize);
+        std::valarray<double>& radarX = geo_block.radarX;
+        std::valarray<double>& radarY = geo_block.radarY;
+        radarX.resize(blockSize);
+        radarY.resize(blockSize);
 
         int azimuthFirstLine = radar_grid.length() - 1;
         int azimuthLastLine = 0;
         int rangeFirstPixel = radar_grid.width() - 1;
         int rangeLastPixel = 0;
 
-        // Loop over lines, samples of the output grid
-#pragma omp parallel for reduction(                                            \
-        min                                                                    \
-        : azimuthFirstLine, rangeFirstPixel)                         \
-        reduction(max                                                          \
-                  : azimuthLastLine, rangeLastPixel)
+        // lon/lat/height of each pixel of the block
+        std::vector<Vec3> llh(blockSize);
 
-        for (size_t kk = 0; kk < geoBlockLength * geogrid.width(); ++kk) {
-
-            size_t blockLine = kk / geogrid.width();
-            size_t pixel = kk % geogrid.width();
+#pragma omp parallel for
+        for (int blockLine = 0; blockLine < geoBlockLength; ++blockLine) {
 
             // Global line index
             const int line = lineStart + blockLine;
 
             // y coordinate in the out put grid
-            double y = geogrid.startY() + geogrid.spacingY() * (0.5 + line);
+            const double y =
+                    geogrid.startY() + geogrid.spacingY() * (0.5 + line);
 
-            // x in the output geocoded Grid
-            double x = geogrid.startX() + geogrid.spacingX() * (0.5 + pixel);
+            for (int pixel = 0; pixel < geogrid.width(); ++pixel) {
 
-            // compute the azimuth time and slant range for the
-            // x,y coordinates in the output grid
-            double aztime, srange;
-            float dem_value;
+                // x in the output geocoded Grid
+                const double x =
+                        geogrid.startX() + geogrid.spacingX() * (0.5 + pixel);
 
-            aztime = radar_grid.sensingMid();
-            int converged = _geo2rdr(radar_grid, x, y, aztime, srange,
-                    demInterp, proj.get(), dem_value);
+                // transform the xyz in the output projection system to llh
+                Vec3& pixel_llh = llh[blockLine * geogrid.width() + pixel];
+                pixel_llh = proj->inverse({x, y, 0.0});
 
-            // (optional arg) save interpolated DEM element
-            if (out_geo_dem != nullptr) {
-#pragma omp atomic write
-                out_geo_dem_array(blockLine, pixel) = dem_value;
+                // interpolate the height from the DEM for this pixel
+                pixel_llh[2] = demInterp.interpolateLonLat(
+                        pixel_llh[0], pixel_llh[1]);
+
+                // (optional arg) save interpolated DEM element
+                if (out_geo_dem != nullptr)
+                    out_geo_dem_array(blockLine, pixel) = pixel_llh[2];
             }
+        }
 
-            if (!converged)
-                continue;
+        // compute the azimuth time and slant range for the
+        // x,y coordinates in the output grid
+        std::vector<double> aztimes(blockSize), sranges(blockSize);
+        isce3::geometry::Geo2RdrStats block_stats;
+        geo2rdrBlock(aztimes.data(), sranges.data(), llh.data(), geogrid,
+                lineStart, geoBlockLength, geogrid.width(), proj.get(),
+                _ellipsoid, _orbit, _doppler, radar_grid, _threshold, _numiter,
+                1.0e-8, _geo2rdrGridSpacing, _geo2rdrGridTolerance,
+                &block_stats);
 
-            // apply timing corrections
-            if (az_time_correction.contains(aztime, srange)) {
-                const auto aztimeCor = az_time_correction.eval(aztime,
-                                                                srange);
-                aztime += aztimeCor;
-            }
+        // Loop over lines, samples of the output grid
+#pragma omp parallel for reduction(                                            \
+        min                                                                    \
+        : azimuthFirstLine, rangeFirstPixel)                         \
+        reduction(max                                                          \
+                  : azimuthLastLine, rangeLastPixel)
+
+        for (int blockLine = 0; blockLine < geoBlockLength; ++blockLine) {
+
+            for (int pixel = 0; pixel < geogrid.width(); ++pixel) {
+
+                double aztime = aztimes[blockLine * geogrid.width() + pixel];
+                double srange = sranges[blockLine * geogrid.width() + pixel];
 
-            if (slant_range_correction.contains(aztime, srange)) {
-                const auto srangeCor = slant_range_correction.eval(aztime,
+                if (std::isnan(aztime))
+                    continue;
+
+                // apply timing corrections
+                if (az_time_correction.contains(aztime, srange)) {
+                    const auto aztimeCor = az_time_correction.eval(aztime,
                                                                     srange);
-                srange += srangeCor;
-            }
+                    aztime += aztimeCor;
+                }
 
-            // check if az time and slant within radar grid
-            if (!radar_grid.contains(aztime, srange)
-                    || !_nativeDoppler.contains(aztime, srange))
-                continue;
+                if (slant_range_correction.contains(aztime, srange)) {
+                    const auto srangeCor = slant_range_correction.eval(aztime,
+                                                                        srange);
+                    srange += srangeCor;
+                }
 
-            // get the row and column index in the radar grid
-            double rdrY = ((aztime - radar_grid.sensingStart()) /
-                           radar_grid.azimuthTimeInterval());
+                // check if az time and slant within radar grid
+                if (!radar_grid.contains(aztime, srange)
+                        || !_nativeDoppler.contains(aztime, srange))
+                    continue;
 
-            double rdrX = ((srange - radar_grid.startingRange()) /
-                           radar_grid.rangePixelSpacing());
+                // get the row and column index in the radar grid
+                double rdrY = ((aztime - radar_grid.sensingStart()) /
+                               radar_grid.azimuthTimeInterval());
 
-            // (optional arg) save rdr pos element
-            if (out_geo_rdr != nullptr) {
-#pragma omp atomic write
-                out_geo_rdr_a(blockLine, pixel) = rdrY;
-#pragma omp atomic write
-                out_geo_rdr_r(blockLine, pixel) = rdrX;
-            }
+                double rdrX = ((srange - radar_grid.startingRange()) /
+                               radar_grid.rangePixelSpacing());
 
-            if (rdrY < 0 || rdrX < 0 || rdrY >= radar_grid.length() ||
-                    rdrX >= radar_grid.width())
-                continue;
+                // (optional arg) save rdr pos element
+                if (out_geo_rdr != nullptr) {
+                    out_geo_rdr_a(blockLine, pixel) = rdrY;
+                    out_geo_rdr_r(blockLine, pixel) = rdrX;
+                }
+
+                if (rdrY < 0 || rdrX < 0 || rdrY >= radar_grid.length() ||
+                        rdrX >= radar_grid.width())
+                    continue;
 
-            azimuthFirstLine = std::min(
-                    azimuthFirstLine, static_cast<int>(std::floor(rdrY)));
-            azimuthLastLine = std::max(azimuthLastLine,
-                    static_cast<int>(std::ceil(rdrY) - 1));
-            rangeFirstPixel = std::min(
-                    rangeFirstPixel, static_cast<int>(std::floor(rdrX)));
-            rangeLastPixel = std::max(
-                    rangeLastPixel, static_cast<int>(std::ceil(rdrX) - 1));
+                azimuthFirstLine = std::min(
+                        azimuthFirstLine, static_cast<int>(std::floor(rdrY)));
+                azimuthLastLine = std::max(azimuthLastLine,
+                        static_cast<int>(std::ceil(rdrY) - 1));
+                rangeFirstPixel = std::min(
+                        rangeFirstPixel, static_cast<int>(std::floor(rdrX)));
+                rangeLastPixel = std::max(
+                        rangeLastPixel, static_cast<int>(std::ceil(rdrX) - 1));
 
-            // store the adjusted X and Y indices
-            radarX[blockLine * geogrid.width() + pixel] = rdrX;
-            radarY[blockLine * geogrid.width() + pixel] = rdrY;
+                // store the adjusted X and Y indices
+                radarX[blockLine * geogrid.width() + pixel] = rdrX;
+                radarY[blockLine * geogrid.width() + pixel] = rdrY;
 
+            }
         } // end loops over lines and pixel of output grid
 
-        // (optional arg) flush rdr position values
-        if (out_geo_rdr != nullptr)
-#pragma omp critical
-        {
-            out_geo_rdr->setBlock(out_geo_rdr_a.data(), 0, lineStart,
-                    geogrid.width(), geoBlockLength, 1);
-            out_geo_rdr->setBlock(out_geo_rdr_r.data(), 0, lineStart,
-                    geogrid.width(), geoBlockLength, 2);
-        }
-
-        // (optional arg) flush interpolated DEM values
-        if (out_geo_dem != nullptr)
-#pragma omp critical
-        {
-            out_geo_dem->setBlock(out_geo_dem_array.data(), 0, lineStart,
-                    geogrid.width(), geoBlockLength, 1);
-        }
+        info << "geo2rdr solves: " << block_stats.numTargets
+             << ", mean iterations per solve: "
+             << block_stats.meanIterations()
+             << ", max: " << block_stats.maxIterations
+             << ", not converged: " << block_stats.numFailed
+             << pyre::journal::endl;
 
         // Add extra margin for interpolation. We set it to 5 pixels marging
         // considering SINC interpolation that requires 9 pixels
@@ -680,38 +739,42 @@ void Geocode<T>::geocodeInterp(
         rangeLastPixel = std::min(rangeLastPixel + interp_margin,
                                   static_cast<int>(radar_grid.width() - 1));
 
-        // set NaN values according to T_out, i.e. real (NaN) or complex (NaN,
-        // NaN)
-        using T_out_real = typename isce3::real<T_out>::type;
-        T_out nan_t_out = 0;
-        nan_t_out *= std::numeric_limits<T_out_real>::quiet_NaN();
-
-        // define the geo-block matrix based on the raster bands data type
-        isce3::core::Matrix<T_out> geoDataBlock(
-                geoBlockLength, geogrid.width());
-        geoDataBlock.fill(nan_t_out);
-
-        // if invalid, fill all bands with NaNs and continue to the next block
-        if (azimuthFirstLine > azimuthLastLine ||
-                rangeFirstPixel > rangeLastPixel) {
-            for (int band = 0; band < nbands; ++band) {
-                outputRaster.setBlock(geoDataBlock.data(), 0, lineStart,
-                        geogrid.width(), geoBlockLength, band + 1);
-            }
-            continue;
-        }
+        geo_block.azimuthFirstLine = azimuthFirstLine;
+        geo_block.rangeFirstPixel = rangeFirstPixel;
+        geo_block.flag_has_radar_data = (azimuthFirstLine <= azimuthLastLine &&
+                                         rangeFirstPixel <= rangeLastPixel);
 
         // shape of the required block of data in the radar coordinates
-        int rdrBlockLength = azimuthLastLine - azimuthFirstLine + 1;
-        int rdrBlockWidth = rangeLastPixel - rangeFirstPixel + 1;
+        geo_block.rdrBlockLength = azimuthLastLine - azimuthFirstLine + 1;
+        geo_block.rdrBlockWidth = rangeLastPixel - rangeFirstPixel + 1;
+    };
 
-        // define the radar-block matrix based on the rasterbands data type
-        isce3::core::Matrix<T_out> rdrDataBlock(rdrBlockLength, rdrBlockWidth);
-        rdrDataBlock.fill(nan_t_out);
+    /*
+    Stage 2 (I/O): read (and baseband) the radar-grid data of all bands
+    required by the geogrid block. This is the only stage that accesses
+    the input raster.
+    */
+    auto read_radar_block = [&](GeoBlock& geo_block) {
+
+        if (!geo_block.flag_has_radar_data)
+            return;
+
+        const int azimuthFirstLine = geo_block.azimuthFirstLine;
+        const int rangeFirstPixel = geo_block.rangeFirstPixel;
+        const int rdrBlockLength = geo_block.rdrBlockLength;
+        const int rdrBlockWidth = geo_block.rdrBlockWidth;
+
+        geo_block.rdrDataBlocks.resize(nbands);
 
         // for each band in the input:
         for (int band = 0; band < nbands; ++band) {
 
+            // define the radar-block matrix based on the rasterbands data type
+            isce3::core::Matrix<T_out>& rdrDataBlock =
+                    geo_block.rdrDataBlocks[band];
+            rdrDataBlock.resize(rdrBlockLength, rdrBlockWidth);
+            rdrDataBlock.fill(nan_t_out);
+
             // if complex to real
             if ((std::is_same<T, std::complex<float>>::value ||
                         std::is_same<T, std::complex<double>>::value) &&
@@ -764,64 +827,207 @@ void Geocode<T>::geocodeInterp(
                             radar_grid.prf(), _nativeDoppler);
                 }
             }
+        }
+    };
+
+    /*
+    Stage 3 (compute): interpolate the radar-grid data of all bands
+    over the geogrid block. The radar-grid data is released afterwards.
+    */
+    auto interpolate_block = [&](GeoBlock& geo_block) {
+
+        const int geoBlockLength = geo_block.geoBlockLength;
+
+        // define the geo-block matrices based on the raster bands data type
+        geo_block.geoDataBlocks.resize(nbands);
+        for (int band = 0; band < nbands; ++band) {
+            geo_block.geoDataBlocks[band].resize(
+                    geoBlockLength, geogrid.width());
+            geo_block.geoDataBlocks[band].fill(nan_t_out);
+        }
+
+        // if invalid, all bands are filled with NaNs
+        if (!geo_block.flag_has_radar_data)
+            return;
+
+        // (optional arg) populate RTC arrays (computed with band 0)
+        if (out_geo_rtc != nullptr) {
+            geo_block.out_geo_rtc_array.resize(geoBlockLength, geogrid.width());
+            geo_block.out_geo_rtc_array.fill(
+                    std::numeric_limits<float>::quiet_NaN());
+        }
+        if (out_geo_rtc_gamma0_to_sigma0 != nullptr) {
+            geo_block.out_geo_rtc_gamma0_to_sigma0_array.resize(
+                    geoBlockLength, geogrid.width());
+            geo_block.out_geo_rtc_gamma0_to_sigma0_array.fill(
+                    std::numeric_limits<float>::quiet_NaN());
+        }
+
+        // for each band in the input:
+        for (int band = 0; band < nbands; ++band) {
 
             // (optional arg) if band == 0, populate RTC array
             isce3::io::Raster* out_geo_rtc_band = nullptr;
-            isce3::core::Matrix<float> out_geo_rtc_array;
+            isce3::core::Matrix<float> out_geo_rtc_array_dummy;
+            isce3::core::Matrix<float>* out_geo_rtc_array =
+                    &out_geo_rtc_array_dummy;
             if (out_geo_rtc != nullptr && band == 0) {
                 out_geo_rtc_band = out_geo_rtc;
-                out_geo_rtc_array.resize(geoBlockLength, geogrid.width());
-                out_geo_rtc_array.fill(std::numeric_limits<float>::quiet_NaN());
+                out_geo_rtc_array = &geo_block.out_geo_rtc_array;
             }
 
             // (optional arg) if band == 0, populate RTC array
             isce3::io::Raster* out_geo_rtc_gamma0_to_sigma0_band = nullptr;
-            isce3::core::Matrix<float> out_geo_rtc_gamma0_to_sigma0_array;
+            isce3::core::Matrix<float>
+                    out_geo_rtc_gamma0_to_sigma0_array_dummy;
+            isce3::core::Matrix<float>* out_geo_rtc_gamma0_to_sigma0_array =
+                    &out_geo_rtc_gamma0_to_sigma0_array_dummy;
             if (out_geo_rtc_gamma0_to_sigma0 != nullptr && band == 0) {
                 out_geo_rtc_gamma0_to_sigma0_band = out_geo_rtc_gamma0_to_sigma0;
-                out_geo_rtc_gamma0_to_sigma0_array.resize(geoBlockLength, geogrid.width());
-                out_geo_rtc_gamma0_to_sigma0_array.fill(std::numeric_limits<float>::quiet_NaN());
+                out_geo_rtc_gamma0_to_sigma0_array =
+                        &geo_block.out_geo_rtc_gamma0_to_sigma0_array;
             }
 
-            isce3::core::Matrix<uint8_t> out_mask_array;
+            // the output mask saved is the one computed with the last band
+            isce3::core::Matrix<uint8_t>& out_mask_array =
+                    geo_block.out_mask_array;
             if (out_mask != nullptr) {
                 out_mask_array.resize(geoBlockLength, geogrid.width());
                 out_mask_array.fill(255);
             }
- 
-            _interpolate(rdrDataBlock, geoDataBlock, radarX, radarY,
-                    rdrBlockWidth, rdrBlockLength, azimuthFirstLine,
-                    rangeFirstPixel, interp.get(), radar_grid,
+
+            _interpolate(geo_block.rdrDataBlocks[band],
+                    geo_block.geoDataBlocks[band], geo_block.radarX,
+                    geo_block.radarY, geo_block.rdrBlockWidth,
+                    geo_block.rdrBlockLength, geo_block.azimuthFirstLine,
+                    geo_block.rangeFirstPixel, interp.get(), radar_grid,
                     flag_az_baseband_doppler, flatten, phase_screen_raster,
                     phase_screen_array, abs_cal_factor, clip_min, clip_max,
-                    flag_apply_rtc, rtc_area_array, rtc_area_sigma0_array, out_geo_rtc_band,
-                    out_geo_rtc_array, out_geo_rtc_gamma0_to_sigma0_band,
-                    out_geo_rtc_gamma0_to_sigma0_array,
+                    flag_apply_rtc, rtc_area_array, rtc_area_sigma0_array,
+                    out_geo_rtc_band, *out_geo_rtc_array,
+                    out_geo_rtc_gamma0_to_sigma0_band,
+                    *out_geo_rtc_gamma0_to_sigma0_array,
                     input_layover_shadow_mask_raster,
                     input_layover_shadow_mask, sub_swaths,
                     effective_apply_valid_samples_sub_swath_masking,
                     out_mask, out_mask_array);
 
+            // release radar-grid data as soon as it is no longer needed
+            geo_block.rdrDataBlocks[band].resize(0, 0);
+        }
+    };
+
+    /*
+    Stage 4 (I/O): write the geocoded bands and the optional layers of
+    the geogrid block. This is the only stage that accesses the output
+    rasters.
+    */
+    auto write_block = [&](GeoBlock& geo_block) {
+
+        const int lineStart = geo_block.lineStart;
+        const int geoBlockLength = geo_block.geoBlockLength;
+
+        // (optional arg) flush rdr position values
+        if (out_geo_rdr != nullptr) {
+            out_geo_rdr->setBlock(geo_block.out_geo_rdr_a.data(), 0,
+                    lineStart, geogrid.width(), geoBlockLength, 1);
+            out_geo_rdr->setBlock(geo_block.out_geo_rdr_r.data(), 0,
+                    lineStart, geogrid.width(), geoBlockLength, 2);
+        }
+
+        // (optional arg) flush interpolated DEM values
+        if (out_geo_dem != nullptr) {
+            out_geo_dem->setBlock(geo_block.out_geo_dem_array.data(), 0,
+                    lineStart, geogrid.width(), geoBlockLength, 1);
+        }
+
+        if (geo_block.flag_has_radar_data) {
+
             // flush optional layers
-            if (out_geo_rtc_band != nullptr && band == 0) {
-                out_geo_rtc->setBlock(out_geo_rtc_array.data(), 0, lineStart,
-                        geogrid.width(), geoBlockLength, 1);
+            if (out_geo_rtc != nullptr) {
+                out_geo_rtc->setBlock(geo_block.out_geo_rtc_array.data(), 0,
+                        lineStart, geogrid.width(), geoBlockLength, 1);
             }
-            if (out_geo_rtc_gamma0_to_sigma0_band != nullptr && band == 0) {
+            if (out_geo_rtc_gamma0_to_sigma0 != nullptr) {
                 out_geo_rtc_gamma0_to_sigma0->setBlock(
-                    out_geo_rtc_gamma0_to_sigma0_array.data(), 0, lineStart,
-                    geogrid.width(), geoBlockLength, 1);
+                    geo_block.out_geo_rtc_gamma0_to_sigma0_array.data(), 0,
+                    lineStart, geogrid.width(), geoBlockLength, 1);
             }
-            if (out_mask != nullptr && band == nbands - 1) {
-                out_mask->setBlock(out_mask_array.data(), 0,
+            if (out_mask != nullptr) {
+                out_mask->setBlock(geo_block.out_mask_array.data(), 0,
                     lineStart, geogrid.width(), geoBlockLength, 1);
             }
+        }
+
+        for (int band = 0; band < nbands; ++band) {
+            outputRaster.setBlock(geo_block.geoDataBlocks[band].data(), 0,
+                    lineStart, geogrid.width(), geoBlockLength, band + 1);
+        }
+    };
 
-            outputRaster.setBlock(geoDataBlock.data(), 0, lineStart,
-                    geogrid.width(), geoBlockLength, band + 1);
+    info << "starting geocoding" << pyre::journal::endl;
 
+    if (!_asyncBlockIO) {
+        // loop over the blocks of the geocoded Grid
+        for (int block = 0; block < nBlocks; ++block) {
+            info << "block: " << block << pyre::journal::endl;
+            GeoBlock geo_block;
+            run_geo2rdr(geo_block, block);
+            read_radar_block(geo_block);
+            interpolate_block(geo_block);
+            write_block(geo_block);
         }
-    } // end loop over block of output grid
+    } else {
+        /*
+        Software pipeline over the blocks of the geocoded grid. While
+        block N runs geo2rdr, the radar data of block N - 1 is being read
+        by a prefetch thread. While block N - 1 is interpolated, block N is
+        being read and block N - 2 is being written by a writer thread. At
+        most three blocks are held in memory at any time. Each raster is
+        only accessed by a single thread.
+        */
+        std::unique_ptr<GeoBlock> reading_block, writing_block;
+        std::future<void> read_future, write_future;
+
+        for (int block = 0; block <= nBlocks; ++block) {
+
+            std::unique_ptr<GeoBlock> current_block;
+            if (block < nBlocks) {
+                info << "block: " << block << pyre::journal::endl;
+                current_block = std::make_unique<GeoBlock>();
+                run_geo2rdr(*current_block, block);
+            }
+
+            // wait for the prefetch of the previous block
+            std::unique_ptr<GeoBlock> interp_block;
+            if (read_future.valid()) {
+                read_future.get();
+                interp_block = std::move(reading_block);
+            }
+
+            // start prefetching the current block
+            if (current_block) {
+                reading_block = std::move(current_block);
+                read_future = std::async(std::launch::async,
+                        read_radar_block, std::ref(*reading_block));
+            }
+
+            if (!interp_block)
+                continue;
+
+            interpolate_block(*interp_block);
+
+            // wait for the writer to flush the block before, then hand over
+            // the block that has just been interpolated
+            if (write_future.valid())
+                write_future.get();
+            writing_block = std::move(interp_block);
+            write_future = std::async(std::launch::async,
+                    write_block, std::ref(*writing_block));
+        }
+        if (write_future.valid())
+            write_future.get();
+    }
 
     double geotransform[] = {geogrid.startX(), geogrid.spacingX(), 0,
             geogrid.startY(), 0, geogrid.spacingY()};
@@ -1143,37 +1349,6 @@ void Geocode<T>::_baseband(isce3::core::Matrix<std::complex<T2>>& data,
     }
 }
 
-template<class T>
-int Geocode<T>::_geo2rdr(const isce3::product::RadarGridParameters& radar_grid,
-        double x, double y, double& azimuthTime, double& slantRange,
-        isce3::geometry::DEMInterpolator& demInterp,
-        isce3::core::ProjectionBase* proj, float& dem_value)
-{
-    // coordinate in the output projection system
-    const Vec3 xyz {x, y, 0.0};
-
-    // transform the xyz in the output projection system to llh
-    Vec3 llh = proj->inverse(xyz);
-
-    // interpolate the height from the DEM for this pixel
-    llh[2] = demInterp.interpolateLonLat(llh[0], llh[1]);
-
-    // assign interpolated DEM value to returning variable
-    dem_value = llh[2];
-
-    // Perform geo->rdr iterations
-    int converged = isce3::geometry::geo2rdr(llh, _ellipsoid, _orbit, _doppler,
-            azimuthTime, slantRange, radar_grid.wavelength(),
-            radar_grid.lookSide(), _threshold, _numiter, 1.0e-8);
-
-    // Check convergence
-    if (converged == 0) {
-        azimuthTime = std::numeric_limits<double>::quiet_NaN();
-        slantRange = std::numeric_limits<double>::quiet_NaN();
-    }
-    return converged;
-}
-
 /*
 This function upsamples the complex input by a factor of 2 in the
 range domain and converts the complex input to the output that can be either
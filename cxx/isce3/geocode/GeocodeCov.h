@@ -409,11 +409,55 @@ public:
 
     void numiterGeo2rdr(int numiter) { _numiter = numiter; }
 
+    /** Get spacing (in geogrid pixels) of the geo2rdr control grid
+     * (0 if disabled) */
+    int geo2rdrGridSpacing() const { return _geo2rdrGridSpacing; }
+
+    /** Set spacing (in geogrid pixels) of the geo2rdr control grid.
+     *
+     * When set to 2 or more, geocoding with interpolation solves geo2rdr
+     * only on a coarse control grid (at three heights spanning the DEM of
+     * each geogrid block) and interpolates the azimuth time and slant range
+     * of the remaining pixels (bicubic in map coordinates, quadratic in
+     * height). Control grid cells whose interpolation residual at the cell
+     * center exceeds geo2rdrGridTolerance() are solved exactly. Set to 0
+     * (the default) to solve geo2rdr for every pixel.
+     *
+     * @param[in]  spacing  Control grid spacing in geogrid pixels
+     */
+    void geo2rdrGridSpacing(int spacing) { _geo2rdrGridSpacing = spacing; }
+
+    /** Get maximum interpolation residual (in radar grid pixels) of the
+     * geo2rdr control grid */
+    double geo2rdrGridTolerance() const { return _geo2rdrGridTolerance; }
+
+    /** Set maximum interpolation residual (in radar grid pixels) of the
+     * geo2rdr control grid before a control grid cell is solved exactly */
+    void geo2rdrGridTolerance(double tolerance)
+    {
+        _geo2rdrGridTolerance = tolerance;
+    }
+
     void radarBlockMargin(int radarBlockMargin)
     {
         _radarBlockMargin = radarBlockMargin;
     }
 
+    /** Get flag indicating whether block I/O runs asynchronously */
+    bool asyncBlockIO() const { return _asyncBlockIO; }
+
+    /** Enable/disable asynchronous block I/O.
+     *
+     * When enabled, geocoding with interpolation overlaps the reading of
+     * the radar data of the next geogrid block (prefetch thread) and the
+     * writing of the previous geogrid block (writer thread) with the
+     * computation of the current block. Up to three geogrid blocks are
+     * held in memory at the same time.
+     *
+     * @param[in]  async_block_io  Flag to enable asynchronous block I/O
+     */
+    void asyncBlockIO(bool async_block_io) { _asyncBlockIO = async_block_io; }
+
     // start X position for the output geogrid
     double geoGridStartX() const { return _geoGridStartX; }
 
@@ -536,11 +580,6 @@ private:
 
     std::string _get_nbytes_str(long nbytes);
 
-    int _geo2rdr(const isce3::product::RadarGridParameters& radar_grid,
-            double x, double y, double& azimuthTime, double& slantRange,
-            isce3::geometry::DEMInterpolator& demInterp,
-            isce3::core::ProjectionBase* proj, float& dem_value);
-
     /**
      * @param[in] rdrDataBlock a basebanded block of data in radar coordinate
      * @param[out] geoDataBlock a block of data in geo coordinates
@@ -655,6 +694,10 @@ private:
     double _threshold = 1e-8;
     int _numiter = 100;
 
+    // geo2rdr control grid spacing (0 = solve every pixel) and tolerance
+    int _geo2rdrGridSpacing = 0;
+    double _geo2rdrGridTolerance = 1e-3;
+
     // radar grids parameters
     isce3::core::LUT2d<double> _doppler;
 
@@ -686,6 +729,9 @@ private:
     // lines/pixels)
     int _radarBlockMargin;
 
+    // overlap block reads and writes with computation
+    bool _asyncBlockIO = false;
+
     // interpolator
     isce3::core::dataInterpMethod _data_interp_method =
             isce3::core::dataInterpMethod::BIQUINTIC_METHOD;
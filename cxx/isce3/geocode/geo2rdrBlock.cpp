@@ -0,0 +1,285 @@
+#include "geo2rdrBlock.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <isce3/core/Ellipsoid.h>
+#include <isce3/core/LUT2d.h>
+#include <isce3/core/LookSide.h>
+#include <isce3/core/Orbit.h>
+#include <isce3/core/Projections.h>
+#include <isce3/core/Vector.h>
+#include <isce3/geometry/geometry.h>
+#include <isce3/product/GeoGridParameters.h>
+#include <isce3/product/RadarGridParameters.h>
+
+namespace isce3 { namespace geocode {
+
+using isce3::core::Vec3;
+using isce3::geometry::Geo2RdrStats;
+
+namespace {
+
+// Number of height layers of the control grid (quadratic in height)
+constexpr int num_heights = 3;
+
+// Weights of the 4-point Lagrange interpolator with nodes at -1, 0, 1, 2
+// evaluated at f in [0, 1]
+inline void cubicWeights(double f, double w[4])
+{
+    w[0] = -f * (f - 1.0) * (f - 2.0) / 6.0;
+    w[1] = (f + 1.0) * (f - 1.0) * (f - 2.0) / 2.0;
+    w[2] = -(f + 1.0) * f * (f - 2.0) / 2.0;
+    w[3] = (f + 1.0) * f * (f - 1.0) / 6.0;
+}
+
+// Geo2rdr solutions on a coarse control grid over a geogrid block. Nodes are
+// placed every `spacing` pixels starting at the first pixel of the block,
+// with one extra ring of nodes around the block so that every pixel has a
+// full 4x4 interpolation stencil.
+struct ControlGrid {
+    size_t spacing;
+
+    // number of cells covering the block along each dimension
+    size_t numCellsY, numCellsX;
+
+    // number of nodes along each dimension (cells + 1, plus the outer ring)
+    size_t length, width;
+
+    // height of the first layer and spacing between layers
+    double h0, dh;
+
+    // solutions, indexed by [layer][node row][node column]
+    std::vector<double> aztime, slantRange;
+
+    ControlGrid(size_t blockLength, size_t blockWidth, size_t spacing_,
+            double hmin, double hmax) :
+        spacing(spacing_),
+        numCellsY(std::max<size_t>(1, (blockLength + spacing - 2) / spacing)),
+        numCellsX(std::max<size_t>(1, (blockWidth + spacing - 2) / spacing)),
+        length(numCellsY + 3),
+        width(numCellsX + 3),
+        h0(hmin),
+        dh(std::max(0.5 * (hmax - hmin), 1.0)),
+        aztime(num_heights * length * width),
+        slantRange(num_heights * length * width)
+    {}
+
+    // cell containing a pixel and fractional position within that cell
+    void locate(size_t pixel, size_t numCells, size_t& cell,
+            double& frac) const
+    {
+        cell = std::min(pixel / spacing, numCells - 1);
+        frac = static_cast<double>(pixel) / spacing - cell;
+    }
+
+    // index of the cell containing a pixel of the block
+    size_t cellIndex(size_t line, size_t col) const
+    {
+        return std::min(line / spacing, numCellsY - 1) * numCellsX +
+               std::min(col / spacing, numCellsX - 1);
+    }
+
+    // interpolate the solutions at a pixel of the block with height h;
+    // NaN if any node of the stencil failed to converge
+    void interpolate(size_t line, size_t col, double h, double& t,
+            double& r) const
+    {
+        size_t ci, cj;
+        double fi, fj;
+        locate(line, numCellsY, ci, fi);
+        locate(col, numCellsX, cj, fj);
+
+        double wi[4], wj[4];
+        cubicWeights(fi, wi);
+        cubicWeights(fj, wj);
+
+        // quadratic Lagrange weights in height
+        const double eta = (h - h0) / dh;
+        const double wh[num_heights] = {0.5 * (eta - 1.0) * (eta - 2.0),
+                -eta * (eta - 2.0), 0.5 * eta * (eta - 1.0)};
+
+        t = 0.0;
+        r = 0.0;
+        for (int k = 0; k < num_heights; ++k) {
+            for (int a = 0; a < 4; ++a) {
+                const size_t row = (k * length + ci + a) * width + cj;
+                const double w = wh[k] * wi[a];
+                for (int b = 0; b < 4; ++b) {
+                    t += w * wj[b] * aztime[row + b];
+                    r += w * wj[b] * slantRange[row + b];
+                }
+            }
+        }
+    }
+};
+
+} // namespace
+
+void geo2rdrBlock(double* aztime, double* slantRange, const Vec3* llh,
+        const isce3::product::GeoGridParameters& geoGrid, size_t lineStart,
+        size_t blockLength, size_t blockWidth,
+        const isce3::core::ProjectionBase* proj,
+        const isce3::core::Ellipsoid& ellipsoid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& doppler,
+        const isce3::product::RadarGridParameters& radarGrid,
+        double threshold, int maxIter, double deltaRange, int gridSpacing,
+        double tolerance, Geo2RdrStats* stats)
+{
+    const double wavelength = radarGrid.wavelength();
+    const isce3::core::LookSide side = radarGrid.lookSide();
+    const double t0 = radarGrid.sensingMid();
+
+    Geo2RdrStats blockStats;
+
+    // solve a run of pixels of the block with warm starts
+    auto solveRun = [&](size_t index, size_t n, double guess,
+                            Geo2RdrStats& runStats) {
+        isce3::geometry::geo2rdrRow(&llh[index], n, ellipsoid, orbit, doppler,
+                &aztime[index], &slantRange[index], wavelength, side,
+                threshold, maxIter, deltaRange, guess, &runStats);
+    };
+
+    if (gridSpacing < 2 || blockLength == 0 || blockWidth == 0) {
+#pragma omp parallel for
+        for (size_t line = 0; line < blockLength; ++line) {
+            Geo2RdrStats lineStats;
+            solveRun(line * blockWidth, blockWidth, t0, lineStats);
+#pragma omp critical
+            blockStats += lineStats;
+        }
+        if (stats) {
+            *stats += blockStats;
+        }
+        return;
+    }
+
+    // height span of the block
+    double hmin = std::numeric_limits<double>::infinity();
+    double hmax = -hmin;
+    for (size_t i = 0; i < blockLength * blockWidth; ++i) {
+        if (std::isfinite(llh[i][2])) {
+            hmin = std::min(hmin, llh[i][2]);
+            hmax = std::max(hmax, llh[i][2]);
+        }
+    }
+    if (hmin > hmax) {
+        hmin = hmax = 0.0;
+    }
+
+    ControlGrid grid(blockLength, blockWidth, gridSpacing, hmin, hmax);
+
+    // Solve geo2rdr on the nodes of the control grid, one row of nodes
+    // per height layer at a time
+#pragma omp parallel for
+    for (size_t i = 0; i < grid.length; ++i) {
+        const double line =
+                lineStart + (static_cast<double>(i) - 1.0) * grid.spacing;
+        const double y = geoGrid.startY() + geoGrid.spacingY() * (0.5 + line);
+
+        std::vector<Vec3> nodeLLH(grid.width);
+        for (size_t j = 0; j < grid.width; ++j) {
+            const double col = (static_cast<double>(j) - 1.0) * grid.spacing;
+            const double x =
+                    geoGrid.startX() + geoGrid.spacingX() * (0.5 + col);
+            nodeLLH[j] = proj->inverse({x, y, 0.0});
+        }
+
+        Geo2RdrStats rowStats;
+        for (int k = 0; k < num_heights; ++k) {
+            for (auto& node : nodeLLH) {
+                node[2] = grid.h0 + k * grid.dh;
+            }
+            const size_t row = (k * grid.length + i) * grid.width;
+            isce3::geometry::geo2rdrRow(nodeLLH.data(), grid.width, ellipsoid,
+                    orbit, doppler, &grid.aztime[row], &grid.slantRange[row],
+                    wavelength, side, threshold, maxIter, deltaRange, t0,
+                    &rowStats);
+        }
+#pragma omp critical
+        blockStats += rowStats;
+    }
+
+    // Check the interpolation residual at the center of each cell against
+    // an exact solve and flag the cells that need to be refined
+    const size_t numCells = grid.numCellsY * grid.numCellsX;
+    std::vector<unsigned char> refine(numCells, 0);
+#pragma omp parallel for
+    for (size_t cell = 0; cell < numCells; ++cell) {
+        const size_t ci = cell / grid.numCellsX;
+        const size_t cj = cell % grid.numCellsX;
+
+        // pixel extents of the cell (the last cell extends to the border)
+        const size_t line0 = ci * grid.spacing;
+        const size_t line1 = (ci + 1 == grid.numCellsY)
+                                     ? blockLength
+                                     : line0 + grid.spacing;
+        const size_t col0 = cj * grid.spacing;
+        const size_t col1 = (cj + 1 == grid.numCellsX) ? blockWidth
+                                                       : col0 + grid.spacing;
+        const size_t line = (line0 + line1 - 1) / 2;
+        const size_t col = (col0 + col1 - 1) / 2;
+        const size_t index = line * blockWidth + col;
+
+        double tInterp, rInterp;
+        grid.interpolate(line, col, llh[index][2], tInterp, rInterp);
+
+        double t, r;
+        Geo2RdrStats cellStats;
+        isce3::geometry::geo2rdrRow(&llh[index], 1, ellipsoid, orbit, doppler,
+                &t, &r, wavelength, side, threshold, maxIter, deltaRange,
+                std::isnan(tInterp) ? t0 : tInterp, &cellStats);
+
+        refine[cell] = std::isnan(t) || std::isnan(tInterp) ||
+                       std::abs(t - tInterp) * radarGrid.prf() > tolerance ||
+                       std::abs(r - rInterp) / radarGrid.rangePixelSpacing() >
+                               tolerance;
+#pragma omp critical
+        blockStats += cellStats;
+    }
+
+    // Interpolate all pixels, then solve the pixels of refined cells and
+    // the pixels whose stencil contains a failed node exactly
+#pragma omp parallel for
+    for (size_t line = 0; line < blockLength; ++line) {
+        const size_t offset = line * blockWidth;
+        for (size_t col = 0; col < blockWidth; ++col) {
+            grid.interpolate(line, col, llh[offset + col][2],
+                    aztime[offset + col], slantRange[offset + col]);
+        }
+
+        auto needsSolve = [&](size_t col) {
+            return refine[grid.cellIndex(line, col)] ||
+                   std::isnan(aztime[offset + col]);
+        };
+
+        Geo2RdrStats lineStats;
+        size_t col = 0;
+        while (col < blockWidth) {
+            if (!needsSolve(col)) {
+                ++col;
+                continue;
+            }
+            size_t end = col + 1;
+            while (end < blockWidth && needsSolve(end)) {
+                ++end;
+            }
+            const double guess = std::isnan(aztime[offset + col])
+                                         ? t0
+                                         : aztime[offset + col];
+            solveRun(offset + col, end - col, guess, lineStats);
+            col = end;
+        }
+#pragma omp critical
+        blockStats += lineStats;
+    }
+
+    if (stats) {
+        *stats += blockStats;
+    }
+}
+
+}} // namespace isce3::geocode
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+
+#include <isce3/core/forward.h>
+#include <isce3/geometry/forward.h>
+#include <isce3/product/forward.h>
+
+namespace isce3 { namespace geocode {
+
+/**
+ * Compute the radar coordinates of every pixel of a block of a geogrid
+ *
+ * When \p gridSpacing is less than 2, geo2rdr is solved for each pixel, one
+ * geogrid line at a time with warm starts from neighboring pixels (see
+ * isce3::geometry::geo2rdrRow).
+ *
+ * Otherwise geo2rdr is only solved on a coarse control grid with a node
+ * every \p gridSpacing pixels (plus one ring of nodes around the block),
+ * at three heights spanning the heights of the block. The azimuth time and
+ * slant range of each pixel are then obtained by bicubic (4x4 Lagrange)
+ * interpolation over the control grid followed by quadratic interpolation
+ * in height. The interpolation residual is checked against an exact solve
+ * at the center of each cell of the control grid; cells where it exceeds
+ * \p tolerance, and pixels whose interpolation stencil contains a node
+ * that failed to converge, are refined to exact per-pixel solves.
+ *
+ * Pixels that fail to converge are assigned NaN azimuth time and slant
+ * range.
+ *
+ * \param[out] aztime       azimuth time of each pixel w.r.t. the orbit
+ *                          reference epoch (row-major, blockLength x
+ *                          blockWidth)
+ * \param[out] slantRange   slant range of each pixel (row-major,
+ *                          blockLength x blockWidth)
+ * \param[in]  llh          lon/lat/height of each pixel (row-major,
+ *                          blockLength x blockWidth)
+ * \param[in]  geoGrid      geogrid parameters
+ * \param[in]  lineStart    first geogrid line of the block
+ * \param[in]  blockLength  number of lines of the block
+ * \param[in]  blockWidth   number of pixels per line of the block (starting
+ *                          at the first geogrid column)
+ * \param[in]  proj         projection of the geogrid
+ * \param[in]  ellipsoid    ellipsoid object
+ * \param[in]  orbit        orbit
+ * \param[in]  doppler      2D LUT Doppler of the image grid
+ * \param[in]  radarGrid    radar grid parameters (wavelength, look side,
+ *                          initial azimuth time guess and pixel spacings)
+ * \param[in]  threshold    geo2rdr azimuth time convergence threshold (s)
+ * \param[in]  maxIter      maximum number of geo2rdr iterations
+ * \param[in]  deltaRange   step size used for computing derivative of Doppler
+ * \param[in]  gridSpacing  control grid spacing in geogrid pixels (values
+ *                          less than 2 disable the control grid)
+ * \param[in]  tolerance    maximum interpolation residual in radar grid
+ *                          pixels before a control grid cell is refined
+ * \param[in,out] stats     geo2rdr iteration statistics to accumulate into
+ *                          (ignored if nullptr)
+ */
+void geo2rdrBlock(double* aztime, double* slantRange,
+        const isce3::core::Vec3* llh,
+        const isce3::product::GeoGridParameters& geoGrid, size_t lineStart,
+        size_t blockLength, size_t blockWidth,
+        const isce3::core::ProjectionBase* proj,
+        const isce3::core::Ellipsoid& ellipsoid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& doppler,
+        const isce3::product::RadarGridParameters& radarGrid,
+        double threshold, int maxIter, double deltaRange, int gridSpacing = 0,
+        double tolerance = 1e-3,
+        isce3::geometry::Geo2RdrStats* stats = nullptr);
+
+}} // namespace isce3::geocode
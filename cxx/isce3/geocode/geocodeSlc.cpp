@@ -2,16 +2,25 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <tuple>
+#include <vector>
 
 #include <isce3/core/Constants.h>
 #include <isce3/core/Ellipsoid.h>
 #include <isce3/core/LUT2d.h>
+#include <isce3/core/LUT2dView.h>
 #include <isce3/core/Orbit.h>
 #include <isce3/core/Poly2d.h>
 #include <isce3/core/Projections.h>
 #include <isce3/geocode/baseband.h>
+#include <isce3/geocode/geo2rdrBlock.h>
+#include <isce3/geometry/boundingbox.h>
 #include <isce3/geometry/DEMInterpolator.h>
 #include <isce3/geometry/loadDem.h>
 #include <isce3/geometry/geometry.h>
@@ -43,12 +52,14 @@ namespace isce3::geocode {
  * @param[in] imageGridDoppler  2D LUT doppler that defines the image grid (radar grid). For zero-Doppler geometries, this will be an LUT that resolves always to 0. For squinted geometries, that have not been deskewed to zero-Doppler, this LUT will be the Doppler Centroid LUT associated with the grid (i.e., usually the same as nativeDoppler).
  * @param[in] thresholdGeo2rdr  threshold to use in geo2rdr
  * @param[in] numiterGeo2rdr    number of iterations to be used in geo2rdr
- * @param[in] azTimeCorrection  azimuth additive correction, in seconds, as a function of azimuth and range. This correction can be an accumulation of multiple corrections that affect the radar signal differently. Individual corrections may account for phenomena such as ionosphere and solid earth tide.
- * @param[in] sRangeCorrection  slant range additive correction, in meters, as a function of azimuth and range. This correction can be an accumulation of multiple corrections that affect the radar signal differently. Individual corrections may account for phenomena such as ionosphere and solid earth tide.
+ * @param[in] azTimeCorrectionLUT  azimuth additive correction, in seconds, as a function of azimuth and range. This correction can be an accumulation of multiple corrections that affect the radar signal differently. Individual corrections may account for phenomena such as ionosphere and solid earth tide.
+ * @param[in] sRangeCorrectionLUT  slant range additive correction, in meters, as a function of azimuth and range. This correction can be an accumulation of multiple corrections that affect the radar signal differently. Individual corrections may account for phenomena such as ionosphere and solid earth tide.
  * @param[in] proj              projection object used to convert geo grid values to latitude and longitude
  * @param[in] useCorrectedSRng  flag to indicate whether geo2rdr slant-range additive values should be used for phase flattening
  * @param[in] lineStart         offset to first line of geo grid
  * @param[in] subswaths         subswath mask representing valid portions of a swath
+ * @param[in] geo2rdrGridSpacing    spacing, in geo grid pixels, of the geo2rdr control grid (0 to solve geo2rdr for every pixel)
+ * @param[in] geo2rdrGridTolerance  maximum interpolation residual, in radar grid pixels, of the geo2rdr control grid
  *
  * \return  tuple consisting of first azimuth line, last azimuth line, first range pixel, and last range pixel
  */
@@ -69,12 +80,14 @@ std::tuple<int, int, int, int> computeGeogridRadarIndicesAndMask(
         const isce3::core::LUT2d<double>& imageGridDoppler,
         const double thresholdGeo2rdr,
         const int numiterGeo2rdr,
-        const isce3::core::LUT2d<double>& azTimeCorrection,
-        const isce3::core::LUT2d<double>& sRangeCorrection,
+        const isce3::core::LUT2d<double>& azTimeCorrectionLUT,
+        const isce3::core::LUT2d<double>& sRangeCorrectionLUT,
         const isce3::core::ProjectionBase* proj,
         const bool useCorrectedSRng,
         const size_t lineStart = 0,
-        const isce3::product::SubSwaths* subswaths = nullptr)
+        const isce3::product::SubSwaths* subswaths = nullptr,
+        const int geo2rdrGridSpacing = 0,
+        const double geo2rdrGridTolerance = 1e-3)
 {
     // Init first and last line of the data block in radar coordinates
     int azimuthFirstLine = radarGrid.length() - 1;
@@ -84,46 +97,57 @@ std::tuple<int, int, int, int> computeGeogridRadarIndicesAndMask(
     int rangeFirstPixel = radarGrid.width() - 1;
     int rangeLastPixel = 0;
 
-    const int chipHalf = isce3::core::SINC_ONE / 2;
-// Loop over lines, samples of the output grid
-#pragma omp parallel for reduction(min: azimuthFirstLine, rangeFirstPixel)  \
-                         reduction(max: azimuthLastLine, rangeLastPixel)
+    // lon/lat/height of each pixel of the block
+    std::vector<isce3::core::Vec3> llh(geoBlockLength * geoBlockWidth);
+#pragma omp parallel for
     for (size_t blockLine = 0; blockLine < geoBlockLength; ++blockLine) {
         // Global line index
         const size_t line = lineStart + blockLine;
 
-        for (size_t pixel = 0; pixel < geoBlockWidth; ++pixel) {
-            // y coordinate in the out put grid
-            // Assuming geoGrid.startY() and geoGrid.startX() represent the top-left
-            // corner of the first pixel, then 0.5 pixel shift is needed to get
-            // to the center of each pixel
-            double y = geoGrid.startY() + geoGrid.spacingY() * (line + 0.5);
+        // y coordinate in the out put grid
+        // Assuming geoGrid.startY() and geoGrid.startX() represent the top-left
+        // corner of the first pixel, then 0.5 pixel shift is needed to get
+        // to the center of each pixel
+        const double y = geoGrid.startY() + geoGrid.spacingY() * (line + 0.5);
 
+        for (size_t pixel = 0; pixel < geoBlockWidth; ++pixel) {
             // x in the output geocoded Grid
-            double x = geoGrid.startX() + geoGrid.spacingX() * (pixel + 0.5);
-
-            // compute the azimuth time and slant range for the
-            // x,y coordinates in the output grid
-            double aztime, srange;
-            aztime = radarGrid.sensingMid();
-
-            // coordinate in the output projection system
-            const isce3::core::Vec3 xyz {x, y, 0.0};
+            const double x =
+                    geoGrid.startX() + geoGrid.spacingX() * (pixel + 0.5);
 
             // transform the xyz in the output projection system to llh
-            isce3::core::Vec3 llh = proj->inverse(xyz);
+            auto& pixelLLH = llh[blockLine * geoBlockWidth + pixel];
+            pixelLLH = proj->inverse({x, y, 0.0});
 
             // interpolate the height from the DEM for this pixel
-            llh[2] = demInterp.interpolateLonLat(llh[0], llh[1]);
+            pixelLLH[2] = demInterp.interpolateLonLat(pixelLLH[0], pixelLLH[1]);
+        }
+    }
 
-            // Perform geo->rdr iterations
-            int geostat = isce3::geometry::geo2rdr(
-                    llh, ellipsoid, orbit, imageGridDoppler, aztime, srange,
-                    radarGrid.wavelength(), radarGrid.lookSide(),
-                    thresholdGeo2rdr, numiterGeo2rdr, 1.0e-8);
+    // compute the azimuth time and slant range for the x,y coordinates
+    // of the block
+    std::vector<double> aztimes(llh.size()), sranges(llh.size());
+    geo2rdrBlock(aztimes.data(), sranges.data(), llh.data(), geoGrid,
+            lineStart, geoBlockLength, geoBlockWidth, proj, ellipsoid, orbit,
+            imageGridDoppler, radarGrid, thresholdGeo2rdr, numiterGeo2rdr,
+            1.0e-8, geo2rdrGridSpacing, geo2rdrGridTolerance);
+
+    const int chipHalf = isce3::core::SINC_ONE / 2;
+
+    // Evaluate the timing corrections inline in the pixel loop
+    const isce3::core::LUT2dView<double> azTimeCorrection(azTimeCorrectionLUT);
+    const isce3::core::LUT2dView<double> sRangeCorrection(sRangeCorrectionLUT);
+
+// Loop over lines, samples of the output grid
+#pragma omp parallel for reduction(min: azimuthFirstLine, rangeFirstPixel)  \
+                         reduction(max: azimuthLastLine, rangeLastPixel)
+    for (size_t blockLine = 0; blockLine < geoBlockLength; ++blockLine) {
+        for (size_t pixel = 0; pixel < geoBlockWidth; ++pixel) {
+            double aztime = aztimes[blockLine * geoBlockWidth + pixel];
+            double srange = sranges[blockLine * geoBlockWidth + pixel];
 
             // Check convergence
-            if (geostat == 0)
+            if (std::isnan(aztime))
                 continue;
 
             // save uncorrected slant range
@@ -276,48 +300,62 @@ void carrierPhaseDeramp(
 }
 
 
-/**
- * Add back range and azimuth phase carrier and simultaneously flatten the block of geocoded SLC
- *
- * @param[out] geoDataBlock     geocoded SLC data whose phase will be added by carrier phase and flatten by geometrical phase
- * @param[out] carrierPhaseBlock     geocoded carrier phase data that could have been added to SLC data
- * @param[out] flattenPhaseBlock     geocoded flattening phase data that could have been flatten to SLC data
- * @param[in] rdrDataBlock      radar grid SLC data
- * @tparam[in] azCarrierPhase   azimuth carrier phase of the SLC data, in radian, as a function of azimuth and range
- * @tparam[in] rgCarrierPhase   range carrier phase of the SLC data, in radian, as a function of azimuth and range
- * @param[in] nativeDopplerLUT  native doppler of SLC image
- * @param[in] rangeIndices      range (radar-coordinates x) index of the pixels in geo-grid
- * @param[in] azimuthIndices    azimuth (radar-coordinates y) index of the pixels in geo-grid
- * @param[in] radarGrid         radar grid parameters
- * @param[in] flatten           flag to flatten the geocoded SLC
- * @param[in] reramp            flag to reramp the geocoded SLC
- * @param[in] azimuthFirstLine  line index of the first sample of the block
- * @param[in] rangeFirstPixel   pixel index of the first sample of the block
- * @param[in] flattenWithCorrectedSRng  flag to use corrected slant range for flattening
- * @param[in] uncorrectedSRngs  slant range without correction, in meters, indexed
- *                              by geo-grid indices
- */
 template <typename AzRgFunc>
-void carrierPhaseRerampAndFlatten(
+void interpolateRerampAndFlatten(
+        const EArray2dc64 rdrDataBlock,
         EArray2dc64 geoDataBlock,
         EArray2df64 carrierPhaseBlock,
         EArray2df64 flattenPhaseBlock,
-        const EArray2dc64 rdrDataBlock,
-        const AzRgFunc& azCarrierPhase, const AzRgFunc& rgCarrierPhase,
-        const isce3::core::LUT2d<double>& nativeDopplerLUT,
-        isce3::core::Matrix<double>& rangeIndices,
-        isce3::core::Matrix<double>& azimuthIndices,
+        const isce3::core::Matrix<double>& rangeIndices,
+        const isce3::core::Matrix<double>& azimuthIndices,
+        const size_t azimuthFirstLine, const size_t rangeFirstPixel,
+        const isce3::core::Sinc2dInterpolator<std::complex<float>>& sincInterp,
         const isce3::product::RadarGridParameters& radarGrid,
+        const isce3::core::LUT2d<double>& nativeDopplerLUT,
+        const AzRgFunc& azCarrierPhase, const AzRgFunc& rgCarrierPhase,
         const bool flatten, const bool reramp,
-        const size_t azimuthFirstLine, const size_t rangeFirstPixel,
         const bool flattenWithCorrectedSRng,
-        isce3::core::Matrix<double>& uncorrectedSRngs)
+        const isce3::core::Matrix<double>& uncorrectedSRngs)
 {
+    constexpr int kernelLength = isce3::core::SINC_LEN;
+    constexpr int kernelHalf = kernelLength / 2;
+    if (sincInterp.kernelLength() != kernelLength) {
+        std::string error_msg("sinc interpolator must have SINC_LEN taps");
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_msg);
+    }
+
     const size_t outWidth = geoDataBlock.cols();
     const size_t outLength = geoDataBlock.rows();
     const int inWidth = rdrDataBlock.cols();
     const int inLength = rdrDataBlock.rows();
-    const int chipHalf = isce3::core::SINC_ONE / 2;
+    const int chipHalf = isce3::core::SINC_HALF;
+
+    const bool writeCarrierPhase =
+            carrierPhaseBlock.rows() == geoDataBlock.rows() and
+            carrierPhaseBlock.cols() == geoDataBlock.cols();
+    const bool writeFlattenPhase =
+            flattenPhaseBlock.rows() == geoDataBlock.rows() and
+            flattenPhaseBlock.cols() == geoDataBlock.cols();
+
+    // Single precision copy of the kernel table with reversed taps, so that
+    // tap k weighs the k-th sample of the support in increasing index order
+    const int decimationFactor = sincInterp.decimationFactor();
+    const auto& kernel = sincInterp.kernel();
+    std::vector<float> weights(decimationFactor * kernelLength);
+    for (int f = 0; f < decimationFactor; ++f) {
+        for (int k = 0; k < kernelLength; ++k) {
+            weights[f * kernelLength + k] =
+                    static_cast<float>(kernel(f, kernelLength - 1 - k));
+        }
+    }
+    auto kernelRow = [&](double frac) {
+        const int ifrac = std::min(std::max(0, int(frac * decimationFactor)),
+                                   decimationFactor - 1);
+        return &weights[ifrac * kernelLength];
+    };
+
+    // Evaluate the native Doppler inline in the pixel loop
+    const isce3::core::LUT2dView<double> nativeDoppler(nativeDopplerLUT);
 
 #pragma omp parallel for
     for (size_t ii = 0; ii < outLength * outWidth; ++ii) {
@@ -333,17 +371,21 @@ void carrierPhaseRerampAndFlatten(
         if (std::isnan(unadjustedRgIndex) or std::isnan(unadjustedAzIndex))
             continue;
 
-        // Get double and int rg/az coordinates (accounting for block offsets)
+        // adjust the row and column indicies for the current block,
+        // i.e., moving the origin to the top-left of this radar block.
         const double RgIndex = unadjustedRgIndex - rangeFirstPixel;
         const double AzIndex = unadjustedAzIndex - azimuthFirstLine;
 
-        // Truncate rg/az indices to int
+        // Truncate rg/az coordinates to int
         const int intRgIndex = static_cast<int>(RgIndex);
         const int intAzIndex = static_cast<int>(AzIndex);
 
-        // Check if chip indices could be outside radar grid (plus interp chip)
-        // i.e. Check if current pixel was interpolated
-        // Skip if chip indices outside int value of radar grid
+        // Save the fractional parts of rg/az coordinates
+        const double fracRgIndex = RgIndex - intRgIndex;
+        const double fracAzIndex = AzIndex - intAzIndex;
+
+        // Check if chip indices could be outside radar grid
+        // Skip if chip indices out of bounds
         if ((intRgIndex < chipHalf) || (intRgIndex >= (inWidth - chipHalf)))
             continue;
         if ((intAzIndex < chipHalf) || (intAzIndex >= (inLength - chipHalf)))
@@ -357,10 +399,13 @@ void carrierPhaseRerampAndFlatten(
         const double az = radarGrid.sensingStart() +
                           unadjustedAzIndex / radarGrid.prf();
 
-        // Skip pixel if doppler could not be evaluated
-        if (not nativeDopplerLUT.contains(az, rng))
+        if (not nativeDoppler.contains(az, rng))
             continue;
 
+        // Evaluate doppler at current range and azimuth time
+        const double doppFreq =
+                nativeDoppler.eval(az, rng) * 2 * M_PI / radarGrid.prf();
+
         // Evaluate range and azimuth carriers
         const double carrierPhase =
             rgCarrierPhase.eval(az, rng) + azCarrierPhase.eval(az, rng);
@@ -378,137 +423,42 @@ void carrierPhaseRerampAndFlatten(
         if (flatten)
             totalPhase += flattenPhase;
 
-        // assign values to carrier and flattening phase arrays if shape
-        // matches geoDataBlock shape
-        if (carrierPhaseBlock.rows() == geoDataBlock.rows() and
-                carrierPhaseBlock.cols() == geoDataBlock.cols())
+        if (writeCarrierPhase)
             carrierPhaseBlock(i, j) = carrierPhase;
-
-        if (flattenPhaseBlock.rows() == geoDataBlock.rows() and
-                flattenPhaseBlock.cols() == geoDataBlock.cols())
+        if (writeFlattenPhase)
             flattenPhaseBlock(i, j) = flattenPhase;
 
-        // Update geoDataBlock column and row from index
-        const std::complex<float> cpxVal(std::cos(totalPhase),
-                                         std::sin(totalPhase));
-        geoDataBlock(i, j) *= cpxVal;
-    }
-}
-
-
-/** Interpolate radar data block to geo data block
- *
- * @param[in] rdrDataBlock      block of SLC data in radar coordinates basebanded in range direction
- * @param[out] geoDataBlock     block of data in geo coordinates
- * @param[in] rangeIndices      range (radar-coordinates x) index of the pixels in geo-grid
- * @param[in] azimuthIndices    azimuth (radar-coordinates y) index of the pixels in geo-grid
- * @param[in] azimuthFirstLine  line index of the first sample of the block
- * @param[in] rangeFirstPixel   pixel index of the first sample of the block
- * @param[in] sincInterp        sinc interpolator object
- * @param[in] radarGrid         RadarGridParameters of radar data
- * @param[in] nativeDopplerLUT  native doppler of SLC image
- */
-void interpolate(
-        const Eigen::Ref<isce3::core::EArray2D<std::complex<float>>> rdrDataBlock,
-        Eigen::Ref<isce3::core::EArray2D<std::complex<float>>> geoDataBlock,
-        isce3::core::Matrix<double>& rangeIndices,
-        isce3::core::Matrix<double>& azimuthIndices,
-        const int azimuthFirstLine, const int rangeFirstPixel,
-        const isce3::core::Interpolator<std::complex<float>>* sincInterp,
-        const isce3::product::RadarGridParameters& radarGrid,
-        const isce3::core::LUT2d<double>& nativeDopplerLUT)
-{
-    const int chipSize = isce3::core::SINC_ONE;
-    const int outWidth = geoDataBlock.cols();
-    const int outLength = geoDataBlock.rows();
-    const int inWidth = rdrDataBlock.cols();
-    const int inLength = rdrDataBlock.rows();
-    const int chipHalf = isce3::core::SINC_HALF;
-
-#pragma omp parallel for
-    for (size_t ii = 0; ii < outLength * outWidth; ++ii) {
-        auto i = ii / outWidth;
-        auto j = ii % outWidth;
-
-        // Cache range and azimuth index for later use
-        const auto unadjustedRgIndex = rangeIndices(i, j);
-        const auto unadjustedAzIndex = azimuthIndices(i, j);
-
-        // Skip further processing if range and azimuth indices are Nan i.e.
-        // invalid
-        if (isnan(unadjustedRgIndex) or isnan(unadjustedAzIndex))
-            continue;
-
-        // adjust the row and column indicies for the current block,
-        // i.e., moving the origin to the top-left of this radar block.
-        double RgIndex = unadjustedRgIndex - rangeFirstPixel;
-        double AzIndex = unadjustedAzIndex - azimuthFirstLine;
-
-        // Truncate rg/az coordinates to int
-        const int intRgIndex = static_cast<int>(RgIndex);
-        const int intAzIndex = static_cast<int>(AzIndex);
-
-        // Save the fractional parts of rg/az coordinates
-        const double fracRgIndex = RgIndex - intRgIndex;
-        const double fracAzIndex = AzIndex - intAzIndex;
-
-        // Check if chip indices could be outside radar grid
-        // Skip if chip indices out of bounds
-        if ((intRgIndex < chipHalf) || (intRgIndex >= (inWidth - chipHalf)))
-            continue;
-        if ((intAzIndex < chipHalf) || (intAzIndex >= (inLength - chipHalf)))
-            continue;
-
-        // Slant Range at the current output pixel
-        const double rng =
-                radarGrid.startingRange() +
-                unadjustedRgIndex * radarGrid.rangePixelSpacing();
-
-        // Azimuth time at the current output pixel
-        const double az = radarGrid.sensingStart() +
-                          unadjustedAzIndex / radarGrid.prf();
-
-        if (not nativeDopplerLUT.contains(az, rng))
-            continue;
-
-        // Evaluate doppler at current range and azimuth time
-        const double doppFreq =
-                nativeDopplerLUT.eval(az, rng) * 2 * M_PI / radarGrid.prf();
-
-        isce3::core::Matrix<std::complex<float>> chip(chipSize, chipSize);
-        // Read data chip
-        for (int ii = 0; ii < chipSize; ++ii) {
-            // Row to read from
-            const int chipRow = intAzIndex + ii - chipHalf;
-
-            // Compute doppler frequency at current row
-            const double doppPhase = doppFreq * (ii - chipHalf);
-            const std::complex<float> doppVal(std::cos(doppPhase),
-                                              -std::sin(doppPhase));
-
-            for (int jj = 0; jj < chipSize; ++jj) {
-                // Column to read from
-                const int chipCol = intRgIndex + jj - chipHalf;
-
-                // Set the data values after doppler demodulation
-                chip(ii, jj) = rdrDataBlock(chipRow, chipCol) * doppVal;
+        // The kernel support spans rows and columns
+        // [index - kernelHalf + 1, index + kernelHalf]
+        const int row0 = intAzIndex - kernelHalf + 1;
+        const int col0 = intRgIndex - kernelHalf + 1;
+        const float* rgWeights = kernelRow(fracRgIndex);
+        const float* azWeights = kernelRow(fracAzIndex);
+
+        // Row k is demodulated by exp(-1j * doppFreq * (row0 + k - intAz))
+        // and the Doppler at the output location is added back with
+        // exp(1j * doppFreq * fracAz), so that row k is modulated by
+        // exp(1j * (phase0 - k * doppFreq))
+        const double phase0 = totalPhase +
+                doppFreq * (fracAzIndex + kernelHalf - 1);
+        std::complex<double> rowPhasor = std::polar(1.0, phase0);
+        const std::complex<double> rowPhasorStep = std::polar(1.0, -doppFreq);
+
+        std::complex<float> cval(0.0f);
+        for (int k = 0; k < kernelLength; ++k) {
+            const std::complex<float>* rdrRow = &rdrDataBlock(row0 + k, col0);
+            float re = 0.0f, im = 0.0f;
+            #pragma omp simd reduction(+:re,im)
+            for (int m = 0; m < kernelLength; ++m) {
+                re += rgWeights[m] * rdrRow[m].real();
+                im += rgWeights[m] * rdrRow[m].imag();
             }
+            cval += std::complex<float>(re, im) *
+                    std::complex<float>(double(azWeights[k]) * rowPhasor);
+            rowPhasor *= rowPhasorStep;
         }
 
-        // Interpolate chip
-        const std::complex<float> cval =
-                sincInterp->interpolate(chipHalf + fracRgIndex,
-                        chipHalf + fracAzIndex, chip);
-
-        // Compute doppler that was demodulated from chip in interpolation to
-        // be added back
-        const auto azLocation = fracAzIndex;
-        const auto doppFreqToAddBack = doppFreq * azLocation;
-        const std::complex<float> doppValAddBack(std::cos(doppFreqToAddBack),
-                std::sin(doppFreqToAddBack));
-
-        // Set geoDataBlock column and row from index with doppler added back
-        geoDataBlock(i, j) = cval * doppValAddBack;
+        geoDataBlock(i, j) = cval;
     }
 }
 
@@ -531,14 +481,17 @@ void geocodeSlc(
         const bool flattenWithCorrectedSRng,
         const std::complex<float> invalidValue,
         isce3::io::Raster* carrierPhaseRaster,
-        isce3::io::Raster* flattenPhaseRaster)
+        isce3::io::Raster* flattenPhaseRaster,
+        const int geo2rdrGridSpacing,
+        const double geo2rdrGridTolerance)
 {
     geocodeSlc(outputRaster, inputRaster, demRaster, radarGrid, radarGrid,
             geoGrid, orbit,nativeDoppler, imageGridDoppler, ellipsoid,
             thresholdGeo2rdr, numiterGeo2rdr, linesPerBlock,
             flatten, reramp, azCarrierPhase, rgCarrierPhase, azTimeCorrection,
             sRangeCorrection, flattenWithCorrectedSRng, invalidValue,
-            carrierPhaseRaster, flattenPhaseRaster);
+            carrierPhaseRaster, flattenPhaseRaster, geo2rdrGridSpacing,
+            geo2rdrGridTolerance);
 }
 
 
@@ -623,7 +576,9 @@ void geocodeSlc(
         const bool flattenWithCorrectedSRng,
         const std::complex<float> invalidValue,
         isce3::io::Raster* carrierPhaseRaster,
-        isce3::io::Raster* flattenPhaseRaster)
+        isce3::io::Raster* flattenPhaseRaster,
+        const int geo2rdrGridSpacing,
+        const double geo2rdrGridTolerance)
 {
     validate_slice(radarGrid, slicedRadarGrid);
 
@@ -714,14 +669,17 @@ void geocodeSlc(
                 sRangeCorrection,
                 proj.get(),
                 flattenWithCorrectedSRng,
-                lineStart);
+                lineStart,
+                nullptr,
+                geo2rdrGridSpacing,
+                geo2rdrGridTolerance);
 
         // Fill the output block with the default value before checking validity
         isce3::core::EArray2D<std::complex<float>> geoDataBlock(geoBlockLength,
                                                                 geoGrid.width());
 
         // assume all values invalid by default
-        // interpolate and carrierPhaseRerampAndFlatten will only modify valid pixels
+        // interpolateRerampAndFlatten will only modify valid pixels
         geoDataBlock.fill(invalidValue);
 
         // init phase and range offset blocks, but only resize and fill if
@@ -795,17 +753,13 @@ void geocodeSlc(
             carrierPhaseDeramp(rdrDataBlock, azCarrierPhase, rgCarrierPhase,
                    azimuthFirstLine, rangeFirstPixel, radarGrid);
 
-            // interpolate the data in radar grid to the geocoded grid.
-            interpolate(rdrDataBlock, geoDataBlock, rangeIndices, azimuthIndices,
-                    azimuthFirstLine, rangeFirstPixel, sincInterp.get(),
-                    radarGrid, nativeDoppler);
-
-            // Add back doppler and carriers as needd
-            carrierPhaseRerampAndFlatten(geoDataBlock, carrierPhaseBlock,
-                    flattenPhaseBlock, rdrDataBlock, azCarrierPhase,
-                    rgCarrierPhase, nativeDoppler, rangeIndices,
-                    azimuthIndices, radarGrid, flatten, reramp,
-                    azimuthFirstLine, rangeFirstPixel, flattenWithCorrectedSRng,
+            // interpolate the data in radar grid to the geocoded grid and
+            // add back doppler and carriers as needed
+            interpolateRerampAndFlatten(rdrDataBlock, geoDataBlock,
+                    carrierPhaseBlock, flattenPhaseBlock, rangeIndices,
+                    azimuthIndices, azimuthFirstLine, rangeFirstPixel,
+                    *sincInterp, radarGrid, nativeDoppler, azCarrierPhase,
+                    rgCarrierPhase, flatten, reramp, flattenWithCorrectedSRng,
                     uncorrectedSRange);
 
             // set output
@@ -853,7 +807,9 @@ void geocodeSlc(
         const isce3::core::LUT2d<double>& sRangeCorrection,
         const bool flattenWithCorrectedSRng,
         const std::complex<float> invalidValue,
-        const isce3::product::SubSwaths* subswaths)
+        const isce3::product::SubSwaths* subswaths,
+        const int geo2rdrGridSpacing,
+        const double geo2rdrGridTolerance)
 {
     if (geoDataBlocks.size() != rdrDataBlocks.size()) {
         std::string error_msg("number of geoDataBlocks != number of rdrDataBlocks");
@@ -940,7 +896,9 @@ void geocodeSlc(
             proj.get(),
             flattenWithCorrectedSRng,
             0,
-            subswaths);
+            subswaths,
+            geo2rdrGridSpacing,
+            geo2rdrGridTolerance);
 
     // loop over pairs of radar and geo block array
     for (auto [gIt, rIt] = std::tuple(geoDataBlocks.begin(), rdrDataBlocks.begin());
@@ -948,26 +906,265 @@ void geocodeSlc(
         auto geoDataBlock = *gIt;
         auto rdrDataBlock = *rIt;
 
-        // interpolate and carrierPhaseRerampAndFlatten will only modify valid pixels
+        // interpolateRerampAndFlatten will only modify valid pixels
         // Remove doppler and carriers as needd
         carrierPhaseDeramp(rdrDataBlock, azCarrierPhase, rgCarrierPhase,
                 azimuthFirstLine, rangeFirstPixel, radarGrid);
 
-        // interpolate the data in radar grid to the geocoded grid.
-        interpolate(rdrDataBlock, geoDataBlock, rangeIndices, azimuthIndices,
-                azimuthFirstLine, rangeFirstPixel, sincInterp.get(),
-                radarGrid, nativeDoppler);
-
-        // Add back doppler and carriers as needd
-        carrierPhaseRerampAndFlatten(geoDataBlock, carrierPhaseBlock,
-                flattenPhaseBlock, rdrDataBlock, azCarrierPhase,
-                rgCarrierPhase, nativeDoppler, rangeIndices,
-                azimuthIndices, radarGrid, flatten, reramp,
-                azimuthFirstLine, rangeFirstPixel, flattenWithCorrectedSRng,
+        // interpolate the data in radar grid to the geocoded grid and add
+        // back doppler and carriers as needed
+        interpolateRerampAndFlatten(rdrDataBlock, geoDataBlock,
+                carrierPhaseBlock, flattenPhaseBlock, rangeIndices,
+                azimuthIndices, azimuthFirstLine, rangeFirstPixel,
+                *sincInterp, radarGrid, nativeDoppler, azCarrierPhase,
+                rgCarrierPhase, flatten, reramp, flattenWithCorrectedSRng,
                 uncorrectedSRange);
     }
 }
 
+void truncateMantissa(std::complex<float>* data, size_t size,
+                      int mantissaBits)
+{
+    constexpr int floatMantissaBits = std::numeric_limits<float>::digits - 1;
+    if (mantissaBits <= 0 or mantissaBits > floatMantissaBits) {
+        std::string error_msg("number of mantissa bits to keep must be in "
+                              "[1, 23]");
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_msg);
+    }
+    if (mantissaBits == floatMantissaBits)
+        return;
+
+    // IEEE 754 stores the sign, then the exponent, then the mantissa, so
+    // the least significant bits of a float are those of its mantissa
+    const uint32_t mask = ~((uint32_t(1) << (floatMantissaBits -
+                                             mantissaBits)) - 1);
+
+    // complex<float> is laid out as an array of two floats
+    float* values = reinterpret_cast<float*>(data);
+    #pragma omp parallel for simd
+    for (size_t i = 0; i < 2 * size; ++i) {
+        uint32_t bits;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        bits &= mask;
+        std::memcpy(&values[i], &bits, sizeof(bits));
+    }
+}
+
+
+template<typename AzRgFunc>
+void geocodeSlcBlocks(
+        const std::vector<isce3::io::Raster*>& outputRasters,
+        isce3::io::Raster* maskRaster,
+        const std::vector<isce3::io::Raster*>& inputRasters,
+        isce3::io::Raster& demRaster,
+        const isce3::product::RadarGridParameters& radarGrid,
+        const isce3::product::GeoGridParameters& geoGrid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& nativeDoppler,
+        const isce3::core::LUT2d<double>& imageGridDoppler,
+        const isce3::core::Ellipsoid& ellipsoid,
+        const double& thresholdGeo2rdr, const int& numiterGeo2rdr,
+        const size_t linesPerBlock, const size_t columnsPerBlock,
+        const bool flatten, const bool reramp,
+        const AzRgFunc& azCarrierPhase, const AzRgFunc& rgCarrierPhase,
+        const isce3::core::LUT2d<double>& azTimeCorrection,
+        const isce3::core::LUT2d<double>& sRangeCorrection,
+        const bool flattenWithCorrectedSRng,
+        const std::complex<float> invalidValue,
+        const isce3::product::SubSwaths* subswaths,
+        const int mantissaBits,
+        const int geogridExpansionThreshold,
+        const int geo2rdrGridSpacing,
+        const double geo2rdrGridTolerance)
+{
+    if (outputRasters.size() != inputRasters.size()) {
+        std::string error_msg("number of output rasters != number of input rasters");
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_msg);
+    }
+    if (linesPerBlock == 0 or columnsPerBlock == 0) {
+        std::string error_msg("geogrid block dimensions must be positive");
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_msg);
+    }
+    if (mantissaBits < 0 or
+            mantissaBits >= std::numeric_limits<float>::digits) {
+        std::string error_msg("number of mantissa bits to keep must be in "
+                              "[0, 23]");
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_msg);
+    }
+
+    pyre::journal::info_t info("isce.geocode.geocodeSlc.geocodeSlcBlocks");
+
+    const size_t nbands = inputRasters.size();
+    const size_t nBlocksY = (geoGrid.length() + linesPerBlock - 1) /
+                            linesPerBlock;
+    const size_t nBlocksX = (geoGrid.width() + columnsPerBlock - 1) /
+                            columnsPerBlock;
+    const size_t nBlocks = nBlocksX * nBlocksY;
+
+    // DEM height extremes used as starting guesses for the radar bounding
+    // box of each block
+    float minHeight, maxHeight, meanHeight;
+    {
+        isce3::geometry::DEMInterpolator demInterp =
+            isce3::geometry::DEMRasterToInterpolator(demRaster, geoGrid, 0,
+                    geoGrid.length(), geoGrid.width());
+        demInterp.computeMinMaxMeanHeight(minHeight, maxHeight, meanHeight);
+    }
+
+    // Input and output rasters may be backed by the same (non thread-safe)
+    // HDF5 library, so the reader and writer threads take turns. The DEM is
+    // read by the processing thread outside of this lock.
+    std::mutex ioMutex;
+
+    struct SlcBlock {
+        size_t lineStart, colStart;
+        isce3::product::GeoGridParameters geoGrid;
+        isce3::geometry::RadarGridBoundingBox bbox;
+        std::vector<isce3::core::EArray2D<std::complex<float>>> rdrData;
+        std::vector<isce3::core::EArray2D<std::complex<float>>> geoData;
+        isce3::core::EArray2D<unsigned char> mask;
+    };
+
+    // Set up a geogrid block, or return nullptr if no radar data is found
+    auto make_block = [&](size_t block) -> std::unique_ptr<SlcBlock> {
+        const size_t blockY = block / nBlocksX;
+        const size_t blockX = block % nBlocksX;
+
+        auto slc_block = std::make_unique<SlcBlock>();
+        slc_block->lineStart = blockY * linesPerBlock;
+        slc_block->colStart = blockX * columnsPerBlock;
+        const size_t length = std::min(linesPerBlock,
+                geoGrid.length() - slc_block->lineStart);
+        const size_t width = std::min(columnsPerBlock,
+                geoGrid.width() - slc_block->colStart);
+        slc_block->geoGrid = isce3::product::GeoGridParameters(
+                geoGrid.startX() + slc_block->colStart * geoGrid.spacingX(),
+                geoGrid.startY() + slc_block->lineStart * geoGrid.spacingY(),
+                geoGrid.spacingX(), geoGrid.spacingY(), width, length,
+                geoGrid.epsg());
+
+        try {
+            slc_block->bbox = isce3::geometry::getRadarBoundingBox(
+                    slc_block->geoGrid, radarGrid, orbit, minHeight,
+                    maxHeight, {}, 50, {}, geogridExpansionThreshold);
+        } catch (const isce3::except::RuntimeError&) {
+            info << "no radar data found for block " << block + 1 << " of "
+                 << nBlocks << pyre::journal::endl;
+            return nullptr;
+        }
+        return slc_block;
+    };
+
+    auto read_block = [&](SlcBlock& slc_block) {
+        const auto& bbox = slc_block.bbox;
+        const size_t rdrLength = bbox.lastAzimuthLine - bbox.firstAzimuthLine;
+        const size_t rdrWidth = bbox.lastRangeSample - bbox.firstRangeSample;
+        slc_block.rdrData.resize(nbands);
+        std::lock_guard<std::mutex> lock(ioMutex);
+        for (size_t band = 0; band < nbands; ++band) {
+            slc_block.rdrData[band].resize(rdrLength, rdrWidth);
+            inputRasters[band]->getBlock(slc_block.rdrData[band].data(),
+                    bbox.firstRangeSample, bbox.firstAzimuthLine, rdrWidth,
+                    rdrLength, 1);
+        }
+    };
+
+    auto geocode_block = [&](SlcBlock& slc_block) {
+        const size_t length = slc_block.geoGrid.length();
+        const size_t width = slc_block.geoGrid.width();
+        slc_block.geoData.resize(nbands);
+        std::vector<EArray2dc64> geoDataRefs, rdrDataRefs;
+        for (size_t band = 0; band < nbands; ++band) {
+            slc_block.geoData[band].resize(length, width);
+            geoDataRefs.emplace_back(slc_block.geoData[band]);
+            rdrDataRefs.emplace_back(slc_block.rdrData[band]);
+        }
+        slc_block.mask.resize(length, width);
+        isce3::core::EArray2D<double> emptyPhase;
+
+        geocodeSlc(geoDataRefs, slc_block.mask, emptyPhase, emptyPhase,
+                rdrDataRefs, demRaster, radarGrid, radarGrid,
+                slc_block.geoGrid, orbit, nativeDoppler, imageGridDoppler,
+                ellipsoid, thresholdGeo2rdr, numiterGeo2rdr,
+                slc_block.bbox.firstAzimuthLine,
+                slc_block.bbox.firstRangeSample, flatten, reramp,
+                azCarrierPhase, rgCarrierPhase, azTimeCorrection,
+                sRangeCorrection, flattenWithCorrectedSRng, invalidValue,
+                subswaths, geo2rdrGridSpacing, geo2rdrGridTolerance);
+
+        // radar data is no longer needed
+        slc_block.rdrData.clear();
+
+        if (mantissaBits > 0) {
+            for (auto& geoData : slc_block.geoData)
+                truncateMantissa(geoData.data(), geoData.size(),
+                                 mantissaBits);
+        }
+    };
+
+    auto write_block = [&](SlcBlock& slc_block) {
+        const size_t length = slc_block.geoGrid.length();
+        const size_t width = slc_block.geoGrid.width();
+        std::lock_guard<std::mutex> lock(ioMutex);
+        for (size_t band = 0; band < nbands; ++band) {
+            outputRasters[band]->setBlock(slc_block.geoData[band].data(),
+                    slc_block.colStart, slc_block.lineStart, width, length, 1);
+        }
+        if (maskRaster) {
+            maskRaster->setBlock(slc_block.mask.data(), slc_block.colStart,
+                    slc_block.lineStart, width, length, 1);
+        }
+    };
+
+    /*
+    Software pipeline over the geogrid blocks. While block N is set up, the
+    radar data of block N - 1 is being prefetched. While block N - 1 is
+    geocoded, block N is being read and block N - 2 is being written. At
+    most three blocks are held in memory at any time.
+    */
+    std::unique_ptr<SlcBlock> reading_block, writing_block;
+    std::future<void> read_future, write_future;
+
+    for (size_t block = 0; block <= nBlocks; ++block) {
+
+        std::unique_ptr<SlcBlock> current_block;
+        if (block < nBlocks) {
+            info << "running geocode SLC array block " << block + 1 << " of "
+                 << nBlocks << pyre::journal::endl;
+            current_block = make_block(block);
+        }
+
+        // wait for the prefetch of the previous block
+        std::unique_ptr<SlcBlock> geocoding_block;
+        if (read_future.valid()) {
+            read_future.get();
+            geocoding_block = std::move(reading_block);
+        }
+
+        // start prefetching the current block
+        if (current_block) {
+            reading_block = std::move(current_block);
+            read_future = std::async(std::launch::async, read_block,
+                                     std::ref(*reading_block));
+        }
+
+        if (!geocoding_block)
+            continue;
+
+        geocode_block(*geocoding_block);
+
+        // wait for the writer to flush the block before, then hand over the
+        // block that has just been geocoded
+        if (write_future.valid())
+            write_future.get();
+        writing_block = std::move(geocoding_block);
+        write_future = std::async(std::launch::async, write_block,
+                                  std::ref(*writing_block));
+    }
+    if (write_future.valid())
+        write_future.get();
+}
+
 #define EXPLICIT_INSTANTIATION(AzRgFunc)                                \
 template void geocodeSlc<AzRgFunc>(                                     \
         isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,\
@@ -987,7 +1184,9 @@ template void geocodeSlc<AzRgFunc>(                                     \
         const bool flattenWithCorrectedSRng,                            \
         const std::complex<float> invalidValue,                         \
         isce3::io::Raster* phaseRaster,                                 \
-        isce3::io::Raster* rgOffsetRaster);                             \
+        isce3::io::Raster* rgOffsetRaster,                              \
+        const int geo2rdrGridSpacing,                                   \
+        const double geo2rdrGridTolerance);                             \
 template void geocodeSlc<AzRgFunc>(                                     \
         isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,\
         isce3::io::Raster& demRaster,                                   \
@@ -1007,7 +1206,9 @@ template void geocodeSlc<AzRgFunc>(                                     \
         const bool flattenWithCorrectedSRng,                            \
         const std::complex<float> invalidValue,                         \
         isce3::io::Raster* phaseRaster,                                 \
-        isce3::io::Raster* rgOffsetRaster);                             \
+        isce3::io::Raster* rgOffsetRaster,                              \
+        const int geo2rdrGridSpacing,                                   \
+        const double geo2rdrGridTolerance);                             \
 template void geocodeSlc<AzRgFunc>(                                     \
         std::vector<EArray2dc64>& geoDataBlocks,                        \
         EArray2duc8 maskBlock,                                          \
@@ -1030,7 +1231,49 @@ template void geocodeSlc<AzRgFunc>(                                     \
         const isce3::core::LUT2d<double>& sRangeCorrection,             \
         const bool flattenWithCorrectedSRng,                            \
         const std::complex<float> invalidValue,                         \
-        const isce3::product::SubSwaths*)
+        const isce3::product::SubSwaths*,                               \
+        const int geo2rdrGridSpacing,                                   \
+        const double geo2rdrGridTolerance);                             \
+template void geocodeSlcBlocks<AzRgFunc>(                               \
+        const std::vector<isce3::io::Raster*>& outputRasters,           \
+        isce3::io::Raster* maskRaster,                                  \
+        const std::vector<isce3::io::Raster*>& inputRasters,            \
+        isce3::io::Raster& demRaster,                                   \
+        const isce3::product::RadarGridParameters& radarGrid,           \
+        const isce3::product::GeoGridParameters& geoGrid,               \
+        const isce3::core::Orbit& orbit,                                \
+        const isce3::core::LUT2d<double>& nativeDoppler,                \
+        const isce3::core::LUT2d<double>& imageGridDoppler,             \
+        const isce3::core::Ellipsoid& ellipsoid,                        \
+        const double& thresholdGeo2rdr, const int& numiterGeo2rdr,      \
+        const size_t linesPerBlock, const size_t columnsPerBlock,       \
+        const bool flatten,  const bool reramp,                         \
+        const AzRgFunc& azCarrierPhase, const AzRgFunc& rgCarrierPhase, \
+        const isce3::core::LUT2d<double>& azTimeCorrection,             \
+        const isce3::core::LUT2d<double>& sRangeCorrection,             \
+        const bool flattenWithCorrectedSRng,                            \
+        const std::complex<float> invalidValue,                         \
+        const isce3::product::SubSwaths* subswaths,                     \
+        const int mantissaBits,                                         \
+        const int geogridExpansionThreshold,                            \
+        const int geo2rdrGridSpacing,                                   \
+        const double geo2rdrGridTolerance);                             \
+template void interpolateRerampAndFlatten<AzRgFunc>(                    \
+        const EArray2dc64 rdrDataBlock,                                 \
+        EArray2dc64 geoDataBlock,                                       \
+        EArray2df64 carrierPhaseBlock,                                  \
+        EArray2df64 flattenPhaseBlock,                                  \
+        const isce3::core::Matrix<double>& rangeIndices,                \
+        const isce3::core::Matrix<double>& azimuthIndices,              \
+        const size_t azimuthFirstLine, const size_t rangeFirstPixel,    \
+        const isce3::core::Sinc2dInterpolator<std::complex<float>>&     \
+                sincInterp,                                             \
+        const isce3::product::RadarGridParameters& radarGrid,           \
+        const isce3::core::LUT2d<double>& nativeDopplerLUT,             \
+        const AzRgFunc& azCarrierPhase, const AzRgFunc& rgCarrierPhase, \
+        const bool flatten, const bool reramp,                          \
+        const bool flattenWithCorrectedSRng,                            \
+        const isce3::core::Matrix<double>& uncorrectedSRngs)
 
 EXPLICIT_INSTANTIATION(isce3::core::LUT2d<double>);
 EXPLICIT_INSTANTIATION(isce3::core::Poly2d);
@@ -41,6 +41,8 @@ typedef Eigen::Ref<isce3::core::EArray2D<unsigned char>> EArray2duc8;
  * \param[in]  invalidValue     invalid pixel fill value
  * \param[out] carrierPhaseRaster     pointer to output raster for the geocoded carrier phase
  * \param[out] flattenPhaseRaster     pointer to output raster for the geocoded flattening phase
+ * \param[in]  geo2rdrGridSpacing     spacing, in geo grid pixels, of the coarse control grid on which geo2rdr is solved before interpolating to every pixel (0 to solve geo2rdr for every pixel)
+ * \param[in]  geo2rdrGridTolerance   maximum interpolation residual, in radar grid pixels, before a cell of the geo2rdr control grid is solved exactly
  */
 template<typename AzRgFunc = isce3::core::Poly2d>
 void geocodeSlc(isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,
@@ -64,7 +66,9 @@ void geocodeSlc(isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,
             std::complex<float>(std::numeric_limits<float>::quiet_NaN(),
                                 std::numeric_limits<float>::quiet_NaN()),
         isce3::io::Raster* carrierPhaseRaster = nullptr,
-        isce3::io::Raster* flattenPhaseRaster = nullptr);
+        isce3::io::Raster* flattenPhaseRaster = nullptr,
+        const int geo2rdrGridSpacing = 0,
+        const double geo2rdrGridTolerance = 1e-3);
 
 /**
  * Geocode SLC to a slice of a given geogrid
@@ -94,6 +98,8 @@ void geocodeSlc(isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,
  * \param[in]  invalidValue     invalid pixel fill value
  * \param[out] carrierPhaseRaster     pointer to output raster for the geocoded carrier phase
  * \param[out] flattenPhaseRaster     pointer to output raster for the geocoded flattening phase
+ * \param[in]  geo2rdrGridSpacing     spacing, in geo grid pixels, of the coarse control grid on which geo2rdr is solved before interpolating to every pixel (0 to solve geo2rdr for every pixel)
+ * \param[in]  geo2rdrGridTolerance   maximum interpolation residual, in radar grid pixels, before a cell of the geo2rdr control grid is solved exactly
  */
 template<typename AzRgFunc = isce3::core::Poly2d>
 void geocodeSlc(isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,
@@ -118,7 +124,9 @@ void geocodeSlc(isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,
             std::complex<float>(std::numeric_limits<float>::quiet_NaN(),
                                 std::numeric_limits<float>::quiet_NaN()),
         isce3::io::Raster* carrierPhaseRaster = nullptr,
-        isce3::io::Raster* flattenPhaseRaster = nullptr);
+        isce3::io::Raster* flattenPhaseRaster = nullptr,
+        const int geo2rdrGridSpacing = 0,
+        const double geo2rdrGridTolerance = 1e-3);
 
 
 /**
@@ -159,6 +167,13 @@ void geocodeSlc(isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,
  * \param[in]  invalidValue     invalid pixel fill value
  * \param[in]  subswaths        subswath mask representing valid portions of a
  *                              swath
+ * \param[in]  geo2rdrGridSpacing   spacing, in geo grid pixels, of the coarse
+ *                              control grid on which geo2rdr is solved
+ *                              before interpolating to every pixel (0 to
+ *                              solve geo2rdr for every pixel)
+ * \param[in]  geo2rdrGridTolerance maximum interpolation residual, in radar
+ *                              grid pixels, before a cell of the geo2rdr
+ *                              control grid is solved exactly
  */
 template<typename AzRgFunc = isce3::core::Poly2d>
 void geocodeSlc(
@@ -188,6 +203,165 @@ void geocodeSlc(
         const std::complex<float> invalidValue =
             std::complex<float>(std::numeric_limits<float>::quiet_NaN(),
                                 std::numeric_limits<float>::quiet_NaN()),
-        const isce3::product::SubSwaths* subswaths = nullptr);
+        const isce3::product::SubSwaths* subswaths = nullptr,
+        const int geo2rdrGridSpacing = 0,
+        const double geo2rdrGridTolerance = 1e-3);
+
+/**
+ * Geocode multiple radar SLC rasters that share a common radar grid to a
+ * given geogrid, one geogrid block at a time.
+ *
+ * The geogrid is split into blocks of linesPerBlock x columnsPerBlock
+ * pixels. For each block the bounding box of its footprint in the radar
+ * grid is computed and the corresponding radar block of every input raster
+ * is geocoded with the multi-array geocodeSlc overload above. Blocks
+ * without radar data are skipped and left unwritten. Blocks are processed
+ * as a software pipeline: while one block is geocoded, the radar data of
+ * the next one is prefetched and the previous one is written by background
+ * threads. Reads of the input rasters and writes of the output rasters are
+ * serialized so that HDF5 backed input/output rasters can be used with a
+ * non thread-safe HDF5 library. The DEM raster is read by the processing
+ * thread concurrently with this I/O and is not covered by the
+ * serialization.
+ *
+ * \tparam[in]  AzRgFunc  2-D real-valued function of azimuth and range
+ *
+ * \param[out] outputRasters    output rasters of the geocoded SLC, one
+ *                              per input raster
+ * \param[out] maskRaster       optional output raster of the geocoded mask
+ * \param[in]  inputRasters     input rasters of the SLC in radar coordinates
+ * \param[in]  demRaster        raster of the DEM
+ * \param[in]  radarGrid        radar grid parameters of the input rasters
+ * \param[in]  geoGrid          geo grid parameters of the output rasters
+ * \param[in]  orbit            orbit
+ * \param[in]  nativeDoppler    2D LUT Doppler of the SLC image
+ * \param[in]  imageGridDoppler 2D LUT Doppler of the image grid
+ * \param[in]  ellipsoid        ellipsoid object
+ * \param[in]  thresholdGeo2rdr threshold for geo2rdr computations
+ * \param[in]  numiterGeo2rdr   maximum number of iterations for Geo2rdr convergence
+ * \param[in]  linesPerBlock    number of geogrid lines in each block
+ * \param[in]  columnsPerBlock  number of geogrid columns in each block
+ * \param[in]  flatten          flag to flatten the geocoded SLC
+ * \param[in]  reramp           flag to reramp the geocoded SLC
+ * \param[in]  azCarrier        azimuth carrier phase of the SLC data, in radians, as a function of azimuth and range
+ * \param[in]  rgCarrier        range carrier phase of the SLC data, in radians, as a function of azimuth and range
+ * \param[in]  azTimeCorrection geo2rdr azimuth additive correction, in seconds, as a function of azimuth and range
+ * \param[in]  sRangeCorrection geo2rdr slant range additive correction, in meters, as a function of azimuth and range
+ * \param[in]  flattenWithCorrectedSRng  flag to indicate whether geo2rdr slant-range additive values should be used for phase flattening
+ * \param[in]  invalidValue     invalid pixel fill value
+ * \param[in]  subswaths        subswath mask representing valid portions of a
+ *                              swath
+ * \param[in]  mantissaBits     number of mantissa bits of the real and
+ *                              imaginary parts of the geocoded SLC to keep
+ *                              (the others are zeroed to improve
+ *                              compression), or 0 to keep all of them
+ * \param[in]  geogridExpansionThreshold  maximum number of outward
+ *                              expansions of a block's corners to search for
+ *                              geo2rdr convergence when computing its radar
+ *                              bounding box
+ * \param[in]  geo2rdrGridSpacing   spacing, in geo grid pixels, of the coarse
+ *                              control grid on which geo2rdr is solved
+ *                              before interpolating to every pixel (0 to
+ *                              solve geo2rdr for every pixel)
+ * \param[in]  geo2rdrGridTolerance maximum interpolation residual, in radar
+ *                              grid pixels, before a cell of the geo2rdr
+ *                              control grid is solved exactly
+ */
+template<typename AzRgFunc = isce3::core::Poly2d>
+void geocodeSlcBlocks(
+        const std::vector<isce3::io::Raster*>& outputRasters,
+        isce3::io::Raster* maskRaster,
+        const std::vector<isce3::io::Raster*>& inputRasters,
+        isce3::io::Raster& demRaster,
+        const isce3::product::RadarGridParameters& radarGrid,
+        const isce3::product::GeoGridParameters& geoGrid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& nativeDoppler,
+        const isce3::core::LUT2d<double>& imageGridDoppler,
+        const isce3::core::Ellipsoid& ellipsoid,
+        const double& thresholdGeo2rdr, const int& numiterGeo2rdr,
+        const size_t linesPerBlock, const size_t columnsPerBlock,
+        const bool flatten = true,
+        const bool reramp = true,
+        const AzRgFunc& azCarrier = AzRgFunc(),
+        const AzRgFunc& rgCarrier = AzRgFunc(),
+        const isce3::core::LUT2d<double>& azTimeCorrection = {},
+        const isce3::core::LUT2d<double>& sRangeCorrection = {},
+        const bool flattenWithCorrectedSRng = false,
+        const std::complex<float> invalidValue =
+            std::complex<float>(std::numeric_limits<float>::quiet_NaN(),
+                                std::numeric_limits<float>::quiet_NaN()),
+        const isce3::product::SubSwaths* subswaths = nullptr,
+        const int mantissaBits = 0,
+        const int geogridExpansionThreshold = 100,
+        const int geo2rdrGridSpacing = 0,
+        const double geo2rdrGridTolerance = 1e-3);
+
+/**
+ * Interpolate radar data block to geo data block, then add back range and
+ * azimuth phase carrier and simultaneously flatten the geocoded SLC
+ *
+ * The separable sinc kernel is applied directly to the radar data without
+ * copying a chip per output pixel: each of the kernel rows is first
+ * interpolated in range with the range weights, and the row results are
+ * summed with the azimuth weights. The Doppler demodulation of the rows,
+ * the Doppler add-back at the output pixel and the carrier and flattening
+ * phases are folded into the azimuth weights, so that a single complex
+ * exponential recurrence replaces the per-row sincos of the chip deramp.
+ *
+ * Pixels with invalid (NaN) indices, too close to the edges of the radar
+ * block for the kernel, or outside of the native Doppler LUT are left
+ * unchanged.
+ *
+ * \tparam[in]  AzRgFunc  2-D real-valued function of azimuth and range
+ *
+ * \param[in]  rdrDataBlock      block of SLC data in radar coordinates basebanded in range direction
+ * \param[out] geoDataBlock      block of data in geo coordinates
+ * \param[out] carrierPhaseBlock output geocoded carrier phase, only written if its shape matches geoDataBlock
+ * \param[out] flattenPhaseBlock output geocoded flattening phase, only written if its shape matches geoDataBlock
+ * \param[in]  rangeIndices      range (radar-coordinates x) index of the pixels in geo-grid
+ * \param[in]  azimuthIndices    azimuth (radar-coordinates y) index of the pixels in geo-grid
+ * \param[in]  azimuthFirstLine  line index of the first sample of the block
+ * \param[in]  rangeFirstPixel   pixel index of the first sample of the block
+ * \param[in]  sincInterp        sinc interpolator of SINC_LEN taps whose
+ *                               kernel table is used
+ * \param[in]  radarGrid         RadarGridParameters of radar data
+ * \param[in]  nativeDopplerLUT  native doppler of SLC image
+ * \param[in]  azCarrierPhase    azimuth carrier phase of the SLC data, in radians, as a function of azimuth and range
+ * \param[in]  rgCarrierPhase    range carrier phase of the SLC data, in radians, as a function of azimuth and range
+ * \param[in]  flatten           flag to flatten the geocoded SLC
+ * \param[in]  reramp            flag to reramp the geocoded SLC
+ * \param[in]  flattenWithCorrectedSRng  flag to use corrected slant range for flattening
+ * \param[in]  uncorrectedSRngs  slant range without correction, in meters, indexed
+ *                               by geo-grid indices
+ */
+template<typename AzRgFunc>
+void interpolateRerampAndFlatten(
+        const EArray2dc64 rdrDataBlock,
+        EArray2dc64 geoDataBlock,
+        EArray2df64 carrierPhaseBlock,
+        EArray2df64 flattenPhaseBlock,
+        const isce3::core::Matrix<double>& rangeIndices,
+        const isce3::core::Matrix<double>& azimuthIndices,
+        const size_t azimuthFirstLine, const size_t rangeFirstPixel,
+        const isce3::core::Sinc2dInterpolator<std::complex<float>>& sincInterp,
+        const isce3::product::RadarGridParameters& radarGrid,
+        const isce3::core::LUT2d<double>& nativeDopplerLUT,
+        const AzRgFunc& azCarrierPhase, const AzRgFunc& rgCarrierPhase,
+        const bool flatten, const bool reramp,
+        const bool flattenWithCorrectedSRng,
+        const isce3::core::Matrix<double>& uncorrectedSRngs);
+
+/**
+ * Zero out the least significant mantissa bits of the real and imaginary
+ * parts of a block of complex data in place.
+ *
+ * \param[in,out] data          block of data
+ * \param[in]     size          number of elements of the block
+ * \param[in]     mantissaBits  number of mantissa bits to keep, in
+ *                              [1, 23]; 23 leaves the data unchanged
+ */
+void truncateMantissa(std::complex<float>* data, size_t size,
+                      int mantissaBits);
 
 }} // namespace isce3::geocode
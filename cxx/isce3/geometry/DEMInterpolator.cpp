@@ -8,9 +8,12 @@
 #include <cmath>
 #include "DEMInterpolator.h"
 
+#include <isce3/core/EMatrix.h>
 #include <isce3/core/Projections.h>
 #include <isce3/io/Raster.h>
 
+#include "DEMTileCache.h"
+
 /** Set EPSG code for input DEM */
 void isce3::geometry::DEMInterpolator::epsgCode(int epsgcode) {
     _epsgcode = epsgcode;
@@ -318,6 +321,7 @@ isce3::error::ErrorCode isce3::geometry::DEMInterpolator::loadDEM(
     }
 
     // Resize DEM array
+    _tileCache.reset();
     _dem.resize(length, width);
 
     if (!flag_dem_file_discontinuity) {
@@ -482,6 +486,7 @@ loadDEM(isce3::io::Raster & demRaster, const int dem_raster_band) {
     _deltay = delta_y;
 
     // Resize memory
+    _tileCache.reset();
     _dem.resize(length, width);
 
     // Read in the DEM
@@ -499,16 +504,61 @@ loadDEM(isce3::io::Raster & demRaster, const int dem_raster_band) {
 }
 
 
+// Set up lazy DEM access
+/** @param[in] demRaster input DEM raster
+  * @param[in] dem_raster_band DEM raster band (starting from 1)
+  * @param[in] tile_size Tile width and length in pixels
+  * @param[in] max_cache_bytes Memory cap of the tile cache in bytes
+  *
+  * Covers the entire DEM like loadDEM(demRaster, dem_raster_band) without
+  * reading it */
+void isce3::geometry::DEMInterpolator::
+loadDEMTiled(isce3::io::Raster & demRaster, const int dem_raster_band,
+             size_t tile_size, size_t max_cache_bytes) {
+
+    // Get original GeoTransform using raster
+    double geotransform[6];
+    demRaster.getGeoTransform(geotransform);
+    const double delta_y = geotransform[5];
+    const double delta_x = geotransform[1];
+
+    //Initialize projection
+    int epsgcode = demRaster.getEPSG();
+    _epsgcode = epsgcode;
+    _proj = isce3::core::makeProjection(epsgcode);
+
+    // Use center of pixel as starting coordinate
+    _xstart = geotransform[0] + 0.5 * delta_x;
+    _ystart = geotransform[3] + 0.5 * delta_y;
+    _deltax = delta_x;
+    _deltay = delta_y;
+    _width = demRaster.width();
+    _length = demRaster.length();
+
+    // Release any DEM in memory and set up the tile cache
+    _dem.resize(0, 0);
+    _tileCache = std::make_shared<DEMTileCache>(demRaster, dem_raster_band,
+                                                tile_size, max_cache_bytes);
+
+    // Initialize internal interpolator
+    _interp = std::unique_ptr<isce3::core::Interpolator<float>>(isce3::core::createInterpolator<float>(_interpMethod));
+
+    // Indicate we have loaded a valid raster
+    _haveRaster = true;
+    _haveStats = false;
+}
+
+
 // Debugging output
 void isce3::geometry::DEMInterpolator::
 declare() const {
     pyre::journal::info_t info("isce.core.DEMInterpolator");
     info << "Actual DEM bounds used:" << pyre::journal::newline
          << "Top Left: " << _xstart << " " << _ystart << pyre::journal::newline
-         << "Bottom Right: " << _xstart + _deltax * (_dem.width() - 1) << " "
-         << _ystart + _deltay * (_dem.length() - 1) << " " << pyre::journal::newline
+         << "Bottom Right: " << _xstart + _deltax * (width() - 1) << " "
+         << _ystart + _deltay * (length() - 1) << " " << pyre::journal::newline
          << "Spacing: " << _deltax << " " << _deltay << pyre::journal::newline
-         << "Dimensions: " << _dem.width() << " " << _dem.length() << pyre::journal::endl;
+         << "Dimensions: " << width() << " " << length() << pyre::journal::endl;
 }
 
 void isce3::geometry::DEMInterpolator::
@@ -524,31 +574,36 @@ computeMinMaxMeanHeight(float &minValue, float &maxValue, float &meanValue) {
     if (_haveRaster and not _haveStats) {
         info << "Computing DEM statistics" << pyre::journal::newline;
 
-        minValue = std::numeric_limits<float>::max();
-        maxValue = -std::numeric_limits<float>::max();
-        double sum = 0.0;
-        auto n_valid = _dem.length() * _dem.width();
-        // loop over all values in DEM raster
+        if (_tileCache) {
+            // without valid pixels the stats stay at the reference height
+            _tileCache->computeStats(minValue, maxValue, meanValue);
+        } else {
+            minValue = std::numeric_limits<float>::max();
+            maxValue = -std::numeric_limits<float>::max();
+            double sum = 0.0;
+            auto n_valid = _dem.length() * _dem.width();
+            // loop over all values in DEM raster
 #pragma omp parallel for collapse(2) reduction(min : minValue)  \
-                                     reduction(max : maxValue)  \
-                                     reduction(+ : sum)         \
-                                     reduction(- : n_valid)
-        for (size_t i = 0; i < _dem.length(); ++i) {
-            for (size_t j = 0; j < _dem.width(); ++j) {
-                float value = _dem(i,j);
-
-                // skip NaN and decrement denominator
-                if (std::isnan(value)) {
-                    n_valid--;
-                    continue;
-                }
+                                         reduction(max : maxValue)  \
+                                         reduction(+ : sum)         \
+                                         reduction(- : n_valid)
+            for (size_t i = 0; i < _dem.length(); ++i) {
+                for (size_t j = 0; j < _dem.width(); ++j) {
+                    float value = _dem(i,j);
+
+                    // skip NaN and decrement denominator
+                    if (std::isnan(value)) {
+                        n_valid--;
+                        continue;
+                    }
 
-                maxValue = std::max(value, maxValue);
-                minValue = std::min(value, minValue);
-                sum += value;
+                    maxValue = std::max(value, maxValue);
+                    minValue = std::min(value, minValue);
+                    sum += value;
+                }
             }
+            meanValue = sum / n_valid;
         }
-        meanValue = sum / n_valid;
 
         // Store updated statistics
         _haveStats = true;
@@ -649,15 +704,42 @@ interpolateXY(double x, double y) const {
     const int icol = int(std::floor(col));
 
     // If outside bounds, return reference height
-    if (irow < 2 || irow >= int(_dem.length() - 1))
+    if (irow < 2 || irow >= int(length() - 1))
         return _refHeight;
-    if (icol < 2 || icol >= int(_dem.width() - 1))
+    if (icol < 2 || icol >= int(width() - 1))
         return _refHeight;
 
+    if (_tileCache) {
+        return interpolateTiled(col, row);
+    }
+
     // Call interpolator and return value
     return _interp->interpolate(col, row, _dem);
 }
 
+/** @param[in] col Column of interpolation point.
+  * @param[in] row Row of interpolation point.
+  *
+  * Copy the pixels around the interpolation point from the tile cache into
+  * a small chip and interpolate the chip */
+double isce3::geometry::DEMInterpolator::
+interpolateTiled(double col, double row) const {
+
+    // The chip spans rows/columns floor(x) - radius + 1 to floor(x) + radius,
+    // enough for the kernels of all interpolators
+    const int radius = (_interpMethod == isce3::core::SINC_METHOD ||
+                        _interpMethod == isce3::core::BIQUINTIC_METHOD) ? 5 : 2;
+    const int size = 2 * radius;
+    const long icol = static_cast<long>(std::floor(col)) - radius + 1;
+    const long irow = static_cast<long>(std::floor(row)) - radius + 1;
+
+    float chip[100];
+    _tileCache->getBlock(chip, icol, irow, size, size);
+
+    const Eigen::Map<const isce3::core::EArray2D<float>> z(chip, size, size);
+    return _interp->interpolate(col - icol, row - irow, z);
+}
+
 void isce3::geometry::DEMInterpolator::
 validateStatsAccess(const std::string& method) const {
     if (not _haveStats) {
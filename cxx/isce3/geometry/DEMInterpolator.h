@@ -70,6 +70,24 @@ class isce3::geometry::DEMInterpolator {
         void loadDEM(isce3::io::Raster &demRaster,
                      const int dem_raster_band = 1);
 
+        /** Set up lazy, tiled access to an entire DEM with a supported
+        * projection
+        * @param[in]  dem_raster              DEM raster
+        * @param[in]  dem_raster_band         DEM raster band (starting from 1)
+        * @param[in]  tile_size               Tile width and length in pixels
+        * @param[in]  max_cache_bytes         Memory cap of the tile cache
+        *
+        * No DEM data is read by this call. Tiles are read the first time an
+        * interpolation needs them and kept in a thread-safe LRU cache (see
+        * DEMTileCache) that is shared by all copies of this object. data()
+        * returns nullptr in this mode and computeMinMaxMeanHeight() returns
+        * approximate statistics of the entire DEM.
+        */
+        void loadDEMTiled(isce3::io::Raster &demRaster,
+                          const int dem_raster_band = 1,
+                          size_t tile_size = 512,
+                          size_t max_cache_bytes = 1UL << 30);
+
         // Print stats
         void declare() const;
 
@@ -122,6 +140,12 @@ class isce3::geometry::DEMInterpolator {
         /** Flag indicating whether a DEM raster has been loaded */
         bool haveRaster() const { return _haveRaster; }
 
+        /** Flag indicating whether the DEM is read lazily from a tile cache */
+        bool isTiled() const { return static_cast<bool>(_tileCache); }
+
+        /** Get tile cache of the DEM (null if the DEM is not tiled) */
+        std::shared_ptr<DEMTileCache> tileCache() const { return _tileCache; }
+
         /** Get reference height of interpolator */
         double refHeight() const { return _refHeight; }
         /** Set reference height of interpolator */
@@ -162,12 +186,16 @@ class isce3::geometry::DEMInterpolator {
         const float* data() const { return _dem.data(); }
 
         /** Get width of DEM data used for interpolation */
-        inline size_t width() const { return (_haveRaster ? _dem.width() : _width); }
+        inline size_t width() const {
+            return (_haveRaster and not _tileCache ? _dem.width() : _width);
+        }
         /** Set width of DEM data used for interpolation */
         inline void width(int width) { _width = width; }
 
         /** Get length of DEM data used for interpolation */
-        inline size_t length() const { return (_haveRaster ? _dem.length() : _length); }
+        inline size_t length() const {
+            return (_haveRaster and not _tileCache ? _dem.length() : _length);
+        }
         /** Set length of DEM data used for interpolation */
         inline void length(int length) { _length = length; }
 
@@ -206,10 +234,15 @@ class isce3::geometry::DEMInterpolator {
         std::shared_ptr<isce3::core::Interpolator<float>> _interp;
         // 2D array for storing DEM subset
         isce3::core::Matrix<float> _dem;
+        // Tile cache for lazy DEM access (replaces _dem if set)
+        std::shared_ptr<DEMTileCache> _tileCache;
         // Starting x/y for DEM subset and spacing
         double _xstart, _ystart, _deltax, _deltay;
         int _width, _length;
 
         // Check if stats are accessed before they're computed.
         void validateStatsAccess(const std::string& method) const;
+
+        // Interpolate at DEM row/column coordinates from the tile cache
+        double interpolateTiled(double col, double row) const;
 };
@@ -0,0 +1,213 @@
+#include "DEMTileCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <gdal_priv.h>
+
+#include <isce3/except/Error.h>
+#include <isce3/io/Raster.h>
+
+isce3::geometry::DEMTileCache::
+DEMTileCache(const isce3::io::Raster& raster, int band, size_t tileSize,
+             size_t maxBytes) :
+    DEMTileCache(raster.width(), raster.length(), nullptr, tileSize, maxBytes)
+{
+    _raster = std::make_shared<isce3::io::Raster>(raster);
+    _band = band;
+    _loader = [raster = _raster, band](float* block, size_t col0, size_t row0,
+                                       size_t blockWidth, size_t blockLength) {
+        raster->getBlock(block, col0, row0, blockWidth, blockLength, band);
+    };
+}
+
+isce3::geometry::DEMTileCache::
+DEMTileCache(size_t width, size_t length, Loader loader, size_t tileSize,
+             size_t maxBytes) :
+    _width {width},
+    _length {length},
+    _tileSize {tileSize},
+    _maxBytes {maxBytes},
+    _loader {std::move(loader)}
+{
+    if (width == 0 or length == 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "DEM dimensions must be positive");
+    }
+    if (tileSize == 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "DEM tile size must be positive");
+    }
+    _numTilesX = (width + tileSize - 1) / tileSize;
+}
+
+size_t isce3::geometry::DEMTileCache::numCachedTiles() const
+{
+    std::shared_lock<std::shared_mutex> lock(_cacheMutex);
+    return _tiles.size();
+}
+
+bool isce3::geometry::DEMTileCache::
+computeStats(float& minValue, float& maxValue, float& meanValue) const
+{
+    float min_value = std::numeric_limits<float>::max();
+    float max_value = -std::numeric_limits<float>::max();
+    double sum = 0.0;
+    size_t n_valid = 0;
+
+    auto accumulate = [&](const std::vector<float>& values, size_t n,
+                          int has_nodata, double nodata) {
+        for (size_t i = 0; i < n; ++i) {
+            const float value = values[i];
+            if (std::isnan(value) or
+                (has_nodata and value == static_cast<float>(nodata))) {
+                continue;
+            }
+            min_value = std::min(value, min_value);
+            max_value = std::max(value, max_value);
+            sum += value;
+            ++n_valid;
+        }
+    };
+
+    if (_raster) {
+        // Read a decimated copy of the DEM of at most stats_size pixels on
+        // each side (GDAL uses overviews when the raster has them)
+        const size_t stats_size = 1024;
+        const size_t step = (std::max(_width, _length) + stats_size - 1) /
+                            stats_size;
+        const size_t width = (_width + step - 1) / step;
+        const size_t length = (_length + step - 1) / step;
+        std::vector<float> values(width * length);
+
+        std::lock_guard<std::mutex> lock(_loadMutex);
+        GDALRasterBand* band = _raster->dataset()->GetRasterBand(_band);
+        int has_nodata = 0;
+        const double nodata = band->GetNoDataValue(&has_nodata);
+        const CPLErr status = band->RasterIO(GF_Read, 0, 0, _width, _length,
+                values.data(), width, length, GDT_Float32, 0, 0);
+        if (status != CE_None) {
+            throw isce3::except::GDALError(ISCE_SRCINFO(),
+                    "failed to read DEM for statistics");
+        }
+        accumulate(values, values.size(), has_nodata, nodata);
+    } else {
+        // Scan the DEM one row of tiles at a time
+        std::vector<float> rows(_width * _tileSize);
+        for (size_t row0 = 0; row0 < _length; row0 += _tileSize) {
+            const size_t numRows = std::min(_tileSize, _length - row0);
+            {
+                std::lock_guard<std::mutex> lock(_loadMutex);
+                _loader(rows.data(), 0, row0, _width, numRows);
+            }
+            accumulate(rows, numRows * _width, 0, 0.0);
+        }
+    }
+
+    if (n_valid == 0) {
+        return false;
+    }
+    minValue = min_value;
+    maxValue = max_value;
+    meanValue = sum / n_valid;
+    return true;
+}
+
+isce3::geometry::DEMTileCache::TileData
+isce3::geometry::DEMTileCache::_getTile(size_t tileIndex) const
+{
+    // Fast path: the tile is cached
+    {
+        std::shared_lock<std::shared_mutex> lock(_cacheMutex);
+        auto it = _tiles.find(tileIndex);
+        if (it != _tiles.end()) {
+            it->second->lastUse = ++_tick;
+            return it->second->data;
+        }
+    }
+
+    // Read the tile without holding the cache lock so that lookups of other
+    // tiles can proceed. Another thread may read the same tile concurrently,
+    // in which case the first one to be inserted is kept.
+    const size_t col0 = (tileIndex % _numTilesX) * _tileSize;
+    const size_t row0 = (tileIndex / _numTilesX) * _tileSize;
+    const size_t tileWidth = std::min(_tileSize, _width - col0);
+    const size_t tileLength = std::min(_tileSize, _length - row0);
+    auto data = std::make_shared<std::vector<float>>(tileWidth * tileLength);
+    {
+        std::lock_guard<std::mutex> lock(_loadMutex);
+        _loader(data->data(), col0, row0, tileWidth, tileLength);
+    }
+    ++_numLoads;
+
+    std::unique_lock<std::shared_mutex> lock(_cacheMutex);
+    auto it = _tiles.find(tileIndex);
+    if (it != _tiles.end()) {
+        it->second->lastUse = ++_tick;
+        return it->second->data;
+    }
+
+    // Evict the least recently used tiles until the new tile fits. Tiles
+    // still in use by other threads stay alive through their shared_ptr.
+    const size_t tileBytes = data->size() * sizeof(float);
+    while (not _tiles.empty() and _cachedBytes + tileBytes > _maxBytes) {
+        auto lru = std::min_element(_tiles.begin(), _tiles.end(),
+                [](const auto& a, const auto& b) {
+                    return a.second->lastUse < b.second->lastUse;
+                });
+        _cachedBytes -= lru->second->data->size() * sizeof(float);
+        _tiles.erase(lru);
+    }
+
+    auto tile = std::make_unique<Tile>();
+    tile->data = data;
+    tile->lastUse = ++_tick;
+    _tiles.emplace(tileIndex, std::move(tile));
+    _cachedBytes += tileBytes;
+    return data;
+}
+
+void isce3::geometry::DEMTileCache::
+getBlock(float* block, long col0, long row0, size_t blockWidth,
+         size_t blockLength) const
+{
+    auto clamp = [](long i, size_t n) {
+        return static_cast<size_t>(std::min(std::max(i, 0L),
+                                            static_cast<long>(n) - 1));
+    };
+
+    // Range of tiles covering the (clamped) block
+    const size_t firstCol = clamp(col0, _width);
+    const size_t lastCol = clamp(col0 + long(blockWidth) - 1, _width);
+    const size_t firstRow = clamp(row0, _length);
+    const size_t lastRow = clamp(row0 + long(blockLength) - 1, _length);
+
+    for (size_t ty = firstRow / _tileSize; ty <= lastRow / _tileSize; ++ty) {
+        for (size_t tx = firstCol / _tileSize; tx <= lastCol / _tileSize;
+             ++tx) {
+
+            const TileData tile = _getTile(ty * _numTilesX + tx);
+            const size_t tileCol0 = tx * _tileSize;
+            const size_t tileRow0 = ty * _tileSize;
+            const size_t tileWidth = std::min(_tileSize, _width - tileCol0);
+
+            // Fill the pixels of the block whose clamped position falls in
+            // this tile
+            for (size_t i = 0; i < blockLength; ++i) {
+                const size_t row = clamp(row0 + long(i), _length);
+                if (row / _tileSize != ty) {
+                    continue;
+                }
+                const float* tileRow =
+                        tile->data() + (row - tileRow0) * tileWidth;
+                for (size_t j = 0; j < blockWidth; ++j) {
+                    const size_t col = clamp(col0 + long(j), _width);
+                    if (col / _tileSize == tx) {
+                        block[i * blockWidth + j] = tileRow[col - tileCol0];
+                    }
+                }
+            }
+        }
+    }
+}
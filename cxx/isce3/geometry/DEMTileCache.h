@@ -0,0 +1,123 @@
+#pragma once
+
+#include "forward.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <isce3/io/forward.h>
+
+/** Thread-safe cache of fixed-size tiles of a DEM raster.
+ *
+ * Tiles are read from the raster the first time one of their pixels is
+ * requested and kept in memory until the total size of the cached tiles
+ * exceeds a memory cap, at which point the least recently used tiles are
+ * evicted. Lookups of cached tiles only take a shared lock, so the cache
+ * can be used concurrently from OpenMP workers. Raster reads are
+ * serialized. */
+class isce3::geometry::DEMTileCache {
+
+    public:
+        /** Function reading a block of the DEM
+         *
+         * Called with the output buffer, the column and row of the first
+         * pixel, and the width and length of the block. */
+        using Loader = std::function<void(float*, size_t, size_t, size_t,
+                                          size_t)>;
+
+        /** Constructor from a DEM raster
+         * @param[in] raster    DEM raster (a reference to the underlying
+         *                      dataset is kept by the cache)
+         * @param[in] band      Raster band (starting from 1)
+         * @param[in] tileSize  Tile width and length in pixels
+         * @param[in] maxBytes  Memory cap of the cached tiles in bytes
+         */
+        DEMTileCache(const isce3::io::Raster& raster, int band = 1,
+                     size_t tileSize = 512, size_t maxBytes = 1UL << 30);
+
+        /** Constructor from a block loader
+         * @param[in] width     DEM width in pixels
+         * @param[in] length    DEM length in pixels
+         * @param[in] loader    Function reading a block of the DEM (calls
+         *                      are serialized)
+         * @param[in] tileSize  Tile width and length in pixels
+         * @param[in] maxBytes  Memory cap of the cached tiles in bytes
+         */
+        DEMTileCache(size_t width, size_t length, Loader loader,
+                     size_t tileSize = 512, size_t maxBytes = 1UL << 30);
+
+        /** Get DEM width */
+        size_t width() const { return _width; }
+        /** Get DEM length */
+        size_t length() const { return _length; }
+        /** Get tile width and length */
+        size_t tileSize() const { return _tileSize; }
+        /** Get memory cap of the cached tiles in bytes */
+        size_t maxBytes() const { return _maxBytes; }
+
+        /** Get number of tiles currently cached */
+        size_t numCachedTiles() const;
+        /** Get number of tiles read from the raster so far */
+        size_t numLoads() const { return _numLoads; }
+
+        /** Compute min, max and mean DEM height, ignoring NaN and no-data
+         * pixels.
+         *
+         * For a raster, the statistics are approximate: they are computed
+         * from a copy of the DEM decimated to at most 1024 pixels on each
+         * side (read from overviews when available). For a block loader,
+         * the whole DEM is scanned without going through the cache.
+         *
+         * @returns False if the DEM has no valid pixel, in which case the
+         *          outputs are left unchanged */
+        bool computeStats(float& minValue, float& maxValue,
+                          float& meanValue) const;
+
+        /** Read a block of the DEM into a row-major buffer
+         *
+         * Pixels outside of the DEM are replaced by the nearest edge pixel,
+         * so that the block may extend past the DEM boundaries.
+         *
+         * @param[out] block    Buffer of blockWidth x blockLength pixels
+         * @param[in]  col0     Column of the first pixel (may be negative)
+         * @param[in]  row0     Row of the first pixel (may be negative)
+         * @param[in]  blockWidth   Block width
+         * @param[in]  blockLength  Block length
+         */
+        void getBlock(float* block, long col0, long row0, size_t blockWidth,
+                      size_t blockLength) const;
+
+    private:
+        using TileData = std::shared_ptr<const std::vector<float>>;
+
+        struct Tile {
+            TileData data;
+            // Tick of the last access, for LRU eviction
+            mutable std::atomic<size_t> lastUse;
+        };
+
+        size_t _width, _length, _tileSize, _maxBytes;
+        size_t _numTilesX;
+        Loader _loader;
+
+        // Raster the tiles are read from (null for a custom loader)
+        std::shared_ptr<isce3::io::Raster> _raster;
+        int _band = 1;
+
+        // Cached tiles by index (row-major over the tile grid)
+        mutable std::unordered_map<size_t, std::unique_ptr<Tile>> _tiles;
+        mutable size_t _cachedBytes = 0;
+        mutable std::shared_mutex _cacheMutex;
+        mutable std::mutex _loadMutex;
+        mutable std::atomic<size_t> _tick {0};
+        mutable std::atomic<size_t> _numLoads {0};
+
+        // Get a tile, loading it if needed
+        TileData _getTile(size_t tileIndex) const;
+};
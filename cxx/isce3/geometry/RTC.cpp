@@ -3,6 +3,7 @@
 
 #include "RTC.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cmath>
@@ -574,10 +575,117 @@ void areaProjIntegrateSegment(double y1, double y2, double x1, double x2,
     }
 }
 
+/*
+Private accumulator of RTC areas over a window of the radar grid.
+
+Facet areas are scattered into the accumulator of the block (or chunk of
+DEM lines) being processed rather than directly into the shared radar-grid
+arrays, so that no atomic updates are required. The window starts empty and
+grows on demand to cover the radar-grid footprint of the facets, with a halo
+so that neighboring facets seldom trigger a reallocation. Accumulators are
+merged into the radar-grid arrays in block order, which makes the results
+independent of thread scheduling.
+*/
+class _RtcAreaAccumulator {
+public:
+    _RtcAreaAccumulator(int length, int width, bool flag_beta,
+            bool flag_sigma) :
+        _length(length),
+        _width(width),
+        _flag_beta(flag_beta),
+        _flag_sigma(flag_sigma)
+    {}
+
+    bool hasBeta() const { return _flag_beta; }
+    bool hasSigma() const { return _flag_sigma; }
+
+    /*
+    Make sure the window covers radar-grid lines y_min to y_max and
+    columns x_min to x_max (inclusive, clipped to the radar grid)
+    */
+    void include(int y_min, int y_max, int x_min, int x_max)
+    {
+        y_min = std::max(y_min, 0);
+        x_min = std::max(x_min, 0);
+        y_max = std::min(y_max, _length - 1);
+        x_max = std::min(x_max, _width - 1);
+        if (y_min > y_max || x_min > x_max)
+            return;
+
+        const int y_end = _y0 + static_cast<int>(_gamma.rows());
+        const int x_end = _x0 + static_cast<int>(_gamma.cols());
+        if (_gamma.size() > 0 && y_min >= _y0 && y_max < y_end &&
+                x_min >= _x0 && x_max < x_end)
+            return;
+
+        // new window: union with the current window plus a halo
+        if (_gamma.size() > 0) {
+            y_min = std::min(y_min, _y0);
+            x_min = std::min(x_min, _x0);
+            y_max = std::max(y_max, y_end - 1);
+            x_max = std::max(x_max, x_end - 1);
+        }
+        const int halo = AREA_PROJECTION_WINDOW_HALO;
+        const int new_y0 = std::max(y_min - halo, 0);
+        const int new_x0 = std::max(x_min - halo, 0);
+        const int new_length = std::min(y_max + halo, _length - 1) - new_y0 + 1;
+        const int new_width = std::min(x_max + halo, _width - 1) - new_x0 + 1;
+
+        _grow(_gamma, new_y0, new_x0, new_length, new_width);
+        if (_flag_beta)
+            _grow(_beta, new_y0, new_x0, new_length, new_width);
+        if (_flag_sigma)
+            _grow(_sigma, new_y0, new_x0, new_length, new_width);
+        _y0 = new_y0;
+        _x0 = new_x0;
+    }
+
+    // Accessors in radar-grid coordinates (must be within the window)
+    float& gamma(int y, int x) { return _gamma(y - _y0, x - _x0); }
+    float& beta(int y, int x) { return _beta(y - _y0, x - _x0); }
+    float& sigma(int y, int x) { return _sigma(y - _y0, x - _x0); }
+
+    // Add the accumulated areas to the radar-grid arrays
+    void mergeInto(isce3::core::Matrix<float>& out_gamma_array,
+            isce3::core::Matrix<float>& out_beta_array,
+            isce3::core::Matrix<float>& out_sigma_array) const
+    {
+        if (_gamma.size() == 0)
+            return;
+        const int length = _gamma.rows();
+        const int width = _gamma.cols();
+        out_gamma_array.block(_y0, _x0, length, width) += _gamma;
+        if (_flag_beta)
+            out_beta_array.block(_y0, _x0, length, width) += _beta;
+        if (_flag_sigma)
+            out_sigma_array.block(_y0, _x0, length, width) += _sigma;
+    }
+
+private:
+    // Extra lines/columns allocated around the requested window
+    static constexpr int AREA_PROJECTION_WINDOW_HALO = 32;
+
+    int _length, _width;
+    bool _flag_beta, _flag_sigma;
+
+    // Radar-grid position of the first element of the window
+    int _y0 = 0, _x0 = 0;
+    isce3::core::Matrix<float> _gamma, _beta, _sigma;
+
+    void _grow(isce3::core::Matrix<float>& array, int new_y0, int new_x0,
+            int new_length, int new_width) const
+    {
+        isce3::core::Matrix<float> new_array(new_length, new_width);
+        new_array.fill(0);
+        if (array.size() > 0)
+            new_array.block(_y0 - new_y0, _x0 - new_x0, array.rows(),
+                    array.cols()) = array;
+        array.swap(new_array);
+    }
+};
+
 void _addArea(double gamma_naught_area, double sigma_naught_area,
-        double beta_naught_area, isce3::core::Matrix<float>& out_gamma_array,
-        isce3::core::Matrix<float>& out_beta_array,
-        isce3::core::Matrix<float>& out_sigma_array,
+        double beta_naught_area, _RtcAreaAccumulator& area_accumulator,
         int length, int width, int x_min, int y_min, int size_x, int size_y,
         isce3::core::Matrix<double>& w_arr, double nlooks,
         isce3::core::Matrix<double>& w_arr_out, double& nlooks_out,
@@ -606,18 +714,13 @@ void _addArea(double gamma_naught_area, double sigma_naught_area,
                 continue;
 
             w /= nlooks - nlooks_out;
-            _Pragma("omp atomic")
-                out_gamma_array(y, x) += w * gamma_naught_area;
+            area_accumulator.gamma(y, x) += w * gamma_naught_area;
 
-            if (out_beta_array.data() != nullptr) {
-                _Pragma("omp atomic")
-                    out_beta_array(y, x) += w * beta_naught_area;
-            }
+            if (area_accumulator.hasBeta())
+                area_accumulator.beta(y, x) += w * beta_naught_area;
 
-            if (out_sigma_array.data() != nullptr) {
-                _Pragma("omp atomic")
-                    out_sigma_array(y, x) += w * sigma_naught_area;
-            }
+            if (area_accumulator.hasSigma())
+                area_accumulator.sigma(y, x) += w * sigma_naught_area;
 
         }
 }
@@ -771,207 +874,218 @@ void computeRtcBilinearDistribution(isce3::io::Raster& dem_raster,
         getDemCoords = getDemCoordsDiffEpsg;
     }
 
-    // Loop over DEM facets
-    _Pragma("omp parallel for schedule(dynamic)")
-        for (size_t ii = 0; ii < imax; ++ii)
-    {
-        double a = radar_grid.sensingMid();
-        double r = radar_grid.midRange();
-
-        // The inner loop is not parallelized in order to keep the previous
-        // solution from geo2rdr as the initial guess for the next call to
-        // geo2rdr.
-        for (size_t jj = 0; jj < jmax; ++jj) {
-            _Pragma("omp atomic") numdone++;
-
-            if (numdone % progress_block == 0)
-                _Pragma("omp critical")
-                    printf("\rRTC progress: %d%%",
-                        (int) ((numdone * 1e2 / imax) / jmax)),
-                        fflush(stdout);
-            // Central DEM coordinates of facets
-            const double dem_ymid = geogrid.startY() + geogrid.spacingY() *
-                                                               (0.5 + ii) /
-                                                               upsample_factor;
-            const double dem_xmid = geogrid.startX() + geogrid.spacingX() *
-                                                               (0.5 + jj) /
-                                                               upsample_factor;
-
-            const Vec3 inputDEM =
-                    getDemCoords(dem_xmid, dem_ymid, dem_interp, proj.get());
-
-            // Compute facet-central LLH vector
-            const Vec3 inputLLH = dem_interp.proj()->inverse(inputDEM);
-            // Should incorporate check on return status here
-            int converged = geo2rdr(inputLLH, ellps, orbit, input_dop, a, r,
-                    radar_grid.wavelength(), side, 1e-8, 100, 1e-8);
-            if (!converged)
-                continue;
-
-            float azpix = (a - start) / pixazm;
-            float ranpix = (r - r0) / dr;
-
-            // Establish bounds for bilinear weighting model
-            const int x1 = (int) std::floor(ranpix);
-            const int x2 = x1 + 1;
-            const int y1 = (int) std::floor(azpix);
-            const int y2 = y1 + 1;
+    /*
+    Loop over DEM facets. DEM lines are processed in chunks of fixed length,
+    each accumulating its areas into a private radar-grid window that is
+    merged into the output arrays in chunk order, so that results do not
+    depend on the number of threads or on scheduling
+    */
+    const size_t chunk_length = 16;
+    const size_t nchunks = (imax + chunk_length - 1) / chunk_length;
+    isce3::core::Matrix<float> out_beta_array;
+
+    _Pragma("omp parallel for ordered schedule(dynamic)")
+    for (size_t chunk = 0; chunk < nchunks; ++chunk) {
+        _RtcAreaAccumulator area_accumulator(radar_grid.length(),
+                radar_grid.width(), false, flag_compute_area_sigma_separately);
+        const size_t ii_end = std::min(imax, (chunk + 1) * chunk_length);
+
+        for (size_t ii = chunk * chunk_length; ii < ii_end; ++ii) {
+            double a = radar_grid.sensingMid();
+            double r = radar_grid.midRange();
+
+            // The inner loop is not parallelized in order to keep the previous
+            // solution from geo2rdr as the initial guess for the next call to
+            // geo2rdr.
+            for (size_t jj = 0; jj < jmax; ++jj) {
+                _Pragma("omp atomic") numdone++;
+
+                if (numdone % progress_block == 0)
+                    _Pragma("omp critical")
+                        printf("\rRTC progress: %d%%",
+                            (int) ((numdone * 1e2 / imax) / jmax)),
+                            fflush(stdout);
+                // Central DEM coordinates of facets
+                const double dem_ymid = geogrid.startY() + geogrid.spacingY() *
+                                                                   (0.5 + ii) /
+                                                                   upsample_factor;
+                const double dem_xmid = geogrid.startX() + geogrid.spacingX() *
+                                                                   (0.5 + jj) /
+                                                                   upsample_factor;
+
+                const Vec3 inputDEM =
+                        getDemCoords(dem_xmid, dem_ymid, dem_interp, proj.get());
+
+                // Compute facet-central LLH vector
+                const Vec3 inputLLH = dem_interp.proj()->inverse(inputDEM);
+                // Should incorporate check on return status here
+                int converged = geo2rdr(inputLLH, ellps, orbit, input_dop, a, r,
+                        radar_grid.wavelength(), side, 1e-8, 100, 1e-8);
+                if (!converged)
+                    continue;
 
-            // Check to see if pixel lies in valid RDC range
-            if (ranpix < -1 or x2 > xbound + 1 or azpix < -1 or y2 > ybound + 1)
-                continue;
+                float azpix = (a - start) / pixazm;
+                float ranpix = (r - r0) / dr;
 
-            // Current x/y-coords in DEM
-            const double dem_y0 = geogrid.startY() +
-                                  geogrid.spacingY() * ii / upsample_factor;
-            const double dem_y1 = dem_y0 + geogrid.spacingY() / upsample_factor;
-            const double dem_x0 = geogrid.startX() +
-                                  geogrid.spacingX() * jj / upsample_factor;
-            const double dem_x1 = dem_x0 + geogrid.spacingX() / upsample_factor;
+                // Establish bounds for bilinear weighting model
+                const int x1 = (int) std::floor(ranpix);
+                const int x2 = x1 + 1;
+                const int y1 = (int) std::floor(azpix);
+                const int y2 = y1 + 1;
 
-            // Set DEM-coordinate corner vectors
-            const Vec3 dem00 =
-                    getDemCoords(dem_x0, dem_y0, dem_interp, proj.get());
-            const Vec3 dem01 =
-                    getDemCoords(dem_x0, dem_y1, dem_interp, proj.get());
-            const Vec3 dem10 =
-                    getDemCoords(dem_x1, dem_y0, dem_interp, proj.get());
-            const Vec3 dem11 =
-                    getDemCoords(dem_x1, dem_y1, dem_interp, proj.get());
-
-            // Convert to XYZ
-            const Vec3 xyz00 =
-                    ellps.lonLatToXyz(dem_interp.proj()->inverse(dem00));
-            const Vec3 xyz01 =
-                    ellps.lonLatToXyz(dem_interp.proj()->inverse(dem01));
-            const Vec3 xyz10 =
-                    ellps.lonLatToXyz(dem_interp.proj()->inverse(dem10));
-            const Vec3 xyz11 =
-                    ellps.lonLatToXyz(dem_interp.proj()->inverse(dem11));
-
-            // Compute normal vectors for each facet
-            const Vec3 normal_facet_1 = normalPlane(xyz00, xyz01, xyz10);
-            const Vec3 normal_facet_2 = normalPlane(xyz01, xyz11, xyz10);
-
-            // Side lengths
-            const double p00_01 = (xyz00 - xyz01).norm();
-            const double p00_10 = (xyz00 - xyz10).norm();
-            const double p10_01 = (xyz10 - xyz01).norm();
-            const double p11_01 = (xyz11 - xyz01).norm();
-            const double p11_10 = (xyz11 - xyz10).norm();
-
-            // Semi-perimeters
-            const float h1 = 0.5 * (p00_01 + p00_10 + p10_01);
-            const float h2 = 0.5 * (p11_01 + p11_10 + p10_01);
-
-            // Heron's formula to get area of facets in XYZ coordinates
-            const float AP1 = std::sqrt(
-                    h1 * (h1 - p00_01) * (h1 - p00_10) * (h1 - p10_01));
-            const float AP2 = std::sqrt(
-                    h2 * (h2 - p11_01) * (h2 - p11_10) * (h2 - p10_01));
-
-            // Compute look angle from sensor to ground
-            const Vec3 xyz_mid = ellps.lonLatToXyz(inputLLH);
-            isce3::core::cartesian_t xyz_plat, vel;
-            isce3::error::ErrorCode status = orbit.interpolate(
-                    &xyz_plat, &vel, a, OrbitInterpBorderMode::FillNaN);
-            if (status != isce3::error::ErrorCode::Success)
-                continue;
+                // Check to see if pixel lies in valid RDC range
+                if (ranpix < -1 or x2 > xbound + 1 or azpix < -1 or y2 > ybound + 1)
+                    continue;
 
-            const Vec3 lookXYZ = (xyz_plat - xyz_mid).normalized();
+                // Current x/y-coords in DEM
+                const double dem_y0 = geogrid.startY() +
+                                      geogrid.spacingY() * ii / upsample_factor;
+                const double dem_y1 = dem_y0 + geogrid.spacingY() / upsample_factor;
+                const double dem_x0 = geogrid.startX() +
+                                      geogrid.spacingX() * jj / upsample_factor;
+                const double dem_x1 = dem_x0 + geogrid.spacingX() / upsample_factor;
+
+                // Set DEM-coordinate corner vectors
+                const Vec3 dem00 =
+                        getDemCoords(dem_x0, dem_y0, dem_interp, proj.get());
+                const Vec3 dem01 =
+                        getDemCoords(dem_x0, dem_y1, dem_interp, proj.get());
+                const Vec3 dem10 =
+                        getDemCoords(dem_x1, dem_y0, dem_interp, proj.get());
+                const Vec3 dem11 =
+                        getDemCoords(dem_x1, dem_y1, dem_interp, proj.get());
+
+                // Convert to XYZ
+                const Vec3 xyz00 =
+                        ellps.lonLatToXyz(dem_interp.proj()->inverse(dem00));
+                const Vec3 xyz01 =
+                        ellps.lonLatToXyz(dem_interp.proj()->inverse(dem01));
+                const Vec3 xyz10 =
+                        ellps.lonLatToXyz(dem_interp.proj()->inverse(dem10));
+                const Vec3 xyz11 =
+                        ellps.lonLatToXyz(dem_interp.proj()->inverse(dem11));
+
+                // Compute normal vectors for each facet
+                const Vec3 normal_facet_1 = normalPlane(xyz00, xyz01, xyz10);
+                const Vec3 normal_facet_2 = normalPlane(xyz01, xyz11, xyz10);
+
+                // Side lengths
+                const double p00_01 = (xyz00 - xyz01).norm();
+                const double p00_10 = (xyz00 - xyz10).norm();
+                const double p10_01 = (xyz10 - xyz01).norm();
+                const double p11_01 = (xyz11 - xyz01).norm();
+                const double p11_10 = (xyz11 - xyz10).norm();
+
+                // Semi-perimeters
+                const float h1 = 0.5 * (p00_01 + p00_10 + p10_01);
+                const float h2 = 0.5 * (p11_01 + p11_10 + p10_01);
+
+                // Heron's formula to get area of facets in XYZ coordinates
+                const float AP1 = std::sqrt(
+                        h1 * (h1 - p00_01) * (h1 - p00_10) * (h1 - p10_01));
+                const float AP2 = std::sqrt(
+                        h2 * (h2 - p11_01) * (h2 - p11_10) * (h2 - p10_01));
+
+                // Compute look angle from sensor to ground
+                const Vec3 xyz_mid = ellps.lonLatToXyz(inputLLH);
+                isce3::core::cartesian_t xyz_plat, vel;
+                isce3::error::ErrorCode status = orbit.interpolate(
+                        &xyz_plat, &vel, a, OrbitInterpBorderMode::FillNaN);
+                if (status != isce3::error::ErrorCode::Success)
+                    continue;
 
-            // Compute dot product between each facet and look vector
-            double cos_inc_facet_1 = -lookXYZ.dot(normal_facet_1);
-            double cos_inc_facet_2 = -lookXYZ.dot(normal_facet_2);
+                const Vec3 lookXYZ = (xyz_plat - xyz_mid).normalized();
 
-            // If facets are not illuminated by radar, skip
-            if (cos_inc_facet_1 <= 0. and cos_inc_facet_2 <= 0.)
-                continue;
+                // Compute dot product between each facet and look vector
+                double cos_inc_facet_1 = -lookXYZ.dot(normal_facet_1);
+                double cos_inc_facet_2 = -lookXYZ.dot(normal_facet_2);
 
-            // Compute projected area
-            double area = 0, area_sigma = 0;
+                // If facets are not illuminated by radar, skip
+                if (cos_inc_facet_1 <= 0. and cos_inc_facet_2 <= 0.)
+                    continue;
 
-            if (cos_inc_facet_1 > 0 &&
-                    output_terrain_radiometry ==
-                            rtcOutputTerrainRadiometry::SIGMA_NAUGHT)
-                area += AP1;
-            else if (cos_inc_facet_1 > 0) {
-                area += AP1 * cos_inc_facet_1;
-                if (flag_compute_area_sigma_separately) {
-                    area_sigma += AP1;
+                // Compute projected area
+                double area = 0, area_sigma = 0;
+
+                if (cos_inc_facet_1 > 0 &&
+                        output_terrain_radiometry ==
+                                rtcOutputTerrainRadiometry::SIGMA_NAUGHT)
+                    area += AP1;
+                else if (cos_inc_facet_1 > 0) {
+                    area += AP1 * cos_inc_facet_1;
+                    if (flag_compute_area_sigma_separately) {
+                        area_sigma += AP1;
+                    }
                 }
-            }
-            if (cos_inc_facet_2 > 0 &&
-                    output_terrain_radiometry ==
-                            rtcOutputTerrainRadiometry::SIGMA_NAUGHT)
-                area += AP2;
-            else if (cos_inc_facet_2 > 0)
-                area += AP2 * cos_inc_facet_2;
-            if (area == 0)
-                continue;
-
-            // Compute fractional weights from indices
-            const double Wr = ranpix - x1;
-            const double Wa = azpix - y1;
-            const double Wrc = 1. - Wr;
-            const double Wac = 1. - Wa;
-
-            if (rtc_area_mode == rtcAreaMode::AREA_FACTOR) {
-                // cosine law: c^2 = a^2 + b^2 - 2.a.b.cos(AB)
-                // cos(AB) = (a^2 + b^2 - c^2) / 2.a.b
-                const double slant_range = (xyz_mid - xyz_plat).norm();
-                const double radius_target = xyz_mid.norm();
-                const double radius_platform = xyz_plat.norm();
-                const double cos_alpha = (
-                    (radius_target * radius_target +
-                     radius_platform * radius_platform -
-                     slant_range * slant_range) /
-                    (2 * radius_target * radius_platform));
+                if (cos_inc_facet_2 > 0 &&
+                        output_terrain_radiometry ==
+                                rtcOutputTerrainRadiometry::SIGMA_NAUGHT)
+                    area += AP2;
+                else if (cos_inc_facet_2 > 0)
+                    area += AP2 * cos_inc_facet_2;
+                if (area == 0)
+                    continue;
 
-                const double ground_velocity =
-                        cos_alpha * radius_target * vel.norm() / radius_platform;
-                const double area_beta = radar_grid.rangePixelSpacing() *
-                                         ground_velocity / radar_grid.prf();
-                area /= area_beta;
-                if (flag_compute_area_sigma_separately) {
-                    area_sigma /= area_beta;
+                // Compute fractional weights from indices
+                const double Wr = ranpix - x1;
+                const double Wa = azpix - y1;
+                const double Wrc = 1. - Wr;
+                const double Wac = 1. - Wa;
+
+                if (rtc_area_mode == rtcAreaMode::AREA_FACTOR) {
+                    // cosine law: c^2 = a^2 + b^2 - 2.a.b.cos(AB)
+                    // cos(AB) = (a^2 + b^2 - c^2) / 2.a.b
+                    const double slant_range = (xyz_mid - xyz_plat).norm();
+                    const double radius_target = xyz_mid.norm();
+                    const double radius_platform = xyz_plat.norm();
+                    const double cos_alpha = (
+                        (radius_target * radius_target +
+                         radius_platform * radius_platform -
+                         slant_range * slant_range) /
+                        (2 * radius_target * radius_platform));
+
+                    const double ground_velocity =
+                            cos_alpha * radius_target * vel.norm() / radius_platform;
+                    const double area_beta = radar_grid.rangePixelSpacing() *
+                                             ground_velocity / radar_grid.prf();
+                    area /= area_beta;
+                    if (flag_compute_area_sigma_separately) {
+                        area_sigma /= area_beta;
+                    }
                 }
-            }
 
-            // if if (ranpix < -1 or x2 > xbound+1 or azpix < -1 or y2 >
-            // ybound+1)
-            if (y1 >= 0 && x1 >= 0) {
-                _Pragma("omp atomic") out_array(y1, x1) += area * Wrc * Wac;
-            }
-            if (y1 >= 0 && x2 <= xbound) {
-                _Pragma("omp atomic") out_array(y1, x2) += area * Wr * Wac;
-            }
-            if (y2 <= ybound && x1 >= 0) {
-                _Pragma("omp atomic") out_array(y2, x1) += area * Wrc * Wa;
-            }
-            if (y2 <= ybound && x2 <= xbound) {
-                _Pragma("omp atomic") out_array(y2, x2) += area * Wr * Wa;
-            }
+                // if if (ranpix < -1 or x2 > xbound+1 or azpix < -1 or y2 >
+                // ybound+1)
+                area_accumulator.include(y1, y2, x1, x2);
+                if (y1 >= 0 && x1 >= 0)
+                    area_accumulator.gamma(y1, x1) += area * Wrc * Wac;
+                if (y1 >= 0 && x2 <= xbound)
+                    area_accumulator.gamma(y1, x2) += area * Wr * Wac;
+                if (y2 <= ybound && x1 >= 0)
+                    area_accumulator.gamma(y2, x1) += area * Wrc * Wa;
+                if (y2 <= ybound && x2 <= xbound)
+                    area_accumulator.gamma(y2, x2) += area * Wr * Wa;
 
-            if (flag_compute_area_sigma_separately) {
-                if (y1 >= 0 && x1 >= 0) {
-                    _Pragma("omp atomic")
-                        out_sigma_array(y1, x1) += area_sigma * Wrc * Wac;
-                }
-                if (y1 >= 0 && x2 <= xbound) {
-                    _Pragma("omp atomic")
-                        out_sigma_array(y1, x2) += area_sigma * Wr * Wac;
-                }
-                if (y2 <= ybound && x1 >= 0) {
-                    _Pragma("omp atomic")
-                        out_sigma_array(y2, x1) += area_sigma * Wrc * Wa;
-                }
-                if (y2 <= ybound && x2 <= xbound) {
-                    _Pragma("omp atomic")
-                        out_sigma_array(y2, x2) += area_sigma * Wr * Wa;
+                if (flag_compute_area_sigma_separately) {
+                    if (y1 >= 0 && x1 >= 0)
+                        area_accumulator.sigma(y1, x1) +=
+                                area_sigma * Wrc * Wac;
+                    if (y1 >= 0 && x2 <= xbound)
+                        area_accumulator.sigma(y1, x2) +=
+                                area_sigma * Wr * Wac;
+                    if (y2 <= ybound && x1 >= 0)
+                        area_accumulator.sigma(y2, x1) +=
+                                area_sigma * Wrc * Wa;
+                    if (y2 <= ybound && x2 <= xbound)
+                        area_accumulator.sigma(y2, x2) +=
+                                area_sigma * Wr * Wa;
                 }
             }
         }
+
+        _Pragma("omp ordered")
+        area_accumulator.mergeInto(
+                out_array, out_beta_array, out_sigma_array);
     }
 
     printf("\rRTC progress: 100%%");
@@ -1054,9 +1168,7 @@ void _RunBlock(const int jmax, const int block_size,
         const isce3::core::LUT2d<double>& dop,
         const isce3::core::Ellipsoid& ellipsoid,
         const isce3::core::Orbit& orbit, double threshold, int num_iter,
-        double delta_range, isce3::core::Matrix<float>& out_gamma_array,
-        isce3::core::Matrix<float>& out_beta_array,
-        isce3::core::Matrix<float>& out_sigma_array,
+        double delta_range, _RtcAreaAccumulator& area_accumulator,
         isce3::core::ProjectionBase* proj, rtcAreaMode rtc_area_mode,
         rtcAreaBetaMode rtc_area_beta_mode,
         rtcInputTerrainRadiometry input_terrain_radiometry,
@@ -1422,6 +1534,7 @@ void _RunBlock(const int jmax, const int block_size,
             // Prepare call to _addArea()
             int size_x = x_max - x_min + 1;
             int size_y = y_max - y_min + 1;
+            area_accumulator.include(y_min, y_max, x_min, x_max);
             isce3::core::Matrix<double> w_arr_1(size_y, size_x);
             isce3::core::Matrix<double> w_arr_2(size_y, size_x);
             w_arr_1.fill(0);
@@ -1464,11 +1577,10 @@ void _RunBlock(const int jmax, const int block_size,
 
             // Add gamma_naught_area to output grid
             _addArea(gamma_naught_area, sigma_naught_area, beta_naught_area,
-                    out_gamma_array, out_beta_array, out_sigma_array,
-                    radar_grid.length(), radar_grid.width(), x_min, y_min,
-                    size_x, size_y, w_arr_1, nlooks_1, w_arr_2, nlooks_2,
-                    x_c_cut, x00_cut, x01_cut, y_c_cut, y00_cut, y01_cut,
-                    plane_orientation);
+                    area_accumulator, radar_grid.length(), radar_grid.width(),
+                    x_min, y_min, size_x, size_y, w_arr_1, nlooks_1,
+                    w_arr_2, nlooks_2, x_c_cut, x00_cut, x01_cut,
+                    y_c_cut, y00_cut, y01_cut, plane_orientation);
 
             // Compute the area (second facet)
             gamma_naught_area = computeFacet(xyz_c, xyz01, xyz11,
@@ -1479,11 +1591,10 @@ void _RunBlock(const int jmax, const int block_size,
 
             // Add area to output grid
             _addArea(gamma_naught_area, sigma_naught_area, beta_naught_area,
-                    out_gamma_array, out_beta_array, out_sigma_array,
-                    radar_grid.length(), radar_grid.width(), x_min, y_min,
-                    size_x, size_y, w_arr_2, nlooks_2, w_arr_1, nlooks_1,
-                    x_c_cut, x01_cut, x11_cut, y_c_cut, y01_cut, y11_cut,
-                    plane_orientation);
+                    area_accumulator, radar_grid.length(), radar_grid.width(),
+                    x_min, y_min, size_x, size_y, w_arr_2, nlooks_2,
+                    w_arr_1, nlooks_1, x_c_cut, x01_cut, x11_cut,
+                    y_c_cut, y01_cut, y11_cut, plane_orientation);
 
             // Compute the area (third facet)
             gamma_naught_area = computeFacet(xyz_c, xyz11, xyz10,
@@ -1494,11 +1605,10 @@ void _RunBlock(const int jmax, const int block_size,
 
             // Add area to output grid
             _addArea(gamma_naught_area, sigma_naught_area, beta_naught_area,
-                    out_gamma_array, out_beta_array, out_sigma_array,
-                    radar_grid.length(), radar_grid.width(), x_min, y_min,
-                    size_x, size_y, w_arr_1, nlooks_1, w_arr_2, nlooks_2,
-                    x_c_cut, x11_cut, x10_cut, y_c_cut, y11_cut, y10_cut,
-                    plane_orientation);
+                    area_accumulator, radar_grid.length(), radar_grid.width(),
+                    x_min, y_min, size_x, size_y, w_arr_1, nlooks_1,
+                    w_arr_2, nlooks_2, x_c_cut, x11_cut, x10_cut,
+                    y_c_cut, y11_cut, y10_cut, plane_orientation);
 
             // Compute the area (fourth facet)
             gamma_naught_area = computeFacet(xyz_c, xyz10, xyz00,
@@ -1509,11 +1619,10 @@ void _RunBlock(const int jmax, const int block_size,
 
             // Add area to output grid
             _addArea(gamma_naught_area, sigma_naught_area, beta_naught_area,
-                    out_gamma_array, out_beta_array, out_sigma_array,
-                    radar_grid.length(), radar_grid.width(), x_min, y_min,
-                    size_x, size_y, w_arr_2, nlooks_2, w_arr_1, nlooks_1,
-                    x_c_cut, x10_cut, x00_cut, y_c_cut, y10_cut, y00_cut,
-                    plane_orientation);
+                    area_accumulator, radar_grid.length(), radar_grid.width(),
+                    x_min, y_min, size_x, size_y, w_arr_2, nlooks_2,
+                    w_arr_1, nlooks_1, x_c_cut, x10_cut, x00_cut,
+                    y_c_cut, y10_cut, y00_cut, plane_orientation);
         }
     }
 
@@ -1646,16 +1755,26 @@ void computeRtcAreaProj(isce3::io::Raster& dem_raster,
     info << "block length (with upsampling): " << block_length_with_upsampling
          << pyre::journal::endl;
 
-    _Pragma("omp parallel for schedule(dynamic)")
+    /*
+    Each block accumulates its areas into a private radar-grid window that is
+    merged into the output arrays in block order, so that results do not
+    depend on the number of threads or on scheduling
+    */
+    _Pragma("omp parallel for ordered schedule(dynamic)")
         for (int block = 0; block < nblocks; ++block) {
+            _RtcAreaAccumulator area_accumulator(radar_grid.length(),
+                    radar_grid.width(), out_beta_array.size() > 0,
+                    out_sigma_array.size() > 0);
             _RunBlock(jmax, block_length, block_length_with_upsampling, block,
                 numdone, progress_block, geogrid_upsampling, interp_method,
                 dem_raster, out_geo_rdr, out_geo_grid, start, pixazm, dr, r0,
                 xbound, ybound, geogrid, radar_grid, input_dop, ellipsoid,
-                orbit, threshold, num_iter, delta_range, out_gamma_array,
-                out_beta_array, out_sigma_array, proj.get(), rtc_area_mode,
-                rtc_area_beta_mode, input_terrain_radiometry,
-                output_terrain_radiometry);
+                orbit, threshold, num_iter, delta_range, area_accumulator,
+                proj.get(), rtc_area_mode, rtc_area_beta_mode,
+                input_terrain_radiometry, output_terrain_radiometry);
+            _Pragma("omp ordered")
+            area_accumulator.mergeInto(
+                    out_gamma_array, out_beta_array, out_sigma_array);
         }
 
     printf("\rRTC progress: 100%%\n");
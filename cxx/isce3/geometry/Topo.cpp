@@ -140,6 +140,13 @@ topo(Raster & demRaster, TopoLayers & layers)
     info << "DEM EPSG: " << demRaster.getEPSG() << pyre::journal::newline;
     info << "Output EPSG: " << _epsgOut << pyre::journal::endl;
 
+    // Access the entire DEM lazily instead of reading a subset per block
+    const bool tiledDem = _demTileCacheSize > 0;
+    if (tiledDem) {
+        demInterp.loadDEMTiled(demRaster, 1, 512, _demTileCacheSize);
+        demInterp.declare();
+    }
+
     // Loop over blocks
     size_t totalconv = 0;
     for (size_t block = 0; block < nBlocks; ++block) {
@@ -165,7 +172,9 @@ topo(Raster & demRaster, TopoLayers & layers)
              << pyre::journal::endl;
 
         // Load DEM subset for SLC image block
-        computeDEMBounds(demRaster, demInterp, lineStart, blockLength);
+        if (not tiledDem) {
+            computeDEMBounds(demRaster, demInterp, lineStart, blockLength);
+        }
 
         // Compute max and mean DEM height for the subset
         float demmin, demmax, dem_avg;
@@ -750,203 +759,324 @@ _setOutputTopoLayers(Vec3 & targetLLH, TopoLayers & layers, size_t line,
 }
 
 
+namespace {
+
+// Work arrays of the layover/shadow mask computation of one line, allocated
+// once per thread and reused for every line of a block
+struct LayoverShadowScratch {
+    LayoverShadowScratch(int width, int gridWidth) :
+        x(width), y(width), ctrack(width), ctrackGrid(gridWidth),
+        slantRangeGrid(gridWidth), elevationAngleGrid(gridWidth),
+        maskGrid(gridWidth), coarseMask(gridWidth)
+    {}
+
+    std::valarray<double> x, y, ctrack;
+    std::valarray<double> ctrackGrid;
+    std::valarray<double> slantRangeGrid;
+    std::valarray<double> elevationAngleGrid;
+    std::valarray<short> maskGrid;
+    // Shadow/layover flags of the decimated cross-track grid
+    std::valarray<bool> coarseMask;
+};
+
+} // namespace
+
 void isce3::geometry::Topo::
 setLayoverShadow(TopoLayers& layers, DEMInterpolator& demInterp,
                  std::vector<Vec3>& satPosition, size_t block,
                  size_t n_blocks)
 {
-    // Cache the width of the block
-    const int width = layers.width();
-    // Compute layover on oversampled grid
-    const int gridWidth = 2 * width;
-
-
     // Initialize mask to zero for this block
     layers.mask() = 0;
 
-    // Prepare function getDemCoords() to interpolate DEM
-    std::function<Vec3(double, double,
-                       const isce3::geometry::DEMInterpolator&,
-                       isce3::core::ProjectionBase*)> getDemCoords;
-
+    // Pick the DEM coordinate conversion once per block so that it is
+    // resolved at compile time instead of being called through a function
+    // object for every grid sample
     if (_epsgOut == demInterp.epsgCode()) {
-        getDemCoords = isce3::geometry::getDemCoordsSameEpsg;
+        _setLayoverShadow(layers, demInterp, satPosition, block, n_blocks,
+                [](double x, double y, const DEMInterpolator& demInterp,
+                   isce3::core::ProjectionBase* proj) {
+                    return isce3::geometry::getDemCoordsSameEpsg(
+                            x, y, demInterp, proj);
+                });
     } else {
-        getDemCoords = isce3::geometry::getDemCoordsDiffEpsg;
+        _setLayoverShadow(layers, demInterp, satPosition, block, n_blocks,
+                [](double x, double y, const DEMInterpolator& demInterp,
+                   isce3::core::ProjectionBase* proj) {
+                    return isce3::geometry::getDemCoordsDiffEpsg(
+                            x, y, demInterp, proj);
+                });
     }
 
-    long long num_lines_done = 0;
-
-    // Loop over lines in block
-#pragma omp parallel for shared(num_lines_done)
-    for (size_t line = 0; line < layers.length(); ++line) {
-
-        // Allocate working valarrays
-        std::valarray<double> x(width), y(width), ctrack(width);
-        std::valarray<double> ctrackGrid(gridWidth);
-        std::valarray<double> slantRangeGrid(gridWidth);
-        std::valarray<double> elevationAngleGrid(gridWidth);
-        std::valarray<short> maskGrid(gridWidth);
-        std::valarray<short> mask(width);
-
-        // Cache satellite position for this line
-        const Vec3& xyzSat = satPosition[line];
-
-        // Copy cross-track, x, and y values for the line
-        for (int i = 0; i < width; ++i) {
-            ctrack[i] = layers.crossTrack(line, i);
-            x[i] = layers.x(line, i);
-            y[i] = layers.y(line, i);
-        }
+    printf("\rLayover/shadow mask progress (block %d/%d): 100%%\n",
+        (int) block + 1, (int) n_blocks), fflush(stdout);
+}
 
-        // Sort ctrack, x, and y by values in ctrack
-        isce3::core::insertionSort(ctrack, x, y);
-
-        // Create regular grid for cross-track values
-        const double cmin = ctrack.min();// - demInterp.maxHeight();
-        const double cmax = ctrack.max();// + demInterp.maxHeight();
-        isce3::core::linspace<double>(cmin, cmax, ctrackGrid);
-
-        // Interpolate DEM to regular cross-track grid
-        for (int i = 0; i < gridWidth; ++i) {
-
-            // Compute nearest ctrack index for current ctrackGrid value
-            const double crossTrack = ctrackGrid[i];
-            int k = isce3::core::binarySearch(ctrack, crossTrack);
-            // Adjust edges if necessary
-            if (k == (width - 1)) {
-                k = width - 2;
-            } else if (k < 0) {
-                k = 0;
-            }
+template<typename DemCoordsFunc>
+void isce3::geometry::Topo::
+_setLayoverShadow(TopoLayers& layers, DEMInterpolator& demInterp,
+                  std::vector<Vec3>& satPosition, size_t block,
+                  size_t n_blocks, DemCoordsFunc getDemCoords)
+{
+    // Cache the width of the block
+    const int width = layers.width();
+    // Compute layover on oversampled grid
+    const int gridWidth = 2 * width;
+    // Spacing of the samples at which the geometry is always computed
+    const int decimation = std::max(1,
+            std::min(_layoverShadowDecimation, gridWidth - 1));
 
-            // Linear interpolation to estimate DEM x/y coordinates
-            const double c1 = ctrack[k];
-            const double c2 = ctrack[k+1];
-            const double frac1 = (c2 - crossTrack) / (c2 - c1);
-            const double frac2 = (crossTrack - c1) / (c2 - c1);
+    long long num_lines_done = 0;
 
-            double x_grid;
-            if (demInterp.epsgCode() != 4326 or std::fabs(x[k] -  x[k+1]) < 180) {
-                x_grid = x[k] * frac1 + x[k+1] * frac2;
-            } else {
-                const double x_k_0_360 = x[k] < 0 ? x[k] + 360: x[k];
-                const double x_k_next_0_360 = x[k+1] < 0 ? x[k+1] + 360: x[k+1];
-                x_grid = x_k_0_360 * frac1 + x_k_next_0_360 * frac2;
+    #pragma omp parallel shared(num_lines_done)
+    {
+        LayoverShadowScratch scratch(width, gridWidth);
+        auto& x = scratch.x;
+        auto& y = scratch.y;
+        auto& ctrack = scratch.ctrack;
+        auto& ctrackGrid = scratch.ctrackGrid;
+        auto& slantRangeGrid = scratch.slantRangeGrid;
+        auto& elevationAngleGrid = scratch.elevationAngleGrid;
+        auto& maskGrid = scratch.maskGrid;
+        auto& coarseMask = scratch.coarseMask;
+
+        // Loop over lines in block
+        #pragma omp for
+        for (size_t line = 0; line < layers.length(); ++line) {
+
+            // Cache satellite position for this line
+            const Vec3& xyzSat = satPosition[line];
+
+            // Copy cross-track, x, and y values for the line
+            for (int i = 0; i < width; ++i) {
+                ctrack[i] = layers.crossTrack(line, i);
+                x[i] = layers.x(line, i);
+                y[i] = layers.y(line, i);
             }
-            const double y_grid = y[k] * frac1 + y[k+1] * frac2;
 
-            // Interpolate DEM at x/y
-            Vec3 demXYZ = getDemCoords(x_grid, y_grid, demInterp, _proj);
+            // Sort ctrack, x, and y by values in ctrack
+            isce3::core::insertionSort(ctrack, x, y);
+
+            // Create regular grid for cross-track values
+            const double cmin = ctrack.min();// - demInterp.maxHeight();
+            const double cmax = ctrack.max();// + demInterp.maxHeight();
+            isce3::core::linspace<double>(cmin, cmax, ctrackGrid);
+
+            // Interpolate DEM to cross-track grid sample i and compute its
+            // slant range and elevation angle
+            auto computeGeometry = [&](int i) {
+
+                // Compute nearest ctrack index for current ctrackGrid value
+                const double crossTrack = ctrackGrid[i];
+                int k = isce3::core::binarySearch(ctrack, crossTrack);
+                // Adjust edges if necessary
+                if (k == (width - 1)) {
+                    k = width - 2;
+                } else if (k < 0) {
+                    k = 0;
+                }
 
-            // Convert DEM XYZ to ECEF XYZ
-            Vec3 llhTarget, xyzTarget;
-            demInterp.proj()->inverse(demXYZ, llhTarget);
-            _ellipsoid.lonLatToXyz(llhTarget, xyzTarget);
+                // Linear interpolation to estimate DEM x/y coordinates
+                const double c1 = ctrack[k];
+                const double c2 = ctrack[k+1];
+                const double frac1 = (c2 - crossTrack) / (c2 - c1);
+                const double frac2 = (crossTrack - c1) / (c2 - c1);
+
+                double x_grid;
+                if (demInterp.epsgCode() != 4326 or
+                        std::fabs(x[k] -  x[k+1]) < 180) {
+                    x_grid = x[k] * frac1 + x[k+1] * frac2;
+                } else {
+                    const double x_k_0_360 = x[k] < 0 ? x[k] + 360: x[k];
+                    const double x_k_next_0_360 =
+                            x[k+1] < 0 ? x[k+1] + 360: x[k+1];
+                    x_grid = x_k_0_360 * frac1 + x_k_next_0_360 * frac2;
+                }
+                const double y_grid = y[k] * frac1 + y[k+1] * frac2;
 
-            // Compute and save slant range
-            const Vec3 targetToSat = xyzSat - xyzTarget;
-            slantRangeGrid[i] = targetToSat.norm();
+                // Interpolate DEM at x/y
+                Vec3 demXYZ = getDemCoords(x_grid, y_grid, demInterp, _proj);
 
-            // Compute geocentric elevation grid (not geodedic!)
-            const double cosElevation = (xyzSat.dot(targetToSat) /
-                (xyzSat.norm() * targetToSat.norm()));
-            elevationAngleGrid[i] = std::acos(cosElevation);
-        }
+                // Convert DEM XYZ to ECEF XYZ
+                Vec3 llhTarget, xyzTarget;
+                demInterp.proj()->inverse(demXYZ, llhTarget);
+                _ellipsoid.lonLatToXyz(llhTarget, xyzTarget);
 
-        // Traverse from near nadir to far nadir on grid spacing
-        maskGrid = 0;
-        double maxElevationAngle = elevationAngleGrid[0];
-        for (long i = 1; i < gridWidth; ++i) {
-            if (maxElevationAngle >= elevationAngleGrid[i]) {
-                maskGrid[i] = isce3::core::SHADOW_VALUE;
-            } else {
-                maxElevationAngle = elevationAngleGrid[i];
-            }
-        }
+                // Compute and save slant range
+                const Vec3 targetToSat = xyzSat - xyzTarget;
+                slantRangeGrid[i] = targetToSat.norm();
 
-        // Now sort cross-track grid in terms of slant range grid
-        isce3::core::insertionSort(slantRangeGrid, ctrackGrid, maskGrid);
-
-       // Traverse from near range to far range on grid spacing for layover detection
-        double minCrossTrack = ctrackGrid[0];
-        for (int i = 1; i < gridWidth; ++i) {
-            const double crossTrack = ctrackGrid[i];
-            // Test layover
-            if (crossTrack <= minCrossTrack) {
-                /*
-                We use bitwise-or (|) to apply new masking values while
-                preserving any existing masks
-
-                BINARY REPRESENTATION ,   CLASSIFICATION
-                       0b0000         ,    (NOT_MASKED)
-                       0b0001         ,     (SHADOW)
-                       0b0010         ,     (LAYOVER)
-                       0b0011         ,  (LAYOVER & SHADOW)
-                */
-                maskGrid[i] |= isce3::core::LAYOVER_VALUE;
-            } else {
-                minCrossTrack = crossTrack;
-            }
-        }
+                // Compute geocentric elevation grid (not geodedic!)
+                const double cosElevation = (xyzSat.dot(targetToSat) /
+                    (xyzSat.norm() * targetToSat.norm()));
+                elevationAngleGrid[i] = std::acos(cosElevation);
+            };
 
-        // Traverse from far range to near range on grid spacing for layover detection
-        double maxCrossTrack = ctrackGrid[gridWidth - 1];
-        for (int i = gridWidth - 2; i >= 0; --i) {
-            const double crossTrack = ctrackGrid[i];
-            // Test layover
-            if (crossTrack >= maxCrossTrack) {
-                maskGrid[i] |= isce3::core::LAYOVER_VALUE;
+            if (decimation == 1) {
+                for (int i = 0; i < gridWidth; ++i) {
+                    computeGeometry(i);
+                }
             } else {
-                maxCrossTrack = crossTrack;
-            }
-        }
+                // Compute the geometry on the decimated grid (always including
+                // the last sample)
+                const int last = gridWidth - 1;
+                const int nCoarse = (last + decimation - 1) / decimation + 1;
+                auto coarse = [&](int j) {
+                    return std::min(j * decimation, last);
+                };
+                for (int j = 0; j < nCoarse; ++j) {
+                    computeGeometry(coarse(j));
+                }
 
-        // Resample maskGrid to original spacing
-        for (int i = 0; i < gridWidth; ++i) {
-            if (maskGrid[i]) {
+                // Flag coarse samples shadowed by nearer samples or laid over
+                // by samples on either side, with the same tests as the full
+                // resolution scans below written in cross-track order
+                coarseMask = false;
+                double maxElevationAngle = elevationAngleGrid[0];
+                double maxSlantRange = slantRangeGrid[0];
+                for (int j = 1; j < nCoarse; ++j) {
+                    const int i = coarse(j);
+                    if (maxElevationAngle >= elevationAngleGrid[i]) {
+                        coarseMask[j] = true;
+                    } else {
+                        maxElevationAngle = elevationAngleGrid[i];
+                    }
+                    if (maxSlantRange >= slantRangeGrid[i]) {
+                        coarseMask[j] = true;
+                    } else {
+                        maxSlantRange = slantRangeGrid[i];
+                    }
+                }
+                double minSlantRange = slantRangeGrid[last];
+                for (int j = nCoarse - 2; j >= 0; --j) {
+                    const int i = coarse(j);
+                    if (minSlantRange <= slantRangeGrid[i]) {
+                        coarseMask[j] = true;
+                    } else {
+                        minSlantRange = slantRangeGrid[i];
+                    }
+                }
 
-                const long slant_range_index =
-                    lround(std::round(_radarGrid.slantRangeIndex(
-                        slantRangeGrid[i])));
+                // Compute the geometry exactly within one coarse interval of
+                // any flagged coarse sample so that mask edges are placed at
+                // full resolution, and interpolate it elsewhere
+                for (int j = 0; j < nCoarse - 1; ++j) {
+                    const int i0 = coarse(j);
+                    const int i1 = coarse(j + 1);
+                    bool refine = false;
+                    for (int jj = std::max(j - 1, 0);
+                         jj <= std::min(j + 2, nCoarse - 1); ++jj) {
+                        refine = refine or coarseMask[jj];
+                    }
+                    for (int i = i0 + 1; i < i1; ++i) {
+                        if (refine) {
+                            computeGeometry(i);
+                            continue;
+                        }
+                        const double frac = double(i - i0) / (i1 - i0);
+                        slantRangeGrid[i] = slantRangeGrid[i0] +
+                            frac * (slantRangeGrid[i1] - slantRangeGrid[i0]);
+                        elevationAngleGrid[i] = elevationAngleGrid[i0] +
+                            frac * (elevationAngleGrid[i1] -
+                                    elevationAngleGrid[i0]);
+                    }
+                }
+            }
 
-                // If out of bounds, escape
-                if (slant_range_index < 0 || slant_range_index >= width) {
-                    continue;
+            // Traverse from near nadir to far nadir on grid spacing
+            maskGrid = 0;
+            double maxElevationAngle = elevationAngleGrid[0];
+            for (long i = 1; i < gridWidth; ++i) {
+                if (maxElevationAngle >= elevationAngleGrid[i]) {
+                    maskGrid[i] = isce3::core::SHADOW_VALUE;
+                } else {
+                    maxElevationAngle = elevationAngleGrid[i];
                 }
+            }
 
-                // Otherwise, update it
-                const short mask_value = layers.mask(line, slant_range_index);
-
-                /*
-                We use bitwise-or (|) to apply new masking values while
-                preserving any existing masks
-
-                BINARY REPRESENTATION ,   CLASSIFICATION
-                       0b0000         ,    (NOT_MASKED)
-                       0b0001         ,     (SHADOW)
-                       0b0010         ,     (LAYOVER)
-                       0b0011         ,  (LAYOVER & SHADOW)
-                */
-                const short new_mask_value = mask_value | maskGrid[i];
-                if (mask_value != new_mask_value) {
-                    layers.mask(line, slant_range_index, new_mask_value);
+            // Now sort cross-track grid in terms of slant range grid
+            isce3::core::insertionSort(slantRangeGrid, ctrackGrid, maskGrid);
+
+            // Traverse from near range to far range on grid spacing for
+            // layover detection
+            double minCrossTrack = ctrackGrid[0];
+            for (int i = 1; i < gridWidth; ++i) {
+                const double crossTrack = ctrackGrid[i];
+                // Test layover
+                if (crossTrack <= minCrossTrack) {
+                    /*
+                    We use bitwise-or (|) to apply new masking values while
+                    preserving any existing masks
+
+                    BINARY REPRESENTATION ,   CLASSIFICATION
+                           0b0000         ,    (NOT_MASKED)
+                           0b0001         ,     (SHADOW)
+                           0b0010         ,     (LAYOVER)
+                           0b0011         ,  (LAYOVER & SHADOW)
+                    */
+                    maskGrid[i] |= isce3::core::LAYOVER_VALUE;
+                } else {
+                    minCrossTrack = crossTrack;
                 }
             }
-        }
 
-        _Pragma("omp atomic")
-            num_lines_done++;
-        if (line % std::max((int) (layers.length() / 100), 1) == 0)
-            _Pragma("omp critical")
-                printf("\rLayover/shadow mask progress (block %d/%d): %d%%",
-                    (int) block + 1, (int) n_blocks,
-                    (int) (num_lines_done * 1e2 / layers.length())),
-                    fflush(stdout);
+            // Traverse from far range to near range on grid spacing for
+            // layover detection
+            double maxCrossTrack = ctrackGrid[gridWidth - 1];
+            for (int i = gridWidth - 2; i >= 0; --i) {
+                const double crossTrack = ctrackGrid[i];
+                // Test layover
+                if (crossTrack >= maxCrossTrack) {
+                    maskGrid[i] |= isce3::core::LAYOVER_VALUE;
+                } else {
+                    maxCrossTrack = crossTrack;
+                }
+            }
 
-    } // end loop lines
+            // Resample maskGrid to original spacing
+            for (int i = 0; i < gridWidth; ++i) {
+                if (maskGrid[i]) {
+
+                    const long slant_range_index =
+                        lround(std::round(_radarGrid.slantRangeIndex(
+                            slantRangeGrid[i])));
+
+                    // If out of bounds, escape
+                    if (slant_range_index < 0 || slant_range_index >= width) {
+                        continue;
+                    }
+
+                    // Otherwise, update it
+                    const short mask_value =
+                            layers.mask(line, slant_range_index);
+
+                    /*
+                    We use bitwise-or (|) to apply new masking values while
+                    preserving any existing masks
+
+                    BINARY REPRESENTATION ,   CLASSIFICATION
+                           0b0000         ,    (NOT_MASKED)
+                           0b0001         ,     (SHADOW)
+                           0b0010         ,     (LAYOVER)
+                           0b0011         ,  (LAYOVER & SHADOW)
+                    */
+                    const short new_mask_value = mask_value | maskGrid[i];
+                    if (mask_value != new_mask_value) {
+                        layers.mask(line, slant_range_index, new_mask_value);
+                    }
+                }
+            }
 
-    printf("\rLayover/shadow mask progress (block %d/%d): 100%%\n",
-        (int) block + 1, (int) n_blocks), fflush(stdout);
+            _Pragma("omp atomic")
+                num_lines_done++;
+            if (line % std::max((int) (layers.length() / 100), 1) == 0)
+                _Pragma("omp critical")
+                    printf("\rLayover/shadow mask progress (block %d/%d): %d%%",
+                        (int) block + 1, (int) n_blocks,
+                        (int) (num_lines_done * 1e2 / layers.length())),
+                        fflush(stdout);
+
+        } // end loop lines
+    } // end omp parallel
 }
 
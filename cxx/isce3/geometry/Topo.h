@@ -149,6 +149,35 @@ public:
      */
     void linesPerBlock(size_t linesPerBlock) { _linesPerBlock = linesPerBlock; }
 
+    /**
+     * Set decimation of the cross-track grid of the shadow-layover mask
+     *
+     * Slant range and elevation angle are computed from the DEM at every
+     * decimation-th sample of the cross-track grid and at all samples
+     * near shadowed or laid-over coarse samples, and are linearly
+     * interpolated elsewhere. Shadow or layover regions falling entirely
+     * between two coarse samples may be missed. A value of 1 (default)
+     * computes the geometry at every sample.
+     *
+     * @param[in] decimation Decimation factor (>= 1)
+     */
+    void layoverShadowDecimation(int decimation);
+
+    /**
+     * Set memory cap of the tiled DEM cache
+     *
+     * If positive, topo() with a DEM raster accesses the entire DEM through
+     * a tile cache of at most this many bytes (see
+     * DEMInterpolator::loadDEMTiled) instead of reading the DEM subset
+     * covering each block, so that processing starts without reading the
+     * DEM up front. DEM height statistics, used as the reference height,
+     * are then computed over the entire DEM. A value of 0 (default) reads
+     * the DEM subset of each block.
+     *
+     * @param[in] maxBytes Memory cap of the DEM tile cache in bytes
+     */
+    void demTileCacheSize(size_t maxBytes) { _demTileCacheSize = maxBytes; }
+
     // Get topo processing options
 
     /** Get distance convergence threshold used for processing */
@@ -181,6 +210,12 @@ public:
     /** Get linesPerBlock */
     size_t linesPerBlock() const { return _linesPerBlock; }
 
+    /** Get decimation of the cross-track grid of the shadow-layover mask */
+    int layoverShadowDecimation() const { return _layoverShadowDecimation; }
+
+    /** Get memory cap of the tiled DEM cache (0 if disabled) */
+    size_t demTileCacheSize() const { return _demTileCacheSize; }
+
     /** Get read-only reference to RadarGridParameters */
     const isce3::product::RadarGridParameters & radarGridParameters() const { return _radarGrid; }
 
@@ -379,6 +414,22 @@ private:
                               isce3::core::Basis &,
                               DEMInterpolator &);
 
+    /**
+     * Compute the layover/shadow mask of all lines of a block
+     *
+     * @param[in] getDemCoords Conversion of output coordinates to DEM
+     *                         coordinates (see getDemCoordsSameEpsg and
+     *                         getDemCoordsDiffEpsg)
+     *
+     * Other parameters are as in setLayoverShadow()
+     */
+    template<typename DemCoordsFunc>
+    void _setLayoverShadow(TopoLayers&, DEMInterpolator&,
+                           std::vector<isce3::core::Vec3>&,
+                           size_t block,
+                           size_t n_blocks,
+                           DemCoordsFunc getDemCoords);
+
     /** Main entry point for the module; internal creation of topo rasters */
     template<typename T> void _topo(T& dem, const std::string& outdir);
 
@@ -414,6 +465,8 @@ private:
     double _margin = 0.15;        //Margin for bounding box in decimal degrees
     size_t _linesPerBlock = 1000; //Block size for processing
     bool _computeMask = true;     //Flag for generating shadow-layover mask
+    int _layoverShadowDecimation = 1; //Decimation of shadow-layover grid
+    size_t _demTileCacheSize = 0; //Memory cap of DEM tile cache (0: no tiling)
 
     isce3::core::dataInterpMethod _demMethod;
 
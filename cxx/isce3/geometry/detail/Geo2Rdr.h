@@ -41,13 +41,15 @@ struct Geo2RdrParams {
  * \param[in]  side      Radar look side
  * \param[in]  t0        Initial azimuth time guess (s)
  * \param[in]  params    Root-finding algorithm parameters
+ * \param[out] niter     Number of Newton-Raphson iterations performed
+ *                       (ignored if \p NULL)
  */
 template<class Orbit, class DopplerModel>
 CUDA_HOSTDEV isce3::error::ErrorCode
 geo2rdr(double* t, double* r, const isce3::core::Vec3& llh,
         const isce3::core::Ellipsoid& ellipsoid, const Orbit& orbit,
         const DopplerModel& doppler, double wvl, isce3::core::LookSide side,
-        double t0, const Geo2RdrParams& params = {});
+        double t0, const Geo2RdrParams& params = {}, int* niter = nullptr);
 
 
 /** Default convergence tolerance for azimuth time (seconds) */
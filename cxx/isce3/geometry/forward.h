@@ -3,6 +3,8 @@
 namespace isce3 { namespace geometry {
 
     class DEMInterpolator;
+    class DEMTileCache;
+    struct Geo2RdrStats;
     class Topo;
     class TopoLayers;
 
@@ -7,6 +7,7 @@
 
 #include "geometry.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <limits>
@@ -17,6 +18,7 @@
 #include <isce3/core/Basis.h>
 #include <isce3/core/Ellipsoid.h>
 #include <isce3/core/LUT2d.h>
+#include <isce3/core/LUT2dView.h>
 #include <isce3/core/LookSide.h>
 #include <isce3/core/Orbit.h>
 #include <isce3/core/Peg.h>
@@ -26,6 +28,7 @@
 #include <isce3/core/Vector.h>
 #include <isce3/except/Error.h>
 #include <isce3/geometry/DEMInterpolator.h>
+#include <isce3/geometry/DEMTileCache.h>
 #include <isce3/product/RadarGridParameters.h>
 
 #include "detail/Geo2Rdr.h"
@@ -245,11 +248,77 @@ int isce3::geometry::geo2rdr(const Vec3& inputLLH, const Ellipsoid& ellipsoid,
 {
     double t0 = aztime;
     detail::Geo2RdrParams params = {threshold, maxIter, deltaRange};
+    const LUT2dView<double> dopplerView(doppler);
     auto status = detail::geo2rdr(&aztime, &slantRange, inputLLH, ellipsoid,
-            orbit, doppler, wavelength, side, t0, params);
+            orbit, dopplerView, wavelength, side, t0, params);
     return (status == ErrorCode::Success);
 }
 
+size_t isce3::geometry::geo2rdrRow(const Vec3* llh, size_t n,
+        const Ellipsoid& ellipsoid, const Orbit& orbit,
+        const LUT2d<double>& doppler, double* aztime, double* slantRange,
+        double wavelength, LookSide side, double threshold, int maxIter,
+        double deltaRange, double t0, Geo2RdrStats* stats)
+{
+    const detail::Geo2RdrParams params = {threshold, maxIter, deltaRange};
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+    // evaluate the Doppler inline rather than through LUT2d's interpolator
+    const LUT2dView<double> dopplerView(doppler);
+
+    Geo2RdrStats rowStats;
+    size_t numConverged = 0;
+
+    // number of consecutive converged targets preceding the current one
+    // (only the last two matter for the predictor)
+    int numSeeds = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+
+        // predict azimuth time from the converged neighbors
+        double guess = t0;
+        if (numSeeds >= 2) {
+            guess = 2.0 * aztime[i - 1] - aztime[i - 2];
+        } else if (numSeeds == 1) {
+            guess = aztime[i - 1];
+        }
+
+        int niter = 0;
+        auto status = detail::geo2rdr(&aztime[i], &slantRange[i], llh[i],
+                ellipsoid, orbit, dopplerView, wavelength, side, guess, params,
+                &niter);
+        int iterations = niter;
+
+        // fall back to the cold start if the warm start failed
+        if (status != ErrorCode::Success and numSeeds > 0) {
+            ++rowStats.numRetries;
+            status = detail::geo2rdr(&aztime[i], &slantRange[i], llh[i],
+                    ellipsoid, orbit, dopplerView, wavelength, side, t0, params,
+                    &niter);
+            iterations += niter;
+        }
+
+        ++rowStats.numTargets;
+        rowStats.totalIterations += iterations;
+        rowStats.maxIterations = std::max(rowStats.maxIterations, iterations);
+
+        if (status == ErrorCode::Success) {
+            ++numConverged;
+            ++numSeeds;
+        } else {
+            ++rowStats.numFailed;
+            numSeeds = 0;
+            aztime[i] = nan;
+            slantRange[i] = nan;
+        }
+    }
+
+    if (stats) {
+        *stats += rowStats;
+    }
+    return numConverged;
+}
+
 // Utility function to compute geographic bounds for a radar grid
 void isce3::geometry::computeDEMBounds(const Orbit& orbit,
         const Ellipsoid& ellipsoid, const LUT2d<double>& doppler,
@@ -621,7 +690,12 @@ double isce3::geometry::compute_mean_dem(const DEMInterpolator& dem)
     if (dem.haveRaster()) {
         if (dem.haveStats())
             return dem.meanHeight();
-        else {
+        else if (dem.isTiled()) {
+            float min, max, mean;
+            if (not dem.tileCache()->computeStats(min, max, mean))
+                return dem.refHeight();
+            return mean;
+        } else {
             double mean = 0.0;
             auto n_valid = dem.length() * dem.width();
             const auto d = dem.data();
@@ -18,6 +18,7 @@
 #include <isce3/core/forward.h>
 #include <isce3/product/forward.h>
 
+#include <algorithm>
 #include <optional>
 #include <tuple>
 
@@ -184,6 +185,88 @@ int geo2rdr(const isce3::core::Vec3& inputLLH,
         double& slantRange, double wavelength, isce3::core::LookSide side,
         double threshold, int maxIter, double deltaRange);
 
+/** Iteration statistics accumulated by isce3::geometry::geo2rdrRow */
+struct Geo2RdrStats {
+    /** Number of targets processed */
+    size_t numTargets = 0;
+
+    /** Number of targets that failed to converge */
+    size_t numFailed = 0;
+
+    /** Number of warm-started solves that were retried from the cold guess */
+    size_t numRetries = 0;
+
+    /** Total number of Newton-Raphson iterations */
+    size_t totalIterations = 0;
+
+    /** Largest number of Newton-Raphson iterations spent on one target */
+    int maxIterations = 0;
+
+    /** Mean number of Newton-Raphson iterations per target */
+    double meanIterations() const
+    {
+        return numTargets > 0 ? static_cast<double>(totalIterations) /
+                                        numTargets
+                              : 0.0;
+    }
+
+    /** Merge statistics, e.g. of another row or thread */
+    Geo2RdrStats& operator+=(const Geo2RdrStats& other)
+    {
+        numTargets += other.numTargets;
+        numFailed += other.numFailed;
+        numRetries += other.numRetries;
+        totalIterations += other.totalIterations;
+        maxIterations = std::max(maxIterations, other.maxIterations);
+        return *this;
+    }
+};
+
+/**
+ * Map coordinates to radar geometry coordinates transformer for a row of
+ * neighboring targets
+ *
+ * Solves geo2rdr for \p n targets that are adjacent on a map grid (e.g. one
+ * line of a geocoded grid). Instead of starting every solve from the same
+ * initial guess, each target is warm-started from the converged azimuth
+ * time of its neighbors: a linear predictor through the two preceding
+ * solutions, or the preceding solution alone when only one is available.
+ * Since neighboring targets have nearly identical solutions this typically
+ * cuts the number of Newton-Raphson iterations per target by more than
+ * half. A warm-started solve that fails is retried from \p t0, so the
+ * converged set matches that of per-target geo2rdr calls with initial guess
+ * \p t0.
+ *
+ * Targets that fail to converge are assigned NaN azimuth time and slant
+ * range. A failed target does not seed its successors.
+ *
+ * @param[in]  llh        Lon/Lat/Hae of the \p n targets
+ * @param[in]  n          Number of targets
+ * @param[in]  ellipsoid  Ellipsoid object
+ * @param[in]  orbit      Orbit object
+ * @param[in]  doppler    LUT2d Doppler model
+ * @param[out] aztime     azimuth time of each target w.r.t reference epoch of
+ * the orbit (array of length \p n)
+ * @param[out] slantRange slant range to each target (array of length \p n)
+ * @param[in]  wavelength Radar wavelength
+ * @param[in]  side       Left or Right
+ * @param[in]  threshold  azimuth time convergence threshold in seconds
+ * @param[in]  maxIter    Maximum number of Newton-Raphson iterations
+ * @param[in]  deltaRange step size used for computing derivative of doppler
+ * @param[in]  t0         Initial azimuth time guess of the first target and
+ * fallback guess of targets without a converged neighbor
+ * @param[in,out] stats   Iteration statistics to accumulate into (ignored if
+ * nullptr)
+ * @returns number of targets that converged
+ */
+size_t geo2rdrRow(const isce3::core::Vec3* llh, size_t n,
+        const isce3::core::Ellipsoid& ellipsoid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& doppler, double* aztime,
+        double* slantRange, double wavelength, isce3::core::LookSide side,
+        double threshold, int maxIter, double deltaRange, double t0,
+        Geo2RdrStats* stats = nullptr);
+
 /**
  * Utility function to compute geographic bounds for a radar grid
  *
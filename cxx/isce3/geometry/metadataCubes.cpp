@@ -1,12 +1,16 @@
 #include "metadataCubes.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 #include <isce3/core/DenseMatrix.h>
 #include <isce3/core/Matrix.h>
 #include <isce3/core/Projections.h>
 #include <isce3/core/LUT2d.h>
+#include <isce3/core/LUT2dView.h>
 #include <isce3/core/Orbit.h>
 #include <isce3/io/Raster.h>
 #include <isce3/error/ErrorCode.h>
@@ -58,14 +62,40 @@ getNanArrayRadarGrid(isce3::io::Raster* raster,
 }
 
 template<class T>
-static void writeArray(isce3::io::Raster* raster,
-        isce3::core::Matrix<T>& data_array, int height_count)
+static std::vector<isce3::core::Matrix<T>>
+getNanCube(isce3::io::Raster* raster,
+           const isce3::product::GeoGridParameters& geogrid, int n_heights)
+{
+    std::vector<isce3::core::Matrix<T>> cube(n_heights);
+    for (auto& data_array : cube) {
+        data_array = getNanArray<T>(raster, geogrid);
+    }
+    return cube;
+}
+
+template<class T>
+static std::vector<isce3::core::Matrix<T>>
+getNanCubeRadarGrid(isce3::io::Raster* raster,
+                    const isce3::product::RadarGridParameters& radar_grid,
+                    int n_heights)
+{
+    std::vector<isce3::core::Matrix<T>> cube(n_heights);
+    for (auto& data_array : cube) {
+        data_array = getNanArrayRadarGrid<T>(raster, radar_grid);
+    }
+    return cube;
+}
+
+template<class T>
+static void writeCube(isce3::io::Raster* raster,
+        std::vector<isce3::core::Matrix<T>>& cube)
 {
     if (raster == nullptr) {
         return;
     }
-#pragma omp critical
-    {
+    for (size_t height_count = 0; height_count < cube.size();
+            ++height_count) {
+        auto& data_array = cube[height_count];
         raster->setBlock(data_array.data(), 0, 0, data_array.width(),
                          data_array.length(), height_count + 1);
     }
@@ -308,113 +338,132 @@ void makeRadarGridCubes(const isce3::product::RadarGridParameters& radar_grid,
     isce3::core::Vec3* terrain_normal_vector = nullptr;
     isce3::core::LookSide* lookside = nullptr;
 
-#pragma omp parallel for
-    for (int height_count = 0; height_count < heights.size(); ++height_count) {
-
-        auto proj = isce3::core::makeProjection(geogrid.epsg());
-        double azimuth_time = radar_grid.sensingMid();
-        double native_azimuth_time = radar_grid.sensingMid();
-        double slant_range = radar_grid.midRange();
-        double native_slant_range = radar_grid.midRange();
-        auto height = heights[height_count];
-
-        const isce3::core::Ellipsoid& ellipsoid = proj->ellipsoid();
-        auto slant_range_array =
-                getNanArray<double>(slant_range_raster, geogrid);
-        auto azimuth_time_array =
-                getNanArray<double>(azimuth_time_raster, geogrid);
-        auto incidence_angle_array =
-                getNanArray<float>(incidence_angle_raster, geogrid);
-        auto los_unit_vector_x_array =
-                getNanArray<float>(los_unit_vector_x_raster, geogrid);
-        auto los_unit_vector_y_array =
-                getNanArray<float>(los_unit_vector_y_raster, geogrid);
-        auto along_track_unit_vector_x_array =
-                getNanArray<float>(along_track_unit_vector_x_raster, geogrid);
-        auto along_track_unit_vector_y_array =
-                getNanArray<float>(along_track_unit_vector_y_raster, geogrid);
-        auto elevation_angle_array =
-                getNanArray<float>(elevation_angle_raster, geogrid);
-        auto ground_track_velocity_array =
-                getNanArray<double>(ground_track_velocity_raster, geogrid);
-
-        for (int i = 0; i < geogrid.length(); ++i) {
-            double pos_y = geogrid.startY() + (0.5 + i) * geogrid.spacingY();
-            for (int j = 0; j < geogrid.width(); ++j) {
-                double pos_x =
+    const int n_heights = heights.size();
+    const int length = geogrid.length();
+    const int width = geogrid.width();
+
+    // Cube layers are buffered in memory for all heights so that the
+    // (height, line) pairs can be processed in any order
+    auto slant_range_cube =
+            getNanCube<double>(slant_range_raster, geogrid, n_heights);
+    auto azimuth_time_cube =
+            getNanCube<double>(azimuth_time_raster, geogrid, n_heights);
+    auto incidence_angle_cube =
+            getNanCube<float>(incidence_angle_raster, geogrid, n_heights);
+    auto los_unit_vector_x_cube =
+            getNanCube<float>(los_unit_vector_x_raster, geogrid, n_heights);
+    auto los_unit_vector_y_cube =
+            getNanCube<float>(los_unit_vector_y_raster, geogrid, n_heights);
+    auto along_track_unit_vector_x_cube = getNanCube<float>(
+            along_track_unit_vector_x_raster, geogrid, n_heights);
+    auto along_track_unit_vector_y_cube = getNanCube<float>(
+            along_track_unit_vector_y_raster, geogrid, n_heights);
+    auto elevation_angle_cube =
+            getNanCube<float>(elevation_angle_raster, geogrid, n_heights);
+    auto ground_track_velocity_cube = getNanCube<double>(
+            ground_track_velocity_raster, geogrid, n_heights);
+
+    // Check if the native Doppler geometry is needed
+    const bool flag_vector_cubes =
+            incidence_angle_raster != nullptr ||
+            los_unit_vector_x_raster != nullptr ||
+            los_unit_vector_y_raster != nullptr ||
+            along_track_unit_vector_x_raster != nullptr ||
+            along_track_unit_vector_y_raster != nullptr ||
+            elevation_angle_raster != nullptr ||
+            ground_track_velocity_raster != nullptr;
+
+#pragma omp parallel
+    {
+    auto proj = isce3::core::makeProjection(geogrid.epsg());
+    const isce3::core::Ellipsoid& ellipsoid = proj->ellipsoid();
+
+    // Per-line work arrays
+    std::vector<isce3::core::Vec3> target_llh(width);
+    std::vector<double> azimuth_time(width), slant_range(width);
+    std::vector<double> native_azimuth_time(width), native_slant_range(width);
+
+    // Parallelize over (height, line) pairs, so that cubes with few heights
+    // still keep all threads busy
+#pragma omp for collapse(2) schedule(dynamic)
+    for (int height_count = 0; height_count < n_heights; ++height_count) {
+        for (int i = 0; i < length; ++i) {
+            const double height = heights[height_count];
+            const double pos_y =
+                    geogrid.startY() + (0.5 + i) * geogrid.spacingY();
+
+            // Get target coordinates in llh
+            for (int j = 0; j < width; ++j) {
+                const double pos_x =
                         geogrid.startX() + (0.5 + j) * geogrid.spacingX();
+                target_llh[j] = proj->inverse({pos_x, pos_y, height});
+            }
 
-                // Get target coordinates in the output projection system
-                const isce3::core::Vec3 target_proj {pos_x, pos_y, height};
-
-                // Get target coordinates in llh
-                const isce3::core::Vec3 target_llh = proj->inverse(target_proj);
-
-                // Get grid Doppler azimuth and slant-range position
-                int converged = isce3::geometry::geo2rdr(
-                        target_llh, ellipsoid, orbit, grid_doppler,
-                        azimuth_time, slant_range, radar_grid.wavelength(),
-                        radar_grid.lookSide(), threshold_geo2rdr,
-                        numiter_geo2rdr, delta_range);
-
+            /*
+            Get grid Doppler azimuth and slant-range positions of the line,
+            warm-starting each target from its neighbors
+            */
+            isce3::geometry::geo2rdrRow(target_llh.data(), width, ellipsoid,
+                    orbit, grid_doppler, azimuth_time.data(),
+                    slant_range.data(), radar_grid.wavelength(),
+                    radar_grid.lookSide(), threshold_geo2rdr,
+                    numiter_geo2rdr, delta_range, radar_grid.sensingMid());
+
+            for (int j = 0; j < width; ++j) {
                 // Check convergence
-                if (!converged) {
-                    azimuth_time = radar_grid.sensingMid();
-                    slant_range = radar_grid.midRange();
+                if (std::isnan(azimuth_time[j])) {
                     continue;
                 }
 
                 // save grid Doppler slant-range position
                 if (slant_range_raster != nullptr) {
-                    slant_range_array(i, j) = slant_range;
+                    slant_range_cube[height_count](i, j) = slant_range[j];
                 }
 
                 // Save grid Doppler azimuth position
                 if (azimuth_time_raster != nullptr) {
-                    azimuth_time_array(i, j) = azimuth_time;
-                }
-
-                // If nothing else to save, skip
-                if (incidence_angle_raster == nullptr &&
-                    los_unit_vector_x_raster == nullptr &&
-                    los_unit_vector_y_raster == nullptr &&
-                    along_track_unit_vector_x_raster == nullptr &&
-                    along_track_unit_vector_y_raster == nullptr &&
-                    elevation_angle_raster == nullptr &&
-                    ground_track_velocity_raster == nullptr) {
-                    continue;
+                    azimuth_time_cube[height_count](i, j) = azimuth_time[j];
                 }
+            }
 
-                /*
-                To retrieve platform position (considering
-                native Doppler), estimate native_azimuth_time
-                */
-                converged = isce3::geometry::geo2rdr(
-                        target_llh, ellipsoid, orbit, native_doppler,
-                        native_azimuth_time, native_slant_range,
-                        radar_grid.wavelength(), radar_grid.lookSide(),
-                        threshold_geo2rdr, numiter_geo2rdr, delta_range);
+            // If nothing else to save, skip
+            if (!flag_vector_cubes) {
+                continue;
+            }
 
+            /*
+            To retrieve platform position (considering
+            native Doppler), estimate native_azimuth_time
+            */
+            isce3::geometry::geo2rdrRow(target_llh.data(), width, ellipsoid,
+                    orbit, native_doppler, native_azimuth_time.data(),
+                    native_slant_range.data(), radar_grid.wavelength(),
+                    radar_grid.lookSide(), threshold_geo2rdr,
+                    numiter_geo2rdr, delta_range, radar_grid.sensingMid());
+
+            for (int j = 0; j < width; ++j) {
                 // Check convergence
-                if (!converged) {
-                    native_azimuth_time = radar_grid.sensingMid();
-                    native_slant_range = radar_grid.midRange();
+                if (std::isnan(azimuth_time[j]) ||
+                        std::isnan(native_azimuth_time[j])) {
                     continue;
                 }
 
                 isce3::geometry::writeVectorDerivedCubes(i, j,
-                        native_azimuth_time, target_llh, orbit, ellipsoid,
-                        incidence_angle_raster, incidence_angle_array,
-                        los_unit_vector_x_raster, los_unit_vector_x_array,
-                        los_unit_vector_y_raster, los_unit_vector_y_array,
+                        native_azimuth_time[j], target_llh[j], orbit,
+                        ellipsoid, incidence_angle_raster,
+                        incidence_angle_cube[height_count],
+                        los_unit_vector_x_raster,
+                        los_unit_vector_x_cube[height_count],
+                        los_unit_vector_y_raster,
+                        los_unit_vector_y_cube[height_count],
                         along_track_unit_vector_x_raster,
-                        along_track_unit_vector_x_array,
+                        along_track_unit_vector_x_cube[height_count],
                         along_track_unit_vector_y_raster,
-                        along_track_unit_vector_y_array, 
+                        along_track_unit_vector_y_cube[height_count],
                         elevation_angle_raster,
-                        elevation_angle_array,
+                        elevation_angle_cube[height_count],
                         ground_track_velocity_raster,
-                        ground_track_velocity_array,
+                        ground_track_velocity_cube[height_count],
                         local_incidence_angle_raster,
                         local_incidence_angle_array,
                         projection_angle_raster,
@@ -424,22 +473,21 @@ void makeRadarGridCubes(const isce3::product::RadarGridParameters& radar_grid,
                         terrain_normal_vector, lookside);
             }
         }
-
-        writeArray(slant_range_raster, slant_range_array, height_count);
-        writeArray(azimuth_time_raster, azimuth_time_array, height_count);
-        writeArray(incidence_angle_raster, incidence_angle_array, height_count);
-        writeArray(los_unit_vector_x_raster, los_unit_vector_x_array,
-                   height_count);
-        writeArray(los_unit_vector_y_raster, los_unit_vector_y_array,
-                   height_count);
-        writeArray(along_track_unit_vector_x_raster,
-                   along_track_unit_vector_x_array, height_count);
-        writeArray(along_track_unit_vector_y_raster,
-                   along_track_unit_vector_y_array, height_count);
-        writeArray(elevation_angle_raster, elevation_angle_array, height_count);
-        writeArray(ground_track_velocity_raster, ground_track_velocity_array,
-                   height_count);
     }
+    } // end omp parallel
+
+    // Write all layers, one height per band
+    writeCube(slant_range_raster, slant_range_cube);
+    writeCube(azimuth_time_raster, azimuth_time_cube);
+    writeCube(incidence_angle_raster, incidence_angle_cube);
+    writeCube(los_unit_vector_x_raster, los_unit_vector_x_cube);
+    writeCube(los_unit_vector_y_raster, los_unit_vector_y_cube);
+    writeCube(along_track_unit_vector_x_raster,
+              along_track_unit_vector_x_cube);
+    writeCube(along_track_unit_vector_y_raster,
+              along_track_unit_vector_y_cube);
+    writeCube(elevation_angle_raster, elevation_angle_cube);
+    writeCube(ground_track_velocity_raster, ground_track_velocity_cube);
 
     if (!flag_set_output_rasters_geolocation) {
         return;
@@ -522,140 +570,200 @@ void makeGeolocationGridCubes(
     isce3::core::Vec3* terrain_normal_vector = nullptr;
     isce3::core::LookSide* lookside = nullptr;
 
-    #pragma omp parallel for
-    for (int height_count = 0; height_count < heights.size(); ++height_count) {
-
-        auto proj = isce3::core::makeProjection(epsg);
-        const isce3::core::Ellipsoid& ellipsoid = proj->ellipsoid();
-
-        auto coordinate_x_array = 
-                getNanArrayRadarGrid<double>(coordinate_x_raster, radar_grid);
-        auto coordinate_y_array =
-                getNanArrayRadarGrid<double>(coordinate_y_raster, radar_grid);
-        auto incidence_angle_array =
-                getNanArrayRadarGrid<float>(incidence_angle_raster, radar_grid);
-        auto los_unit_vector_x_array =
-                getNanArrayRadarGrid<float>(los_unit_vector_x_raster, radar_grid);
-        auto los_unit_vector_y_array =
-                getNanArrayRadarGrid<float>(los_unit_vector_y_raster, radar_grid);
-        auto along_track_unit_vector_x_array =
-                getNanArrayRadarGrid<float>(along_track_unit_vector_x_raster, radar_grid);
-        auto along_track_unit_vector_y_array =
-                getNanArrayRadarGrid<float>(along_track_unit_vector_y_raster, radar_grid);
-        auto elevation_angle_array =
-                getNanArrayRadarGrid<float>(elevation_angle_raster, radar_grid);
-        auto ground_track_velocity_array =
-                getNanArrayRadarGrid<double>(ground_track_velocity_raster, radar_grid);
-
-        auto height = heights[height_count];
-        isce3::geometry::DEMInterpolator dem_interpolator(height, epsg);
-        double native_azimuth_time = radar_grid.sensingMid();
-        double native_slant_range = radar_grid.midRange();
-
-        for (int i = 0; i < radar_grid.length(); ++i) {
-            double az_time = radar_grid.sensingTime(i);
-            for (int j = 0; j < radar_grid.width(); ++j) {
-                double slant_range = radar_grid.slantRange(j);
-                Vec3 target_llh;
-                /*
-                Skip processing for radar grid points outside grid doppler
-                */
-                if (!grid_doppler.contains(az_time, slant_range)) {
-                    continue;
-                }
+    const int n_heights = heights.size();
+    const int length = radar_grid.length();
+    const int width = radar_grid.width();
+
+    // Cube layers are buffered in memory for all heights so that the
+    // (height, line) pairs can be processed in any order
+    auto coordinate_x_cube = getNanCubeRadarGrid<double>(
+            coordinate_x_raster, radar_grid, n_heights);
+    auto coordinate_y_cube = getNanCubeRadarGrid<double>(
+            coordinate_y_raster, radar_grid, n_heights);
+    auto incidence_angle_cube = getNanCubeRadarGrid<float>(
+            incidence_angle_raster, radar_grid, n_heights);
+    auto los_unit_vector_x_cube = getNanCubeRadarGrid<float>(
+            los_unit_vector_x_raster, radar_grid, n_heights);
+    auto los_unit_vector_y_cube = getNanCubeRadarGrid<float>(
+            los_unit_vector_y_raster, radar_grid, n_heights);
+    auto along_track_unit_vector_x_cube = getNanCubeRadarGrid<float>(
+            along_track_unit_vector_x_raster, radar_grid, n_heights);
+    auto along_track_unit_vector_y_cube = getNanCubeRadarGrid<float>(
+            along_track_unit_vector_y_raster, radar_grid, n_heights);
+    auto elevation_angle_cube = getNanCubeRadarGrid<float>(
+            elevation_angle_raster, radar_grid, n_heights);
+    auto ground_track_velocity_cube = getNanCubeRadarGrid<double>(
+            ground_track_velocity_raster, radar_grid, n_heights);
+
+    // Check if the native Doppler geometry is needed
+    const bool flag_vector_cubes =
+            incidence_angle_raster != nullptr ||
+            los_unit_vector_x_raster != nullptr ||
+            los_unit_vector_y_raster != nullptr ||
+            along_track_unit_vector_x_raster != nullptr ||
+            along_track_unit_vector_y_raster != nullptr ||
+            elevation_angle_raster != nullptr ||
+            ground_track_velocity_raster != nullptr;
+
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+    // Slant ranges of the radar grid columns
+    std::vector<double> slant_range(width);
+    for (int j = 0; j < width; ++j) {
+        slant_range[j] = radar_grid.slantRange(j);
+    }
 
-                /*
-                Get target position (target_llh) considering grid Doppler
-                */
-                double fd = grid_doppler.eval(az_time, slant_range);
-                target_llh[2] = height;
+    // Evaluate the grid Doppler of each line in a single batched call
+    const isce3::core::LUT2dView<double> grid_doppler_view(grid_doppler);
 
+#pragma omp parallel
+    {
+    auto proj = isce3::core::makeProjection(epsg);
+    const isce3::core::Ellipsoid& ellipsoid = proj->ellipsoid();
+
+    // Per-line work arrays
+    std::vector<double> fd(width);
+    std::vector<isce3::core::Vec3> target_llh(width);
+    std::vector<double> native_azimuth_time(width), native_slant_range(width);
+
+    // Parallelize over (height, line) pairs, so that cubes with few heights
+    // still keep all threads busy
+#pragma omp for collapse(2) schedule(dynamic)
+    for (int height_count = 0; height_count < n_heights; ++height_count) {
+        for (int i = 0; i < length; ++i) {
+            const double height = heights[height_count];
+            const isce3::geometry::DEMInterpolator dem_interpolator(
+                    height, epsg);
+            const double az_time = radar_grid.sensingTime(i);
+
+            /*
+            Skip processing for radar grid points outside grid doppler.
+            Slant ranges increase along the line, so the points inside
+            the grid Doppler LUT are the columns [j_start, j_end)
+            */
+            auto inside_grid_doppler = [&](int j) {
+                return grid_doppler_view.contains(az_time, slant_range[j]);
+            };
+            int j_start = 0;
+            while (j_start < width && !inside_grid_doppler(j_start)) {
+                ++j_start;
+            }
+            int j_end = j_start;
+            while (j_end < width && inside_grid_doppler(j_end)) {
+                ++j_end;
+            }
+            if (j_start == j_end) {
+                continue;
+            }
+            grid_doppler_view.eval(az_time, &slant_range[j_start],
+                                   &fd[j_start], j_end - j_start);
+
+            /*
+            Get target positions (target_llh) considering grid Doppler
+            */
+            for (int j = j_start; j < j_end; ++j) {
+                target_llh[j] = {0, 0, height};
                 auto converged =
-                        rdr2geo(az_time, slant_range, fd, orbit, ellipsoid,
-                                dem_interpolator, target_llh,
+                        rdr2geo(az_time, slant_range[j], fd[j], orbit,
+                                ellipsoid, dem_interpolator, target_llh[j],
                                 radar_grid.wavelength(),
                                 radar_grid.lookSide(), threshold_geo2rdr,
                                 numiter_geo2rdr, delta_range);
 
-                // Check convergence
+                // Check convergence (failed targets are flagged with a NaN
+                // longitude)
                 if (!converged) {
+                    target_llh[j][0] = nan;
                     continue;
                 }
 
                 // Get target position in the output proj system
-                isce3::core::Vec3 target_proj = proj->forward(target_llh);
+                isce3::core::Vec3 target_proj = proj->forward(target_llh[j]);
 
                 if (coordinate_x_raster != nullptr) {
-                    coordinate_x_array(i, j) = target_proj[0];
+                    coordinate_x_cube[height_count](i, j) = target_proj[0];
                 }
                 if (coordinate_y_raster != nullptr) {
-                    coordinate_y_array(i, j) = target_proj[1];
-                }
-
-                // If nothing else to save, skip
-                if (incidence_angle_raster == nullptr &&
-                        los_unit_vector_x_raster == nullptr &&
-                        los_unit_vector_y_raster == nullptr &&
-                        along_track_unit_vector_x_raster == nullptr &&
-                        along_track_unit_vector_y_raster == nullptr &&
-                        elevation_angle_raster == nullptr &&
-                        ground_track_velocity_raster == nullptr) {
-                    continue;
+                    coordinate_y_cube[height_count](i, j) = target_proj[1];
                 }
+            }
 
-                /*
-                To retrieve platform position (considering
-                native Doppler), estimate native_azimuth_time 
-                */
-                converged = geo2rdr(target_llh, ellipsoid, orbit, native_doppler,
-                        native_azimuth_time, native_slant_range,
-                        radar_grid.wavelength(), radar_grid.lookSide(),
-                        threshold_geo2rdr, numiter_geo2rdr, delta_range);
+            // If nothing else to save, skip
+            if (!flag_vector_cubes) {
+                continue;
+            }
 
-                // Check convergence
-                if (!converged) {
-                    native_azimuth_time = radar_grid.sensingMid();
-                    native_slant_range = radar_grid.midRange();
+            /*
+            To retrieve platform position (considering
+            native Doppler), estimate native_azimuth_time of the converged
+            targets, warm-starting each target from its neighbors
+            */
+            int j = j_start;
+            while (j < j_end) {
+                // Find the next run of converged targets
+                if (std::isnan(target_llh[j][0])) {
+                    ++j;
                     continue;
                 }
+                int j_run_end = j + 1;
+                while (j_run_end < j_end &&
+                        !std::isnan(target_llh[j_run_end][0])) {
+                    ++j_run_end;
+                }
 
-                writeVectorDerivedCubes(i, j, native_azimuth_time, target_llh,
-                        orbit, ellipsoid,
-                        incidence_angle_raster, incidence_angle_array,
-                        los_unit_vector_x_raster, los_unit_vector_x_array,
-                        los_unit_vector_y_raster, los_unit_vector_y_array,
-                        along_track_unit_vector_x_raster,
-                        along_track_unit_vector_x_array,
-                        along_track_unit_vector_y_raster,
-                        along_track_unit_vector_y_array, 
-                        elevation_angle_raster,
-                        elevation_angle_array,
-                        ground_track_velocity_raster,
-                        ground_track_velocity_array,
-                        local_incidence_angle_raster,
-                        local_incidence_angle_array,
-                        projection_angle_raster,
-                        projection_angle_array,
-                        simulated_radar_brightness_raster,
-                        simulated_radar_brightness_array,
-                        terrain_normal_vector, lookside);
+                geo2rdrRow(&target_llh[j], j_run_end - j, ellipsoid, orbit,
+                        native_doppler, &native_azimuth_time[j],
+                        &native_slant_range[j], radar_grid.wavelength(),
+                        radar_grid.lookSide(), threshold_geo2rdr,
+                        numiter_geo2rdr, delta_range, radar_grid.sensingMid());
+
+                for (; j < j_run_end; ++j) {
+                    // Check convergence
+                    if (std::isnan(native_azimuth_time[j])) {
+                        continue;
+                    }
+
+                    writeVectorDerivedCubes(i, j, native_azimuth_time[j],
+                            target_llh[j], orbit, ellipsoid,
+                            incidence_angle_raster,
+                            incidence_angle_cube[height_count],
+                            los_unit_vector_x_raster,
+                            los_unit_vector_x_cube[height_count],
+                            los_unit_vector_y_raster,
+                            los_unit_vector_y_cube[height_count],
+                            along_track_unit_vector_x_raster,
+                            along_track_unit_vector_x_cube[height_count],
+                            along_track_unit_vector_y_raster,
+                            along_track_unit_vector_y_cube[height_count],
+                            elevation_angle_raster,
+                            elevation_angle_cube[height_count],
+                            ground_track_velocity_raster,
+                            ground_track_velocity_cube[height_count],
+                            local_incidence_angle_raster,
+                            local_incidence_angle_array,
+                            projection_angle_raster,
+                            projection_angle_array,
+                            simulated_radar_brightness_raster,
+                            simulated_radar_brightness_array,
+                            terrain_normal_vector, lookside);
+                }
             }
         }
-        writeArray(coordinate_x_raster, coordinate_x_array, height_count);
-        writeArray(coordinate_y_raster, coordinate_y_array, height_count);
-        writeArray(incidence_angle_raster, incidence_angle_array, height_count);
-        writeArray(los_unit_vector_x_raster, los_unit_vector_x_array,
-                   height_count);
-        writeArray(los_unit_vector_y_raster, los_unit_vector_y_array,
-                   height_count);
-        writeArray(along_track_unit_vector_x_raster,
-                   along_track_unit_vector_x_array, height_count);
-        writeArray(along_track_unit_vector_y_raster,
-                   along_track_unit_vector_y_array, height_count);
-        writeArray(elevation_angle_raster, elevation_angle_array, height_count);
-        writeArray(ground_track_velocity_raster, ground_track_velocity_array, 
-                   height_count);
     }
+    } // end omp parallel
+
+    // Write all layers, one height per band
+    writeCube(coordinate_x_raster, coordinate_x_cube);
+    writeCube(coordinate_y_raster, coordinate_y_cube);
+    writeCube(incidence_angle_raster, incidence_angle_cube);
+    writeCube(los_unit_vector_x_raster, los_unit_vector_x_cube);
+    writeCube(los_unit_vector_y_raster, los_unit_vector_y_cube);
+    writeCube(along_track_unit_vector_x_raster,
+              along_track_unit_vector_x_cube);
+    writeCube(along_track_unit_vector_y_raster,
+              along_track_unit_vector_y_cube);
+    writeCube(elevation_angle_raster, elevation_angle_cube);
+    writeCube(ground_track_velocity_raster, ground_track_velocity_cube);
 }
 }
 }
@@ -105,6 +105,11 @@ void writeVectorDerivedCubes(const int array_pos_i,
  * then be used to interpolate the metadata cubes and generate
  * high-resolution maps of the corresponding radar geometry variable.
  *
+ * The cubes are computed in parallel over (height, line) pairs, with the
+ * geo2rdr solutions of each line warm-started from neighboring targets.
+ * All requested layers are buffered in memory for every height and
+ * written once at the end.
+ *
  * Each output layer is saved onto the first band of its
  * associated raster file.
  * 
@@ -180,6 +185,11 @@ void makeRadarGridCubes(const isce3::product::RadarGridParameters& radar_grid,
  * then be used to interpolate the metadata cubes and generate
  * high-resolution maps of the corresponding radar geometry variable.
  *
+ * The cubes are computed in parallel over (height, line) pairs, with the
+ * geo2rdr solutions of each line warm-started from neighboring targets.
+ * All requested layers are buffered in memory for every height and
+ * written once at the end.
+ *
  * Each output layer is saved onto the first band of its
  * associated raster file.
  * 
@@ -271,6 +271,23 @@ void ResampSlc::_transformTile(Tile_t& originalTile, Raster& outputSlc,
     // Initialize/fill with invalid values
     resampledTile = _invalid_value;
 
+    // Tabulate separable sinc weights once if polyphase mode is requested.
+    // Reuse the sinc interpolator setup so the weights only differ from the
+    // default mode by the number of phases.
+    const bool usePolyphase = _polyphaseFactor > 0;
+    isce3::core::Matrix<float> polyphaseTable;
+    if (usePolyphase) {
+        const isce3::core::Sinc2dInterpolator<std::complex<float>> sinc(
+                chipSize - 1, _polyphaseFactor);
+        const auto& kernel = sinc.kernel();
+        polyphaseTable.resize(kernel.length(), kernel.width());
+        for (size_t i = 0; i < kernel.length(); ++i) {
+            for (size_t j = 0; j < kernel.width(); ++j) {
+                polyphaseTable(i, j) = static_cast<float>(kernel(i, j));
+            }
+        }
+    }
+
     // From this point on, transformation is multithreaded
     size_t tileLine = 0;
     _Pragma("omp parallel shared(resampledTile)")
@@ -360,6 +377,16 @@ void ResampSlc::_transformTile(Tile_t& originalTile, Raster& outputSlc,
                               ((1.0 / _refWavelength) - (1.0 / _wavelength)));
                 }
 
+                // Interpolate directly from the tile with tabulated weights
+                if (usePolyphase) {
+                    const std::complex<float> cval = _polyphaseInterp(
+                            originalTile, polyphaseTable, iRowResampled,
+                            iColResampled, fracAz, fracRg, dop);
+                    resampledTile[tileLine * outWidth + iCol] = cval *
+                            std::complex<float>(std::cos(phase), std::sin(phase));
+                    continue;
+                }
+
                 // Read data chip without the carrier phases
                 for (int iChipRow = 0; iChipRow < chipSize; ++iChipRow) {
                     // Row to read from
@@ -400,4 +427,52 @@ void ResampSlc::_transformTile(Tile_t& originalTile, Raster& outputSlc,
     outputSlc.setBlock(resampledTile, 0, originalTile.rowStart(), outWidth, outLength);
 }
 
+// Separable interpolation of one pixel using a polyphase weight table
+std::complex<float> ResampSlc::_polyphaseInterp(
+        const Tile_t& tile, const isce3::core::Matrix<float>& table,
+        size_t iRowResampled, size_t iColResampled, double fracAz,
+        double fracRg, double dop) const
+{
+    const int nphase = table.length();
+    const int ntaps = table.width();
+    const int halfTaps = ntaps / 2;
+
+    // Split fractional offsets in [-0.5, 0.5] into an integer shift and a
+    // phase in [0, 1) using the same convention as Sinc2dInterpolator.
+    const double floorAz = std::floor(fracAz);
+    const double floorRg = std::floor(fracRg);
+    const int phaseAz = std::min(std::max(0,
+            static_cast<int>((fracAz - floorAz) * nphase)), nphase - 1);
+    const int phaseRg = std::min(std::max(0,
+            static_cast<int>((fracRg - floorRg) * nphase)), nphase - 1);
+    const float* wAz = &table(phaseAz, 0);
+    const float* wRg = &table(phaseRg, 0);
+
+    // Taps run backwards from these tile indices.
+    const long rowLast = static_cast<long>(iRowResampled)
+            - static_cast<long>(tile.firstImageRow())
+            + static_cast<long>(floorAz) + halfTaps;
+    const long colLast = static_cast<long>(iColResampled)
+            + static_cast<long>(floorRg) + halfTaps;
+
+    // Azimuth Doppler phasor of the first tap, advanced by recurrence.
+    std::complex<double> deramp =
+            std::polar(1.0, -dop * (floorAz + halfTaps));
+    const std::complex<double> step = std::polar(1.0, dop);
+
+    std::complex<float> sum(0.0f, 0.0f);
+    for (int i = 0; i < ntaps; ++i) {
+        const std::complex<float>* row = &tile(rowLast - i, colLast);
+        // Range interpolation along one line
+        std::complex<float> rowSum(0.0f, 0.0f);
+        for (int j = 0; j < ntaps; ++j) {
+            rowSum += row[-j] * wRg[j];
+        }
+        // Azimuth interpolation after removing the Doppler
+        sum += rowSum * (wAz[i] * std::complex<float>(deramp));
+        deramp *= step;
+    }
+    return sum;
+}
+
 }} // namespace isce3::image
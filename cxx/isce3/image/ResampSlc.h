@@ -12,6 +12,7 @@
 
 #include <isce3/core/Interpolator.h>
 #include <isce3/core/Poly2d.h>
+#include <isce3/except/Error.h>
 #include <isce3/product/RadarGridProduct.h>
 #include <isce3/product/RadarGridParameters.h>
 
@@ -111,6 +112,23 @@ public:
     size_t linesPerTile() const;
     void linesPerTile(size_t);
 
+    /** Get number of phases of the polyphase interpolation table
+     * (0 if polyphase mode is disabled) */
+    int polyphaseFactor() const;
+
+    /** Set number of phases of the polyphase interpolation table.
+     *
+     * When nonzero, fractional offsets are quantized to this many phases
+     * and each output pixel is formed with separable range/azimuth weights
+     * read from a table precomputed once per resamp() call, instead of
+     * copying a chip and calling the 2D sinc interpolator.  Fewer phases
+     * give a smaller, more cache-friendly table at the cost of a larger
+     * quantization error (at most 1/phases of a pixel).  Using
+     * isce3::core::SINC_SUB reproduces the weights of the default sinc
+     * interpolator.  Set to 0 (the default) to disable.
+     */
+    void polyphaseFactor(int);
+
     /** Get flag for reference data */
     bool haveRefData() const { return _haveRefData; }
 
@@ -165,6 +183,8 @@ public:
 protected:
     // Number of lines per tile
     size_t _linesPerTile = 1000;
+    // Number of phases in polyphase table (0 = use 2D sinc interpolator)
+    int _polyphaseFactor = 0;
     // Band number
     int _inputBand;
     // Filename of the input product
@@ -253,6 +273,25 @@ protected:
                         const Tile<double>& azOffTile, size_t inLength,
                         bool flatten, int chipSize);
 
+    /*
+     * Interpolate one output pixel from the input tile using separable
+     * weights from a polyphase table
+     *
+     * \param[in]  tile             tile object containing input block
+     * \param[in]  table            polyphase table, one row of kernel taps
+     *                              per fractional offset phase
+     * \param[in]  iRowResampled    nearest input row of output pixel
+     * \param[in]  iColResampled    nearest input column of output pixel
+     * \param[in]  fracAz           fractional azimuth offset in [-0.5, 0.5]
+     * \param[in]  fracRg           fractional range offset in [-0.5, 0.5]
+     * \param[in]  dop              Doppler phase increment per line
+     *                              (radians) removed before interpolation
+     */
+    std::complex<float> _polyphaseInterp(
+            const Tile_t& tile, const isce3::core::Matrix<float>& table,
+            size_t iRowResampled, size_t iColResampled, double fracAz,
+            double fracRg, double dop) const;
+
     // Convenience functions
     size_t _computeNumberOfTiles(size_t, size_t);
 
@@ -21,5 +21,13 @@ namespace isce3 {
 
         template<typename T>
         auto asGDT = gdal::detail::Type2GDALDataType<T>::datatype;
+
+        /// Expected access pattern of a memory-mapped raster (madvise hint)
+        enum class MemoryMapAdvice {
+            Normal,     ///< No special treatment
+            Sequential, ///< Pages will be accessed in increasing order
+            Random,     ///< Pages will be accessed in random order
+            WillNeed    ///< Pages will be accessed soon, read them ahead
+        };
     }
 }
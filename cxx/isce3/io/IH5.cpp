@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <cstring>
 
+#include <zlib.h>
+
 #include <isce3/core/Constants.h>
 
 ///////////////////////// UTILITIES ///////////////////////////////////
@@ -20,6 +22,34 @@ inline unsigned int mapFileAccessMode(const char mode) {
     }
 }
 
+// Fletcher32 checksum as computed by the HDF5 fletcher32 filter (pairs of
+// bytes are summed as big-endian 16-bit words)
+inline uint32_t fletcher32(const unsigned char* data, size_t size) {
+    uint32_t sum1 = 0, sum2 = 0;
+    size_t len = size / 2;
+    while (len) {
+        // Fold the sums before they can overflow
+        size_t n = std::min<size_t>(len, 360);
+        len -= n;
+        do {
+            sum1 += (uint32_t(data[0]) << 8) | uint32_t(data[1]);
+            data += 2;
+            sum2 += sum1;
+        } while (--n);
+        sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+        sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    }
+    if (size % 2) {
+        sum1 += uint32_t(data[0]) << 8;
+        sum2 += sum1;
+        sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+        sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    }
+    sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+    sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    return (sum2 << 16) | sum1;
+}
+
 // The first argument refers to the H5Object that gets used to call
 // this function as an operator.
 void attrsNames(H5::H5Object&, H5std_string nameAttr, void* opdata) {
@@ -309,6 +339,315 @@ std::vector<int> isce3::io::IDataSet::getChunkSize() {
     return out;
 }
 
+/** @param[in] numChunks  Number of chunks the cache should hold
+ *  @param[in] chunkBytes Size of one (uncompressed) chunk in bytes
+ *
+ *  The number of hash table slots is the smallest prime larger than 100
+ *  times the number of chunks, as recommended by the HDF5 documentation. */
+isce3::io::ChunkCacheConfig
+isce3::io::ChunkCacheConfig::forChunks(size_t numChunks, size_t chunkBytes) {
+
+    auto isPrime = [](size_t n) {
+        if (n < 2)
+            return false;
+        for (size_t d = 2; d * d <= n; d++) {
+            if (n % d == 0)
+                return false;
+        }
+        return true;
+    };
+
+    ChunkCacheConfig config;
+    config.numSlots = 100 * std::max<size_t>(numChunks, 1) + 1;
+    while (not isPrime(config.numSlots))
+        config.numSlots++;
+    config.numBytes = std::max<size_t>(numChunks, 1) * chunkBytes;
+    config.preemption = 1.0;
+    return config;
+}
+
+/** Returns the chunk cache parameters of the dataset access property list.
+ *  Parameters left to their defaults at opening are reported with the
+ *  values inherited from the file. */
+isce3::io::ChunkCacheConfig isce3::io::IDataSet::getChunkCache() const {
+    ChunkCacheConfig config;
+    getAccessPlist().getChunkCache(config.numSlots, config.numBytes,
+                                   config.preemption);
+    return config;
+}
+
+/** @param[in] startIn Position of the first element of the block in each
+ *  dimension. If nullptr, the block starts at 0 in all dimensions.
+ *  @param[in] countIn Number of elements of the block in each dimension. If
+ *  nullptr, the block extends to the end of the dataset in all dimensions.
+ *
+ *  Returns the chunks intersecting the block, sorted by their address in the
+ *  file so that reading them in order scans the file sequentially.
+ *  Unallocated chunks (and all chunks with HDF5 versions older than 1.10.5,
+ *  which can not query chunk addresses) are listed last, in logical
+ *  order. */
+std::vector<isce3::io::ChunkInfo>
+isce3::io::IDataSet::getChunks(const int* startIn, const int* countIn) {
+
+    H5::DSetCreatPropList plist = getCreatePlist();
+    if (H5D_CHUNKED != plist.getLayout()) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                                            "Dataset is not chunked");
+    }
+
+    const int rank = getRank();
+    std::vector<hsize_t> dims(rank), chunkDims(rank);
+    getSpace().getSimpleExtentDims(dims.data());
+    plist.getChunk(rank, chunkDims.data());
+
+    // Range of chunk indices intersecting the block in each dimension
+    std::vector<hsize_t> first(rank), last(rank);
+    for (int i = 0; i < rank; i++) {
+        const hsize_t start = startIn ? startIn[i] : 0;
+        const hsize_t count = countIn ? countIn[i] : dims[i] - start;
+        if ((startIn and startIn[i] < 0) or (countIn and countIn[i] < 0) or
+            start + count > dims[i]) {
+            throw isce3::except::OutOfRange(ISCE_SRCINFO(),
+                                           "Invalid dataset subselection");
+        }
+        if (count == 0)
+            return {};
+        first[i] = start / chunkDims[i];
+        last[i] = (start + count - 1) / chunkDims[i];
+    }
+
+    // Enumerate the chunks in logical order
+    std::vector<ChunkInfo> chunks;
+    std::vector<hsize_t> index(first);
+    while (true) {
+        ChunkInfo chunk;
+        chunk.offset.resize(rank);
+        chunk.count.resize(rank);
+        for (int i = 0; i < rank; i++) {
+            chunk.offset[i] = index[i] * chunkDims[i];
+            chunk.count[i] = std::min(chunkDims[i], dims[i] - chunk.offset[i]);
+        }
+#if H5_VERSION_GE(1, 10, 5)
+        if (H5Dget_chunk_info_by_coord(getId(), chunk.offset.data(),
+                                       &chunk.filterMask, &chunk.address,
+                                       &chunk.size) < 0) {
+            throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                                             "Could not query chunk info");
+        }
+#endif
+        chunks.push_back(std::move(chunk));
+
+        int i = rank - 1;
+        while (i >= 0 and index[i] == last[i]) {
+            index[i] = first[i];
+            i--;
+        }
+        if (i < 0)
+            break;
+        index[i]++;
+    }
+
+    // Sort in storage order (HADDR_UNDEF is the largest address)
+    std::stable_sort(chunks.begin(), chunks.end(),
+                     [](const ChunkInfo& a, const ChunkInfo& b) {
+                         return a.address < b.address;
+                     });
+    return chunks;
+}
+
+/** @param[in]  memType Memory data type the chunks are read into
+ *  @param[out] filters Identifiers of the filters of the dataset pipeline
+ *
+ *  Direct chunk reads need HDF5 1.10.5 or later. */
+bool isce3::io::IDataSet::directChunkFilters(
+        const H5::DataType& memType, std::vector<H5Z_filter_t>& filters) {
+
+    filters.clear();
+
+#if H5_VERSION_GE(1, 10, 5)
+    H5::DSetCreatPropList plist = getCreatePlist();
+    if (H5D_CHUNKED != plist.getLayout() or not(getDataType() == memType))
+        return false;
+
+    bool supported = true;
+    for (int i = 0; i < plist.getNfilters(); i++) {
+        unsigned int flags, config;
+        size_t nelmts = 0;
+        char name[64];
+        const H5Z_filter_t filter = plist.getFilter(i, flags, nelmts, nullptr,
+                                                    sizeof(name), name, config);
+        filters.push_back(filter);
+        supported = supported and (filter == H5Z_FILTER_DEFLATE or
+                                   filter == H5Z_FILTER_SHUFFLE or
+                                   filter == H5Z_FILTER_FLETCHER32);
+    }
+    return supported;
+#else
+    static_cast<void>(memType);
+    return false;
+#endif
+}
+
+/** @param[in]  chunk Chunk to read
+ *  @param[out] raw   Raw bytes of the chunk as stored in the file */
+void isce3::io::IDataSet::readRawChunk(const ChunkInfo& chunk,
+                                       std::vector<unsigned char>& raw) {
+#if H5_VERSION_GE(1, 10, 5)
+    raw.resize(chunk.size);
+    uint32_t filterMask = 0;
+    if (H5Dread_chunk(getId(), H5P_DEFAULT, chunk.offset.data(), &filterMask,
+                      raw.data()) < 0) {
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                                         "Direct chunk read failed");
+    }
+#else
+    static_cast<void>(chunk);
+    static_cast<void>(raw);
+    throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+            "Direct chunk reads require HDF5 1.10.5 or later");
+#endif
+}
+
+/** @param[in]     chunk     Chunk to decode
+ *  @param[in]     chunkDims Chunk size of the dataset
+ *  @param[in]     filters   Filter pipeline of the dataset
+ *  @param[in]     typeSize  Size of one element in bytes
+ *  @param[in,out] raw       Raw bytes of the chunk (used as workspace)
+ *  @param[in,out] work      Workspace
+ *  @param[out]    buf       Contiguous buffer of the count elements of the
+ *                           chunk
+ *
+ *  Chunks with a Fletcher32 checksum that does not match their data are
+ *  not decoded, so that the HDF5 library reports the error. */
+bool isce3::io::IDataSet::decodeChunk(const ChunkInfo& chunk,
+                                      const std::vector<hsize_t>& chunkDims,
+                                      const std::vector<H5Z_filter_t>& filters,
+                                      size_t typeSize,
+                                      std::vector<unsigned char>& raw,
+                                      std::vector<unsigned char>& work,
+                                      void* buf) {
+
+    size_t chunkBytes = typeSize;
+    for (auto n : chunkDims)
+        chunkBytes *= n;
+
+    // Undo the filters in reverse order of the pipeline
+    for (int i = static_cast<int>(filters.size()) - 1; i >= 0; i--) {
+        if (chunk.filterMask & (1u << i))
+            continue;
+
+        switch (filters[i]) {
+        case H5Z_FILTER_DEFLATE: {
+            work.resize(chunkBytes);
+            uLongf size = chunkBytes;
+            if (Z_OK != uncompress(work.data(), &size, raw.data(), raw.size()))
+                return false;
+            work.resize(size);
+            raw.swap(work);
+            break;
+        }
+        case H5Z_FILTER_SHUFFLE: {
+            // Byte k of element j is stored at k * n + j. Trailing bytes
+            // that do not make up a full element are not shuffled.
+            const size_t n = raw.size() / typeSize;
+            if (typeSize > 1 and n > 1) {
+                work.resize(raw.size());
+                for (size_t k = 0; k < typeSize; k++) {
+                    for (size_t j = 0; j < n; j++)
+                        work[j * typeSize + k] = raw[k * n + j];
+                }
+                std::copy(raw.begin() + n * typeSize, raw.end(),
+                          work.begin() + n * typeSize);
+                raw.swap(work);
+            }
+            break;
+        }
+        case H5Z_FILTER_FLETCHER32: {
+            if (raw.size() < 4)
+                return false;
+            const size_t n = raw.size() - 4;
+            // Stored little-endian after the data
+            const uint32_t stored = uint32_t(raw[n]) |
+                                    (uint32_t(raw[n + 1]) << 8) |
+                                    (uint32_t(raw[n + 2]) << 16) |
+                                    (uint32_t(raw[n + 3]) << 24);
+            const uint32_t sum = fletcher32(raw.data(), n);
+            // HDF5 also accepts the checksum with the bytes of each half
+            // swapped, as written by versions before 1.6.3
+            const uint32_t swapped = ((sum & 0x00ff00ffu) << 8) |
+                                     ((sum >> 8) & 0x00ff00ffu);
+            if (stored != sum and stored != swapped)
+                return false;
+            raw.resize(n);
+            break;
+        }
+        default: return false;
+        }
+    }
+
+    if (raw.size() != chunkBytes)
+        return false;
+
+    // Drop the padding of edge chunks
+    const int rank = chunkDims.size();
+    const std::vector<hsize_t> zero(rank, 0);
+    copyBlock(raw.data(), chunkDims.data(), zero.data(),
+              static_cast<unsigned char*>(buf), chunk.count.data(),
+              zero.data(), chunk.count.data(), rank, typeSize);
+    return true;
+}
+
+/** @param[in]  src      Source array
+ *  @param[in]  srcDims  Dimensions of the source array
+ *  @param[in]  srcStart Position of the block in the source array
+ *  @param[out] dst      Destination array
+ *  @param[in]  dstDims  Dimensions of the destination array
+ *  @param[in]  dstStart Position of the block in the destination array
+ *  @param[in]  count    Dimensions of the block
+ *  @param[in]  rank     Number of dimensions
+ *  @param[in]  typeSize Size of one element in bytes
+ *
+ *  The block is copied one row (fastest dimension) at a time, in increasing
+ *  address order, so that src and dst may be the same array as long as
+ *  every destination row precedes its source row. */
+void isce3::io::IDataSet::copyBlock(const unsigned char* src,
+                                    const hsize_t* srcDims,
+                                    const hsize_t* srcStart,
+                                    unsigned char* dst, const hsize_t* dstDims,
+                                    const hsize_t* dstStart,
+                                    const hsize_t* count, int rank,
+                                    size_t typeSize) {
+
+    if (rank == 0) {
+        std::memmove(dst, src, typeSize);
+        return;
+    }
+
+    size_t numRows = 1;
+    for (int i = 0; i < rank - 1; i++)
+        numRows *= count[i];
+    const size_t rowBytes = count[rank - 1] * typeSize;
+    if (rowBytes == 0)
+        return;
+
+    std::vector<hsize_t> index(rank, 0);
+    for (size_t row = 0; row < numRows; row++) {
+        size_t srcOffset = 0, dstOffset = 0;
+        for (int i = 0; i < rank; i++) {
+            srcOffset = srcOffset * srcDims[i] + srcStart[i] + index[i];
+            dstOffset = dstOffset * dstDims[i] + dstStart[i] + index[i];
+        }
+        std::memmove(dst + dstOffset * typeSize, src + srcOffset * typeSize,
+                     rowBytes);
+
+        for (int i = rank - 2; i >= 0; i--) {
+            if (++index[i] < count[i])
+                break;
+            index[i] = 0;
+        }
+    }
+}
+
 /** @param[in] v Name of the attribute (optional).
  *  Returns the actual number of bit used to store the current dataset or given
  *  attribute data in the file. */
@@ -713,6 +1052,19 @@ isce3::io::IDataSet isce3::io::IGroup::openDataSet(const H5std_string& name) {
     return H5::Group::openDataSet(name);
 }
 
+/** @param[in] name  Name of the dataset to open.
+ *  @param[in] cache Chunk cache parameters of the dataset.
+ *
+ * name must contain the full path from root location and name of the dataset
+ * to open. The chunk cache is private to the returned dataset. */
+isce3::io::IDataSet
+isce3::io::IGroup::openDataSet(const H5std_string& name,
+                               const ChunkCacheConfig& cache) {
+    H5::DSetAccPropList dapl;
+    dapl.setChunkCache(cache.numSlots, cache.numBytes, cache.preemption);
+    return H5::Group::openDataSet(name, dapl);
+}
+
 /** @param[in] name Name of the group to open.
  *
  * name must contain the full path from root location and name of the group
@@ -795,6 +1147,19 @@ isce3::io::IDataSet isce3::io::IH5File::openDataSet(const H5std_string& name) {
     return H5::H5File::openDataSet(name);
 }
 
+/** @param[in] name  Name of the dataset to open.
+ *  @param[in] cache Chunk cache parameters of the dataset.
+ *
+ * name must contain the full path from root location and name of the dataset
+ * to open. The chunk cache is private to the returned dataset. */
+isce3::io::IDataSet
+isce3::io::IH5File::openDataSet(const H5std_string& name,
+                                const ChunkCacheConfig& cache) {
+    H5::DSetAccPropList dapl;
+    dapl.setChunkCache(cache.numSlots, cache.numBytes, cache.preemption);
+    return H5::H5File::openDataSet(name, dapl);
+}
+
 /** @param[in] name Name of the group to open.
  *
  * name must contain the full path from root location and name of the group
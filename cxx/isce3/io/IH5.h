@@ -1,8 +1,13 @@
 #pragma once
 
 #include <H5Cpp.h>
+#include <algorithm>
+#include <atomic>
 #include <complex>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <numeric>
 #include <isce3/core/Constants.h>
 #include <isce3/except/Error.h>
 #include <regex>
@@ -37,6 +42,48 @@ struct findMeta {
     std::string basePath;
 };
 
+/** Raw data chunk cache parameters of a dataset (see H5Pset_chunk_cache).
+ *
+ * The defaults keep the settings of the file access property list. */
+struct ChunkCacheConfig {
+    /** Number of slots in the hash table of the chunk cache. Should be a
+     * prime number about 100 times the number of chunks that fit in the
+     * cache. */
+    size_t numSlots = H5D_CHUNK_CACHE_NSLOTS_DEFAULT;
+
+    /** Total size of the chunk cache in bytes */
+    size_t numBytes = H5D_CHUNK_CACHE_NBYTES_DEFAULT;
+
+    /** Chunk preemption policy in [0, 1]. 1 evicts fully read chunks first,
+     * which suits reading a dataset once in storage order. */
+    double preemption = H5D_CHUNK_CACHE_W0_DEFAULT;
+
+    /** Cache configuration holding a given number of chunks of a given
+     * (uncompressed) size, evicting fully read chunks first */
+    static ChunkCacheConfig forChunks(size_t numChunks, size_t chunkBytes);
+};
+
+/** Location and storage of one chunk of a chunked dataset */
+struct ChunkInfo {
+    /** Position of the first element of the chunk in each dimension */
+    std::vector<hsize_t> offset;
+
+    /** Number of elements of the chunk within the extent of the dataset in
+     * each dimension (smaller than the chunk size for edge chunks) */
+    std::vector<hsize_t> count;
+
+    /** Filter mask of the chunk (bit i is set if the i-th filter of the
+     * pipeline was not applied) */
+    unsigned filterMask = 0;
+
+    /** Address of the chunk in the file (HADDR_UNDEF if the chunk is not
+     * allocated or its address is unknown) */
+    haddr_t address = HADDR_UNDEF;
+
+    /** Size of the (filtered) chunk in the file in bytes */
+    hsize_t size = 0;
+};
+
 /** Our derived dataset structure that includes utility functions */
 class IDataSet : public H5::DataSet {
 
@@ -70,6 +117,14 @@ public:
     /** Get the storage chunk size of the dataset */
     std::vector<int> getChunkSize();
 
+    /** Get the chunk cache parameters the dataset was opened with */
+    ChunkCacheConfig getChunkCache() const;
+
+    /** Get the chunks intersecting a block of the dataset, in storage
+     * order */
+    std::vector<ChunkInfo> getChunks(const int* startIn = nullptr,
+                                     const int* countIn = nullptr);
+
     /** Get the number of bit used to store each dataset element */
     int getNumBits(const std::string& v = "");
 
@@ -174,6 +229,28 @@ public:
     template<typename T>
     inline void read(std::valarray<T>& buf, const std::gslice* gsliceIn);
 
+    // Chunk-wise reading. Chunks are read with direct chunk reads and their
+    // filters (deflate, shuffle, fletcher32) are undone outside of the HDF5
+    // library, so that decompression can run on several threads. Chunks
+    // that can not be decoded this way (other filters, unallocated chunks,
+    // memory type different from the file type) are read through the HDF5
+    // library instead.
+
+    /** Reading one chunk into a contiguous buffer of its count elements */
+    template<typename T>
+    inline void readChunk(T* buf, const ChunkInfo& chunk);
+
+    /** Reading chunks in parallel and passing each one to a callback.
+     * Returns the number of chunks decoded outside of the HDF5 library. */
+    template<typename T, typename F>
+    inline size_t readChunks(const std::vector<ChunkInfo>& chunks, F&& callback);
+
+    /** Reading a block of the dataset in raw pointer with parallel chunk
+     * decompression */
+    template<typename T>
+    inline void readChunked(T* buf, const int* startIn = nullptr,
+                            const int* countIn = nullptr);
+
     // Dataset writing queries
 
     /** Writing std::vector data into a dataset */
@@ -293,6 +370,34 @@ public:
 private:
     template<typename T> void read(T* buffer, const H5::DataSpace& dspace);
 
+    // Get the filter pipeline of the dataset. Returns true if memType
+    // matches the type of the dataset and all the filters can be undone by
+    // decodeChunk(), in which case chunks can be read directly.
+    bool directChunkFilters(const H5::DataType& memType,
+                            std::vector<H5Z_filter_t>& filters);
+
+    // Direct read of the raw (filtered) bytes of a chunk
+    void readRawChunk(const ChunkInfo& chunk, std::vector<unsigned char>& raw);
+
+    // Read a chunk through the HDF5 library into a contiguous buffer of its
+    // count elements
+    template<typename T> void readChunkHyperslab(T* buf, const ChunkInfo& chunk);
+
+    // Decode a chunk into a contiguous buffer of its count elements. Does not
+    // call the HDF5 library and can run concurrently. Returns false if the
+    // chunk could not be decoded.
+    static bool decodeChunk(const ChunkInfo& chunk,
+                            const std::vector<hsize_t>& chunkDims,
+                            const std::vector<H5Z_filter_t>& filters,
+                            size_t typeSize, std::vector<unsigned char>& raw,
+                            std::vector<unsigned char>& work, void* buf);
+
+    // Copy a block of count elements between two row-major arrays
+    static void copyBlock(const unsigned char* src, const hsize_t* srcDims,
+                          const hsize_t* srcStart, unsigned char* dst,
+                          const hsize_t* dstDims, const hsize_t* dstStart,
+                          const hsize_t* count, int rank, size_t typeSize);
+
     template<typename T>
     void createAttribute(const std::string& name, const H5::DataType& datatype,
                          const H5::DataSpace& dataspace, const T* buffer);
@@ -345,6 +450,10 @@ public:
     /** Open a given dataset */
     IDataSet openDataSet(const H5std_string& name);
 
+    /** Open a given dataset with given chunk cache parameters */
+    IDataSet openDataSet(const H5std_string& name,
+                         const ChunkCacheConfig& cache);
+
     /** Open a given group */
     IGroup openGroup(const H5std_string& name);
 
@@ -454,6 +563,10 @@ public:
     /** Open a given dataset */
     IDataSet openDataSet(const H5std_string& name);
 
+    /** Open a given dataset with given chunk cache parameters */
+    IDataSet openDataSet(const H5std_string& name,
+                         const ChunkCacheConfig& cache);
+
     /** Open a given group */
     IGroup openGroup(const H5std_string& name);
 
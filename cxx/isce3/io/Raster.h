@@ -246,6 +246,28 @@ class isce3::io::Raster {
           }
       }
 
+      /** Create a memory mapping of a band and return a strided view of it.
+       *
+       * Flat binary rasters (e.g. those created with the default VRT
+       * driver, ENVI or ISCE) are mapped directly from the file so that
+       * reads and writes through the view involve no intermediate copies.
+       * Other formats fall back to GDAL's page-fault driven virtual memory.
+       *
+       * The mapping is created on the first call for each band and stays
+       * valid until the Raster is destroyed or assigned to.  Writes through
+       * the view bypass GDAL's block cache, so don't mix them with
+       * setBlock/setLine/setValue on the same band.
+       *
+       * @param[in] band   Band number in 1-index
+       * @param[in] advice Expected access pattern, passed to madvise
+       *
+       * @throws isce3::except::RuntimeError if T does not match the band
+       * datatype or the band cannot be mapped
+       */
+      template<typename T>
+      isce3::io::gdal::TypedBuffer<T> memmap(size_t band = 1,
+              MemoryMapAdvice advice = MemoryMapAdvice::Normal);
+
       //Functions to deal with projections and geotransform information
       /** Return EPSG code corresponding to raster*/
       int getEPSG() const;
@@ -272,6 +294,9 @@ class isce3::io::Raster {
 private:
     GDALDataset * _dataset;
     bool _owner = true;
+    // Memory maps created by memmap(), keyed by band number.  Must be
+    // released before the dataset is closed.
+    std::unordered_map<size_t, isce3::io::gdal::detail::MemoryMap> _mmaps;
 };
 
 #define ISCE_IO_RASTER_ICC
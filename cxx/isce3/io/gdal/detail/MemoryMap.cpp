@@ -1,5 +1,9 @@
 #include "MemoryMap.h"
 
+#include <cstdint>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include <isce3/except/Error.h>
 
 namespace isce3 { namespace io { namespace gdal { namespace detail {
@@ -28,4 +32,29 @@ MemoryMap::MemoryMap(GDALRasterBand * raster, GDALAccess access)
     _rowstride = std::size_t(rowstride);
 }
 
+void MemoryMap::advise(MemoryMapAdvice advice) const
+{
+    if (!_mmap) {
+        return;
+    }
+
+    int posix_advice = POSIX_MADV_NORMAL;
+    switch (advice) {
+        case MemoryMapAdvice::Normal:     posix_advice = POSIX_MADV_NORMAL;     break;
+        case MemoryMapAdvice::Sequential: posix_advice = POSIX_MADV_SEQUENTIAL; break;
+        case MemoryMapAdvice::Random:     posix_advice = POSIX_MADV_RANDOM;     break;
+        case MemoryMapAdvice::WillNeed:   posix_advice = POSIX_MADV_WILLNEED;   break;
+    }
+
+    // madvise requires a page-aligned start address, but the start of the
+    // raster data need not be aligned (e.g. files with a header)
+    const auto pagesize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    const auto addr = reinterpret_cast<std::uintptr_t>(data());
+    const auto start = addr - (addr % pagesize);
+    const std::size_t len = size() + (addr - start);
+
+    // Advice is only a hint, so failure to apply it is not an error
+    posix_madvise(reinterpret_cast<void *>(start), len, posix_advice);
+}
+
 }}}}
@@ -5,6 +5,8 @@
 #include <memory>
 
 #include "../forward.h"
+#include "../../Constants.h"
+#include "../../forward.h"
 
 namespace isce3 { namespace io { namespace gdal { namespace detail {
 
@@ -33,7 +35,14 @@ public:
     // Stride in bytes between the start of adjacent rows
     std::size_t rowstride() const { return _rowstride; }
 
+    // True if the mapping is backed directly by the file (zero-copy)
+    bool isFileMapping() const { return CPLVirtualMemIsFileMapping(_mmap.get()); }
+
+    // Hint the expected access pattern of the mapped pages to the kernel
+    void advise(MemoryMapAdvice advice) const;
+
     friend class isce3::io::gdal::Raster;
+    friend class isce3::io::Raster;
 
 private:
 
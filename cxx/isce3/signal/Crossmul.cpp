@@ -1,5 +1,18 @@
 #include "Crossmul.h"
 
+#include <algorithm>
+#include <climits>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <isce3/fft/FFTPlan.h>
+#include <isce3/io/Raster.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "Filter.h"
 #include "Looks.h"
 #include "Signal.h"
@@ -65,6 +78,51 @@ size_t omp_thread_count() {
     return n;
 }
 
+namespace {
+
+// Per-thread buffers and FFT plans used by Crossmul to process one range
+// line at a time
+struct CrossmulWorkspace {
+    // zero-padded range line and its spectrum
+    std::vector<std::complex<float>> line;
+    std::vector<std::complex<float>> spectrum;
+
+    // zero-padded (upsampled) spectrum and upsampled lines of the reference
+    // and secondary SLCs
+    std::vector<std::complex<float>> spectrumUpsampled;
+    std::vector<std::complex<float>> refUpsampled;
+    std::vector<std::complex<float>> secUpsampled;
+
+    isce3::fft::FwdFFTPlan<float> fwdPlan;
+    isce3::fft::InvFFTPlan<float> refInvPlan;
+    isce3::fft::InvFFTPlan<float> secInvPlan;
+
+    // full resolution interferogram line
+    std::vector<std::complex<float>> ifgram;
+
+    // sums over the looks of an output row of the interferogram and of the
+    // power of the SLCs
+    std::vector<std::complex<float>> ifgramSum;
+    std::vector<float> refPowerSum;
+    std::vector<float> secPowerSum;
+};
+
+// A block of lines of input and output data
+struct CrossmulBlock {
+    // first line and number of lines of input data
+    size_t rowStart = 0;
+    size_t rows = 0;
+
+    std::vector<std::complex<float>> refSlc;
+    std::vector<std::complex<float>> secSlc;
+    std::vector<double> rngOffset;
+
+    std::vector<std::complex<float>> ifgram;
+    std::vector<float> coherence;
+};
+
+} // namespace
+
 void isce3::signal::Crossmul::
 crossmul(isce3::io::Raster& refSlcRaster,
         isce3::io::Raster& secSlcRaster,
@@ -92,7 +150,8 @@ crossmul(isce3::io::Raster& refSlcRaster,
     if (_multiLookEnabled) {
         // Making sure that the number of rows in each block (linesPerBlock)
         // to be an integer multiple of the number of azimuth looks.
-        linesPerBlock = (_linesPerBlock / _azimuthLooks) * _azimuthLooks;
+        linesPerBlock = std::max<size_t>(_linesPerBlock / _azimuthLooks, 1) *
+                        _azimuthLooks;
 
         // checking only multilook interferogram shape is sufficient
         // interferogram and coherence shapes checked to match above
@@ -120,26 +179,9 @@ crossmul(isce3::io::Raster& refSlcRaster,
     // Set flatten flag based range offset raster ptr value
     bool flatten = rngOffsetRaster ? true : false;
 
-    //signal object for refSlc
-    isce3::signal::Signal<float> refSignal(nthreads);
-
-    //signal object for secSlc
-    isce3::signal::Signal<float> secSignal(nthreads);
-
-    // instantiate Looks used for multi-looking the interferogram
-    isce3::signal::Looks<float> looksObj;
-
-    const size_t linesPerBlockMLooked = linesPerBlock / _azimuthLooks;
-    const size_t ncolsMultiLooked = ncols / _rangeLooks;
-    looksObj.nrows(linesPerBlock);
-    looksObj.ncols(ncols);
-    looksObj.rowsLooks(_azimuthLooks);
-    looksObj.colsLooks(_rangeLooks);
-    looksObj.nrowsLooked(linesPerBlockMLooked);
-    looksObj.ncolsLooked(ncolsMultiLooked);
-
     // Compute FFT size (power of 2)
     size_t fft_size;
+    isce3::signal::Signal<float> refSignal(nthreads);
     refSignal.nextPowerOfTwo(ncols, fft_size);
 
     if (fft_size > INT_MAX)
@@ -155,236 +197,282 @@ crossmul(isce3::io::Raster& refSlcRaster,
         nblocks += 1;
     }
 
-    // size of not-unsampled valarray
-    const auto spectrumSize = fft_size * linesPerBlock;
-
-    // size of unsampled valarray
-    const auto spectrumUpsampleSize = _oversampleFactor * spectrumSize;
-
-    // storage for a block of reference SLC data
-    std::valarray<std::complex<float>> refSlc(spectrumSize);
-
-    // storage for a block of secondary SLC data
-    std::valarray<std::complex<float>> secSlc(spectrumSize);
-
-    // storage for a block of range offsets
-    std::valarray<double> rngOffset(ncols*linesPerBlock);
-
-    // storage for a simulated interferogram which its phase is the
-    // interferometric phase due to the imaging geometry:
-    // phase = (4*PI/wavelength)*(rangePixelSpacing)*(rngOffset)
-    // complex conjugate of geometryIfgram
-    std::valarray<std::complex<float>> geometryIfgramConj(spectrumSize);
-
-    // upsampled interferogram
-    std::valarray<std::complex<float>> ifgramUpsampled(_oversampleFactor*ncols*linesPerBlock);
-
-    // full resolution interferogram
-    std::valarray<std::complex<float>> ifgram(ncols*linesPerBlock);
-
-    // multi-looked interferogram
-    std::valarray<std::complex<float>> ifgramMultiLooked;
-
-    // multi-looked power of reference SLC
-    std::valarray<float> refPowerLooked;
-
-    // multi-looked power of secondary SLC
-    std::valarray<float> secPowerLooked;
-
-    // coherence for multi-looked and full-res interferogram
-    std::valarray<float> coherence;
-
-    if (_multiLookEnabled) {
-        // resize following valarrays from empty
-        const auto mlookSize = ncolsMultiLooked*linesPerBlockMLooked;
-        ifgramMultiLooked.resize(mlookSize);
-        coherence.resize(mlookSize);
-        refPowerLooked.resize(mlookSize);
-        secPowerLooked.resize(mlookSize);
-    }
-    else {
-        coherence.resize(ncols*linesPerBlock);
+    const size_t ov = _oversampleFactor;
+    const size_t rangeLooks = _multiLookEnabled ? _rangeLooks : 1;
+    const size_t azimuthLooks = _multiLookEnabled ? _azimuthLooks : 1;
+    const size_t ncolsMultiLooked = ncols / rangeLooks;
+    const size_t upsampledSize = ov * fft_size;
+
+    // looking down the upsampled interferogram may shift the samples by a
+    // fraction of a pixel depending on the oversample factor. predicting the
+    // impact of the shift in frequency domain which is a linear phase allows
+    // to account for it during the upsampling process
+    std::valarray<std::complex<float>> shiftImpact;
+    if (ov > 1) {
+        shiftImpact.resize(upsampledSize);
+        lookdownShiftImpact(ov, fft_size, 1, shiftImpact);
     }
 
-    // storage for spectrum of the block of data in reference SLC
-    std::valarray<std::complex<float>> refSpectrum;
-
-    // storage for spectrum of the block of data in secondary SLC
-    std::valarray<std::complex<float>> secSpectrum;
-
-    // upsampled spectrum of the block of reference SLC
-    std::valarray<std::complex<float>> refSpectrumUpsampled;
-
-    // upsampled spectrum of the block of secondary SLC
-    std::valarray<std::complex<float>> secSpectrumUpsampled;
-
-    // upsampled block of reference SLC
-    std::valarray<std::complex<float>> refSlcUpsampled;
-
-    // upsampled block of secondary SLC
-    std::valarray<std::complex<float>> secSlcUpsampled;
-
-    // only resize valarrays and init FFT when oversampling
-    if (_oversampleFactor > 1) {
-        refSpectrum.resize(spectrumSize);
-        secSpectrum.resize(spectrumSize);
-
-        refSpectrumUpsampled.resize(spectrumUpsampleSize);
-        secSpectrumUpsampled.resize(spectrumUpsampleSize);
-        refSlcUpsampled.resize(spectrumUpsampleSize);
-        secSlcUpsampled.resize(spectrumUpsampleSize);
-
-        // make forward and inverse fft plans for the reference SLC
-        refSignal.forwardRangeFFT(refSlc, refSpectrum, fft_size, linesPerBlock);
-        refSignal.inverseRangeFFT(refSpectrumUpsampled, refSlcUpsampled,
-                fft_size*_oversampleFactor, linesPerBlock);
-
-        // make forward and inverse fft plans for the secondary SLC
-        secSignal.forwardRangeFFT(secSlc, secSpectrum, fft_size, linesPerBlock);
-        secSignal.inverseRangeFFT(secSpectrumUpsampled, secSlcUpsampled,
-                fft_size*_oversampleFactor, linesPerBlock);
+    // Per-thread workspaces. The SLCs are upsampled, cross-multiplied,
+    // looked down and multilooked one range line at a time so that no
+    // upsampled block of data is ever formed. FFT plans are created here,
+    // outside of the parallel regions, and come from the plan cache so that
+    // all threads share the same underlying FFTW plans.
+    std::vector<CrossmulWorkspace> workspaces(nthreads);
+    for (auto& ws : workspaces) {
+        ws.ifgram.resize(ncols);
+        ws.ifgramSum.resize(ncolsMultiLooked);
+        ws.refPowerSum.resize(ncolsMultiLooked);
+        ws.secPowerSum.resize(ncolsMultiLooked);
+        if (ov > 1) {
+            ws.line.resize(fft_size);
+            ws.spectrum.resize(fft_size);
+            ws.spectrumUpsampled.resize(upsampledSize);
+            ws.refUpsampled.resize(upsampledSize);
+            ws.secUpsampled.resize(upsampledSize);
+            ws.fwdPlan = isce3::fft::FwdFFTPlan<float>(ws.spectrum.data(),
+                    ws.line.data(), fft_size, 1, FFTW_MEASURE, 1);
+            ws.refInvPlan = isce3::fft::InvFFTPlan<float>(
+                    ws.refUpsampled.data(), ws.spectrumUpsampled.data(),
+                    upsampledSize, 1, FFTW_MEASURE, 1);
+            ws.secInvPlan = isce3::fft::InvFFTPlan<float>(
+                    ws.secUpsampled.data(), ws.spectrumUpsampled.data(),
+                    upsampledSize, 1, FFTW_MEASURE, 1);
+
+            // planning may overwrite the buffers. Only the ends of the
+            // upsampled spectrum are filled afterwards, the band in between
+            // stays zero.
+            std::fill(ws.spectrumUpsampled.begin(),
+                      ws.spectrumUpsampled.end(), 0);
+        }
     }
 
-    // looking down the upsampled interferogram may shift the samples by a fraction of a pixel
-    // depending on the oversample factor. predicting the impact of the shift in frequency domain
-    // which is a linear phase allows to account for it during the upsampling process
-    std::valarray<std::complex<float>> shiftImpact(spectrumUpsampleSize);
-    lookdownShiftImpact(_oversampleFactor,  fft_size,
-                        linesPerBlock, shiftImpact);
-
-    // loop over all blocks
-    std::cout << "nblocks : " << nblocks << std::endl;
-
-    for (size_t block = 0; block < nblocks; ++block) {
-        std::cout << "block: " << block << std::endl;
-        // start row for this block
-        const auto rowStart = block * linesPerBlock;
-
-        //number of lines of data in this block. blockRowsData<= linesPerBlock
-        //Note that linesPerBlock is fixed number of lines
-        //blockRowsData might be less than or equal to linesPerBlock.
-        //e.g. if nrows = 512, and linesPerBlock = 100, then
-        //blockRowsData for last block will be 12
-        const auto blockRowsData = std::min(nrows - rowStart, linesPerBlock);
-
-        // fill the valarray with zero before getting the block of the data
-        refSlc = 0;
-        secSlc = 0;
-        ifgramUpsampled = 0;
-        ifgram = 0;
-
-        // get a block of reference and secondary SLC data
-        // and a block of range offsets
-        // This will change once we have the functionality to
-        // get a block of data directly in to a slice
-        // This zero-pads SLCs in range
-        std::valarray<std::complex<float>> dataLine(ncols);
-        for (size_t line = 0; line < blockRowsData; ++line) {
-            refSlcRaster.getLine(dataLine, rowStart + line);
-            refSlc[std::slice(line*fft_size, ncols, 1)] = dataLine;
-            secSlcRaster.getLine(dataLine, rowStart + line);
-            secSlc[std::slice(line*fft_size, ncols, 1)] = dataLine;
+    // Upsample a range line by zero-padding its spectrum. The spectrum has
+    // values from begining to fft_size index. It is moved such that the
+    // spectrum of the upsampled data has values from 0 to fft_size/2 and
+    // from ov*fft_size - fft_size/2 to the end, multiplied by the shift
+    // impact and normalized before the inverse FFT.
+    auto upsampleLine = [&](CrossmulWorkspace& ws,
+                            const std::complex<float>* in,
+                            isce3::fft::InvFFTPlan<float>& invPlan) {
+        std::copy(in, in + ncols, ws.line.begin());
+        std::fill(ws.line.begin() + ncols, ws.line.end(), 0);
+        ws.fwdPlan.execute();
+
+        const float scale = 1.0f / fft_size;
+        const size_t npos = (fft_size + 1) / 2;
+        const size_t nneg = fft_size / 2;
+        for (size_t i = 0; i < npos; ++i) {
+            ws.spectrumUpsampled[i] = ws.spectrum[i] * scale * shiftImpact[i];
         }
-
-        // upsample the reference and secondary SLCs
-        if (_oversampleFactor == 1) {
-            refSlcUpsampled = refSlc;
-            secSlcUpsampled = secSlc;
-        } else {
-            refSignal.upsample(refSlc, refSlcUpsampled, linesPerBlock, fft_size,
-                               _oversampleFactor, shiftImpact);
-            secSignal.upsample(secSlc, secSlcUpsampled, linesPerBlock, fft_size,
-                               _oversampleFactor, shiftImpact);
+        for (size_t i = 0; i < nneg; ++i) {
+            const size_t j = upsampledSize - nneg + i;
+            ws.spectrumUpsampled[j] =
+                    ws.spectrum[npos + i] * scale * shiftImpact[j];
         }
-
-        // Compute oversampled interferogram data
-        #pragma omp parallel for
-        for (size_t line = 0; line < blockRowsData; line++) {
-            for (size_t col = 0; col < _oversampleFactor*ncols; col++) {
-                ifgramUpsampled[line*(_oversampleFactor*ncols) + col] =
-                        refSlcUpsampled[line*(_oversampleFactor*fft_size) + col]*
-                        std::conj(secSlcUpsampled[line*(_oversampleFactor*fft_size) + col]);
+        invPlan.execute();
+    };
+
+    // Compute a full resolution line of the interferogram, flatten it if
+    // requested and, when multilooking, add it and the power of the SLCs
+    // to the sums of the current output row
+    auto processLine = [&](CrossmulWorkspace& ws,
+                           const std::complex<float>* refSlc,
+                           const std::complex<float>* secSlc,
+                           const double* rngOffset,
+                           std::complex<float>* ifgram) {
+        // number of full resolution columns which are multilooked
+        const size_t ncolsLooked = ncolsMultiLooked * rangeLooks;
+
+        if (ov == 1) {
+            for (size_t col = 0; col < ncols; ++col) {
+                ifgram[col] = refSlc[col] * std::conj(secSlc[col]);
+            }
+            if (_multiLookEnabled) {
+                for (size_t col = 0; col < ncolsLooked; ++col) {
+                    ws.refPowerSum[col / rangeLooks] += std::norm(refSlc[col]);
+                    ws.secPowerSum[col / rangeLooks] += std::norm(secSlc[col]);
+                }
+            }
+        } else {
+            upsampleLine(ws, refSlc, ws.refInvPlan);
+            upsampleLine(ws, secSlc, ws.secInvPlan);
+
+            // Reclaim the extra oversample looks across
+            const float ovf = ov;
+            for (size_t col = 0; col < ncols; ++col) {
+                const std::complex<float>* ref = &ws.refUpsampled[col * ov];
+                const std::complex<float>* sec = &ws.secUpsampled[col * ov];
+                std::complex<float> sum = 0;
+                for (size_t j = 0; j < ov; ++j) {
+                    sum += ref[j] * std::conj(sec[j]);
+                }
+                ifgram[col] = sum / ovf;
+
+                if (_multiLookEnabled and col < ncolsLooked) {
+                    float refPower = 0, secPower = 0;
+                    for (size_t j = 0; j < ov; ++j) {
+                        refPower += std::norm(ref[j]);
+                        secPower += std::norm(sec[j]);
+                    }
+                    ws.refPowerSum[col / rangeLooks] += refPower;
+                    ws.secPowerSum[col / rangeLooks] += secPower;
+                }
             }
         }
 
-        if (flatten) {
-            // Read range offsets
-            std::valarray<double> offsetLine(ncols);
-            for (size_t line = 0; line < blockRowsData; ++line) {
-                rngOffsetRaster->getLine(offsetLine, rowStart + line);
-                rngOffset[std::slice(line*ncols, ncols, 1)] = offsetLine + _offsetStartingRangeShift / _rangePixelSpacing;
+        if (rngOffset) {
+            // phase of a simulated interferogram due to the imaging
+            // geometry: phase = (4*PI/wavelength)*(rangePixelSpacing)*(rngOffset)
+            for (size_t col = 0; col < ncols; ++col) {
+                const double offset = rngOffset[col] +
+                        _offsetStartingRangeShift / _rangePixelSpacing;
+                const double phase = 4.0 * M_PI * _rangePixelSpacing *
+                                     offset / _wavelength;
+                ifgram[col] *= std::complex<float>(std::cos(phase),
+                                                   -1.0 * std::sin(phase));
             }
+        }
 
-            #pragma omp parallel for
-            for (size_t line = 0; line < blockRowsData; ++line) {
-                for (size_t col = 0; col < ncols; ++col) {
-                    double phase = 4.0*M_PI*_rangePixelSpacing*rngOffset[line*ncols+col]/_wavelength;
-                    geometryIfgramConj[line*fft_size + col] = std::complex<float> (std::cos(phase),
-                                                                            -1.0*std::sin(phase));
-
+        if (_multiLookEnabled) {
+            for (size_t col = 0; col < ncolsMultiLooked; ++col) {
+                std::complex<float> sum = 0;
+                for (size_t j = 0; j < rangeLooks; ++j) {
+                    sum += ifgram[col * rangeLooks + j];
                 }
+                ws.ifgramSum[col] += sum;
             }
         }
+    };
+
+    auto read_block = [&](CrossmulBlock& block) {
+        block.refSlc.resize(block.rows * ncols);
+        block.secSlc.resize(block.rows * ncols);
+        refSlcRaster.getBlock(block.refSlc.data(), 0, block.rowStart, ncols,
+                              block.rows);
+        secSlcRaster.getBlock(block.secSlc.data(), 0, block.rowStart, ncols,
+                              block.rows);
+        if (flatten) {
+            block.rngOffset.resize(block.rows * ncols);
+            rngOffsetRaster->getBlock(block.rngOffset.data(), 0,
+                                      block.rowStart, ncols, block.rows);
+        }
+    };
+
+    auto process_block = [&](CrossmulBlock& block) {
+        const size_t rowsOut = block.rows / azimuthLooks;
+        const size_t colsOut = _multiLookEnabled ? ncolsMultiLooked : ncols;
+        block.ifgram.resize(rowsOut * colsOut);
+        block.coherence.resize(rowsOut * colsOut);
+
+        #pragma omp parallel num_threads(nthreads)
+        {
+#ifdef _OPENMP
+            CrossmulWorkspace& ws = workspaces[omp_get_thread_num()];
+#else
+            CrossmulWorkspace& ws = workspaces[0];
+#endif
+
+            #pragma omp for schedule(dynamic)
+            for (size_t row = 0; row < rowsOut; ++row) {
+                if (not _multiLookEnabled) {
+                    const size_t offset = row * ncols;
+                    processLine(ws, &block.refSlc[offset],
+                                &block.secSlc[offset],
+                                flatten ? &block.rngOffset[offset] : nullptr,
+                                &block.ifgram[offset]);
+
+                    // fill coherence with ones (no need to compute result)
+                    std::fill_n(&block.coherence[offset], ncols, 1.0f);
+                    continue;
+                }
 
-        // Reclaim the extra oversample looks across
-        float ov = _oversampleFactor;
-        #pragma omp parallel for
-        for (size_t line = 0; line < blockRowsData; line++) {
-            for (size_t col = 0; col < ncols; col++) {
-                std::complex<float> sum = 0;
-                for (size_t j=0; j< _oversampleFactor; j++)
-                    sum += ifgramUpsampled[line*(ncols*_oversampleFactor) + j + col*_oversampleFactor];
-                ifgram[line*ncols + col] = sum/ov;
+                std::fill(ws.ifgramSum.begin(), ws.ifgramSum.end(), 0);
+                std::fill(ws.refPowerSum.begin(), ws.refPowerSum.end(), 0);
+                std::fill(ws.secPowerSum.begin(), ws.secPowerSum.end(), 0);
+                for (size_t i = 0; i < azimuthLooks; ++i) {
+                    const size_t offset = (row * azimuthLooks + i) * ncols;
+                    processLine(ws, &block.refSlc[offset],
+                                &block.secSlc[offset],
+                                flatten ? &block.rngOffset[offset] : nullptr,
+                                ws.ifgram.data());
+                }
 
-                if (flatten)
-                    ifgram[line*ncols + col] *= geometryIfgramConj[line*fft_size + col];
+                // multilooked interferogram and power, and coherence
+                const float nlooks = rangeLooks * azimuthLooks;
+                const float npower = ov * nlooks;
+                for (size_t col = 0; col < ncolsMultiLooked; ++col) {
+                    const std::complex<float> ifg = ws.ifgramSum[col] / nlooks;
+                    const float refPower = ws.refPowerSum[col] / npower;
+                    const float secPower = ws.secPowerSum[col] / npower;
+                    block.ifgram[row * ncolsMultiLooked + col] = ifg;
+                    block.coherence[row * ncolsMultiLooked + col] =
+                            std::abs(ifg) / std::sqrt(refPower * secPower);
+                }
             }
         }
+    };
+
+    auto write_block = [&](CrossmulBlock& block) {
+        const size_t rowsOut = block.rows / azimuthLooks;
+        const size_t colsOut = _multiLookEnabled ? ncolsMultiLooked : ncols;
+        if (rowsOut == 0)
+            return;
+        ifgRaster.setBlock(block.ifgram.data(), 0,
+                           block.rowStart / azimuthLooks, colsOut, rowsOut);
+        coherenceRaster.setBlock(block.coherence.data(), 0,
+                                 block.rowStart / azimuthLooks, colsOut,
+                                 rowsOut);
+    };
+
+    auto make_block = [&](size_t block) {
+        auto data = std::make_unique<CrossmulBlock>();
+        data->rowStart = block * linesPerBlock;
+
+        //number of lines of data in this block. rows <= linesPerBlock
+        //e.g. if nrows = 512, and linesPerBlock = 100, then
+        //rows for last block will be 12
+        data->rows = std::min(nrows - data->rowStart, linesPerBlock);
+        return data;
+    };
 
-        // Take looks down (summing columns)
-        if (_multiLookEnabled) {
+    std::cout << "nblocks : " << nblocks << std::endl;
 
-            // mulitlook interferogram and set raster
-            looksObj.ncols(ncols);
-            looksObj.colsLooks(_rangeLooks);
-            looksObj.multilook(ifgram, ifgramMultiLooked);
-            ifgRaster.setBlock(ifgramMultiLooked, 0, rowStart/_azimuthLooks,
-                        ncols/_rangeLooks, blockRowsData/_azimuthLooks);
-
-            // multilook SLC to power for coherence computation
-            // refPowerLooked = average(abs(refSlc)^2)
-            if (_oversampleFactor == 1) {
-                looksObj.ncols(fft_size);
-                looksObj.multilook(refSlc, refPowerLooked, 2);
-                looksObj.multilook(secSlc, secPowerLooked, 2);
-            } else {
-                // update looksObj so SlcUpsampled can be mulitlooked
-                looksObj.ncols(_oversampleFactor*fft_size);
-                looksObj.colsLooks(_oversampleFactor*_rangeLooks);
-                looksObj.multilook(refSlcUpsampled, refPowerLooked, 2);
-                looksObj.multilook(secSlcUpsampled, secPowerLooked, 2);
-            }
+    /*
+    Software pipeline over the blocks. While block N is processed, block
+    N + 1 is being read by a prefetch thread and block N - 1 is being
+    written by a writer thread. At most three blocks are held in memory at
+    any time. Each raster is only accessed by a single thread.
+    */
+    std::unique_ptr<CrossmulBlock> reading_block = make_block(0);
+    std::future<void> read_future = std::async(std::launch::async,
+            read_block, std::ref(*reading_block));
+    std::unique_ptr<CrossmulBlock> writing_block;
+    std::future<void> write_future;
 
-            // compute coherence
-            #pragma omp parallel for
-            for (size_t i = 0; i< ifgramMultiLooked.size(); ++i) {
-                coherence[i] = std::abs(ifgramMultiLooked[i])/
-                        std::sqrt(refPowerLooked[i]*secPowerLooked[i]);
-            }
+    for (size_t block = 0; block < nblocks; ++block) {
+        std::cout << "block: " << block << std::endl;
 
-            // set coherence raster
-            coherenceRaster.setBlock(coherence, 0, rowStart/_azimuthLooks,
-                    ncols/_rangeLooks, blockRowsData/_azimuthLooks);
-        } else {
-            // set the block of interferogram
-            ifgRaster.setBlock(ifgram, 0, rowStart, ncols, blockRowsData);
+        // wait for the prefetch of this block, then start prefetching the
+        // next one
+        read_future.get();
+        std::unique_ptr<CrossmulBlock> current_block = std::move(reading_block);
+        if (block + 1 < nblocks) {
+            reading_block = make_block(block + 1);
+            read_future = std::async(std::launch::async,
+                    read_block, std::ref(*reading_block));
+        }
 
-            // fill coherence with ones (no need to compute result)
-            coherence = 1.0;
+        process_block(*current_block);
 
-            // set the block of coherence
-            coherenceRaster.setBlock(coherence, 0, rowStart, ncols,
-                                     blockRowsData);
-        }
+        // wait for the writer to flush the previous block, then hand over
+        // the block that has just been processed
+        if (write_future.valid())
+            write_future.get();
+        writing_block = std::move(current_block);
+        write_future = std::async(std::launch::async,
+                write_block, std::ref(*writing_block));
     }
+    if (write_future.valid())
+        write_future.get();
 }
@@ -7,6 +7,9 @@
 
 #include "Looks.h"
 
+#include <algorithm>
+#include <vector>
+
 bool isce3::signal::verifyComplexToRealCasting(isce3::io::Raster& input_raster,
                                               isce3::io::Raster& output_raster,
                                               int& exponent) {
@@ -28,6 +31,105 @@ bool isce3::signal::verifyComplexToRealCasting(isce3::io::Raster& input_raster,
     return flag_complex_to_real;
 }
 
+namespace {
+
+/*
+ * Sum non-overlapping boxes of colsLooks x rowsLooks pixels of a row-major
+ * array with ncols columns into an array of nrowsLooked x ncolsLooked sums.
+ *
+ * Each output row is computed in a single pass over its input rows: the
+ * rowsLooks input rows are accumulated column-wise into a contiguous row
+ * buffer (a unit-stride loop that vectorizes), whose adjacent columns are
+ * then summed. Every input pixel is thus read once and added once
+ * regardless of the number of looks, and the working set of a thread is a
+ * single row. value(x) maps an input pixel to the value being summed. If
+ * weights is not null, the values are weighted and the sums of the weights
+ * are stored in sumWeights.
+ */
+template<class In, class Out, class W, class Value>
+void boxSum(const In* input, const W* weights, size_t ncols,
+            size_t nrowsLooked, size_t ncolsLooked, size_t colsLooks,
+            size_t rowsLooks, Value value, Out* sum, W* sumWeights)
+{
+    const size_t width = ncolsLooked * colsLooks;
+
+    #pragma omp parallel
+    {
+        std::vector<Out> rowSum(width);
+        std::vector<W> rowSumWeights(weights ? width : 0);
+
+        #pragma omp for schedule(static)
+        for (size_t line = 0; line < nrowsLooked; ++line) {
+            std::fill(rowSum.begin(), rowSum.end(), Out(0));
+            std::fill(rowSumWeights.begin(), rowSumWeights.end(), W(0));
+
+            for (size_t i = line * rowsLooks; i < (line + 1) * rowsLooks; ++i) {
+                const In* in = &input[i * ncols];
+                if (weights) {
+                    const W* w = &weights[i * ncols];
+                    for (size_t j = 0; j < width; ++j) {
+                        rowSum[j] += w[j] * value(in[j]);
+                        rowSumWeights[j] += w[j];
+                    }
+                } else {
+                    for (size_t j = 0; j < width; ++j) {
+                        rowSum[j] += value(in[j]);
+                    }
+                }
+            }
+
+            for (size_t col = 0; col < ncolsLooked; ++col) {
+                Out s = 0;
+                W sw = 0;
+                for (size_t j = col * colsLooks; j < (col + 1) * colsLooks; ++j) {
+                    s += rowSum[j];
+                    if (weights)
+                        sw += rowSumWeights[j];
+                }
+                sum[line * ncolsLooked + col] = s;
+                if (weights)
+                    sumWeights[line * ncolsLooked + col] = sw;
+            }
+        }
+    }
+}
+
+template<class T>
+struct Identity {
+    T operator()(const T& x) const { return x; }
+};
+
+/*
+ * Sum the absolute values of complex pixels raised to an exponent. The
+ * common exponents avoid the call to std::pow.
+ */
+template<class T>
+void boxSumPow(const std::complex<T>* input, size_t ncols,
+               size_t nrowsLooked, size_t ncolsLooked, size_t colsLooks,
+               size_t rowsLooks, int exponent, T* sum)
+{
+    using W = T;
+    const W* noWeights = nullptr;
+    if (exponent == 2) {
+        boxSum(input, noWeights, ncols, nrowsLooked, ncolsLooked, colsLooks,
+               rowsLooks, [](const std::complex<T>& x) { return std::norm(x); },
+               sum, (W*) nullptr);
+    } else if (exponent == 1) {
+        boxSum(input, noWeights, ncols, nrowsLooked, ncolsLooked, colsLooks,
+               rowsLooks, [](const std::complex<T>& x) { return std::abs(x); },
+               sum, (W*) nullptr);
+    } else {
+        boxSum(input, noWeights, ncols, nrowsLooked, ncolsLooked, colsLooks,
+               rowsLooks,
+               [exponent](const std::complex<T>& x) -> T {
+                   return std::pow(std::abs(x), exponent);
+               },
+               sum, (W*) nullptr);
+    }
+}
+
+} // namespace
+
 template<class T>
 void isce3::signal::Looks<T>::multilook(isce3::io::Raster& input_raster,
                                        isce3::io::Raster& output_raster,
@@ -40,29 +142,92 @@ void isce3::signal::Looks<T>::multilook(isce3::io::Raster& input_raster,
 
     bool flag_complex_to_real =
             verifyComplexToRealCasting(input_raster, output_raster, exponent);
+    const bool flag_complex =
+            GDALDataTypeIsComplex(input_raster.dtype()) &&
+            GDALDataTypeIsComplex(output_raster.dtype());
+
+    // The raster is processed in strips of whole multilooking windows so
+    // that the memory footprint is bounded by the strip size
+    const size_t rowsLookedPerBlock =
+            std::max<size_t>(_linesPerBlock / _rowsLooks, 1);
+    const size_t nblocks =
+            (_nrowsLooked + rowsLookedPerBlock - 1) / rowsLookedPerBlock;
+    const size_t blockSize = rowsLookedPerBlock * _rowsLooks * _ncols;
+    const size_t blockSizeLooked = rowsLookedPerBlock * _ncolsLooked;
+
+    std::vector<T> image, image_ml;
+    std::vector<std::complex<T>> complex_image, complex_image_ml;
+    if (flag_complex_to_real || flag_complex) {
+        complex_image.resize(blockSize);
+    } else {
+        image.resize(blockSize);
+    }
+    if (flag_complex) {
+        complex_image_ml.resize(blockSizeLooked);
+    } else {
+        image_ml.resize(blockSizeLooked);
+    }
+
     for (int band = 0; band < nbands; band++) {
         if (nbands == 1)
-            std::cout << "loading slant-range image..." << std::endl;
+            std::cout << "multilooking slant-range image..." << std::endl;
         else
-            std::cout << "loading slant-range band: " << band << std::endl;
-        std::valarray<T> image_ml(_ncolsLooked * _nrowsLooked);
-        if (!flag_complex_to_real) {
-            std::valarray<T> image(_ncols * _nrows);
-            input_raster.getBlock(image, 0, 0, _ncols, _nrows, band + 1);
-            multilook(image, image_ml);
-        } else {
-            std::valarray<std::complex<T>> complex_image(_ncols * _nrows);
-            input_raster.getBlock(complex_image, 0, 0, _ncols, _nrows,
-                                  band + 1);
-            multilook(complex_image, image_ml, exponent);
+            std::cout << "multilooking slant-range band: " << band << std::endl;
+
+        for (size_t block = 0; block < nblocks; ++block) {
+            const size_t lineStart = block * rowsLookedPerBlock;
+            const size_t blockRowsLooked =
+                    std::min(rowsLookedPerBlock, _nrowsLooked - lineStart);
+            const size_t rowStart = lineStart * _rowsLooks;
+            const size_t blockRows = blockRowsLooked * _rowsLooks;
+
+            if (flag_complex) {
+                input_raster.getBlock(complex_image.data(), 0, rowStart,
+                                      _ncols, blockRows, band + 1);
+                boxSum(complex_image.data(), (T*) nullptr, _ncols,
+                       blockRowsLooked, _ncolsLooked, _colsLooks, _rowsLooks,
+                       Identity<std::complex<T>>(), complex_image_ml.data(),
+                       (T*) nullptr);
+                scale(complex_image_ml.data(), blockRowsLooked * _ncolsLooked);
+                output_raster.setBlock(complex_image_ml.data(), 0, lineStart,
+                                       _ncolsLooked, blockRowsLooked, band + 1);
+                continue;
+            }
+
+            if (flag_complex_to_real) {
+                input_raster.getBlock(complex_image.data(), 0, rowStart,
+                                      _ncols, blockRows, band + 1);
+                boxSumPow(complex_image.data(), _ncols, blockRowsLooked,
+                          _ncolsLooked, _colsLooks, _rowsLooks, exponent,
+                          image_ml.data());
+            } else {
+                input_raster.getBlock(image.data(), 0, rowStart, _ncols,
+                                      blockRows, band + 1);
+                boxSum(image.data(), (T*) nullptr, _ncols, blockRowsLooked,
+                       _ncolsLooked, _colsLooks, _rowsLooks, Identity<T>(),
+                       image_ml.data(), (T*) nullptr);
+            }
+            scale(image_ml.data(), blockRowsLooked * _ncolsLooked);
+            output_raster.setBlock(image_ml.data(), 0, lineStart,
+                                   _ncolsLooked, blockRowsLooked, band + 1);
         }
-        std::cout << "saving block" << std::endl;
-        output_raster.setBlock(image_ml, 0, 0, _ncolsLooked, _nrowsLooked,
-                               band + 1);
         std::cout << "...done" << std::endl;
     }
 }
 
+/**
+ * @param[in,out] data multilooked sums to be divided by the number of looks
+ * @param[in] size number of elements of data
+ */
+template<class T>
+template<class U>
+void isce3::signal::Looks<T>::scale(U* data, size_t size) const {
+    const T nlooks = _colsLooks * _rowsLooks;
+    for (size_t i = 0; i < size; ++i) {
+        data[i] /= nlooks;
+    }
+}
+
 /**
  * * @param[in] input input array to be multi-looked
  * * @param[out] output output multilooked and downsampled array 
@@ -78,44 +243,11 @@ void isce3::signal::Looks<T>::multilook(std::valarray<T>& input,
     // size of output array: _ncolsLooked * _nrowsLooked
     //
     // The mean of a box of size _colsLooks * _rowsLooks is computed
-    //
-    // This function is implemented to perform time domain
-    // multi-looking in two steps:
-    //  1) multi-looking in range direction (columns) and store the results in a
-    //  temporary buffer 2) multi-looking the temporary array from previous step
-    //  in azimuth direction (rows)
-
-    // a temporary buffer to store the multi-looked data in range (columns)
-    // direction
-    std::valarray<T> tempOutput(_nrows * _ncolsLooked);
-
-// multi-looking in range direction (columns)
-#pragma omp parallel for
-    for (size_t kk = 0; kk < _nrows * _ncolsLooked; ++kk) {
-        size_t line = kk / _ncolsLooked;
-        size_t col = kk % _ncolsLooked;
-        T sum = 0.0;
-        for (size_t j = col * _colsLooks; j < (col + 1) * _colsLooks; ++j) {
-            sum += input[line * _ncols + j];
-        }
-        tempOutput[line * _ncolsLooked + col] = sum;
-    }
-
-// multi-looking in azimuth direction (rows)
-#pragma omp parallel for
-    for (size_t kk = 0; kk < _ncolsLooked * _nrowsLooked; ++kk) {
-        size_t line = kk / _ncolsLooked;
-        size_t col = kk % _ncolsLooked;
-        T sum = 0.0;
-        for (size_t i = line * _rowsLooks; i < (line + 1) * _rowsLooks; ++i) {
-            sum += tempOutput[i * _ncolsLooked + col];
-        }
-
-        output[line * _ncolsLooked + col] = sum;
-    }
+    boxSum(&input[0], (T*) nullptr, _ncols, _nrowsLooked, _ncolsLooked,
+           _colsLooks, _rowsLooks, Identity<T>(), &output[0], (T*) nullptr);
 
     // To compute the mean
-    output /= (_colsLooks * _rowsLooks);
+    scale(&output[0], _nrowsLooked * _ncolsLooked);
 }
 
 /**
@@ -178,46 +310,16 @@ void isce3::signal::Looks<T>::multilook(std::valarray<T>& input,
                                        std::valarray<T>& output) {
 
     // A general implementation of multi-looking with weight array.
+    const size_t size = _nrowsLooked * _ncolsLooked;
+    std::vector<T> sum(size), sumWeights(size);
+    boxSum(&input[0], &weights[0], _ncols, _nrowsLooked, _ncolsLooked,
+           _colsLooks, _rowsLooks, Identity<T>(), sum.data(),
+           sumWeights.data());
 
-    // temporary buffers used for mult-looking columns for the
-    // data and the weights
-    std::valarray<T> tempOutput(_nrows * _ncolsLooked);
-    std::valarray<T> tempSumWeights(_nrows * _ncolsLooked);
-
-// weighted multi-looking the columns
-#pragma omp parallel for
-    for (size_t kk = 0; kk < _nrows * _ncolsLooked; ++kk) {
-        size_t line = kk / _ncolsLooked;
-        size_t col = kk % _ncolsLooked;
-        T sum = 0.0;
-        T sumWgt = 0;
-        for (size_t j = col * _colsLooks; j < (col + 1) * _colsLooks; ++j) {
-            sum += weights[line * _ncols + j] * input[line * _ncols + j];
-            sumWgt += weights[line * _ncols + j];
-        }
-        tempOutput[line * _ncolsLooked + col] = sum;
-        tempSumWeights[line * _ncolsLooked + col] = sumWgt;
-    }
-
-    // weighted multi-looking the rows
-    #pragma omp parallel for
-    for (size_t kk = 0; kk < _nrowsLooked*_ncolsLooked; ++kk){
-        size_t line = kk/_ncolsLooked;
-        size_t col = kk%_ncolsLooked;
-
-        T sum = 0.0;
-        T sumWgt = 0;
-        for (size_t i=line*_rowsLooks; i<(line+1)*_rowsLooks; ++i){
-
-            // Note that the elements of tempOutput are already weighted in the previous loop. 
-            // So no need to weight them again.
-            sum += tempOutput[i*_ncolsLooked + col];
-            sumWgt += tempSumWeights[i*_ncolsLooked + col];
-        }
-
+    for (size_t i = 0; i < size; ++i) {
         // To avoid dividing by zero
-        if (sumWgt>0)
-            output[line*_ncolsLooked + col] = sum/sumWgt;
+        if (sumWeights[i] > 0)
+            output[i] = sum[i] / sumWeights[i];
     }
 }
 
@@ -230,32 +332,11 @@ void isce3::signal::Looks<T>::multilook(std::valarray<std::complex<T>>& input,
                                        std::valarray<std::complex<T>>& output) {
 
     // The implementation details are same as real data. See the notes above.
+    boxSum(&input[0], (T*) nullptr, _ncols, _nrowsLooked, _ncolsLooked,
+           _colsLooks, _rowsLooks, Identity<std::complex<T>>(), &output[0],
+           (T*) nullptr);
 
-    std::valarray<std::complex<T>> tempOutput(_nrows * _ncolsLooked);
-
-#pragma omp parallel for
-    for (size_t kk = 0; kk < _nrows * _ncolsLooked; ++kk) {
-        size_t line = kk / _ncolsLooked;
-        size_t col = kk % _ncolsLooked;
-        std::complex<T> sum = std::complex<T>(0.0, 0.0);
-        for (size_t j = col * _colsLooks; j < (col + 1) * _colsLooks; ++j) {
-            sum += input[line * _ncols + j];
-        }
-        tempOutput[line * _ncolsLooked + col] = sum;
-    }
-
-#pragma omp parallel for
-    for (size_t kk = 0; kk < _nrowsLooked * _ncolsLooked; ++kk){
-        size_t line = kk/_ncolsLooked;
-        size_t col = kk%_ncolsLooked;
-        std::complex<T> sum = std::complex<T> (0.0 , 0.0);
-        for (size_t i=line*_rowsLooks; i<(line+1)*_rowsLooks; ++i){
-            sum += tempOutput[i*_ncolsLooked + col];
-        }
-        output[line * _ncolsLooked + col] = sum;
-    }
-
-    output /= (_colsLooks * _rowsLooks);
+    scale(&output[0], _nrowsLooked * _ncolsLooked);
 }
 
 /**
@@ -315,40 +396,16 @@ multilook(std::valarray<std::complex<T>> &input,
             std::valarray<std::complex<T>> &output)
 {
 
-    std::valarray<std::complex<T>> tempOutput(_nrows*_ncolsLooked);
-    std::valarray<T> tempSumWeights(_nrows * _ncolsLooked);
+    const size_t size = _nrowsLooked * _ncolsLooked;
+    std::vector<std::complex<T>> sum(size);
+    std::vector<T> sumWeights(size);
+    boxSum(&input[0], &weights[0], _ncols, _nrowsLooked, _ncolsLooked,
+           _colsLooks, _rowsLooks, Identity<std::complex<T>>(), sum.data(),
+           sumWeights.data());
 
-#pragma omp parallel for
-    for (size_t kk = 0; kk < _nrows*_ncolsLooked; ++kk){
-        size_t line = kk/_ncolsLooked;
-        size_t col = kk%_ncolsLooked;
-
-        std::complex<T> sum = std::complex<T> (0.0, 0.0);
-        T sumWeights = 0;
-
-        for (size_t j=col*_colsLooks; j<(col+1)*_colsLooks; ++j){
-            sum += weights[line*_ncols+j] * input[line*_ncols+j];
-            sumWeights += weights[line * _ncols + j];
-        }
-
-        tempOutput[line*_ncolsLooked + col] = sum;
-        tempSumWeights[line * _ncolsLooked + col] = sumWeights;
-    }
-
-    #pragma omp parallel for
-    for (size_t kk = 0; kk < _nrowsLooked * _ncolsLooked; ++kk){
-        size_t line = kk/_ncolsLooked;
-        size_t col = kk%_ncolsLooked;
-        std::complex<T> sum = std::complex<T> (0.0 , 0.0);
-        T sumWeights = 0;
-        for (size_t i=line*_rowsLooks; i<(line+1)*_rowsLooks; ++i){
-            sum += tempOutput[i*_ncolsLooked + col];
-            sumWeights += tempSumWeights[i * _ncolsLooked + col];
-        }
-
-        output[line * _ncolsLooked + col] = sum / sumWeights;
+    for (size_t i = 0; i < size; ++i) {
+        output[i] = sum[i] / sumWeights[i];
     }
-    
 }
 
 /**
@@ -365,33 +422,11 @@ void isce3::signal::Looks<T>::multilook(std::valarray<std::complex<T>>& input,
     if (exponent == 0)
         exponent = 2;
 
-    std::valarray<T> tempOutput(_nrows * _ncolsLooked);
+    boxSumPow(&input[0], _ncols, _nrowsLooked, _ncolsLooked, _colsLooks,
+              _rowsLooks, exponent, &output[0]);
 
-#pragma omp parallel for
-    for (size_t kk = 0; kk < _nrows * _ncolsLooked; ++kk) {
-        size_t line = kk / _ncolsLooked;
-        size_t col = kk % _ncolsLooked;
-        T sum = 0.0;
-        for (size_t j = col * _colsLooks; j < (col + 1) * _colsLooks; ++j) {
-            sum += std::pow(std::abs(input[line * _ncols + j]), exponent);
-        }
-        tempOutput[line * _ncolsLooked + col] = sum;
-    }
-
-#pragma omp parallel for
-    for (size_t kk = 0; kk < _nrowsLooked * _ncolsLooked; ++kk){
-        size_t line = kk/_ncolsLooked;
-        size_t col = kk%_ncolsLooked;
-        T sum = 0.0;
-        for (size_t i=line*_rowsLooks; i<(line+1)*_rowsLooks; ++i){
-            sum += tempOutput[i*_ncolsLooked + col];
-        }
-
-        output[line*_ncolsLooked+col] = sum;
-    }
-    output /= (_colsLooks * _rowsLooks);
+    scale(&output[0], _nrowsLooked * _ncolsLooked);
 }
 
 template class isce3::signal::Looks<float>;
 template class isce3::signal::Looks<double>;
-
@@ -39,6 +39,12 @@ class isce3::signal::Looks {
         ~Looks() {};
 
         /** Multi-looking with rasters
+         *
+         * The rasters are processed in strips of at most linesPerBlock()
+         * input lines (rounded down to a multiple of the number of looks
+         * on rows), so that memory usage does not depend on the raster
+         * size.
+         *
          * @param[in] input_raster input raster
          * @param[out] output raster
          * @param[in] exponent the power to which the absolute of complex
@@ -118,6 +124,12 @@ class isce3::signal::Looks {
         /** Set number of columns after multi-looking */
         inline void ncolsLooked(int);
 
+        /** Set number of input lines per strip when multi-looking rasters */
+        inline void linesPerBlock(size_t linesPerBlock) { _linesPerBlock = linesPerBlock; }
+
+        /** Get number of input lines per strip when multi-looking rasters */
+        inline size_t linesPerBlock() const { return _linesPerBlock; }
+
     private:
         // number of columns before multilooking
         size_t _ncols;
@@ -137,8 +149,15 @@ class isce3::signal::Looks {
         // numbe of looks in azimuth direction (rows)
         size_t _rowsLooks;
 
+        // number of input lines per strip when multi-looking rasters
+        size_t _linesPerBlock = 1024;
+
         // multilooking method
         // size_t _method;
+
+        // Divide multi-looked sums by the number of looks
+        template<class U>
+        void scale(U* data, size_t size) const;
 };
 
 template<class T>
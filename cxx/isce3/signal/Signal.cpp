@@ -1,11 +1,19 @@
 #include "Signal.h"
 #include <iostream>
-#include "fftw3cxx.h"
+#include <memory>
+#include <isce3/fft/detail/FFTWWrapper.h>
 
+using isce3::fft::detail::executePlan;
+
+// Plans are shared with other Signal objects & FFT plans of the same
+// configuration through the isce3::fft plan cache, and are executed on the
+// arrays passed to each transform.
 template<class T>
 struct isce3::signal::Signal<T>::impl {
-    isce3::fftw3cxx::plan<T> _plan_fwd;
-    isce3::fftw3cxx::plan<T> _plan_inv;
+    using plan_t = typename isce3::fft::detail::FFTWPlanType<T>::plan_t;
+    std::shared_ptr<plan_t> _plan_fwd;
+    std::shared_ptr<plan_t> _plan_inv;
+    int _nthreads = 1;
 };
 
 template <class T>
@@ -15,8 +23,7 @@ Signal() : pimpl(new impl, [](impl* p) { delete p; }) {}
 template <class T>
 isce3::signal::Signal<T>::
 Signal(int nthreads) : pimpl(new impl, [](impl* p) { delete p; }) {
-    fftw3cxx::init_threads<T>();
-    fftw3cxx::plan_with_nthreads<T>(nthreads);
+    pimpl->_nthreads = nthreads;
 }
 
 /**
@@ -76,10 +83,10 @@ fftPlanForward(std::complex<T> *input, std::complex<T> *output,
                inembed, istride, idist, 
                onembed, ostride, odist);
 
-    pimpl->_plan_fwd = fftw3cxx::plan<T>::plan_many_dft(rank, n, howmany,
+    pimpl->_plan_fwd = isce3::fft::detail::getPlan(rank, n, howmany,
                                             input, inembed, istride, idist,
                                             output, onembed, ostride, odist,
-                                            sign, FFTW_ESTIMATE);
+                                            sign, FFTW_ESTIMATE, pimpl->_nthreads);
 
 }
 
@@ -136,10 +143,10 @@ fftPlanForward(T *input, std::complex<T> *output,
                inembed, istride, idist, 
                onembed, ostride, odist);
 
-    pimpl->_plan_fwd = fftw3cxx::plan<T>::plan_many_dft_r2c(rank, n, howmany,
+    pimpl->_plan_fwd = isce3::fft::detail::getPlan(rank, n, howmany,
                                             input, inembed, istride, idist,
                                             output, onembed, ostride, odist,
-                                            FFTW_ESTIMATE);
+                                            FFTW_FORWARD, FFTW_ESTIMATE, pimpl->_nthreads);
 
 }
 
@@ -202,10 +209,10 @@ fftPlanBackward(std::complex<T> *input, std::complex<T> *output,
                inembed, istride, idist, 
                onembed, ostride, odist);
 
-    pimpl->_plan_inv = fftw3cxx::plan<T>::plan_many_dft(rank, n, howmany,
+    pimpl->_plan_inv = isce3::fft::detail::getPlan(rank, n, howmany,
                                             input, inembed, istride, idist,
                                             output, onembed, ostride, odist,
-                                            sign, FFTW_ESTIMATE);
+                                            sign, FFTW_ESTIMATE, pimpl->_nthreads);
 
 }
 
@@ -264,10 +271,10 @@ fftPlanBackward(std::complex<T> *input, T *output,
                inembed, istride, idist, 
                onembed, ostride, odist);
 
-    pimpl->_plan_inv = fftw3cxx::plan<T>::plan_many_dft_c2r(rank, n, howmany,
+    pimpl->_plan_inv = isce3::fft::detail::getPlan(rank, n, howmany,
                                             input, inembed, istride, idist,
                                             output, onembed, ostride, odist,
-                                            FFTW_ESTIMATE);
+                                            FFTW_BACKWARD, FFTW_ESTIMATE, pimpl->_nthreads);
 
 }
 
@@ -280,7 +287,7 @@ void
 isce3::signal::Signal<T>::
 forward(std::valarray<std::complex<T>> &input, std::valarray<std::complex<T>> &output)
 {
-    pimpl->_plan_fwd.execute_dft(&input[0], &output[0]);
+    executePlan(*pimpl->_plan_fwd, &input[0], &output[0]);
 }
 
 /** unnormalized forward transform
@@ -292,7 +299,7 @@ void
 isce3::signal::Signal<T>::
 forward(std::complex<T> *input, std::complex<T> *output)
 {
-    pimpl->_plan_fwd.execute_dft(input, output);
+    executePlan(*pimpl->_plan_fwd, input, output);
 }
 
 /** unnormalized forward transform
@@ -304,7 +311,7 @@ void
 isce3::signal::Signal<T>::
 forward(std::valarray<T> &input, std::valarray<std::complex<T>> &output)
 {
-    pimpl->_plan_fwd.execute_dft_r2c(&input[0], &output[0]);
+    executePlan(*pimpl->_plan_fwd, &input[0], &output[0]);
 }
 
 /** unnormalized forward transform
@@ -316,7 +323,7 @@ void
 isce3::signal::Signal<T>::
 forward(T *input, std::complex<T> *output)
 {
-    pimpl->_plan_fwd.execute_dft_r2c(input, output);
+    executePlan(*pimpl->_plan_fwd, input, output);
 }
 
 
@@ -333,7 +340,7 @@ void
 isce3::signal::Signal<T>::
 inverse(std::valarray<std::complex<T>> &input, std::valarray<std::complex<T>> &output)
 {
-    pimpl->_plan_inv.execute_dft(&input[0], &output[0]);
+    executePlan(*pimpl->_plan_inv, &input[0], &output[0]);
 }
 
 /** unnormalized inverse transform.*/
@@ -342,7 +349,7 @@ void
 isce3::signal::Signal<T>::
 inverse(std::complex<T> *input, std::complex<T> *output)
 {
-    pimpl->_plan_inv.execute_dft(input, output);
+    executePlan(*pimpl->_plan_inv, input, output);
 }
 
 /** unnormalized inverse transform.*/
@@ -351,7 +358,7 @@ void
 isce3::signal::Signal<T>::
 inverse(std::valarray<std::complex<T>> &input, std::valarray<T> &output)
 {
-    pimpl->_plan_inv.execute_dft_c2r(&input[0], &output[0]);
+    executePlan(*pimpl->_plan_inv, &input[0], &output[0]);
 }
 
 /** unnormalized inverse transform.*/
@@ -360,7 +367,7 @@ void
 isce3::signal::Signal<T>::
 inverse(std::complex<T> *input, T *output)
 {
-    pimpl->_plan_inv.execute_dft_c2r(input, output);
+    executePlan(*pimpl->_plan_inv, input, output);
 }
 
 /**
@@ -984,7 +991,7 @@ upsample(std::valarray<std::complex<T>> &signal,
     spectrumShifted = std::complex<T> (0.0,0.0);
 
     // forward fft in range
-    pimpl->_plan_fwd.execute_dft(&signal[0], &spectrum[0]);
+    executePlan(*pimpl->_plan_fwd, &signal[0], &spectrum[0]);
 
     //spectrum /= fft_size;
     //shift the spectrum
@@ -1014,7 +1021,7 @@ upsample(std::valarray<std::complex<T>> &signal,
         spectrumShifted *= shiftImpact;
 
     // inverse fft to get the upsampled signal
-    pimpl->_plan_inv.execute_dft(&spectrumShifted[0], &signalUpsampled[0]);
+    executePlan(*pimpl->_plan_inv, &spectrumShifted[0], &signalUpsampled[0]);
 
     // Normalize
     signalUpsampled /= fft_size;
@@ -1050,7 +1057,7 @@ void isce3::signal::Signal<T>::upsample(
     spectrumShifted = std::complex<T>(0.0, 0.0);
 
     // forward fft in range
-    pimpl->_plan_fwd.execute_dft(signal.data(), spectrum.data());
+    executePlan(*pimpl->_plan_fwd, signal.data(), spectrum.data());
 
     // spectrum /= fft_size;
     // shift the spectrum
@@ -1072,7 +1079,7 @@ void isce3::signal::Signal<T>::upsample(
         spectrumShifted *= shiftImpact;
 
     // inverse fft to get the upsampled signal
-    pimpl->_plan_inv.execute_dft(spectrumShifted.data(),
+    executePlan(*pimpl->_plan_inv, spectrumShifted.data(),
                                  signalUpsampled.data());
 
     // Normalize
@@ -1218,9 +1225,9 @@ upsample2D(std::complex<T> *signal,
     // output container, the forward FFT is done out-of-place and the reverse FFT will be
     // done in-place.
     if (signal != signalUpsampled) 
-       pimpl->_plan_fwd.execute_dft(signal, signalUpsampled);
+       executePlan(*pimpl->_plan_fwd, signal, signalUpsampled);
     else
-       pimpl->_plan_fwd.execute_dft(signalUpsampled, signalUpsampled);
+       executePlan(*pimpl->_plan_fwd, signalUpsampled, signalUpsampled);
 
 
     // [2] Spectrum shuffling - Moving the 4 quarts to the corners of the output (larger)
@@ -1263,7 +1270,7 @@ upsample2D(std::complex<T> *signal,
 
 
     // [3] Inverse fft to get the upsampled signal
-    pimpl->_plan_inv.execute_dft(signalUpsampled, signalUpsampled);
+    executePlan(*pimpl->_plan_inv, signalUpsampled, signalUpsampled);
 
 
     // [4] Normalize
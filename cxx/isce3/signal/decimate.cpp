@@ -4,14 +4,14 @@
 
 #include <isce3/except/Error.h>
 
-template<typename T>
-void isce3::signal::decimate(std::valarray<T>& out, const std::valarray<T>& in,
-                             size_t nrows, size_t ncols, size_t nrows_decimated,
-                             size_t ncols_decimated, size_t rows_decimation,
-                             size_t cols_decimation, size_t rows_offset,
-                             size_t cols_offset)
-{
+namespace {
 
+void checkDecimation(size_t in_size, size_t out_size, size_t nrows,
+                     size_t ncols, size_t nrows_decimated,
+                     size_t ncols_decimated, size_t rows_decimation,
+                     size_t cols_decimation, size_t rows_offset,
+                     size_t cols_offset)
+{
     // sanity checks
     if (nrows <= 0) {
         throw isce3::except::DomainError(
@@ -31,12 +31,12 @@ void isce3::signal::decimate(std::valarray<T>& out, const std::valarray<T>& in,
                 ISCE_SRCINFO(),
                 "Number of columns of the output should be > 0");
     }
-    if (in.size() != nrows * ncols) {
+    if (in_size != nrows * ncols) {
         throw isce3::except::DomainError(
                 ISCE_SRCINFO(),
                 "Input size does not match the input rows and columns");
     }
-    if (out.size() != nrows_decimated * ncols_decimated) {
+    if (out_size != nrows_decimated * ncols_decimated) {
         throw isce3::except::DomainError(
                 ISCE_SRCINFO(),
                 "Output size does not match the output rows and columns");
@@ -56,6 +56,20 @@ void isce3::signal::decimate(std::valarray<T>& out, const std::valarray<T>& in,
                 ISCE_SRCINFO(), "The input number of rows in the decimated "
                                 "data does not seem correct");
     }
+}
+
+} // namespace
+
+template<typename T>
+void isce3::signal::decimate(std::valarray<T>& out, const std::valarray<T>& in,
+                             size_t nrows, size_t ncols, size_t nrows_decimated,
+                             size_t ncols_decimated, size_t rows_decimation,
+                             size_t cols_decimation, size_t rows_offset,
+                             size_t cols_offset)
+{
+    checkDecimation(in.size(), out.size(), nrows, ncols, nrows_decimated,
+                    ncols_decimated, rows_decimation, cols_decimation,
+                    rows_offset, cols_offset);
 
     _Pragma("omp parallel for") for (size_t kk = 0;
                                      kk < nrows_decimated * ncols_decimated;
@@ -70,12 +84,38 @@ void isce3::signal::decimate(std::valarray<T>& out, const std::valarray<T>& in,
     }
 }
 
+template<typename T>
+void isce3::signal::decimate(std::valarray<T>& data, size_t nrows,
+                             size_t ncols, size_t nrows_decimated,
+                             size_t ncols_decimated, size_t rows_decimation,
+                             size_t cols_decimation, size_t rows_offset,
+                             size_t cols_offset)
+{
+    checkDecimation(data.size(), nrows_decimated * ncols_decimated, nrows,
+                    ncols, nrows_decimated, ncols_decimated, rows_decimation,
+                    cols_decimation, rows_offset, cols_offset);
+
+    // Output sample kk is read from an index >= kk, so a sequential forward
+    // pass never overwrites an input sample before it is used
+    for (size_t kk = 0; kk < nrows_decimated * ncols_decimated; ++kk) {
+        size_t line_out = kk / ncols_decimated;
+        size_t col_out = kk % ncols_decimated;
+        size_t line_in = line_out * rows_decimation + rows_offset;
+        size_t col_in = col_out * cols_decimation + cols_offset;
+        data[kk] = data[line_in * ncols + col_in];
+    }
+}
+
 #define SPECIALIZE_DECIMATE(T)                                                 \
     template void isce3::signal::decimate(                                     \
             std::valarray<T>& out, const std::valarray<T>& in, size_t nrows,   \
             size_t ncols, size_t nrows_decimated, size_t ncols_decimated,      \
             size_t rows_decimation, size_t cols_decimation,                    \
-            size_t rows_offset, size_t cols_offset);
+            size_t rows_offset, size_t cols_offset);                           \
+    template void isce3::signal::decimate(std::valarray<T>& data,              \
+            size_t nrows, size_t ncols, size_t nrows_decimated,                \
+            size_t ncols_decimated, size_t rows_decimation,                    \
+            size_t cols_decimation, size_t rows_offset, size_t cols_offset);
 
 SPECIALIZE_DECIMATE(float)
 SPECIALIZE_DECIMATE(double)
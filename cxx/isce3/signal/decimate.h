@@ -23,4 +23,26 @@ void decimate(std::valarray<T>& out, const std::valarray<T>& in, size_t nrows,
               size_t rows_decimation, size_t cols_decimation,
               size_t rows_offset = 0, size_t cols_offset = 0);
 
+/**
+ * Decimate a 2D dataset in place without allocating an output buffer.
+ *
+ * The decimated samples are stored row-major in the first
+ * nrows_decimated * ncols_decimated elements of data; the size of data is
+ * left unchanged so that the buffer can be reused for the next block.
+ * \param[in,out] data data to be decimated
+ * \param[in] nrows number of rows in the input array before decimation
+ * \param[in] ncols number of columns in the input array before decimation
+ * \param[in] nrows_decimated number of rows in the decimated data
+ * \param[in] ncols_decimated number of columns in the decimated data
+ * \param[in] rows_decimation decimation factor in rows direction
+ * \param[in] cols_decimation decimation factor in columns direction
+ * \param[in] rows_offset offset in row direction to start decimation
+ * \param[in] cols_offset offset in columns direction to start decimation
+ */
+template<typename T>
+void decimate(std::valarray<T>& data, size_t nrows, size_t ncols,
+              size_t nrows_decimated, size_t ncols_decimated,
+              size_t rows_decimation, size_t cols_decimation,
+              size_t rows_offset = 0, size_t cols_offset = 0);
+
 }} // namespace isce3::signal
@@ -1,15 +1,26 @@
 #include "filter2D.h"
 
+#include <algorithm>
+#include <cmath>
 #include <complex>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
 
 #include <isce3/core/TypeTraits.h>
 #include <isce3/core/Utilities.h>
 #include <isce3/except/Error.h>
+#include <isce3/fft/FFTPlan.h>
+#include <isce3/fft/FFTUtil.h>
 #include <isce3/io/Raster.h>
 #include <isce3/signal/convolve.h>
 #include <isce3/signal/decimate.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 void check_kernels(const std::valarray<double>& kernel_columns,
                    const std::valarray<double>& kernel_rows)
 {
@@ -80,57 +91,374 @@ void check_rasters(isce3::io::Raster& input_raster,
     }
 }
 
-void setup_block_parameters(const int nrows, const int blockRows,
-                            const int row_start, const int nblocks,
-                            const int block, const int pad_rows,
-                            int& block_line_start, int& line_start_read,
-                            int& line_stop_read, int& block_rows_data,
-                            int& block_rows_data_padded)
+namespace {
+
+// Size of an FFT tile along one dimension and the cost of filtering one
+// output sample along that dimension. Larger tiles amortize the kernel
+// overlap but cost more per sample; tiles are capped to stay cache sized.
+struct TileSize {
+    int fft_size;
+    double cost;
+};
+
+TileSize select_tile_size(int kernel_size, int data_size)
+{
+    const int max_size = std::max(512, 2 * kernel_size);
+    const int data_fft_size = isce3::fft::nextPowerOfTwo(data_size);
+    TileSize best {0, std::numeric_limits<double>::max()};
+    for (int n = isce3::fft::nextPowerOfTwo(std::max(kernel_size, 16));
+         n <= max_size; n *= 2) {
+        const double cost = double(n) / (n - kernel_size + 1);
+        if (cost < best.cost) {
+            best = {n, cost};
+        }
+        // no point in tiles larger than the data
+        if (n >= data_fft_size)
+            break;
+    }
+    return best;
+}
+
+// cost per output pixel of FFT convolution with tiles of fft_rows x
+// fft_cols samples
+double fft_cost(int ncols_kernel, int nrows_kernel, int ncols, int nrows,
+                bool mask, const isce3::signal::FilterCostModel& cost,
+                int& fft_cols, int& fft_rows)
 {
+    const TileSize tile_cols = select_tile_size(ncols_kernel, ncols);
+    const TileSize tile_rows = select_tile_size(nrows_kernel, nrows);
+    fft_cols = tile_cols.fft_size;
+    fft_rows = tile_rows.fft_size;
+
+    // forward & inverse transforms of the data (and of the weights when
+    // masked) plus the product of the spectra, per input sample of a tile,
+    // scaled by the ratio of input to output samples of a tile
+    const int nfft = mask ? 4 : 2;
+    const double per_sample =
+            nfft * cost.fft * std::log2(double(fft_cols) * fft_rows) +
+            (mask ? 2 : 1);
+    return per_sample * tile_cols.cost * tile_rows.cost;
+}
+
+// Cheapest method to filter ncols x nrows blocks of data, and the size of
+// the FFT tiles used if FFT convolution is selected or requested
+isce3::signal::FilterMethod
+select_method(int ncols_kernel, int nrows_kernel, int ncols, int nrows,
+              bool mask, const isce3::signal::FilterCostModel& cost,
+              int& fft_cols, int& fft_rows)
+{
+    using isce3::signal::FilterMethod;
+
+    const double direct_2d = cost.direct2D * ncols_kernel * nrows_kernel;
+    const double separable = cost.separable * (ncols_kernel + nrows_kernel) +
+                             cost.separableOverhead;
+    const double fft = fft_cost(ncols_kernel, nrows_kernel, ncols, nrows,
+                                mask, cost, fft_cols, fft_rows);
+
+    if (direct_2d <= separable and direct_2d <= fft)
+        return FilterMethod::Direct2D;
+    if (separable <= fft)
+        return FilterMethod::DirectSeparable;
+    return FilterMethod::FFT;
+}
 
-    if ((row_start + blockRows) > nrows) {
-        block_rows_data = nrows - row_start;
+// Convert the complex result of FFT convolution to the data type
+template<typename T>
+T from_complex(const std::complex<double>& z)
+{
+    if constexpr (isce3::is_complex<T>::value) {
+        return T(z);
     } else {
-        block_rows_data = blockRows;
+        return T(z.real());
+    }
+}
+
+/*
+ * Direct convolution with the 2D kernel formed by the outer product of the
+ * separable kernels. Same conventions as convolve2D: the input is padded by
+ * half the kernel size on each side, the output is normalized by the sum
+ * of the kernel weights of valid pixels and masked pixels are not
+ * updated.
+ */
+template<typename T>
+void convolve2D_direct(std::valarray<T>& output, const std::valarray<T>& input,
+                       const bool* mask,
+                       const std::valarray<double>& kernel_columns,
+                       const std::valarray<double>& kernel_rows, int ncols,
+                       int ncols_padded)
+{
+    using PromotedType = typename isce3::core::double_promote<T>::type;
+
+    const int ncols_kernel = kernel_columns.size();
+    const int nrows_kernel = kernel_rows.size();
+    const int nrows = output.size() / ncols;
+    const int line_start = nrows_kernel / 2;
+    const int col_start = ncols_kernel / 2;
+
+    std::vector<double> kernel(nrows_kernel * ncols_kernel);
+    double kernel_sum = 0.0;
+    for (int i = 0; i < nrows_kernel; ++i) {
+        for (int j = 0; j < ncols_kernel; ++j) {
+            kernel[i * ncols_kernel + j] = kernel_rows[i] * kernel_columns[j];
+            kernel_sum += kernel[i * ncols_kernel + j];
+        }
     }
 
-    // Due to padding required for convolution, we need to know
-    // where reading the block of data starts/stops and where the
-    // block of data within the padded block is located
-    if (block == 0 && nblocks == 1) {
-        // when there is only one block
-        line_start_read = row_start;
-        line_stop_read = line_start_read + block_rows_data;
-        block_line_start = pad_rows;
-
-    } else if (block == 0) {
-        // at first block and there are more than one blocks to process
-        line_start_read = row_start;
-        line_stop_read = line_start_read + block_rows_data + pad_rows;
-        block_line_start = pad_rows;
-
-    } else if (block == nblocks - 1) {
-        // at last block and there more than one block
-        line_start_read = row_start - pad_rows;
-        line_stop_read = line_start_read + block_rows_data + pad_rows;
-        block_line_start = 0;
+    #pragma omp parallel for
+    for (int line = 0; line < nrows; ++line) {
+        for (int col = 0; col < ncols; ++col) {
+            const int center =
+                    (line + line_start) * ncols_padded + col + col_start;
+            if (mask and not mask[center])
+                continue;
+
+            T s = 0.0;
+            auto sum = static_cast<PromotedType>(s);
+            double sum_kernel = mask ? 0.0 : kernel_sum;
+            for (int i = 0; i < nrows_kernel; ++i) {
+                const int window = (line + i) * ncols_padded + col;
+                const double* k = &kernel[i * ncols_kernel];
+                if (mask) {
+                    for (int j = 0; j < ncols_kernel; ++j) {
+                        if (mask[window + j]) {
+                            sum += k[j] * static_cast<PromotedType>(
+                                                  input[window + j]);
+                            sum_kernel += k[j];
+                        }
+                    }
+                } else {
+                    for (int j = 0; j < ncols_kernel; ++j) {
+                        sum += k[j] *
+                               static_cast<PromotedType>(input[window + j]);
+                    }
+                }
+            }
 
-    } else {
-        // any block in the middle
-        line_start_read = row_start - pad_rows;
-        line_stop_read = line_start_read + block_rows_data + 2 * pad_rows;
-        block_line_start = 0;
+            if (sum_kernel > 0.0) {
+                output[line * ncols + col] = sum / sum_kernel;
+            } else {
+                output[line * ncols + col] = 0.0;
+            }
+        }
     }
+}
+
+/*
+ * Convolution in frequency domain by overlap-save. The padded input block
+ * is split into overlapping tiles of fft_rows x fft_cols samples whose
+ * circular correlation with the kernel is computed by FFT; the samples of
+ * each tile not affected by wrap-around are the output. Tiles are
+ * processed in parallel with per-thread buffers and plans. Masked data
+ * are filtered by also correlating the mask with the kernel, which gives
+ * the normalization of each output pixel.
+ */
+template<typename T>
+class FFTFilter {
+public:
+    FFTFilter(const std::valarray<double>& kernel_columns,
+              const std::valarray<double>& kernel_rows, int fft_cols,
+              int fft_rows, bool mask, int nthreads) :
+        _ncols_kernel(kernel_columns.size()),
+        _nrows_kernel(kernel_rows.size()),
+        _fft_cols(fft_cols),
+        _fft_rows(fft_rows),
+        _mask(mask),
+        _spectrum(fft_cols * fft_rows)
+    {
+        const int n[2] = {fft_rows, fft_cols};
+
+        _kernel_sum = 0.0;
+        _kernel_abs_sum = 0.0;
+        for (int i = 0; i < _nrows_kernel; ++i) {
+            for (int j = 0; j < _ncols_kernel; ++j) {
+                const double k = kernel_rows[i] * kernel_columns[j];
+                _spectrum[i * fft_cols + j] = k;
+                _kernel_sum += k;
+                _kernel_abs_sum += std::abs(k);
+            }
+        }
+
+        // FFT plans are created here, outside of the parallel region
+        _workspaces.resize(nthreads);
+        for (auto& ws : _workspaces) {
+            ws.data.resize(fft_cols * fft_rows);
+            ws.fwd = isce3::fft::FwdFFTPlan<double>(
+                    ws.data.data(), ws.data.data(), n, 1, FFTW_MEASURE, 1);
+            ws.inv = isce3::fft::InvFFTPlan<double>(
+                    ws.data.data(), ws.data.data(), n, 1, FFTW_MEASURE, 1);
+            if (mask) {
+                ws.weights.resize(fft_cols * fft_rows);
+                ws.fwd_weights = isce3::fft::FwdFFTPlan<double>(
+                        ws.weights.data(), ws.weights.data(), n, 1,
+                        FFTW_MEASURE, 1);
+                ws.inv_weights = isce3::fft::InvFFTPlan<double>(
+                        ws.weights.data(), ws.weights.data(), n, 1,
+                        FFTW_MEASURE, 1);
+            }
+        }
 
-    // number of lines in the block
-    block_rows_data_padded = line_stop_read - line_start_read;
+        // Spectrum of the kernel, conjugated so that the product with the
+        // spectrum of the data gives a correlation, and normalized for the
+        // unnormalized inverse FFT
+        std::vector<std::complex<double>> kernel(_spectrum);
+        isce3::fft::FwdFFTPlan<double> plan(_spectrum.data(), kernel.data(),
+                                            n, 1, FFTW_ESTIMATE, 1);
+        plan.execute();
+        const double scale = 1.0 / (double(fft_cols) * fft_rows);
+        for (auto& z : _spectrum) {
+            z = std::conj(z) * scale;
+        }
+    }
+
+    void filter(std::valarray<T>& output, const std::valarray<T>& input,
+                const bool* mask, int ncols, int ncols_padded)
+    {
+        const int nrows = output.size() / ncols;
+        const int nrows_padded = input.size() / ncols_padded;
+
+        // number of output samples of a tile
+        const int tile_cols = _fft_cols - _ncols_kernel + 1;
+        const int tile_rows = _fft_rows - _nrows_kernel + 1;
+        const int ntiles_cols = (ncols + tile_cols - 1) / tile_cols;
+        const int ntiles_rows = (nrows + tile_rows - 1) / tile_rows;
+
+        const int line_start = _nrows_kernel / 2;
+        const int col_start = _ncols_kernel / 2;
+
+        // threshold below which the sum of the kernel weights of valid
+        // pixels is considered zero (FFT round-off)
+        const double min_weight = 1e-9 * _kernel_abs_sum;
+
+        #pragma omp parallel num_threads(_workspaces.size())
+        {
+#ifdef _OPENMP
+            Workspace& ws = _workspaces[omp_get_thread_num()];
+#else
+            Workspace& ws = _workspaces[0];
+#endif
+
+            #pragma omp for schedule(dynamic)
+            for (int tile = 0; tile < ntiles_rows * ntiles_cols; ++tile) {
+                const int line0 = (tile / ntiles_cols) * tile_rows;
+                const int col0 = (tile % ntiles_cols) * tile_cols;
+
+                // copy the padded input window (zero outside of the block)
+                for (int i = 0; i < _fft_rows; ++i) {
+                    const int line = line0 + i;
+                    std::complex<double>* data = &ws.data[i * _fft_cols];
+                    std::complex<double>* weights =
+                            mask ? &ws.weights[i * _fft_cols] : nullptr;
+                    for (int j = 0; j < _fft_cols; ++j) {
+                        const int col = col0 + j;
+                        if (line >= nrows_padded or col >= ncols_padded) {
+                            data[j] = 0.0;
+                            if (mask)
+                                weights[j] = 0.0;
+                            continue;
+                        }
+                        const int index = line * ncols_padded + col;
+                        const std::complex<double> value(input[index]);
+                        if (mask) {
+                            const double w = mask[index] ? 1.0 : 0.0;
+                            data[j] = value * w;
+                            weights[j] = w;
+                        } else {
+                            data[j] = value;
+                        }
+                    }
+                }
+
+                ws.fwd.execute();
+                for (size_t k = 0; k < _spectrum.size(); ++k) {
+                    ws.data[k] *= _spectrum[k];
+                }
+                ws.inv.execute();
+
+                if (mask) {
+                    ws.fwd_weights.execute();
+                    for (size_t k = 0; k < _spectrum.size(); ++k) {
+                        ws.weights[k] *= _spectrum[k];
+                    }
+                    ws.inv_weights.execute();
+                }
+
+                const int rows = std::min(tile_rows, nrows - line0);
+                const int cols = std::min(tile_cols, ncols - col0);
+                for (int i = 0; i < rows; ++i) {
+                    for (int j = 0; j < cols; ++j) {
+                        const int line = line0 + i;
+                        const int col = col0 + j;
+                        const int k = i * _fft_cols + j;
+                        double sum_kernel = _kernel_sum;
+                        if (mask) {
+                            const int center = (line + line_start) *
+                                                       ncols_padded +
+                                               col + col_start;
+                            if (not mask[center])
+                                continue;
+                            sum_kernel = ws.weights[k].real();
+                        }
+
+                        T& out = output[line * ncols + col];
+                        if (sum_kernel > min_weight) {
+                            out = from_complex<T>(ws.data[k] / sum_kernel);
+                        } else {
+                            out = 0.0;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    struct Workspace {
+        std::vector<std::complex<double>> data;
+        std::vector<std::complex<double>> weights;
+        isce3::fft::FwdFFTPlan<double> fwd, fwd_weights;
+        isce3::fft::InvFFTPlan<double> inv, inv_weights;
+    };
+
+    int _ncols_kernel, _nrows_kernel;
+    int _fft_cols, _fft_rows;
+    bool _mask;
+    double _kernel_sum, _kernel_abs_sum;
+
+    // conjugated and normalized spectrum of the kernel
+    std::vector<std::complex<double>> _spectrum;
+
+    std::vector<Workspace> _workspaces;
+};
+
+const char* method_name(isce3::signal::FilterMethod method)
+{
+    using isce3::signal::FilterMethod;
+    switch (method) {
+    case FilterMethod::DirectSeparable: return "direct separable";
+    case FilterMethod::Direct2D: return "direct 2D";
+    case FilterMethod::FFT: return "FFT";
+    default: return "auto";
+    }
+}
+
+} // namespace
+
+isce3::signal::FilterMethod
+isce3::signal::selectFilterMethod(int ncols_kernel, int nrows_kernel,
+                                  int ncols, int nrows, bool mask,
+                                  const FilterCostModel& cost)
+{
+    int fft_cols, fft_rows;
+    return select_method(ncols_kernel, nrows_kernel, ncols, nrows, mask, cost,
+                         fft_cols, fft_rows);
 }
 
 template<typename T>
 void isce3::signal::filter2D(isce3::io::Raster& output_raster,
                              isce3::io::Raster& input_raster,
                              const std::valarray<double>& kernel_columns,
-                             const std::valarray<double>& kernel_rows, int block_rows)
+                             const std::valarray<double>& kernel_rows, int block_rows,
+                             FilterMethod method, const FilterCostModel& cost)
 {
 
     bool do_decimate = false;
@@ -160,7 +488,8 @@ void isce3::signal::filter2D(isce3::io::Raster& output_raster,
                                   "ENVI");
 
     filter2D<T>(output_raster, input_raster, mask_raster, kernel_columns,
-                kernel_rows, do_decimate, mask_data, block_rows);
+                kernel_rows, do_decimate, mask_data, block_rows, method,
+                cost);
 }
 
 template<typename T>
@@ -168,7 +497,8 @@ void isce3::signal::filter2D(isce3::io::Raster& output_raster,
                              isce3::io::Raster& input_raster,
                              isce3::io::Raster& mask_raster,
                              const std::valarray<double>& kernel_columns,
-                             const std::valarray<double>& kernel_rows, int block_rows)
+                             const std::valarray<double>& kernel_rows, int block_rows,
+                             FilterMethod method, const FilterCostModel& cost)
 {
 
     std::cout << "A mask is provided. The input will be masked before filtering"
@@ -184,7 +514,8 @@ void isce3::signal::filter2D(isce3::io::Raster& output_raster,
     }
 
     filter2D<T>(output_raster, input_raster, mask_raster, kernel_columns,
-                kernel_rows, do_decimate, mask_data, block_rows);
+                kernel_rows, do_decimate, mask_data, block_rows, method,
+                cost);
 }
 
 template<typename T>
@@ -194,7 +525,8 @@ void isce3::signal::filter2D(isce3::io::Raster& output_raster,
                              const std::valarray<double>& kernel_columns,
                              const std::valarray<double>& kernel_rows,
                              const bool do_decimate, const bool mask_data,
-                             int block_rows)
+                             int block_rows, FilterMethod method,
+                             const FilterCostModel& cost)
 {
 
     // sanity checks
@@ -228,7 +560,7 @@ void isce3::signal::filter2D(isce3::io::Raster& output_raster,
 
     int ncols_padded = ncols + 2 * pad_cols;
 
-    block_rows = (block_rows / nrows_kernel) * nrows_kernel;
+    block_rows = std::max(block_rows / nrows_kernel, 1) * nrows_kernel;
 
     // number of blocks to process
     int nblocks = nrows / block_rows;
@@ -258,6 +590,37 @@ void isce3::signal::filter2D(isce3::io::Raster& output_raster,
         output_decimated.resize(block_rows_decimated * ncols_decimated);
     }
 
+    // select the convolution method for the blocks that are filtered, with
+    // the FFT tiles its cost is based on
+    int fft_cols = 0, fft_rows = 0;
+    const FilterMethod selected = select_method(ncols_kernel, nrows_kernel,
+            ncols_padded, block_rows_padded, mask_data, cost, fft_cols,
+            fft_rows);
+    if (method == FilterMethod::Auto) {
+        method = selected;
+    }
+    std::cout << "filtering method: " << method_name(method) << std::endl;
+
+    std::unique_ptr<FFTFilter<T>> fft_filter;
+    if (method == FilterMethod::FFT) {
+        int nthreads = 1;
+#ifdef _OPENMP
+        #pragma omp parallel
+        {
+            #pragma omp single
+            nthreads = omp_get_num_threads();
+        }
+#endif
+        fft_filter = std::make_unique<FFTFilter<T>>(kernel_columns,
+                kernel_rows, fft_cols, fft_rows, mask_data, nthreads);
+    }
+
+    // Line i of the padded block buffer holds line (row_start - pad_rows + i)
+    // of the input raster, or zeros outside of the raster. The 2 * pad_rows
+    // lines at the end of a block are the first lines of the next block, so
+    // they are moved to the top of the buffer instead of being read again.
+    const int halo_rows = 2 * pad_rows;
+
     for (int block = 0; block < nblocks; ++block) {
         std::cout << "working on block: " << block + 1 << std::endl;
         int row_start = block * block_rows;
@@ -267,48 +630,62 @@ void isce3::signal::filter2D(isce3::io::Raster& output_raster,
         // block_rows_data might be less than or equal to blockRows.
         // e.g. if nrows = 512, and blockRows = 100, then
         // block_rows_data for last block will be 12
-        int block_rows_data, block_rows_data_padded;
-        int line_start_read, line_stop_read, block_line_start;
-        setup_block_parameters(nrows, block_rows, row_start, nblocks, block,
-                               pad_rows, block_line_start, line_start_read,
-                               line_stop_read, block_rows_data,
-                               block_rows_data_padded);
+        int block_rows_data = std::min(block_rows, nrows - row_start);
 
-        // containers for one line of data
-        std::valarray<T> data_line(ncols);
-
-        input = 0.0;
         output = 0.0;
 
-        // read the block of data
-        for (size_t line = 0; line < block_rows_data_padded; ++line) {
-
-            input_raster.getLine(data_line, line_start_read + line);
-            input[std::slice((line + block_line_start) * ncols_padded +
-                                     pad_cols,
-                             ncols, 1)] = data_line;
+        int first_line = 0;
+        if (block > 0 and halo_rows > 0) {
+            std::copy(&input[block_rows * ncols_padded],
+                      &input[block_rows * ncols_padded] +
+                              halo_rows * ncols_padded,
+                      &input[0]);
+            if (mask_data) {
+                std::copy(&mask[block_rows * ncols_padded],
+                          &mask[block_rows * ncols_padded] +
+                                  halo_rows * ncols_padded,
+                          &mask[0]);
+            }
+            first_line = halo_rows;
         }
 
-        if (mask_data) {
-            mask = false;
-            std::valarray<bool> mask_line(ncols);
-            // read the block of data
-            for (size_t line = 0; line < block_rows_data_padded; ++line) {
-
-                mask_raster.getLine(mask_line, line_start_read + line);
-                mask[std::slice((line + block_line_start) * ncols_padded +
-                                        pad_cols,
-                                ncols, 1)] = mask_line;
+        // read the new lines of the block. Padded columns are never written
+        // and remain zero.
+        for (int line = first_line; line < block_rows_padded; ++line) {
+            const int raster_line = row_start - pad_rows + line;
+            T* data_line = &input[line * ncols_padded + pad_cols];
+            bool* mask_line =
+                    mask_data ? &mask[line * ncols_padded + pad_cols] : nullptr;
+            if (raster_line < 0 or raster_line >= nrows) {
+                std::fill(data_line, data_line + ncols, T(0.0));
+                if (mask_data)
+                    std::fill(mask_line, mask_line + ncols, false);
+                continue;
             }
+            input_raster.getLine(data_line, raster_line, ncols);
+            if (mask_data)
+                mask_raster.getLine(mask_line, raster_line, ncols);
+        }
 
+        switch (method) {
+        case FilterMethod::Direct2D:
+            convolve2D_direct(output, input, mask_data ? &mask[0] : nullptr,
+                              kernel_columns, kernel_rows, ncols,
+                              ncols_padded);
+            break;
+        case FilterMethod::FFT:
+            fft_filter->filter(output, input, mask_data ? &mask[0] : nullptr,
+                               ncols, ncols_padded);
+            break;
+        default:
             // Convolution in time domain
-            isce3::signal::convolve2D(output, input, mask, kernel_columns,
-                                      kernel_rows, ncols, ncols_padded);
-
-        } else {
-            // Convolution in time domain
-            isce3::signal::convolve2D(output, input, kernel_columns,
-                                      kernel_rows, ncols, ncols_padded);
+            if (mask_data) {
+                isce3::signal::convolve2D(output, input, mask, kernel_columns,
+                                          kernel_rows, ncols, ncols_padded);
+            } else {
+                isce3::signal::convolve2D(output, input, kernel_columns,
+                                          kernel_rows, ncols, ncols_padded);
+            }
         }
 
         // write the output block of filtered data to the raster
@@ -338,18 +715,21 @@ void isce3::signal::filter2D(isce3::io::Raster& output_raster,
             isce3::io::Raster & output_raster,                                 \
             isce3::io::Raster & input_raster,                                  \
             const std::valarray<double> & kernel_columns,                      \
-            const std::valarray<double> & kernel_rows, int block_rows);        \
+            const std::valarray<double> & kernel_rows, int block_rows,         \
+            FilterMethod method, const FilterCostModel & cost);                \
     template void isce3::signal::filter2D<T>(                                  \
             isce3::io::Raster & output_raster,                                 \
             isce3::io::Raster & input_raster, isce3::io::Raster & mask_raster, \
             const std::valarray<double> & kernel_columns,                      \
-            const std::valarray<double> & kernel_rows, int block_rows);        \
+            const std::valarray<double> & kernel_rows, int block_rows,         \
+            FilterMethod method, const FilterCostModel & cost);                \
     template void isce3::signal::filter2D<T>(                                  \
             isce3::io::Raster & output_raster,                                 \
             isce3::io::Raster & input_raster, isce3::io::Raster & mask_raster, \
             const std::valarray<double> & kernel_columns,                      \
             const std::valarray<double> & kernel_rows, const bool do_decimate, \
-            const bool mask, int block_rows)
+            const bool mask, int block_rows, FilterMethod method,              \
+            const FilterCostModel & cost)
 
 SPECIALIZE_FILTER(float);
 SPECIALIZE_FILTER(std::complex<float>);
@@ -5,6 +5,55 @@
 
 namespace isce3 { namespace signal {
 
+/** Convolution method used by filter2D */
+enum class FilterMethod {
+    /** Select the cheapest method from the kernel size */
+    Auto,
+    /** Direct convolution with the two 1D kernels in turn */
+    DirectSeparable,
+    /** Direct convolution with the 2D (outer product) kernel */
+    Direct2D,
+    /** Block convolution in frequency domain (overlap-save) */
+    FFT
+};
+
+/**
+ * Relative costs of the filtering methods, used to select a method when
+ * FilterMethod::Auto is requested. Costs are expressed per output pixel in
+ * units of one multiply-add of the direct 2D convolution. The defaults are
+ * rough throughputs on current x86 hardware and may be recalibrated by
+ * timing each method on the target platform.
+ */
+struct FilterCostModel {
+    /** Cost of one multiply-add of the direct 2D convolution */
+    double direct2D = 1.0;
+    /** Cost of one multiply-add of the separable convolution */
+    double separable = 1.0;
+    /** Fixed cost per pixel of the intermediate pass of the separable
+     * convolution */
+    double separableOverhead = 4.0;
+    /** Cost per sample and per log2 of the size of a complex FFT */
+    double fft = 1.5;
+};
+
+/**
+ * Select the cheapest method to filter data with separable kernels.
+ * \param[in] ncols_kernel size of the kernel in columns direction
+ * \param[in] nrows_kernel size of the kernel in rows direction
+ * \param[in] ncols number of columns of the (padded) block of data filtered
+ * at once, which bounds the size of the FFT tiles
+ * \param[in] nrows number of rows of the (padded) block of data filtered
+ * at once
+ * \param[in] mask flag to indicate if the data are masked, which doubles
+ * the cost of FFT convolution
+ * \param[in] cost cost model
+ * \returns FilterMethod::DirectSeparable, FilterMethod::Direct2D or
+ * FilterMethod::FFT
+ */
+FilterMethod selectFilterMethod(int ncols_kernel, int nrows_kernel, int ncols,
+                                int nrows, bool mask = false,
+                                const FilterCostModel& cost = {});
+
 /**
  * filters real or complex type data by convolving two 1D separable kernels in
  * columns and rows directions. 
@@ -13,11 +62,16 @@ namespace isce3 { namespace signal {
  * \param[in] kernel_columns 1-D kernel in columns direction 
  * \param[in] kernel_rows 1-D kernel in rows direction 
  * \param[in] block_rows number of lines (rows) per block.
+ * \param[in] method convolution method
+ * \param[in] cost cost model used to select the method when method is
+ * FilterMethod::Auto
  */
 template<typename T>
 void filter2D(isce3::io::Raster& output_raster, isce3::io::Raster& input_raster,
               const std::valarray<double>& kernel_columns,
-              const std::valarray<double>& kernel_rows, int block_rows = 1000);
+              const std::valarray<double>& kernel_rows, int block_rows = 1000,
+              FilterMethod method = FilterMethod::Auto,
+              const FilterCostModel& cost = {});
 
 /**
  * filters real or complex data by convolving two 1D separable kernels in
@@ -28,12 +82,17 @@ void filter2D(isce3::io::Raster& output_raster, isce3::io::Raster& input_raster,
  * \param[in] kernel_columns 1-D kernel in columns direction 
  * \param[in] kernel_rows 1-D kernel in rows direction 
  * \param[in] block_rows number of lines (rows) per block
+ * \param[in] method convolution method
+ * \param[in] cost cost model used to select the method when method is
+ * FilterMethod::Auto
  * */
 template<typename T>
 void filter2D(isce3::io::Raster& output_raster, isce3::io::Raster& input_raster,
               isce3::io::Raster& mask_raster,
               const std::valarray<double>& kernel_columns,
-              const std::valarray<double>& kernel_rows, int block_rows = 1000);
+              const std::valarray<double>& kernel_rows, int block_rows = 1000,
+              FilterMethod method = FilterMethod::Auto,
+              const FilterCostModel& cost = {});
 
 /**
  * filters real or complex data by convolving two 1D separable kernels in
@@ -46,12 +105,21 @@ void filter2D(isce3::io::Raster& output_raster, isce3::io::Raster& input_raster,
  * \param[in] do_decimate flag to indicate if the output data will be decimated proportional to the kernel size 
  * \param[in] mask flag to indicate if the output data will be masked before filtering
  * \param[in] block_rows number of lines (rows) per block
+ * \param[in] method convolution method
+ * \param[in] cost cost model used to select the method when method is
+ * FilterMethod::Auto
+ *
+ * The input is read in blocks of block_rows lines. The lines overlapping
+ * the next block (the halo needed by the kernel) are kept in memory and
+ * only the new lines are read for each block.
  * */
 template<typename T>
 void filter2D(isce3::io::Raster& output_raster, isce3::io::Raster& input_raster,
               isce3::io::Raster& mask_raster,
               const std::valarray<double>& kernel_columns,
               const std::valarray<double>& kernel_rows, const bool do_decimate,
-              const bool mask = true, int block_rows = 1000);
+              const bool mask = true, int block_rows = 1000,
+              FilterMethod method = FilterMethod::Auto,
+              const FilterCostModel& cost = {});
 
 }} // namespace isce3::signal
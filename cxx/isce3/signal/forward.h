@@ -8,5 +8,6 @@ namespace isce3 { namespace signal {
     template<class> class Looks;
     template<class> class NFFT;
     template<class> class Signal;
+    template<class> class ShiftSignalWorkspace;
     template<class> class FilterData;
 }}
@@ -6,6 +6,11 @@
 
 #include "shiftSignal.h"
 
+#include <algorithm>
+
+#include <isce3/core/TypeTraits.h>
+#include <isce3/except/Error.h>
+
 /**
  * @param[in] data input data to be shifted
  * @param[out] dataShifted output data after the shift
@@ -178,6 +183,164 @@ frequencyResponseAzimuth(size_t ncols, size_t nrows, const double shift,
 }
 
 
+/**
+ * @param[in] ncols number of columns of the blocks of data
+ * @param[in] nrows number of rows of the blocks of data
+ * @param[in] shiftX constant shift in X direction (columns)
+ * @param[in] shiftY constant shift in Y direction (rows)
+ * @param[in] threads number of threads of the FFTs
+ */
+template<typename U>
+isce3::signal::ShiftSignalWorkspace<U>::
+ShiftSignalWorkspace(size_t ncols, size_t nrows,
+                     double shiftX, double shiftY, int threads) :
+    _ncols(ncols), _nrows(nrows), _shiftX(shiftX), _shiftY(shiftY),
+    _doShiftX(not isce3::core::compareFloatingPoint(shiftX, 0.0)),
+    _doShiftY(not isce3::core::compareFloatingPoint(shiftY, 0.0))
+{
+    if (ncols == 0 or nrows == 0) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(),
+                "block of data to shift must not be empty");
+    }
+    if (not _doShiftX and not _doShiftY) {
+        return;
+    }
+
+    // since FFTW is not normalized, the ramps include the inverse of the
+    // total length of the fft
+    const double fft_size = (_doShiftX ? ncols : 1) * (_doShiftY ? nrows : 1);
+    auto ramp = [fft_size](size_t n, double shift, double scale,
+                           std::vector<std::complex<U>> & out) {
+        std::valarray<double> frequencies(n);
+        fftfreq(1.0, frequencies);
+        out.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            double phase = -1.0*shift*2.0*M_PI*frequencies[i];
+            out[i] = std::complex<U>(scale * std::cos(phase),
+                                     scale * std::sin(phase));
+        }
+    };
+    if (_doShiftX) {
+        ramp(ncols, shiftX, 1.0 / fft_size, _rampX);
+    }
+    if (_doShiftY) {
+        ramp(nrows, shiftY, _doShiftX ? 1.0 : 1.0 / fft_size, _rampY);
+    }
+
+    _spectrum.resize(ncols * nrows);
+    std::complex<U> * buf = _spectrum.data();
+    if (_doShiftX and _doShiftY) {
+        const int n[2] = {int(nrows), int(ncols)};
+        _fwdPlan = isce3::fft::FwdFFTPlan<U>(buf, buf, n, 1, FFTW_MEASURE,
+                                             threads);
+        _invPlan = isce3::fft::InvFFTPlan<U>(buf, buf, n, 1, FFTW_MEASURE,
+                                             threads);
+    } else if (_doShiftX) {
+        // transform each row
+        _fwdPlan = isce3::fft::FwdFFTPlan<U>(buf, buf, ncols, nrows,
+                                             FFTW_MEASURE, threads);
+        _invPlan = isce3::fft::InvFFTPlan<U>(buf, buf, ncols, nrows,
+                                             FFTW_MEASURE, threads);
+    } else {
+        // transform each column
+        _fwdPlan = isce3::fft::FwdFFTPlan<U>(buf, buf, nrows, nrows, ncols, 1,
+                                             ncols, FFTW_MEASURE, threads);
+        _invPlan = isce3::fft::InvFFTPlan<U>(buf, buf, nrows, nrows, ncols, 1,
+                                             ncols, FFTW_MEASURE, threads);
+    }
+}
+
+/**
+ * @param[in] in input block of data to be shifted
+ * @param[out] out output block of data after the shift
+ */
+template<typename U>
+template<typename T>
+void isce3::signal::ShiftSignalWorkspace<U>::
+shift(const T * in, T * out)
+{
+    const size_t size = _ncols * _nrows;
+    if (not _doShiftX and not _doShiftY) {
+        // if no shift requested, return the original signal
+        if (in != out) {
+            std::copy(in, in + size, out);
+        }
+        return;
+    }
+
+    std::copy(in, in + size, _spectrum.begin());
+    _fwdPlan.execute();
+
+    // mutiply the spectrum by the impact of the shift in frequency domain
+    // F(X,Y) <--> f(x,y)
+    // exp(1J(x0+y0))*F(X,Y) <--> f(x-x0,y-y0)
+    for (size_t row = 0; row < _nrows; ++row) {
+        std::complex<U> * line = &_spectrum[row * _ncols];
+        if (_doShiftX and _doShiftY) {
+            const std::complex<U> rampY = _rampY[row];
+            for (size_t col = 0; col < _ncols; ++col) {
+                line[col] *= rampY * _rampX[col];
+            }
+        } else if (_doShiftX) {
+            for (size_t col = 0; col < _ncols; ++col) {
+                line[col] *= _rampX[col];
+            }
+        } else {
+            const std::complex<U> rampY = _rampY[row];
+            for (size_t col = 0; col < _ncols; ++col) {
+                line[col] *= rampY;
+            }
+        }
+    }
+
+    _invPlan.execute();
+
+    if constexpr (isce3::is_complex<T>::value) {
+        std::copy(_spectrum.begin(), _spectrum.end(), out);
+    } else {
+        for (size_t i = 0; i < size; ++i) {
+            out[i] = _spectrum[i].real();
+        }
+    }
+}
+
+/**
+ * @param[in,out] data block of data to be shifted in place
+ * @param[in] workspace workspace with the phase ramps and FFT plans of the
+ * shift and the shape of the block of data
+ */
+template<typename T, typename U>
+void isce3::signal::
+shiftSignal(std::valarray<T> & data,
+            isce3::signal::ShiftSignalWorkspace<U> & workspace)
+{
+    if (data.size() != workspace.ncols() * workspace.nrows()) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(),
+                "data size does not match the shift workspace");
+    }
+    workspace.shift(&data[0], &data[0]);
+}
+
+/**
+ * @param[in] data input data to be shifted
+ * @param[out] dataShifted output data after the shift
+ * @param[in] workspace workspace with the phase ramps and FFT plans of the
+ * shift and the shape of the block of data
+ */
+template<typename T, typename U>
+void isce3::signal::
+shiftSignal(const std::valarray<T> & data,
+            std::valarray<T> & dataShifted,
+            isce3::signal::ShiftSignalWorkspace<U> & workspace)
+{
+    if (data.size() != workspace.ncols() * workspace.nrows() or
+            dataShifted.size() != data.size()) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(),
+                "data size does not match the shift workspace");
+    }
+    workspace.shift(&data[0], &dataShifted[0]);
+}
+
 template void isce3::signal::
 shiftSignal(std::valarray<float> & data,
             std::valarray<float> & dataShifted,
@@ -258,3 +421,18 @@ template void isce3::signal::
             const double shift,
             std::valarray<std::complex<double>> & shiftImpact);
 
+#define SPECIALIZE_SHIFT_WORKSPACE(T, U)                                       \
+    template void isce3::signal::ShiftSignalWorkspace<U>::shift(               \
+            const T * in, T * out);                                            \
+    template void isce3::signal::shiftSignal(std::valarray<T> & data,          \
+            isce3::signal::ShiftSignalWorkspace<U> & workspace);               \
+    template void isce3::signal::shiftSignal(const std::valarray<T> & data,    \
+            std::valarray<T> & dataShifted,                                    \
+            isce3::signal::ShiftSignalWorkspace<U> & workspace);
+
+template class isce3::signal::ShiftSignalWorkspace<float>;
+template class isce3::signal::ShiftSignalWorkspace<double>;
+SPECIALIZE_SHIFT_WORKSPACE(float, float)
+SPECIALIZE_SHIFT_WORKSPACE(std::complex<float>, float)
+SPECIALIZE_SHIFT_WORKSPACE(double, double)
+SPECIALIZE_SHIFT_WORKSPACE(std::complex<double>, double)
@@ -9,9 +9,12 @@
 #include "forward.h"
 
 #include <cmath>
+#include <complex>
 #include <valarray>
+#include <vector>
 #include "Filter.h"
 #include <isce3/core/Utilities.h>
+#include <isce3/fft/FFTPlan.h>
 
 
 namespace isce3 {
@@ -38,6 +41,25 @@ namespace isce3 {
             std::valarray<std::complex<U>> & phaseRamp,
             isce3::signal::Signal<U> & sigObj);
         
+        /**
+         *\brief shift a block of data in place by constant offsets in x
+         * (columns) or y (rows) directions, reusing the phase ramps and FFT
+         * plans of a workspace
+         */
+        template<typename T, typename U>
+        void shiftSignal(std::valarray<T> & data,
+            ShiftSignalWorkspace<U> & workspace);
+
+        /**
+         *\brief shift a block of data by constant offsets in x (columns) or
+         * y (rows) directions, reusing the phase ramps and FFT plans of a
+         * workspace
+         */
+        template<typename T, typename U>
+        void shiftSignal(const std::valarray<T> & data,
+            std::valarray<T> & dataShifted,
+            ShiftSignalWorkspace<U> & workspace);
+
         /**
          *\brief compute the impact of a constant range pixel shift in frequency domain
          */
@@ -55,3 +77,65 @@ namespace isce3 {
             std::valarray<std::complex<T>> & shiftImpact);
     }
 }
+
+/**
+ * Workspace to shift blocks of data of a fixed size by constant offsets
+ * in x (columns) or y (rows) directions.
+ *
+ * The frequency response of the shift and the FFT plans are computed once
+ * at construction, so that shifting a block neither allocates memory nor
+ * evaluates trigonometric functions. The response is stored as one ramp per
+ * direction whose product gives the 2D response. FFTs are computed over
+ * rows (shift in x only), columns (shift in y only) or in 2D.
+ */
+template<typename U>
+class isce3::signal::ShiftSignalWorkspace {
+    public:
+        /**
+         * Constructor
+         * \param[in] ncols number of columns of the blocks of data
+         * \param[in] nrows number of rows of the blocks of data
+         * \param[in] shiftX constant shift in X direction (columns)
+         * \param[in] shiftY constant shift in Y direction (rows)
+         * \param[in] threads number of threads of the FFTs
+         */
+        ShiftSignalWorkspace(size_t ncols, size_t nrows,
+                             double shiftX, double shiftY, int threads = 1);
+
+        /** Get number of columns */
+        size_t ncols() const { return _ncols; }
+
+        /** Get number of rows */
+        size_t nrows() const { return _nrows; }
+
+        /** Get shift in X direction (columns) */
+        double shiftX() const { return _shiftX; }
+
+        /** Get shift in Y direction (rows) */
+        double shiftY() const { return _shiftY; }
+
+        /**
+         * Shift a block of ncols x nrows samples (row major). Real data are
+         * shifted as complex data and the real part is kept. in and out may
+         * be the same buffer.
+         */
+        template<typename T>
+        void shift(const T * in, T * out);
+
+    private:
+        size_t _ncols, _nrows;
+        double _shiftX, _shiftY;
+        bool _doShiftX, _doShiftY;
+
+        // frequency response of the shift in each direction, the
+        // normalization of the FFTs is included in the first non empty one
+        std::vector<std::complex<U>> _rampX;
+        std::vector<std::complex<U>> _rampY;
+
+        // spectrum of the block of data
+        std::vector<std::complex<U>> _spectrum;
+
+        isce3::fft::FwdFFTPlan<U> _fwdPlan;
+        isce3::fft::InvFFTPlan<U> _invPlan;
+};
+
@@ -1,5 +1,6 @@
 #include "Backproject.h"
 
+#include <memory>
 #include <optional>
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
@@ -9,6 +10,7 @@
 #include <isce3/except/Error.h>
 #include <isce3/focus/Backproject.h>
 #include <isce3/focus/DryTroposphereModel.h>
+#include <isce3/focus/FactorizedBackproject.h>
 #include <isce3/geometry/DEMInterpolator.h>
 #include <isce3/geometry/detail/Geo2Rdr.h>
 #include <isce3/geometry/detail/Rdr2Geo.h>
@@ -78,6 +80,57 @@ Geo2RdrBracketParams parse_geo2rdr_params(const py::dict& params)
 }
 
 
+// Check the shapes of the arrays passed to the backprojection functions and
+// return a pointer to the height array data (nullptr if not provided)
+static float* check_backproject_arrays(
+        py::array_t<std::complex<float>, py::array::c_style>& out,
+        const RadarGeometry& out_geometry,
+        const py::array_t<std::complex<float>, py::array::c_style>& in,
+        const RadarGeometry& in_geometry,
+        std::optional<py::array_t<float, py::array::c_style>>& height)
+{
+    if (out.ndim() != 2) {
+        throw InvalidArgument(ISCE_SRCINFO(), "output array must be 2-D");
+    }
+
+    if (out.shape()[0] != out_geometry.gridLength() or
+        out.shape()[1] != out_geometry.gridWidth()) {
+
+        std::string errmsg = "output array shape must match output "
+            "radar grid shape";
+        throw InvalidArgument(ISCE_SRCINFO(), errmsg);
+    }
+
+    if (in.ndim() != 2) {
+        throw InvalidArgument(ISCE_SRCINFO(), "input signal data must be 2-D");
+    }
+
+    if (in.shape()[0] != in_geometry.gridLength() or
+        in.shape()[1] != in_geometry.gridWidth()) {
+
+        std::string errmsg = "input signal data shape must match "
+            "input radar grid shape";
+        throw InvalidArgument(ISCE_SRCINFO(), errmsg);
+    }
+
+    float* height_data = nullptr;
+
+    if (height.has_value()) {
+        auto h = height.value();
+        if (h.shape()[0] != out_geometry.gridLength() or
+            h.shape()[1] != out_geometry.gridWidth()) {
+
+            std::string errmsg = "height array shape must match output "
+                "radar grid shape";
+            throw InvalidArgument(ISCE_SRCINFO(), errmsg);
+        }
+        height_data = h.mutable_data();
+    }
+
+    return height_data;
+}
+
+
 void addbinding_backproject(py::module& m)
 {
     m.def("backproject", [](
@@ -92,65 +145,100 @@ void addbinding_backproject(py::module& m)
                 const std::string& dry_tropo_model,
                 py::dict rdr2geo_params,
                 py::dict geo2rdr_params,
-                std::optional<py::array_t<float, py::array::c_style>> height) {
+                std::optional<py::array_t<float, py::array::c_style>> height,
+                const std::string& precision) {
 
-            if (out.ndim() != 2) {
-                throw InvalidArgument(ISCE_SRCINFO(), "output array must be 2-D");
-            }
+            std::complex<float>* out_data = out.mutable_data();
+            const std::complex<float>* in_data = in.data();
+            float* height_data = check_backproject_arrays(out, out_geometry,
+                    in, in_geometry, height);
 
-            if (out.shape()[0] != out_geometry.gridLength() or
-                out.shape()[1] != out_geometry.gridWidth()) {
+            DryTroposphereModel atm = parseDryTropoModel(dry_tropo_model);
+            BackprojectPrecision prec = parseBackprojectPrecision(precision);
 
-                std::string errmsg = "output array shape must match output "
-                    "radar grid shape";
-                throw InvalidArgument(ISCE_SRCINFO(), errmsg);
-            }
+            const auto r2gparams = parse_rdr2geo_params(rdr2geo_params);
+            const auto g2rparams = parse_geo2rdr_params(geo2rdr_params);
 
-            if (in.ndim() != 2) {
-                throw InvalidArgument(ISCE_SRCINFO(), "input signal data must be 2-D");
+            ErrorCode err;
+            {
+                py::gil_scoped_release release;
+                err = backproject(out_data, out_geometry, in_data, in_geometry,
+                    dem, fc, ds, kernel, atm, r2gparams, g2rparams,
+                    height_data, prec);
             }
+            // TODO bind ErrorCode class.  For now return nonzero on failure.
+            return err != ErrorCode::Success;
+            },
+            R"(
+                Focus in azimuth via time-domain backprojection.
+            )",
+            py::arg("out"),
+            py::arg("out_geometry"),
+            py::arg("in"),
+            py::arg("in_geometry"),
+            py::arg("dem"),
+            py::arg("fc"),
+            py::arg("ds"),
+            py::arg("kernel"),
+            py::arg("dry_tropo_model") = "tsx",
+            py::arg("rdr2geo_params") = py::dict(),
+            py::arg("geo2rdr_params") = py::dict(),
+            py::arg("height") = py::none(),
+            py::arg("precision") = "double");
+}
 
-            if (in.shape()[0] != in_geometry.gridLength() or
-                in.shape()[1] != in_geometry.gridWidth()) {
-
-                std::string errmsg = "input signal data shape must match "
-                    "input radar grid shape";
-                throw InvalidArgument(ISCE_SRCINFO(), errmsg);
-            }
+void addbinding_factorized_backproject(py::module& m)
+{
+    m.def("factorized_backproject", [](
+                py::array_t<std::complex<float>, py::array::c_style> out,
+                const RadarGeometry& out_geometry,
+                py::array_t<std::complex<float>, py::array::c_style> in,
+                const RadarGeometry& in_geometry,
+                const DEMInterpolator& dem,
+                double fc,
+                double ds,
+                const Kernel<float>& kernel,
+                const std::string& dry_tropo_model,
+                int leaf_size,
+                int depth,
+                double angular_oversampling,
+                py::dict rdr2geo_params,
+                py::dict geo2rdr_params,
+                std::optional<py::array_t<float, py::array::c_style>> height) {
 
             std::complex<float>* out_data = out.mutable_data();
             const std::complex<float>* in_data = in.data();
-            float* height_data = nullptr;
-
-            if (height.has_value()) {
-                auto h = height.value();
-                if (h.shape()[0] != out_geometry.gridLength() or
-                    h.shape()[1] != out_geometry.gridWidth()) {
-
-                    std::string errmsg = "height array shape must match output "
-                        "radar grid shape";
-                    throw InvalidArgument(ISCE_SRCINFO(), errmsg);
-                }
-                height_data = h.mutable_data();
-            }
+            float* height_data = check_backproject_arrays(out, out_geometry,
+                    in, in_geometry, height);
 
             DryTroposphereModel atm = parseDryTropoModel(dry_tropo_model);
 
+            FFBPParams ffbp_params;
+            ffbp_params.leaf_size = leaf_size;
+            ffbp_params.depth = depth;
+            ffbp_params.angular_oversampling = angular_oversampling;
+
             const auto r2gparams = parse_rdr2geo_params(rdr2geo_params);
             const auto g2rparams = parse_geo2rdr_params(geo2rdr_params);
 
             ErrorCode err;
             {
                 py::gil_scoped_release release;
-                err = backproject(out_data, out_geometry, in_data, in_geometry,
-                    dem, fc, ds, kernel, atm, r2gparams, g2rparams,
-                    height_data);
+                err = factorizedBackproject(out_data, out_geometry, in_data,
+                    in_geometry, dem, fc, ds, kernel, atm, ffbp_params,
+                    r2gparams, g2rparams, height_data);
             }
             // TODO bind ErrorCode class.  For now return nonzero on failure.
             return err != ErrorCode::Success;
             },
             R"(
-                Focus in azimuth via time-domain backprojection.
+                Focus in azimuth via fast factorized backprojection.
+
+                Approximates backproject() by merging subaperture images
+                backprojected onto polar grids.  leaf_size is the number of
+                pulses of the shortest subapertures, depth the number of
+                merge stages, and angular_oversampling the oversampling
+                factor of the subaperture images in angle.
             )",
             py::arg("out"),
             py::arg("out_geometry"),
@@ -161,7 +249,131 @@ void addbinding_backproject(py::module& m)
             py::arg("ds"),
             py::arg("kernel"),
             py::arg("dry_tropo_model") = "tsx",
+            py::arg("leaf_size") = 16,
+            py::arg("depth") = 4,
+            py::arg("angular_oversampling") = 2.,
             py::arg("rdr2geo_params") = py::dict(),
             py::arg("geo2rdr_params") = py::dict(),
             py::arg("height") = py::none());
 }
+
+void addbinding(py::class_<Backprojector>& pyBackprojector)
+{
+    using buf_t = py::array_t<std::complex<float>, py::array::c_style>;
+
+    pyBackprojector
+        .def(py::init([](const RadarGeometry& out_geometry,
+                         const RadarGeometry& in_geometry,
+                         const DEMInterpolator& dem,
+                         double fc,
+                         double ds,
+                         const Kernel<float>& kernel,
+                         const std::string& dry_tropo_model,
+                         py::dict rdr2geo_params,
+                         py::dict geo2rdr_params,
+                         const std::string& precision) {
+
+                DryTroposphereModel atm = parseDryTropoModel(dry_tropo_model);
+                BackprojectPrecision prec =
+                        parseBackprojectPrecision(precision);
+
+                const auto r2gparams = parse_rdr2geo_params(rdr2geo_params);
+                const auto g2rparams = parse_geo2rdr_params(geo2rdr_params);
+
+                py::gil_scoped_release release;
+                return std::make_unique<Backprojector>(out_geometry,
+                        in_geometry, dem, fc, ds, kernel, atm, r2gparams,
+                        g2rparams, prec);
+            }),
+            // the kernel is held by reference
+            py::keep_alive<1, 7>(),
+            py::arg("out_geometry"),
+            py::arg("in_geometry"),
+            py::arg("dem"),
+            py::arg("fc"),
+            py::arg("ds"),
+            py::arg("kernel"),
+            py::arg("dry_tropo_model") = "tsx",
+            py::arg("rdr2geo_params") = py::dict(),
+            py::arg("geo2rdr_params") = py::dict(),
+            py::arg("precision") = "double",
+            R"(
+    Incremental time-domain backprojection.
+
+    Locates the target of each output pixel on construction.  Batches of
+    range-compressed pulses are then accumulated into the output image with
+    add_pulses() and the focused image is written by finalize().
+            )")
+
+        .def("add_pulses",
+            [](Backprojector& self, const buf_t& pulses, int first_pulse) {
+                if (pulses.ndim() != 2) {
+                    throw InvalidArgument(ISCE_SRCINFO(),
+                            "pulses array must be 2-D");
+                }
+                if (pulses.shape(1) != self.inGeometry().gridWidth()) {
+                    std::string errmsg = "pulses array width must match "
+                        "input radar grid width";
+                    throw InvalidArgument(ISCE_SRCINFO(), errmsg);
+                }
+                py::gil_scoped_release release;
+                self.addPulses(pulses.data(), first_pulse, pulses.shape(0));
+            },
+            py::arg("pulses"),
+            py::arg("first_pulse"),
+            R"(
+    Backproject a batch of consecutive range-compressed pulses (2-D array of
+    shape (number of pulses, input grid width)) starting at pulse index
+    first_pulse of the input grid and accumulate them into the output image.
+            )")
+
+        .def("finalize",
+            [](const Backprojector& self, buf_t out,
+               std::optional<py::array_t<float, py::array::c_style>> height) {
+                const RadarGeometry& geom = self.outGeometry();
+                if (out.ndim() != 2 or
+                    out.shape(0) != geom.gridLength() or
+                    out.shape(1) != geom.gridWidth()) {
+
+                    std::string errmsg = "output array shape must match "
+                        "output radar grid shape";
+                    throw InvalidArgument(ISCE_SRCINFO(), errmsg);
+                }
+                float* height_data = nullptr;
+                if (height.has_value()) {
+                    auto h = height.value();
+                    if (h.ndim() != 2 or
+                        h.shape(0) != geom.gridLength() or
+                        h.shape(1) != geom.gridWidth()) {
+
+                        std::string errmsg = "height array shape must match "
+                            "output radar grid shape";
+                        throw InvalidArgument(ISCE_SRCINFO(), errmsg);
+                    }
+                    height_data = h.mutable_data();
+                }
+
+                ErrorCode err;
+                {
+                    py::gil_scoped_release release;
+                    err = self.finalize(out.mutable_data(), height_data);
+                }
+                // nonzero on failure, as for backproject()
+                return err != ErrorCode::Success;
+            },
+            py::arg("out"),
+            py::arg("height") = py::none(),
+            R"(
+    Write the image focused from the pulses added so far.  Returns nonzero if
+    geometry failed to converge for any pixel (set to NaN).
+            )")
+
+        .def("reset", &Backprojector::reset,
+            "Discard the pulses added so far, keeping the pixel geometry")
+
+        .def_property_readonly("out_geometry", &Backprojector::outGeometry)
+        .def_property_readonly("in_geometry", &Backprojector::inGeometry)
+        .def_property_readonly("num_pulses_added",
+                &Backprojector::numPulsesAdded)
+        ;
+}
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <pybind11/pybind11.h>
+#include <isce3/focus/Backproject.h>
 #include <isce3/geometry/detail/Rdr2Geo.h>
 #include <isce3/geometry/detail/Geo2Rdr.h>
 
 void addbinding_backproject(pybind11::module& m);
+void addbinding_factorized_backproject(pybind11::module& m);
+void addbinding(pybind11::class_<isce3::focus::Backprojector>&);
 
 isce3::geometry::detail::Rdr2GeoBracketParams
 parse_rdr2geo_params(const pybind11::dict& params);
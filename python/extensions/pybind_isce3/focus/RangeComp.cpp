@@ -40,18 +40,21 @@ void addbinding(py::class_<RangeComp>& pyRangeComp)
     using buf_t = py::array_t<T, py::array::c_style>;
 
     pyRangeComp
-        .def(py::init<const chirp_t &, int, int, RangeComp::Mode>(),
+        .def(py::init<const chirp_t &, int, int, RangeComp::Mode, int>(),
             py::arg("chirp"), py::arg("inputsize"),
             py::arg("maxbatch") = 1, py::arg("mode") = RangeComp::Mode::Full,
+            py::arg("segmentsize") = 0,
             R"(
     Forms a matched filter from the time-reversed complex conjugate of the
     chirp replica and creates FFT plans for frequency domain convolution
     with the matched filter.
 
-    chirp     Time-domain replica of the transmitted chirp waveform
-    inputsize Number of range samples in the signal to be compressed
-    maxbatch  Max batch size
-    mode      Convolution output mode
+    chirp       Time-domain replica of the transmitted chirp waveform
+    inputsize   Number of range samples in the signal to be compressed
+    maxbatch    Max batch size
+    mode        Convolution output mode
+    segmentsize Overlap-save segment FFT length (0 to use a single FFT
+                spanning the whole range line)
             )")
 
         .def("rangecompress",
@@ -87,6 +90,30 @@ void addbinding(py::class_<RangeComp>& pyRangeComp)
     function.  Batch size inferred from first dimension of 2D data (1 for 1D).
             )")
 
+        .def("rangecompress_parallel",
+            [](const RangeComp & self, buf_t & out, const buf_t & in) {
+                if (in.ndim() != 2 or out.ndim() != 2)
+                    throw std::invalid_argument("require 2D data");
+                if (in.shape(0) != out.shape(0))
+                    throw std::length_error(
+                        "require equal number of lines on input and output");
+                if (in.shape(1) != self.inputSize())
+                    throw std::length_error("unexpected input length");
+                if (out.shape(1) != self.outputSize())
+                    throw std::length_error("unexpected output length");
+                auto out_data = out.mutable_data();
+                auto in_data = in.data();
+                int nlines = in.shape(0);
+                py::gil_scoped_release release;
+                self.rangecompressParallel(out_data, in_data, nlines);
+            }, py::arg("out"), py::arg("in"), R"(
+    Perform pulse compression on a block of input signals in parallel
+
+    Lines are distributed over threads, each using its own workspace.  The
+    number of lines is not limited by maxbatch and the method may be called
+    concurrently from multiple threads.
+            )")
+
         .def_property_readonly("chirp_size", &RangeComp::chirpSize)
         .def_property_readonly("input_size", &RangeComp::inputSize)
         .def_property_readonly("fft_size", &RangeComp::fftSize)
@@ -95,5 +122,8 @@ void addbinding(py::class_<RangeComp>& pyRangeComp)
         .def_property_readonly("mode", &RangeComp::mode)
         .def_property_readonly("output_size", &RangeComp::outputSize)
         .def_property_readonly("first_valid_sample", &RangeComp::firstValidSample)
+        .def_property_readonly("is_segmented", &RangeComp::isSegmented)
+        .def_property_readonly("segment_fft_size", &RangeComp::segmentFFTSize)
+        .def_property_readonly("num_segments", &RangeComp::numSegments)
         ;
 }
@@ -15,6 +15,8 @@ void addsubmodule_focus(py::module & m)
     // forward declare bound enums
     py::enum_<isce3::focus::DryTroposphereModel> pyDryTropoModel(m_focus, "DryTroposphereModel");
 
+    py::class_<isce3::focus::Backprojector>
+        pyBackprojector(m_focus, "Backprojector");
     py::class_<isce3::focus::RangeComp> pyRangeComp(m_focus, "RangeComp");
     py::enum_<isce3::focus::RangeComp::Mode> pyMode(pyRangeComp, "Mode");
 
@@ -23,7 +25,9 @@ void addsubmodule_focus(py::module & m)
     addbinding(pyMode);
 
     addbinding_backproject(m_focus);
+    addbinding_factorized_backproject(m_focus);
     addbinding_chirp(m_focus);
     addbindings_presum(m_focus);
+    addbinding(pyBackprojector);
     addbinding(pyRangeComp);
 }
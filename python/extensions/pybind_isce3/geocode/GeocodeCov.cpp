@@ -37,6 +37,18 @@ void addbinding(py::class_<Geocode<T>>& pyGeocode)
                           &Geocode<T>::numiterGeo2rdr)
             .def_property("radar_block_margin", nullptr,
                     &Geocode<T>::radarBlockMargin)
+            .def_property("async_block_io",
+                    py::overload_cast<>(&Geocode<T>::asyncBlockIO, py::const_),
+                    py::overload_cast<bool>(&Geocode<T>::asyncBlockIO))
+            .def_property("geo2rdr_grid_spacing",
+                    py::overload_cast<>(
+                            &Geocode<T>::geo2rdrGridSpacing, py::const_),
+                    py::overload_cast<int>(&Geocode<T>::geo2rdrGridSpacing))
+            .def_property("geo2rdr_grid_tolerance",
+                    py::overload_cast<>(
+                            &Geocode<T>::geo2rdrGridTolerance, py::const_),
+                    py::overload_cast<double>(
+                            &Geocode<T>::geo2rdrGridTolerance))
             .def_property("data_interpolator",
                     py::overload_cast<>(
                             &Geocode<T>::dataInterpolator, py::const_),
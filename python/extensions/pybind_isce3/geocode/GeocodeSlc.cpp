@@ -41,7 +41,9 @@ void addbinding_geocodeslc(py::module & m)
             const bool,
             const std::complex<float>,
             isce3::io::Raster*,
-            isce3::io::Raster*>(&isce3::geocode::geocodeSlc<AzRgFunc>),
+            isce3::io::Raster*,
+            const int,
+            const double>(&isce3::geocode::geocodeSlc<AzRgFunc>),
         py::arg("output_raster"),
         py::arg("input_raster"),
         py::arg("dem_raster"),
@@ -66,6 +68,8 @@ void addbinding_geocodeslc(py::module & m)
                                 std::numeric_limits<float>::quiet_NaN()),
         py::arg("carrier_phase_raster") = nullptr,
         py::arg("flatten_phase_raster") = nullptr,
+        py::arg("geo2rdr_grid_spacing") = 0,
+        py::arg("geo2rdr_grid_tolerance") = 1e-3,
         R"(
         Geocode a SLC raster
 
@@ -115,6 +119,13 @@ void addbinding_geocodeslc(py::module & m)
             Optional output raster containing geocoded carrier phase
         flatten_phase_raster: Raster
             Optional output raster containing geocoded flattening phase
+        geo2rdr_grid_spacing: int
+            Spacing, in geo grid pixels, of the coarse control grid on which
+            geo2rdr is solved before interpolating to every pixel. Set to 0
+            (default) to solve geo2rdr for every pixel.
+        geo2rdr_grid_tolerance: float
+            Maximum interpolation residual, in radar grid pixels, before a
+            cell of the geo2rdr control grid is solved exactly
         )");
     m.def("geocode_slc", py::overload_cast<isce3::io::Raster &,
             isce3::io::Raster &, isce3::io::Raster &,
@@ -136,7 +147,9 @@ void addbinding_geocodeslc(py::module & m)
             const bool,
             const std::complex<float>,
             isce3::io::Raster*,
-            isce3::io::Raster*>(&isce3::geocode::geocodeSlc<AzRgFunc>),
+            isce3::io::Raster*,
+            const int,
+            const double>(&isce3::geocode::geocodeSlc<AzRgFunc>),
         py::arg("output_raster"),
         py::arg("input_raster"),
         py::arg("dem_raster"),
@@ -162,6 +175,8 @@ void addbinding_geocodeslc(py::module & m)
                                 std::numeric_limits<float>::quiet_NaN()),
         py::arg("carrier_phase_raster") = nullptr,
         py::arg("flatten_phase_raster") = nullptr,
+        py::arg("geo2rdr_grid_spacing") = 0,
+        py::arg("geo2rdr_grid_tolerance") = 1e-3,
         R"(
         Geocode a subset of a SLC raster based a sliced radar grid
 
@@ -213,6 +228,13 @@ void addbinding_geocodeslc(py::module & m)
             Optional output raster containing geocoded carrier phase
         flatten_phase_raster: Raster
             Optional output raster containing geocoded flattening phase
+        geo2rdr_grid_spacing: int
+            Spacing, in geo grid pixels, of the coarse control grid on which
+            geo2rdr is solved before interpolating to every pixel. Set to 0
+            (default) to solve geo2rdr for every pixel.
+        geo2rdr_grid_tolerance: float
+            Maximum interpolation residual, in radar grid pixels, before a
+            cell of the geo2rdr control grid is solved exactly
         )");
     m.def("_geocode_slc", py::overload_cast<
             std::vector<isce3::geocode::EArray2dc64>&,
@@ -238,7 +260,9 @@ void addbinding_geocodeslc(py::module & m)
             const isce3::core::LUT2d<double> &,
             const bool,
             const std::complex<float>,
-            const isce3::product::SubSwaths*>
+            const isce3::product::SubSwaths*,
+            const int,
+            const double>
             (&isce3::geocode::geocodeSlc<AzRgFunc>),
         py::arg("geo_data_blocks"),
         py::arg("mask_block"),
@@ -266,6 +290,8 @@ void addbinding_geocodeslc(py::module & m)
             std::complex<float>(std::numeric_limits<float>::quiet_NaN(),
                                 std::numeric_limits<float>::quiet_NaN()),
         py::arg("subswaths") = nullptr,
+        py::arg("geo2rdr_grid_spacing") = 0,
+        py::arg("geo2rdr_grid_tolerance") = 1e-3,
         R"(
         Geocode a subset of pixels for multiple radar SLC arrays to a given
         geogrid. All radar SLC arrays share a common radar grid. All output
@@ -328,6 +354,114 @@ void addbinding_geocodeslc(py::module & m)
         subswaths: isce3.product.SubSwaths, optional
             SubSwaths from RSLC to be used for masking geocoded output. If None,
             no subswath masking is performed. Defaults to None.
+        geo2rdr_grid_spacing: int
+            Spacing, in geo grid pixels, of the coarse control grid on which
+            geo2rdr is solved before interpolating to every pixel. Set to 0
+            (default) to solve geo2rdr for every pixel.
+        geo2rdr_grid_tolerance: float
+            Maximum interpolation residual, in radar grid pixels, before a
+            cell of the geo2rdr control grid is solved exactly
+        )");
+    m.def("geocode_slc_blocks", &isce3::geocode::geocodeSlcBlocks<AzRgFunc>,
+        py::arg("output_rasters"),
+        py::arg("mask_raster"),
+        py::arg("input_rasters"),
+        py::arg("dem_raster"),
+        py::arg("radargrid"),
+        py::arg("geogrid"),
+        py::arg("orbit"),
+        py::arg("native_doppler"),
+        py::arg("image_grid_doppler"),
+        py::arg("ellipsoid"),
+        py::arg("threshold_geo2rdr") = 1.0e-9,
+        py::arg("numiter_geo2rdr") = 25,
+        py::arg("lines_per_block") = 1000,
+        py::arg("columns_per_block") = 1000,
+        py::arg("flatten") = true,
+        py::arg("reramp") = true,
+        py::arg("az_carrier") = AzRgFunc(),
+        py::arg("rg_carrier") = AzRgFunc(),
+        py::arg("az_time_correction") = isce3::core::LUT2d<double>(),
+        py::arg("srange_correction") = isce3::core::LUT2d<double>(),
+        py::arg("flatten_with_corrected_srange") = false,
+        py::arg("invalid_value") =
+            std::complex<float>(std::numeric_limits<float>::quiet_NaN(),
+                                std::numeric_limits<float>::quiet_NaN()),
+        py::arg("subswaths") = nullptr,
+        py::arg("mantissa_bits") = 0,
+        py::arg("geogrid_expansion_threshold") = 100,
+        py::arg("geo2rdr_grid_spacing") = 0,
+        py::arg("geo2rdr_grid_tolerance") = 1e-3,
+        py::call_guard<py::gil_scoped_release>(),
+        R"(
+        Geocode multiple SLC rasters sharing a common radar grid to a geogrid,
+        one geogrid block at a time. Radar blocks are prefetched and geocoded
+        blocks are written by background threads while the current block is
+        geocoded. Geogrid blocks without radar data are left unwritten.
+
+        Parameters
+        ----------
+        output_rasters: list of Raster
+            Output rasters of the geocoded SLC, one per input raster
+        mask_raster: Raster or None
+            Optional output raster of the geocoded mask
+        input_rasters: list of Raster
+            Input rasters of the SLC in radar coordinates
+        dem_raster: Raster
+            Raster of the DEM
+        radargrid: RadarGridParameters
+            Radar grid parameters of the input rasters
+        geogrid: GeoGridParameters
+            Geo grid parameters of the output rasters
+        orbit: isce3.core.Orbit
+            Orbit object associated with radar grid
+        native_doppler: LUT2d
+            2D LUT doppler of the SLC image
+        image_grid_doppler: LUT2d
+            2d LUT doppler of the image grid
+        ellipsoid: Ellipsoid
+            Ellipsoid object
+        threshold_geo2rdr: float
+            Threshold for geo2rdr computations
+        numiter_geo2rdr: int
+            Maximum number of iterations for geo2rdr convergence
+        lines_per_block: int
+            Number of geogrid lines per block
+        columns_per_block: int
+            Number of geogrid columns per block
+        flatten: bool
+            Flag to flatten the geocoded SLC
+        reramp: bool
+            Flag to reramp the geocoded SLC
+        az_carrier: [LUT2d, Poly2d]
+            Azimuth carrier phase of the SLC data, in radians, as a function of azimuth and range
+        rg_carrier: [LUT2d, Poly2d]
+            Range carrier phase of the SLC data, in radians, as a function of azimuth and range
+        az_time_correction: LUT2d
+             geo2rdr azimuth additive correction, in seconds, as a function of azimuth and range
+        srange_correction: LUT2d
+            geo2rdr slant range additive correction, in meters, as a function of azimuth and range
+        flatten_with_corrected_srange: bool
+            flag to indicate whether geo2rdr slant-range additive values should be used for phase flattening
+        invalid_value: complex
+            invalid pixel fill value
+        subswaths: isce3.product.SubSwaths, optional
+            SubSwaths from RSLC to be used for masking geocoded output. If None,
+            no subswath masking is performed. Defaults to None.
+        mantissa_bits: int
+            Number of mantissa bits of the real and imaginary parts of the
+            geocoded SLC to keep, or 0 (default) to keep all of them
+        geogrid_expansion_threshold: int
+            Maximum number of outward expansions of the corners of a block
+            to search for geo2rdr convergence when computing its radar
+            bounding box
+        geo2rdr_grid_spacing: int
+            Spacing, in geo grid pixels, of the coarse control grid on which
+            geo2rdr is solved before interpolating to every pixel. Set to 0
+            (default) to solve geo2rdr for every pixel.
+        geo2rdr_grid_tolerance: float
+            Maximum interpolation residual, in radar grid pixels, before a
+            cell of the geo2rdr control grid is solved exactly
         )");
 }
 
@@ -52,6 +52,14 @@ void addbinding(pybind11::class_<DEMInterp>& pyDEMInterpolator)
                             double, double, int>(&DEMInterp::loadDEM),
                     py::arg("raster"), py::arg("min_x"), py::arg("max_x"),
                     py::arg("min_y"), py::arg("max_y"), py::arg("raster_band") = 1)
+            .def("load_dem_tiled", &DEMInterp::loadDEMTiled,
+                    py::arg("raster"), py::arg("raster_band") = 1,
+                    py::arg("tile_size") = 512,
+                    py::arg("max_cache_bytes") = 1UL << 30,
+                    R"(
+    Set up lazy access to the entire DEM through a thread-safe LRU cache of
+    tiles read on first use, instead of loading the DEM into memory.
+    )")
 
             .def("interpolate_lonlat", &DEMInterp::interpolateLonLat)
             .def("interpolate_xy", &DEMInterp::interpolateXY)
@@ -60,6 +68,7 @@ void addbinding(pybind11::class_<DEMInterp>& pyDEMInterpolator)
                     py::overload_cast<>(&DEMInterp::refHeight, py::const_),
                     py::overload_cast<double>(&DEMInterp::refHeight))
             .def_property_readonly("have_raster", &DEMInterp::haveRaster)
+            .def_property_readonly("is_tiled", &DEMInterp::isTiled)
             .def_property_readonly("have_stats", &DEMInterp::haveStats)
             .def_property("interp_method",
                     py::overload_cast<>(&DEMInterp::interpMethod, py::const_),
@@ -86,6 +95,10 @@ void addbinding(pybind11::class_<DEMInterp>& pyDEMInterpolator)
                             throw std::out_of_range(
                                     "Tried to access DEM data but size=0");
                         }
+                        if (self.isTiled()) {
+                            throw std::runtime_error(
+                                    "DEM data of a tiled DEM is not in memory");
+                        }
                         using namespace Eigen;
                         using MatF = Eigen::Matrix<float, Dynamic, Dynamic,
                                 RowMajor>;
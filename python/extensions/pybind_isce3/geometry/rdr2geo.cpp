@@ -272,5 +272,12 @@ void addbinding(py::class_<Topo>& pyRdr2Geo)
                     py::overload_cast<bool>(&Topo::computeMask))
             .def_property("lines_per_block",
                     py::overload_cast<>(&Topo::linesPerBlock, py::const_),
-                    py::overload_cast<size_t>(&Topo::linesPerBlock));
+                    py::overload_cast<size_t>(&Topo::linesPerBlock))
+            .def_property("layover_shadow_decimation",
+                    py::overload_cast<>(&Topo::layoverShadowDecimation,
+                            py::const_),
+                    py::overload_cast<int>(&Topo::layoverShadowDecimation))
+            .def_property("dem_tile_cache_size",
+                    py::overload_cast<>(&Topo::demTileCacheSize, py::const_),
+                    py::overload_cast<size_t>(&Topo::demTileCacheSize));
 }
@@ -65,6 +65,11 @@ void addbinding(py::class_<ResampSlc> & pyResampSlc)
         .def_property("lines_per_tile",
                 py::overload_cast<>(&ResampSlc::linesPerTile, py::const_),
                 py::overload_cast<size_t>(&ResampSlc::linesPerTile))
+        .def_property("polyphase_factor",
+                py::overload_cast<>(&ResampSlc::polyphaseFactor, py::const_),
+                py::overload_cast<int>(&ResampSlc::polyphaseFactor),
+                "Number of phases of separable polyphase interpolation "
+                "table, or 0 to use the 2D sinc interpolator")
         .def_property_readonly("start_range", &ResampSlc::startingRange)
         .def_property_readonly("range_pixel_spacing", &ResampSlc::rangePixelSpacing)
         .def_property_readonly("sensing_start", &ResampSlc::sensingStart)
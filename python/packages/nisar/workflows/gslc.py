@@ -25,6 +25,81 @@ from nisar.workflows.yaml_argparse import YamlArgparse
 from nisar.products.writers import GslcWriter
 from nisar.workflows.helpers import validate_fs_page_size
 
+
+def geocode_slc_blocks_numpy(rslc_datasets, gslc_datasets, mask_dataset,
+                             is_complex32, output_type, geo_grid, radar_grid,
+                             orbit, dem_raster, lines_per_block,
+                             columns_per_block, geogrid_expansion_threshold,
+                             native_doppler, image_grid_doppler, ellipsoid,
+                             threshold_geo2rdr, iteration_geo2rdr, flatten,
+                             az_correction, srg_correction, sub_swaths):
+    '''
+    Geocode RSLC datasets block by block with h5py I/O, for the input and
+    output data types not handled by isce3.geocode.geocode_slc_blocks
+    '''
+    # loop over geogrid blocks skipping those without radar data
+    # where block_generator skips blocks where no radar data is found
+    for (rdr_blk_slice, geo_blk_slice, geo_blk_shape, blk_geo_grid) in \
+         block_generator(geo_grid, radar_grid, orbit, dem_raster,
+                         lines_per_block, columns_per_block,
+                         geogrid_expansion_threshold):
+
+        # unpack block parameters
+        az_first = rdr_blk_slice[0].start
+        rg_first = rdr_blk_slice[1].start
+
+        # init input/rslc and output/gslc blocks for each polarization
+        gslc_data_blks = []
+        rslc_data_blks = []
+        for rslc_dataset in rslc_datasets:
+            # extract RSLC data block/array
+            if is_complex32:
+                rslc_data_blks.append(
+                    read_c4_dataset_as_c8(rslc_dataset, rdr_blk_slice))
+            else:
+                rslc_data_blks.append(rslc_dataset[rdr_blk_slice])
+
+            # prepare zero'd GSLC data block/array
+            gslc_data_blks.append(
+                np.zeros(geo_blk_shape, dtype=np.complex64))
+
+        # init geocoded mask block/array with 255 as invalid value
+        mask_data_blk = np.full(geo_blk_shape, 255, dtype=np.ubyte)
+
+        # run geocodeSlc
+        isce3.geocode.geocode_slc(gslc_data_blks, mask_data_blk, rslc_data_blks,
+                                  dem_raster, radar_grid, blk_geo_grid,
+                                  orbit, native_doppler,
+                                  image_grid_doppler, ellipsoid,
+                                  threshold_geo2rdr,
+                                  iteration_geo2rdr,
+                                  radar_grid,
+                                  first_azimuth_line=az_first,
+                                  first_range_sample=rg_first,
+                                  flatten=flatten,
+                                  az_time_correction=az_correction,
+                                  srange_correction=srg_correction,
+                                  subswaths=sub_swaths)
+
+        # write geocoded blocks to respective HDF5 datasets
+        for gslc_dataset, gslc_data_blk in zip(gslc_datasets,
+                                               gslc_data_blks):
+            # only convert/modify output if type not 'complex64'
+            # do nothing if type is 'complex64'
+            if output_type == 'complex32':
+                gslc_data_blk = to_complex32(gslc_data_blk)
+            if output_type == 'complex64_zero_mantissa':
+                # use default nonzero_mantissa_bits = 10 below
+                truncate_mantissa(gslc_data_blk)
+
+            # write to GSLC block HDF5
+            gslc_dataset.write_direct(gslc_data_blk,
+                                      dest_sel=geo_blk_slice)
+
+        # write to mask block HDF5
+        mask_dataset.write_direct(mask_data_blk, dest_sel=geo_blk_slice)
+
+
 def run(cfg):
     '''
     run geocodeSlc according to parameters in cfg dict
@@ -140,9 +215,11 @@ def run(cfg):
             # initialize source/rslc and destination/gslc datasets
             rslc_datasets = []
             gslc_datasets = []
+            any_complex32 = False
             for polarization in pol_list:
                 # check the datatype of RSLC
                 is_complex32 = slc.is_dataset_complex32(freq, polarization)
+                any_complex32 = any_complex32 or is_complex32
 
                 # path and dataset to rdr SLC data in HDF5
                 rslc_ds_path = slc.slcPath(freq, polarization)
@@ -156,68 +233,47 @@ def run(cfg):
             mask_dataset_path = f'/{root_ds}/mask'
             mask_dataset = dst_h5[mask_dataset_path]
 
-            # loop over geogrid blocks skipping those without radar data
-            # where block_generator skips blocks where no radar data is found
-            for (rdr_blk_slice, geo_blk_slice, geo_blk_shape, blk_geo_grid) in \
-                 block_generator(geo_grid, radar_grid, orbit, dem_raster,
-                                 lines_per_block, columns_per_block,
-                                 geogrid_expansion_threshold):
-
-                # unpack block parameters
-                az_first = rdr_blk_slice[0].start
-                rg_first = rdr_blk_slice[1].start
-
-                # init input/rslc and output/gslc blocks for each polarization
-                gslc_data_blks = []
-                rslc_data_blks = []
-                for rslc_dataset in rslc_datasets:
-                    # extract RSLC data block/array
-                    if is_complex32:
-                        rslc_data_blks.append(
-                            read_c4_dataset_as_c8(rslc_dataset, rdr_blk_slice))
-                    else:
-                        rslc_data_blks.append(rslc_dataset[rdr_blk_slice])
-
-                    # prepare zero'd GSLC data block/array
-                    gslc_data_blks.append(
-                        np.zeros(geo_blk_shape, dtype=np.complex64))
-
-                # init geocoded mask block/array with 255 as invalid value
-                mask_data_blk = np.full(geo_blk_shape, 255, dtype=np.ubyte)
-
-                # run geocodeSlc
-                isce3.geocode.geocode_slc(gslc_data_blks, mask_data_blk, rslc_data_blks,
-                                          dem_raster, radar_grid, blk_geo_grid,
-                                          orbit, native_doppler,
-                                          image_grid_doppler, ellipsoid,
-                                          threshold_geo2rdr,
-                                          iteration_geo2rdr,
-                                          radar_grid,
-                                          first_azimuth_line=az_first,
-                                          first_range_sample=rg_first,
-                                          flatten=flatten,
-                                          az_time_correction=az_correction,
-                                          srange_correction=srg_correction,
-                                          subswaths=sub_swaths)
-
-                # write geocoded blocks to respective HDF5 datasets
-                for gslc_dataset, gslc_data_blk in zip(gslc_datasets,
-                                                       gslc_data_blks):
-                    # only convert/modify output if type not 'complex64'
-                    # do nothing if type is 'complex64'
-                    output_type = cfg['output']['data_type']
-                    if output_type == 'complex32':
-                        gslc_data_blk = to_complex32(gslc_data_blk)
-                    if output_type == 'complex64_zero_mantissa':
-                        # use default nonzero_mantissa_bits = 10 below
-                        truncate_mantissa(gslc_data_blk)
-
-                    # write to GSLC block HDF5
-                    gslc_dataset.write_direct(gslc_data_blk,
-                                              dest_sel=geo_blk_slice)
-
-                # write to mask block HDF5
-                mask_dataset.write_direct(mask_data_blk, dest_sel=geo_blk_slice)
+            output_type = cfg['output']['data_type']
+            if not any_complex32 and output_type in ['complex64',
+                                                     'complex64_zero_mantissa']:
+                # geocode all polarizations block by block in C++, with
+                # radar blocks prefetched and geocoded blocks written in the
+                # background
+                def h5_raster(dataset, update=False):
+                    return isce3.io.Raster(
+                        f"IH5:::ID={dataset.id.id}".encode("utf-8"),
+                        update=update)
+
+                rslc_rasters = [h5_raster(ds) for ds in rslc_datasets]
+                gslc_rasters = [h5_raster(ds, update=True)
+                                for ds in gslc_datasets]
+                mask_raster = h5_raster(mask_dataset, update=True)
+
+                # use default nonzero_mantissa_bits = 10 below
+                mantissa_bits = 10 \
+                    if output_type == 'complex64_zero_mantissa' else 0
+
+                isce3.geocode.geocode_slc_blocks(
+                    gslc_rasters, mask_raster, rslc_rasters, dem_raster,
+                    radar_grid, geo_grid, orbit, native_doppler,
+                    image_grid_doppler, ellipsoid, threshold_geo2rdr,
+                    iteration_geo2rdr, lines_per_block, columns_per_block,
+                    flatten=flatten, az_time_correction=az_correction,
+                    srange_correction=srg_correction, subswaths=sub_swaths,
+                    mantissa_bits=mantissa_bits,
+                    geogrid_expansion_threshold=geogrid_expansion_threshold)
+
+                # release the HDF5 backed rasters before computing stats
+                del rslc_rasters, gslc_rasters, mask_raster
+            else:
+                geocode_slc_blocks_numpy(
+                    rslc_datasets, gslc_datasets, mask_dataset, any_complex32,
+                    output_type, geo_grid, radar_grid, orbit, dem_raster,
+                    lines_per_block, columns_per_block,
+                    geogrid_expansion_threshold, native_doppler,
+                    image_grid_doppler, ellipsoid, threshold_geo2rdr,
+                    iteration_geo2rdr, flatten, az_correction,
+                    srg_correction, sub_swaths)
 
             # loop over polarizations and compute statistics
             for gslc_dataset in gslc_datasets:
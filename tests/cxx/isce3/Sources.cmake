@@ -5,6 +5,7 @@ container/rsd.cpp
 core/attitude/quaternion_euler.cpp
 core/attitude/attitude.cpp
 core/attitude/representations.cpp
+core/blockprocessing/tilescheduler.cpp
 core/datetime/datetime.cpp
 core/ellipsoid/ellipsoid.cpp
 core/interp1d.cpp
@@ -34,6 +35,7 @@ focus/presum.cpp
 focus/rangecomp.cpp
 geocode/geocodeCov.cpp
 geocode/geocodeSlc.cpp
+geocode/geo2rdrBlock.cpp
 geometry/dem/dem.cpp
 geometry/geo2rdr/geo2rdr.cpp
 geometry/geometry/geometry_constlat.cpp
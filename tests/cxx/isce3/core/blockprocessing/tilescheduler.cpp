@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <isce3/core/blockProcessing.h>
+#include <isce3/except/Error.h>
+
+using isce3::core::getTiles2d;
+using isce3::core::Tile2d;
+using isce3::core::TileScheduler;
+
+TEST(TileSchedulerTest, Tiles2dCoverArray)
+{
+    const int length = 103, width = 57;
+    const int halo_y = 3, halo_x = 5;
+    auto tiles = getTiles2d(length, width, 20, 16, halo_y, halo_x);
+
+    // 6 x 4 tiles
+    ASSERT_EQ(tiles.size(), 24);
+
+    // every sample is covered by exactly one tile
+    std::vector<int> count(length * width, 0);
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        const Tile2d& tile = tiles[i];
+        EXPECT_EQ(tile.index, i);
+        for (int y = tile.offset_y; y < tile.offset_y + tile.length; ++y)
+            for (int x = tile.offset_x; x < tile.offset_x + tile.width; ++x)
+                count[y * width + x]++;
+
+        // halo region contains the tile and is clipped to the array
+        EXPECT_LE(tile.halo_offset_y, tile.offset_y);
+        EXPECT_LE(tile.halo_offset_x, tile.offset_x);
+        EXPECT_GE(tile.halo_offset_y, 0);
+        EXPECT_GE(tile.halo_offset_x, 0);
+        EXPECT_EQ(tile.halo_offset_y, std::max(tile.offset_y - halo_y, 0));
+        EXPECT_EQ(tile.halo_offset_x, std::max(tile.offset_x - halo_x, 0));
+        EXPECT_EQ(tile.halo_offset_y + tile.halo_length,
+                  std::min(tile.offset_y + tile.length + halo_y, length));
+        EXPECT_EQ(tile.halo_offset_x + tile.halo_width,
+                  std::min(tile.offset_x + tile.width + halo_x, width));
+    }
+    for (int c : count)
+        ASSERT_EQ(c, 1);
+
+    // last row/column of tiles are truncated
+    EXPECT_EQ(tiles.back().length, 3);
+    EXPECT_EQ(tiles.back().width, 9);
+
+    EXPECT_THROW(getTiles2d(length, width, 0, 16), std::invalid_argument);
+    EXPECT_THROW(getTiles2d(length, width, 20, 16, -1, 0),
+                 std::invalid_argument);
+}
+
+TEST(TileSchedulerTest, MemoryBudget)
+{
+    const int length = 2000, width = 3000;
+    const int nbands = 2, type_size = 8;
+    const int halo_y = 10, halo_x = 20;
+    const long long max_memory = 1 << 22;
+    const int n_threads = 4;
+
+    TileScheduler scheduler(length, width, nbands, type_size, halo_y, halo_x,
+                            max_memory, 1 << 10, 4, 1, n_threads);
+
+    ASSERT_EQ(scheduler.numThreads(), n_threads);
+    ASSERT_GT(scheduler.numTiles(), n_threads);
+
+    // all tiles processed concurrently fit in the memory budget
+    const long long tile_bytes =
+            static_cast<long long>(scheduler.tileLength() + 2 * halo_y) *
+            (scheduler.tileWidth() + 2 * halo_x) * nbands * type_size;
+    EXPECT_LE(tile_bytes * n_threads, max_memory);
+
+    // snapped tiles are rounded down to stay within the budget
+    const int snap = 200;
+    TileScheduler snapped(length, width, nbands, type_size, halo_y, halo_x,
+                          max_memory, 1 << 10, 4, snap, n_threads);
+    EXPECT_EQ(snapped.tileLength() % snap, 0);
+    EXPECT_EQ(snapped.tileWidth() % snap, 0);
+    const long long snapped_tile_bytes =
+            static_cast<long long>(snapped.tileLength() + 2 * halo_y) *
+            (snapped.tileWidth() + 2 * halo_x) * nbands * type_size;
+    EXPECT_LE(snapped_tile_bytes * n_threads, max_memory);
+
+    // a single snap x snap tile does not fit in the budget
+    EXPECT_THROW(TileScheduler(length, width, nbands, type_size, halo_y,
+                               halo_x, max_memory, 1 << 10, 4, 300, n_threads),
+                 isce3::except::RuntimeError);
+
+    // arrays smaller than snap are processed as a single tile
+    TileScheduler small(100, 150, nbands, type_size, halo_y, halo_x,
+                        max_memory, 1 << 10, 4, 300, n_threads);
+    EXPECT_EQ(small.numTiles(), 1);
+}
+
+TEST(TileSchedulerTest, LoadBalancing)
+{
+    // a generous memory budget still produces several tiles per thread
+    const int n_threads = 8, tiles_per_thread = 4;
+    TileScheduler scheduler(1000, 1000, 1, 4, 0, 0, 1LL << 40, 1 << 10,
+                            tiles_per_thread, 1, n_threads);
+    EXPECT_GE(scheduler.numTiles(), n_threads * tiles_per_thread);
+
+    // narrow arrays are split along Y only
+    TileScheduler narrow(100000, 10, 1, 4, 0, 0, 1LL << 40, 1 << 10,
+                         tiles_per_thread, 1, n_threads);
+    EXPECT_EQ(narrow.tileWidth(), 10);
+    EXPECT_GE(narrow.numTiles(), n_threads * tiles_per_thread);
+
+    // snap
+    TileScheduler snapped(1000, 1000, 1, 4, 0, 0, 1LL << 40, 1 << 10,
+                          tiles_per_thread, 16, n_threads);
+    EXPECT_EQ(snapped.tileLength() % 16, 0);
+    EXPECT_EQ(snapped.tileWidth() % 16, 0);
+}
+
+TEST(TileSchedulerTest, Run)
+{
+    const int length = 517, width = 311;
+    TileScheduler scheduler(length, width, 1, 4, 2, 2, 1 << 20, 1 << 10);
+
+    // each tile writes its own index into the samples it owns
+    std::vector<int> owner(length * width, -1);
+    std::vector<std::atomic<int>> ncalls(scheduler.numTiles());
+    for (auto& n : ncalls)
+        n = 0;
+
+    scheduler.run([&](const Tile2d& tile) {
+        ncalls[tile.index]++;
+        for (int y = tile.offset_y; y < tile.offset_y + tile.length; ++y)
+            for (int x = tile.offset_x; x < tile.offset_x + tile.width; ++x)
+                owner[y * width + x] = tile.index;
+    });
+
+    for (auto& n : ncalls)
+        ASSERT_EQ(n, 1);
+
+    for (const Tile2d& tile : scheduler.tiles())
+        for (int y = tile.offset_y; y < tile.offset_y + tile.length; ++y)
+            for (int x = tile.offset_x; x < tile.offset_x + tile.width; ++x)
+                ASSERT_EQ(owner[y * width + x], tile.index);
+}
+
+TEST(TileSchedulerTest, RunException)
+{
+    TileScheduler scheduler(256, 256, 1, 4, 0, 0, 1 << 16, 1 << 8);
+    ASSERT_GT(scheduler.numTiles(), 1);
+
+    EXPECT_THROW(scheduler.run([](const Tile2d& tile) {
+        if (tile.index == 1)
+            throw std::runtime_error("tile failure");
+    }),
+                 std::runtime_error);
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
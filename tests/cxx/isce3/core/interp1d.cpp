@@ -336,6 +336,64 @@ TEST_F(Interp1dTest, NFFT)
     check(0.998, 1.0, 0.1, 0.1);
 }
 
+TEST_F(Interp1dTest, Batch)
+{
+    auto knab = isce3::core::KnabKernel<double>(9.0, 0.8);
+    auto table = isce3::core::TabulatedKernel<double>(knab, 2048);
+    auto times = gen_rand_times();
+    // Include points near and beyond the edges.
+    times.push_back(-3.0);
+    times.push_back(n + 3.0);
+    const auto nt = times.size();
+    std::vector<std::complex<double>> batch(nt);
+
+    for (bool periodic : {false, true}) {
+        for (isce3::core::Kernel<double>* kernel :
+                {(isce3::core::Kernel<double>*) &knab,
+                 (isce3::core::Kernel<double>*) &table}) {
+            interp1d(*kernel, &signal[0], signal.size(), 1, times.data(),
+                     batch.data(), nt, periodic);
+            for (int i = 0; i < nt; ++i) {
+                auto expected = interp1d(*kernel, signal, times[i], periodic);
+                EXPECT_EQ(batch[i], expected) << "i = " << i;
+            }
+        }
+    }
+}
+
+template<typename T>
+void check_batch_evaluate(const isce3::core::Kernel<T>& kernel, double tol)
+{
+    // Sample beyond the support to check out-of-bounds handling, too.
+    const int n = 1001;
+    const double xmax = kernel.width() / 2 + 1.0;
+    std::vector<double> x(n);
+    std::vector<T> y(n);
+    for (int i = 0; i < n; ++i) {
+        x[i] = -xmax + 2 * xmax * i / (n - 1.0);
+    }
+    kernel.evaluate(x.data(), y.data(), n);
+    for (int i = 0; i < n; ++i) {
+        EXPECT_NEAR(y[i], kernel(x[i]), tol) << "x = " << x[i];
+    }
+}
+
+TEST(Kernel, BatchEvaluate)
+{
+    auto knab = isce3::core::KnabKernel<double>(9.0, 0.8);
+    check_batch_evaluate(knab, 1e-12);
+    check_batch_evaluate(isce3::core::KnabKernel<float>(8.0, 0.9), 1e-6);
+    check_batch_evaluate(isce3::core::LinearKernel<double>(), 1e-15);
+    check_batch_evaluate(isce3::core::BartlettKernel<float>(3.0), 1e-7);
+    check_batch_evaluate(
+            isce3::core::TabulatedKernel<double>(knab, 2048), 1e-15);
+    check_batch_evaluate(isce3::core::TabulatedKernel<float>(knab, 512), 1e-7);
+    check_batch_evaluate(isce3::core::ChebyKernel<double>(knab, 16), 1e-14);
+    check_batch_evaluate(isce3::core::ChebyKernel<float>(knab, 16), 1e-6);
+    // Default implementation.
+    check_batch_evaluate(isce3::core::NFFTKernel<double>(4, 512, 1024), 0.0);
+}
+
 template<class T>
 class SpeedCheck {
 public:
@@ -7,6 +7,7 @@
 #include <sstream>
 #include "isce3/core/Matrix.h"
 #include "isce3/core/LUT2d.h"
+#include "isce3/core/LUT2dView.h"
 #include "isce3/core/Utilities.h"
 #include "gtest/gtest.h"
 
@@ -147,6 +148,77 @@ TEST(LUT2dTest, Contains)
     }
 }
 
+// Check that LUT2dView matches LUT2d evaluation
+TEST(LUT2dTest, View)
+{
+    // Fill a LUT with z = sin(x**2 + y**2)
+    const double x0 = -2.0, dx = 0.25, y0 = 1.0, dy = 0.5;
+    const size_t width = 17, length = 9;
+    isce3::core::Matrix<double> M(length, width);
+    for (size_t i = 0; i < length; ++i) {
+        for (size_t j = 0; j < width; ++j) {
+            const double x = x0 + j * dx;
+            const double y = y0 + i * dy;
+            M(i, j) = std::sin(0.1 * (x * x + y * y));
+        }
+    }
+
+    // Points covering the interior, the edges and the grid nodes
+    std::vector<double> xs, ys;
+    for (double x = x0; x <= x0 + (width - 1) * dx; x += 0.0625) {
+        xs.push_back(x);
+    }
+    for (double y = y0; y <= y0 + (length - 1) * dy; y += 0.125) {
+        ys.push_back(y);
+    }
+
+    for (auto method : {isce3::core::NEAREST_METHOD,
+                        isce3::core::BILINEAR_METHOD,
+                        isce3::core::BICUBIC_METHOD,
+                        isce3::core::BIQUINTIC_METHOD}) {
+
+        const isce3::core::LUT2d<double> lut(x0, y0, dx, dy, M, method);
+        const isce3::core::LUT2dView<double> view(lut);
+        EXPECT_EQ(view.interpMethod(), method);
+
+        // The generic bicubic and biquintic interpolators read outside of
+        // the LUT near its edges, so only compare them in the interior
+        int margin = 0;
+        if (method == isce3::core::BICUBIC_METHOD) {
+            margin = 2;
+        } else if (method == isce3::core::BIQUINTIC_METHOD) {
+            margin = 4;
+        }
+
+        std::vector<double> xin;
+        for (double x : xs) {
+            if (x >= x0 + margin * dx and
+                x <= x0 + (width - 1 - margin) * dx) {
+                xin.push_back(x);
+            }
+        }
+
+        std::vector<double> batch(xin.size());
+        for (double y : ys) {
+            if (y < y0 + margin * dy or y > y0 + (length - 1 - margin) * dy) {
+                continue;
+            }
+            view.eval(y, xin.data(), batch.data(), xin.size());
+            for (size_t i = 0; i < xin.size(); ++i) {
+                const double x = xin[i];
+                const double ref = lut.eval(y, x);
+                EXPECT_NEAR(view.eval(y, x), ref, 1e-12);
+                EXPECT_NEAR(batch[i], ref, 1e-12);
+            }
+        }
+    }
+
+    // Views of LUTs without data return the reference value
+    const isce3::core::LUT2d<double> empty;
+    const isce3::core::LUT2dView<double> emptyView(empty);
+    EXPECT_EQ(emptyView.eval(1e9, -1e9), 0.0);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
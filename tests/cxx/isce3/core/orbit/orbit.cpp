@@ -550,6 +550,53 @@ TEST_F(CircularOrbitInterpTest, Legendre)
     }
 }
 
+TEST_F(CircularOrbitInterpTest, Batch)
+{
+    for (auto method : {OrbitInterpMethod::Hermite, OrbitInterpMethod::Legendre}) {
+        Orbit orbit(statevecs, method);
+
+        // sorted times including state vector epochs, then a few unsorted
+        std::vector<double> t;
+        for (int i = 0; i <= 500; ++i) {
+            t.push_back(orbit.startTime() + i * (orbit.endTime() - orbit.startTime()) / 500.);
+        }
+        t.insert(t.end(), interp_times.begin(), interp_times.end());
+        t.push_back(orbit.startTime());
+
+        const size_t n = t.size();
+        std::vector<Vec3> pos(n), vel(n), pos_only(n);
+        orbit.interpolate(pos.data(), vel.data(), t.data(), n);
+        orbit.interpolate(pos_only.data(), nullptr, t.data(), n);
+
+        for (size_t i = 0; i < n; ++i) {
+            Vec3 p, v;
+            orbit.interpolate(&p, &v, t[i]);
+            EXPECT_PRED3( compareVecs, pos[i], p, 1e-6 );
+            EXPECT_PRED3( compareVecs, vel[i], v, 1e-8 );
+            EXPECT_PRED3( compareVecs, pos_only[i], p, 1e-6 );
+        }
+    }
+}
+
+TEST_F(CircularOrbitInterpTest, BatchBorderMode)
+{
+    Orbit orbit(statevecs);
+
+    std::vector<double> t = { orbit.startTime() - 1., orbit.midTime(), orbit.endTime() + 1. };
+    std::vector<Vec3> pos(t.size()), vel(t.size());
+
+    EXPECT_THROW( orbit.interpolate(pos.data(), vel.data(), t.data(), t.size()),
+                  isce3::except::OutOfRange );
+
+    auto status = orbit.interpolate(pos.data(), vel.data(), t.data(), t.size(),
+                                    OrbitInterpBorderMode::FillNaN);
+    EXPECT_EQ( status, isce3::error::ErrorCode::OrbitInterpDomainError );
+    EXPECT_TRUE( std::isnan(pos[0][0]) && std::isnan(vel[0][0]) );
+    EXPECT_TRUE( std::isnan(pos[2][0]) && std::isnan(vel[2][0]) );
+    EXPECT_PRED3( compareVecs, pos[1], reforbit.position(t[1]), errtol );
+    EXPECT_PRED3( compareVecs, vel[1], reforbit.velocity(t[1]), errtol );
+}
+
 int main(int argc, char * argv[])
 {
     testing::InitGoogleTest(&argc, argv);
@@ -1,9 +1,11 @@
 #include <complex>
+#include <cstdio>
 #include <gtest/gtest.h>
 #include <vector>
 
 #include <isce3/except/Error.h>
 #include <isce3/fft/FFTPlan.h>
+#include <isce3/fft/FFTPlanCache.h>
 
 #include "FFTTestHelper.h"
 
@@ -37,6 +39,108 @@ TEST(FFTPlanTest, InvalidPlanConfig)
     EXPECT_THROW( { FwdFFTPlan<double> plan(out.data(), in.data(), -n); }, isce3::except::RuntimeError );
 }
 
+TEST(FFTPlanTest, PlanCache)
+{
+    isce3::fft::clearPlanCache();
+
+    int n = 24;
+    int batch = 3;
+    ComplexUniformDistribution<double> U(0., 1.);
+
+    // Plans of the same configuration on different arrays (with the same
+    // SIMD alignment, hence sliced from one buffer at offsets that are
+    // multiples of 64 bytes) share a single cached plan but are executed on
+    // their own arrays.
+    std::vector<std::complex<double>> buf(4 * n * batch);
+    std::complex<double> * in1 = &buf[0];
+    std::complex<double> * out1 = &buf[n * batch];
+    std::complex<double> * in2 = &buf[2 * n * batch];
+    std::complex<double> * out2 = &buf[3 * n * batch];
+    FwdFFTPlan<double> plan1(out1, in1, n, batch);
+    ASSERT_EQ( isce3::fft::planCacheSize(), 1 );
+    FwdFFTPlan<double> plan2(out2, in2, n, batch);
+    EXPECT_EQ( isce3::fft::planCacheSize(), 1 );
+
+    for (int i = 0; i < n * batch; ++i) {
+        in1[i] = U.sample();
+        in2[i] = U.sample();
+    }
+
+    plan1.execute();
+    plan2.execute();
+    for (int b = 0; b < batch; ++b) {
+        std::vector<std::complex<double>> expected(n), out(n);
+
+        fwd_dft_c2c_1d(expected.data(), &in1[b * n], n);
+        std::copy_n(&out1[b * n], n, out.data());
+        EXPECT_PRED3( compareVectors<std::complex<double>>, out, expected, 1e-8 );
+
+        fwd_dft_c2c_1d(expected.data(), &in2[b * n], n);
+        std::copy_n(&out2[b * n], n, out.data());
+        EXPECT_PRED3( compareVectors<std::complex<double>>, out, expected, 1e-8 );
+    }
+
+    // different direction, size, or in-place-ness make new plans
+    InvFFTPlan<double> plan3(out1, in1, n, batch);
+    EXPECT_EQ( isce3::fft::planCacheSize(), 2 );
+    FwdFFTPlan<double> plan4(out1, in1, n / 2, batch);
+    EXPECT_EQ( isce3::fft::planCacheSize(), 3 );
+    FwdFFTPlan<double> plan5(in1, in1, n, batch);
+    EXPECT_EQ( isce3::fft::planCacheSize(), 4 );
+
+    // plans in use remain valid after clearing the cache
+    isce3::fft::clearPlanCache();
+    EXPECT_EQ( isce3::fft::planCacheSize(), 0 );
+    std::vector<std::complex<double>> expected(n), out(n);
+    plan1.execute();
+    fwd_dft_c2c_1d(expected.data(), in1, n);
+    std::copy_n(out1, n, out.data());
+    EXPECT_PRED3( compareVectors<std::complex<double>>, out, expected, 1e-8 );
+}
+
+TEST(FFTPlanTest, PlanCacheEviction)
+{
+    isce3::fft::clearPlanCache();
+
+    const int nplans = int(isce3::fft::maxCachedPlans);
+    std::vector<std::complex<double>> in(nplans + 1), out(nplans + 1);
+
+    // fill the cache with plans of distinct sizes
+    FwdFFTPlan<double> first(out.data(), in.data(), 1);
+    for (int n = 2; n <= nplans; ++n) {
+        FwdFFTPlan<double> plan(out.data(), in.data(), n);
+    }
+    ASSERT_EQ( isce3::fft::planCacheSize(), isce3::fft::maxCachedPlans );
+
+    // new plans evict old ones instead of growing the cache
+    FwdFFTPlan<double> extra(out.data(), in.data(), nplans + 1);
+    EXPECT_EQ( isce3::fft::planCacheSize(), isce3::fft::maxCachedPlans );
+    InvFFTPlan<double> inverse(out.data(), in.data(), 1);
+    EXPECT_EQ( isce3::fft::planCacheSize(), isce3::fft::maxCachedPlans );
+
+    // plans evicted from the cache remain valid while in use
+    in.assign(in.size(), 1.);
+    first.execute();
+    EXPECT_NEAR( std::abs(out[0] - 1.), 0., 1e-12 );
+
+    isce3::fft::clearPlanCache();
+    EXPECT_EQ( isce3::fft::planCacheSize(), 0 );
+}
+
+TEST(FFTPlanTest, Wisdom)
+{
+    int n = 32;
+    std::vector<std::complex<float>> in(n), out(n);
+    FwdFFTPlan<float> plan(out.data(), in.data(), n);
+
+    std::string filename = "fftplan-wisdom.txt";
+    EXPECT_TRUE( isce3::fft::exportWisdom(filename) );
+    EXPECT_TRUE( isce3::fft::importWisdom(filename) );
+    std::remove(filename.c_str());
+
+    EXPECT_FALSE( isce3::fft::importWisdom("does-not-exist.txt") );
+}
+
 struct FFTPlanTest : public testing::TestWithParam<int> {};
 
 TEST_P(FFTPlanTest, FFT1D)
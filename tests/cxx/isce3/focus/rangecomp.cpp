@@ -1,8 +1,10 @@
 #include <algorithm>
 #include <cmath>
 #include <gtest/gtest.h>
+#include <random>
 #include <stdexcept>
 
+#include <isce3/except/Error.h>
 #include <isce3/focus/Chirp.h>
 #include <isce3/focus/RangeComp.h>
 #include <isce3/math/Sinc.h>
@@ -183,6 +185,78 @@ TEST(RangeCompTest, ConvolveMode)
     }
 }
 
+// random complex signal with unit variance
+std::vector<std::complex<float>> randomSignal(std::size_t n, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> normal(0.f, std::sqrt(0.5f));
+    std::vector<std::complex<float>> x(n);
+    for (auto & z : x) { z = {normal(rng), normal(rng)}; }
+    return x;
+}
+
+TEST(RangeCompTest, Parallel)
+{
+    std::vector<std::complex<float>> chirp = formLinearChirp(1e12, 4e-6, 24e6);
+
+    int inputsize = 500;
+    int nlines = 13;
+    auto input = randomSignal(std::size_t(nlines) * inputsize, 1234);
+
+    RangeComp rcproc(chirp, inputsize, nlines);
+    std::vector<std::complex<float>> expected(std::size_t(nlines) * rcproc.outputSize());
+    rcproc.rangecompress(expected.data(), input.data(), nlines);
+
+    // may exceed the max batch size
+    RangeComp rcproc1(chirp, inputsize, 1);
+    std::vector<std::complex<float>> output(expected.size());
+    rcproc1.rangecompressParallel(output.data(), input.data(), nlines);
+    EXPECT_LT(maxAbsError(output, expected), 1e-4);
+
+    // reuse the pooled workspaces
+    std::fill(output.begin(), output.end(), std::complex<float>(0.f));
+    rcproc1.rangecompressParallel(output.data(), input.data(), nlines);
+    EXPECT_LT(maxAbsError(output, expected), 1e-4);
+}
+
+TEST(RangeCompTest, Segmented)
+{
+    std::vector<std::complex<float>> chirp = formLinearChirp(1e12, 4e-6, 24e6);
+
+    int inputsize = 1000;
+    int nlines = 3;
+    auto input = randomSignal(std::size_t(nlines) * inputsize, 5678);
+
+    for (auto mode : {RangeComp::Mode::Full, RangeComp::Mode::Valid, RangeComp::Mode::Same}) {
+        RangeComp rcproc(chirp, inputsize, nlines, mode);
+        EXPECT_FALSE(rcproc.isSegmented());
+        EXPECT_EQ(rcproc.numSegments(), 1);
+
+        std::vector<std::complex<float>> expected(std::size_t(nlines) * rcproc.outputSize());
+        rcproc.rangecompress(expected.data(), input.data(), nlines);
+
+        RangeComp segproc(chirp, inputsize, nlines, mode, 256);
+        ASSERT_TRUE(segproc.isSegmented());
+        EXPECT_GE(segproc.segmentFFTSize(), 2 * segproc.chirpSize());
+        EXPECT_LT(segproc.segmentFFTSize(), segproc.fftSize());
+        EXPECT_GT(segproc.numSegments(), 1);
+        EXPECT_EQ(segproc.outputSize(), rcproc.outputSize());
+        EXPECT_EQ(segproc.firstValidSample(), rcproc.firstValidSample());
+
+        std::vector<std::complex<float>> output(expected.size());
+        segproc.rangecompress(output.data(), input.data(), nlines);
+        EXPECT_LT(maxAbsError(output, expected), 1e-4);
+    }
+
+    // segmentation is disabled if it wouldn't shrink the FFT
+    RangeComp rcproc(chirp, inputsize, 1, RangeComp::Mode::Full, 1 << 16);
+    EXPECT_FALSE(rcproc.isSegmented());
+    EXPECT_EQ(rcproc.segmentFFTSize(), 0);
+
+    EXPECT_THROW(RangeComp(chirp, inputsize, 1, RangeComp::Mode::Full, -1),
+                 isce3::except::DomainError);
+}
+
 int main(int argc, char * argv[])
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,123 @@
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <isce3/core/Ellipsoid.h>
+#include <isce3/core/LUT2d.h>
+#include <isce3/core/Orbit.h>
+#include <isce3/core/Projections.h>
+#include <isce3/geocode/geo2rdrBlock.h>
+#include <isce3/geometry/geometry.h>
+#include <isce3/io/IH5.h>
+#include <isce3/product/GeoGridParameters.h>
+#include <isce3/product/RadarGridProduct.h>
+#include <isce3/product/RadarGridParameters.h>
+
+using isce3::core::Vec3;
+
+struct Geo2RdrBlockTest : public ::testing::Test {
+
+    isce3::core::Ellipsoid ellipsoid;
+    isce3::core::Orbit orbit;
+    isce3::core::LUT2d<double> doppler;
+    isce3::product::RadarGridParameters radarGrid;
+
+    // geogrid around the envisat scene and its projection
+    const int length = 150, width = 200;
+    isce3::product::GeoGridParameters geoGrid {
+            -115.75, 34.68, 2.0e-4, -2.0e-4, width, length, 4326};
+    std::unique_ptr<isce3::core::ProjectionBase> proj {
+            isce3::core::createProj(4326)};
+
+    // lon/lat/height of each pixel over synthetic terrain
+    std::vector<Vec3> llh;
+
+protected:
+    Geo2RdrBlockTest()
+    {
+        std::string h5file(TESTDATA_DIR "envisat.h5");
+        isce3::io::IH5File file(h5file);
+        isce3::product::RadarGridProduct product(file);
+        orbit = product.metadata().orbit();
+        radarGrid = isce3::product::RadarGridParameters(product, 'A');
+
+        llh.resize(length * width);
+        for (int line = 0; line < length; ++line) {
+            for (int pixel = 0; pixel < width; ++pixel) {
+                const double x = geoGrid.startX() +
+                                 geoGrid.spacingX() * (0.5 + pixel);
+                const double y = geoGrid.startY() +
+                                 geoGrid.spacingY() * (0.5 + line);
+                Vec3& p = llh[line * width + pixel];
+                p = proj->inverse({x, y, 0.0});
+                p[2] = 1000.0 + 800.0 * std::sin(0.05 * pixel) *
+                                        std::cos(0.04 * line) +
+                       30.0 * std::sin(0.9 * pixel + 0.4 * line);
+            }
+        }
+    }
+
+    void solve(std::vector<double>& aztime, std::vector<double>& slantRange,
+            int gridSpacing, double tolerance,
+            isce3::geometry::Geo2RdrStats& stats)
+    {
+        aztime.resize(llh.size());
+        slantRange.resize(llh.size());
+        isce3::geocode::geo2rdrBlock(aztime.data(), slantRange.data(),
+                llh.data(), geoGrid, 0, length, width, proj.get(), ellipsoid,
+                orbit, doppler, radarGrid, 1.0e-8, 50, 1.0e-8, gridSpacing,
+                tolerance, &stats);
+    }
+};
+
+TEST_F(Geo2RdrBlockTest, MatchesExact)
+{
+    std::vector<double> t_exact, r_exact;
+    isce3::geometry::Geo2RdrStats exact_stats;
+    solve(t_exact, r_exact, 0, 1e-3, exact_stats);
+    ASSERT_EQ(exact_stats.numTargets, llh.size());
+    ASSERT_EQ(exact_stats.numFailed, 0);
+
+    for (int spacing : {8, 16, 32}) {
+        std::vector<double> t, r;
+        isce3::geometry::Geo2RdrStats stats;
+        solve(t, r, spacing, 1e-3, stats);
+
+        // the control grid needs far fewer solves than pixels
+        EXPECT_LT(stats.numTargets * 10, exact_stats.numTargets);
+
+        for (size_t i = 0; i < llh.size(); ++i) {
+            ASSERT_FALSE(std::isnan(t[i]));
+            EXPECT_NEAR((t[i] - t_exact[i]) * radarGrid.prf(), 0.0, 1e-3);
+            EXPECT_NEAR((r[i] - r_exact[i]) / radarGrid.rangePixelSpacing(),
+                    0.0, 1e-3);
+        }
+    }
+}
+
+TEST_F(Geo2RdrBlockTest, Refinement)
+{
+    std::vector<double> t_exact, r_exact;
+    isce3::geometry::Geo2RdrStats exact_stats;
+    solve(t_exact, r_exact, 0, 1e-3, exact_stats);
+
+    // a negative tolerance forces every cell to be refined, which must
+    // reproduce the exact solutions
+    std::vector<double> t, r;
+    isce3::geometry::Geo2RdrStats stats;
+    solve(t, r, 16, -1.0, stats);
+    EXPECT_GT(stats.numTargets, exact_stats.numTargets);
+    for (size_t i = 0; i < llh.size(); ++i) {
+        EXPECT_NEAR(t[i], t_exact[i], 1e-7);
+        EXPECT_NEAR(r[i], r_exact[i], 1e-4);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -557,6 +557,99 @@ TEST(GeocodeTest, CheckGeocodeCovResults) {
 
 }
 
+TEST(GeocodeTest, CheckGeocodeCovAsyncBlockIO) {
+    // Geocoding with asynchronous block I/O should produce exactly the
+    // same results as the synchronous block loop
+
+    std::string h5file(TESTDATA_DIR "envisat.h5");
+    isce3::io::IH5File file(h5file);
+    isce3::product::RadarGridProduct product(file);
+
+    const isce3::product::Swath & swath = product.swath('A');
+    isce3::core::Orbit orbit = product.metadata().orbit();
+    isce3::core::Ellipsoid ellipsoid;
+    isce3::core::LUT2d<double> doppler =
+            product.metadata().procInfo().dopplerCentroid('A');
+    isce3::product::RadarGridParameters radar_grid(swath,
+                                                   product.lookSide());
+
+    // same geogrid and block parameters used in TestGeocodeCov
+    int reduction_factor = 10;
+    double geoGridStartX = -115.6;
+    double geoGridStartY = 34.832;
+    double geoGridSpacingX = reduction_factor * 0.0002;
+    double geoGridSpacingY = reduction_factor * -8.0e-5;
+    int geoGridLength = 380 / reduction_factor;
+    int geoGridWidth = 400 / reduction_factor;
+    const long long min_block_size = 16;
+    const long long max_block_size = isce3::core::DEFAULT_MIN_BLOCK_SIZE;
+
+    isce3::geocode::Geocode<double> geoObj;
+    geoObj.orbit(orbit);
+    geoObj.doppler(doppler);
+    geoObj.ellipsoid(ellipsoid);
+    geoObj.thresholdGeo2rdr(1.0e-9);
+    geoObj.numiterGeo2rdr(25);
+    geoObj.radarBlockMargin(10);
+    geoObj.dataInterpolator(isce3::core::BIQUINTIC_METHOD);
+    geoObj.geoGrid(geoGridStartX, geoGridStartY, geoGridSpacingX,
+                   geoGridSpacingY, geoGridWidth, geoGridLength, 4326);
+
+    ASSERT_FALSE(geoObj.asyncBlockIO());
+    geoObj.asyncBlockIO(true);
+    ASSERT_TRUE(geoObj.asyncBlockIO());
+
+    isce3::io::Raster demRaster("zero_height_dem_geo.bin");
+
+    for (std::string xy_str : {"x", "y"}) {
+        isce3::io::Raster radarRaster(xy_str + ".rdr");
+
+        std::string async_file_str = xy_str + "_interp_async_geo.bin";
+        {
+            isce3::io::Raster geocodedRaster(async_file_str, geoGridWidth,
+                    geoGridLength, 1, GDT_Float64, "ENVI");
+
+            geoObj.geocode(radar_grid, radarRaster, geocodedRaster,
+                    demRaster, isce3::geocode::geocodeOutputMode::INTERP,
+                    false, false, 1, false, false,
+                    isce3::geometry::rtcInputTerrainRadiometry::BETA_NAUGHT,
+                    isce3::geometry::rtcOutputTerrainRadiometry::GAMMA_NAUGHT,
+                    0, std::numeric_limits<float>::quiet_NaN(),
+                    std::numeric_limits<double>::quiet_NaN(),
+                    isce3::geometry::rtcAlgorithm::RTC_AREA_PROJECTION,
+                    isce3::geometry::rtcAreaBetaMode::AUTO, 1,
+                    std::numeric_limits<float>::quiet_NaN(),
+                    std::numeric_limits<float>::quiet_NaN(),
+                    std::numeric_limits<float>::quiet_NaN(), 1, nullptr,
+                    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, {},
+                    {}, nullptr, nullptr, nullptr, nullptr, {}, nullptr,
+                    isce3::core::GeocodeMemoryMode::BlocksGeogrid,
+                    min_block_size, max_block_size);
+        }
+
+        isce3::io::Raster syncRaster(xy_str + "_interp_geo.bin");
+        isce3::io::Raster asyncRaster(async_file_str);
+
+        const size_t length = syncRaster.length();
+        const size_t width = syncRaster.width();
+        ASSERT_EQ(asyncRaster.length(), length);
+        ASSERT_EQ(asyncRaster.width(), width);
+
+        std::valarray<double> sync_data(length * width);
+        std::valarray<double> async_data(length * width);
+        syncRaster.getBlock(sync_data, 0, 0, width, length);
+        asyncRaster.getBlock(async_data, 0, 0, width, length);
+
+        for (size_t i = 0; i < length * width; ++i) {
+            if (std::isnan(sync_data[i])) {
+                ASSERT_TRUE(std::isnan(async_data[i]));
+                continue;
+            }
+            ASSERT_EQ(sync_data[i], async_data[i]);
+        }
+    }
+}
+
 // global geocode SLC modes shared between running and checking
 std::set<std::string> axes = {"x", "y"};
 std::set<std::string> gslc_modes = {"_raster", "_array"};
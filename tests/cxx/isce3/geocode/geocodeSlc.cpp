@@ -1,8 +1,12 @@
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <complex>
 #include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <random>
 #include <sstream>
 #include <vector>
 
@@ -10,10 +14,12 @@
 
 #include <isce3/core/Ellipsoid.h>
 #include <isce3/core/EMatrix.h>
+#include <isce3/core/Interpolator.h>
 #include <isce3/core/LUT2d.h>
 #include <isce3/core/Metadata.h>
 #include <isce3/core/Orbit.h>
 #include <isce3/core/Poly2d.h>
+#include <isce3/except/Error.h>
 #include <isce3/geocode/geocodeSlc.h>
 #include <isce3/geocode/GeocodeCov.h>
 #include <isce3/geometry/Topo.h>
@@ -39,7 +45,7 @@ void createTestData();
 // global geocode SLC modes shared between running and checking
 std::set<std::string> axes = {"x", "y"};
 std::set<std::string> offset_modes = {"", "_rg", "_az", "_rg_az"};
-std::set<std::string> gslc_modes = {"_raster", "_array"};
+std::set<std::string> gslc_modes = {"_raster", "_array", "_blocks"};
 
 TEST(GeocodeTest, TestGeocodeSlc)
 {
@@ -220,6 +226,20 @@ TEST(GeocodeTest, TestGeocodeSlc)
             geocodedSlcArr.setBlock(geoDataArr.data(), 0, 0, geoGridWidth,
                     geoGridLength, 1);
             geocodedSlcArr.setGeoTransform(_geoTrans);
+
+            // geocodeSlc block by block with blocks that do not divide the
+            // geogrid evenly
+            isce3::io::Raster geocodedSlcBlocks(filePrefix + "_blocks.bin",
+                    geoGridWidth, geoGridLength, 1, GDT_CFloat32, "ENVI");
+            std::vector<isce3::io::Raster*> outputRasters = {&geocodedSlcBlocks};
+            std::vector<isce3::io::Raster*> inputRasters = {&inputSlc};
+            isce3::geocode::geocodeSlcBlocks(outputRasters, nullptr,
+                    inputRasters, demRaster, testRdrGrid, geoGrid, orbit,
+                    nativeDoppler, imageGridDoppler, ellipsoid,
+                    thresholdGeo2rdr, numiterGeo2rdr, 200, 150, flatten,
+                    reramp, default_carrier_lut2d, default_carrier_lut2d,
+                    az_correction, srange_correction);
+            geocodedSlcBlocks.setGeoTransform(_geoTrans);
         } // loop over offset_modes
     } // loop over axes
 }
@@ -293,6 +313,169 @@ TEST(GeocodeTest, CheckGeocodeSlc)
     ASSERT_EQ(nFails, 0);
 }
 
+TEST(GeocodeTest, TruncateMantissa)
+{
+    std::vector<std::complex<float>> data = {{1.0f + 0x1.0p-20f, -3.0f},
+                                             {0.1f, 1.0e-30f}};
+    auto truncated = data;
+    isce3::geocode::truncateMantissa(truncated.data(), truncated.size(), 10);
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        for (auto [value, expected] : {
+                std::pair(truncated[i].real(), data[i].real()),
+                std::pair(truncated[i].imag(), data[i].imag())}) {
+            // only the 13 least significant bits may change
+            uint32_t bits, expectedBits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            std::memcpy(&expectedBits, &expected, sizeof(bits));
+            EXPECT_EQ(bits, expectedBits & ~uint32_t(0x1fff));
+        }
+    }
+    EXPECT_EQ(truncated[0].real(), 1.0f);
+    EXPECT_EQ(truncated[0].imag(), -3.0f);
+
+    // keeping all 23 bits is a no-op
+    truncated = data;
+    isce3::geocode::truncateMantissa(truncated.data(), truncated.size(), 23);
+    EXPECT_EQ(truncated, data);
+
+    EXPECT_THROW(isce3::geocode::truncateMantissa(truncated.data(),
+                         truncated.size(), 0),
+            isce3::except::InvalidArgument);
+}
+
+TEST(GeocodeTest, InterpolateRerampAndFlattenDoppler)
+{
+    // Random radar block with a non-zero native Doppler, carriers and
+    // flattening, compared to the Doppler demodulation of a chip followed
+    // by sinc interpolation and Doppler add-back
+    const double prf = 1000.0, wavelength = 0.24;
+    const double startingRange = 800000.0, rangePixelSpacing = 7.0;
+    const size_t rdrLength = 60, rdrWidth = 50;
+    isce3::product::RadarGridParameters radarGrid(0.0, wavelength, prf,
+            startingRange, rangePixelSpacing, isce3::core::LookSide::Left,
+            rdrLength, rdrWidth, isce3::core::DateTime());
+
+    // radar block starting at line 5 and pixel 3 of the radar grid
+    const size_t azimuthFirstLine = 5, rangeFirstPixel = 3;
+    const int blockLength = 40, blockWidth = 36;
+    std::mt19937 gen(1234);
+    std::normal_distribution<float> normal;
+    isce3::core::EArray2D<std::complex<float>> rdrData(blockLength,
+                                                       blockWidth);
+    for (int i = 0; i < blockLength; ++i)
+        for (int j = 0; j < blockWidth; ++j)
+            rdrData(i, j) = std::complex<float>(normal(gen), normal(gen));
+
+    // Doppler of a few hundred Hz varying in azimuth and range, and
+    // carriers as functions of azimuth time and slant range
+    const size_t lutLength = 8, lutWidth = 8;
+    const double lutDy = rdrLength / prf / (lutLength - 1);
+    const double lutDx = rdrWidth * rangePixelSpacing / (lutWidth - 1);
+    isce3::core::Matrix<double> doppler(lutLength, lutWidth);
+    isce3::core::Matrix<double> azCarrier(lutLength, lutWidth);
+    isce3::core::Matrix<double> rgCarrier(lutLength, lutWidth);
+    for (size_t i = 0; i < lutLength; ++i) {
+        for (size_t j = 0; j < lutWidth; ++j) {
+            doppler(i, j) = 250.0 + 30.0 * i - 12.0 * j;
+            azCarrier(i, j) = 0.7 * i - 0.2 * j;
+            rgCarrier(i, j) = 1.3 * j + 0.1 * i * j;
+        }
+    }
+    const isce3::core::LUT2d<double> dopplerLUT(startingRange, 0.0, lutDx,
+                                                lutDy, doppler);
+    const isce3::core::LUT2d<double> azCarrierLUT(startingRange, 0.0, lutDx,
+                                                  lutDy, azCarrier);
+    const isce3::core::LUT2d<double> rgCarrierLUT(startingRange, 0.0, lutDx,
+                                                  lutDy, rgCarrier);
+
+    // Fractional radar grid indices of the output pixels, with an invalid
+    // pixel and a pixel too close to the edge of the block
+    const int geoLength = 7, geoWidth = 6;
+    isce3::core::Matrix<double> rangeIndices(geoLength, geoWidth);
+    isce3::core::Matrix<double> azimuthIndices(geoLength, geoWidth);
+    isce3::core::Matrix<double> uncorrectedSRngs(geoLength, geoWidth);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (int i = 0; i < geoLength; ++i) {
+        for (int j = 0; j < geoWidth; ++j) {
+            azimuthIndices(i, j) = azimuthFirstLine + 6 + 3.7 * i +
+                                   uniform(gen);
+            rangeIndices(i, j) = rangeFirstPixel + 5 + 4.1 * j + uniform(gen);
+            uncorrectedSRngs(i, j) = startingRange +
+                    rangeIndices(i, j) * rangePixelSpacing + 0.01 * i;
+        }
+    }
+    rangeIndices(0, 0) = std::numeric_limits<double>::quiet_NaN();
+    azimuthIndices(0, 1) = azimuthFirstLine + 1.5;
+
+    const std::complex<float> invalid(-1.0f, -1.0f);
+    isce3::core::EArray2D<std::complex<float>> geoData(geoLength, geoWidth);
+    isce3::core::EArray2D<double> carrierPhase(geoLength, geoWidth);
+    isce3::core::EArray2D<double> flattenPhase(geoLength, geoWidth);
+    geoData.fill(invalid);
+
+    const isce3::core::Sinc2dInterpolator<std::complex<float>> sincInterp(
+            isce3::core::SINC_LEN, isce3::core::SINC_SUB);
+    isce3::geocode::interpolateRerampAndFlatten(rdrData, geoData,
+            carrierPhase, flattenPhase, rangeIndices, azimuthIndices,
+            azimuthFirstLine, rangeFirstPixel, sincInterp, radarGrid,
+            dopplerLUT, azCarrierLUT, rgCarrierLUT, true, true, false,
+            uncorrectedSRngs);
+
+    EXPECT_EQ(geoData(0, 0), invalid);
+    EXPECT_EQ(geoData(0, 1), invalid);
+
+    const int chipSize = isce3::core::SINC_ONE;
+    const int chipHalf = isce3::core::SINC_HALF;
+    isce3::core::Matrix<std::complex<float>> chip(chipSize, chipSize);
+    double maxErr = 0.0;
+    for (int i = 0; i < geoLength; ++i) {
+        for (int j = 0; j < geoWidth; ++j) {
+            if (i == 0 and j < 2)
+                continue;
+            const double rgIndex = rangeIndices(i, j) - rangeFirstPixel;
+            const double azIndex = azimuthIndices(i, j) - azimuthFirstLine;
+            const int intRg = static_cast<int>(rgIndex);
+            const int intAz = static_cast<int>(azIndex);
+            const double fracRg = rgIndex - intRg;
+            const double fracAz = azIndex - intAz;
+
+            const double rng = startingRange +
+                               rangeIndices(i, j) * rangePixelSpacing;
+            const double az = azimuthIndices(i, j) / prf;
+            const double doppFreq = dopplerLUT.eval(az, rng) * 2 * M_PI / prf;
+
+            // Doppler demodulated chip
+            for (int ii = 0; ii < chipSize; ++ii) {
+                const double doppPhase = doppFreq * (ii - chipHalf);
+                for (int jj = 0; jj < chipSize; ++jj) {
+                    chip(ii, jj) = std::complex<double>(
+                            rdrData(intAz + ii - chipHalf,
+                                    intRg + jj - chipHalf)) *
+                            std::polar(1.0, -doppPhase);
+                }
+            }
+            const std::complex<double> interp = sincInterp.interpolate(
+                    chipHalf + fracRg, chipHalf + fracAz, chip);
+
+            const double expectedCarrier =
+                    azCarrierLUT.eval(az, rng) + rgCarrierLUT.eval(az, rng);
+            const double expectedFlatten =
+                    4.0 * M_PI / wavelength * uncorrectedSRngs(i, j);
+            EXPECT_DOUBLE_EQ(carrierPhase(i, j), expectedCarrier);
+            EXPECT_DOUBLE_EQ(flattenPhase(i, j), expectedFlatten);
+
+            // Doppler added back, reramped and flattened
+            const std::complex<double> expected = interp *
+                    std::polar(1.0, doppFreq * fracAz + expectedCarrier +
+                                            expectedFlatten);
+            maxErr = std::max(maxErr,
+                    std::abs(std::complex<double>(geoData(i, j)) - expected));
+        }
+    }
+    EXPECT_LT(maxErr, 1e-5);
+}
+
 int main(int argc, char* argv[])
 {
     testing::InitGoogleTest(&argc, argv);
@@ -9,6 +9,7 @@
 #include <isce3/geometry/loadDem.h>
 #include <isce3/io/Raster.h>
 #include <isce3/geometry/DEMInterpolator.h>
+#include <isce3/geometry/DEMTileCache.h>
 
 
 TEST(DEMTest, ConstDEM) {
@@ -530,6 +531,67 @@ TEST(DEMTest, DatelineCrossing) {
 }
 
 
+TEST(DEMTest, Tiled) {
+
+    // Use geoid EGM96 as a DEM for testing
+    isce3::io::Raster dem_raster(TESTDATA_DIR "egm96_15.gtx");
+
+    // small tiles and a cache holding only a few of them to exercise eviction
+    const size_t tile_size = 64;
+    const size_t max_cache_bytes = 8 * tile_size * tile_size * sizeof(float);
+
+    for (auto method : {isce3::core::BILINEAR_METHOD,
+                        isce3::core::BICUBIC_METHOD,
+                        isce3::core::BIQUINTIC_METHOD,
+                        isce3::core::SINC_METHOD}) {
+
+        isce3::geometry::DEMInterpolator dem_full(0, method);
+        dem_full.loadDEM(dem_raster);
+
+        isce3::geometry::DEMInterpolator dem_tiled(0, method);
+        dem_tiled.loadDEMTiled(dem_raster, 1, tile_size, max_cache_bytes);
+
+        ASSERT_TRUE(dem_tiled.isTiled());
+        ASSERT_FALSE(dem_full.isTiled());
+        EXPECT_EQ(dem_tiled.width(), dem_full.width());
+        EXPECT_EQ(dem_tiled.length(), dem_full.length());
+        EXPECT_EQ(dem_tiled.tileCache()->numLoads(), 0);
+
+        // Interpolated heights match away from the DEM edges
+        const double dx = dem_raster.dx();
+        const double dy = dem_raster.dy();
+        int n_errors = 0;
+        _Pragma("omp parallel for reduction(+:n_errors)")
+        for (int i = 10; i < int(dem_full.length()) - 10; i += 7) {
+            for (int j = 10; j < int(dem_full.width()) - 10; j += 5) {
+                const double x = dem_full.xStart() + (j + 0.3) * dx;
+                const double y = dem_full.yStart() + (i + 0.6) * dy;
+                if (dem_tiled.interpolateXY(x, y) !=
+                        dem_full.interpolateXY(x, y)) {
+                    n_errors++;
+                }
+            }
+        }
+        EXPECT_EQ(n_errors, 0);
+
+        // The cache stays within its memory cap
+        EXPECT_GT(dem_tiled.tileCache()->numLoads(), 8);
+        EXPECT_LE(dem_tiled.tileCache()->numCachedTiles(), 8);
+    }
+
+    // Approximate statistics from a decimated DEM bracket the exact ones
+    isce3::geometry::DEMInterpolator dem_full, dem_tiled;
+    dem_full.loadDEM(dem_raster);
+    dem_tiled.loadDEMTiled(dem_raster);
+    float min_full, max_full, mean_full, min_tiled, max_tiled, mean_tiled;
+    dem_full.computeMinMaxMeanHeight(min_full, max_full, mean_full);
+    dem_tiled.computeMinMaxMeanHeight(min_tiled, max_tiled, mean_tiled);
+    EXPECT_GE(min_tiled, min_full);
+    EXPECT_LE(max_tiled, max_full);
+    EXPECT_NEAR(mean_tiled, mean_full, 5.0);
+}
+
+
 int main(int argc, char * argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -5,11 +5,13 @@
 // Copyright 2018
 //
 
+#include <cmath>
 #include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -178,6 +180,67 @@ TEST_F(GeometryTest, GeoToRdr)
     EXPECT_NEAR(slantRange, 830449.6727720434, 1.0e-6);
 }
 
+TEST_F(GeometryTest, GeoToRdrRow)
+{
+    // Make a row of targets along a line of a geocoded grid
+    const double radians = M_PI / 180.0;
+    const size_t n = 200;
+    std::vector<isce3::core::Vec3> llh(n);
+    for (size_t i = 0; i < n; ++i) {
+        llh[i] = {(-115.75 + 2.0e-4 * i) * radians, 34.65846532785868 * radians,
+                1772.0 + 50.0 * std::sin(0.1 * i)};
+    }
+
+    // Solve the row with warm starts from neighboring targets
+    const double wvl = swath.processedWavelength();
+    const double t0 = orbit.midTime();
+    std::vector<double> aztime(n), slantRange(n);
+    isce3::geometry::Geo2RdrStats warmStats;
+    const size_t numConverged = isce3::geometry::geo2rdrRow(llh.data(), n,
+            ellipsoid, orbit, doppler, aztime.data(), slantRange.data(), wvl,
+            lookSide, 1.0e-10, 50, 10.0, t0, &warmStats);
+
+    ASSERT_EQ(numConverged, n);
+    EXPECT_EQ(warmStats.numTargets, n);
+    EXPECT_EQ(warmStats.numFailed, 0);
+
+    // Compare against independent solves from the same initial guess
+    size_t coldIterations = 0;
+    for (size_t i = 0; i < n; ++i) {
+        double t = t0, r;
+        const int stat = isce3::geometry::geo2rdr(llh[i], ellipsoid, orbit,
+                doppler, t, r, wvl, lookSide, 1.0e-10, 50, 10.0);
+        ASSERT_EQ(stat, 1);
+        EXPECT_NEAR(aztime[i], t, 1.0e-9);
+        EXPECT_NEAR(slantRange[i], r, 1.0e-5);
+
+        isce3::geometry::Geo2RdrStats coldStats;
+        isce3::geometry::geo2rdrRow(&llh[i], 1, ellipsoid, orbit, doppler,
+                &t, &r, wvl, lookSide, 1.0e-10, 50, 10.0, t0, &coldStats);
+        coldIterations += coldStats.totalIterations;
+    }
+
+    // Warm starts should need substantially fewer iterations
+    EXPECT_LT(2 * warmStats.totalIterations, coldIterations);
+
+    // Mirror one target to the other side of the ground track. A failed
+    // target yields NaN and does not seed its successor.
+    isce3::core::Vec3 pos, vel;
+    orbit.interpolate(&pos, &vel, aztime[n / 2]);
+    const auto xyz = ellipsoid.lonLatToXyz(llh[n / 2]);
+    const isce3::core::Vec3 normal = vel.cross(pos).normalized();
+    llh[n / 2] = ellipsoid.xyzToLonLat(
+            xyz - 2.0 * (xyz - pos).dot(normal) * normal);
+    isce3::geometry::Geo2RdrStats stats;
+    isce3::geometry::geo2rdrRow(llh.data(), n, ellipsoid, orbit, doppler,
+            aztime.data(), slantRange.data(), wvl, lookSide, 1.0e-10, 50, 10.0,
+            t0, &stats);
+    EXPECT_TRUE(std::isnan(aztime[n / 2]));
+    EXPECT_TRUE(std::isnan(slantRange[n / 2]));
+    EXPECT_FALSE(std::isnan(aztime[n / 2 + 1]));
+    EXPECT_EQ(stats.numFailed, 1);
+}
+
 TEST(Geometry, SrLkvHeadDemNed)
 {
     using namespace isce3::geometry;
@@ -8,6 +8,10 @@
 #include <isce3/product/RadarGridParameters.h>
 #include <string>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // Create set of RadarGridParameters to process
 std::set<std::string> radar_grid_str_set = {"cropped", "multilooked"};
 
@@ -193,6 +197,68 @@ TEST(TestRTC, CheckResults) {
     }
 }
 
+TEST(TestRTC, Reproducible) {
+    // Area projection in block mode must give the same results regardless of
+    // the number of threads
+    isce3::io::IH5File file(TESTDATA_DIR "envisat.h5");
+    isce3::product::RadarGridProduct product(file);
+    char frequency = 'A';
+
+    isce3::io::Raster dem(TESTDATA_DIR "srtm_cropped.tif");
+
+    isce3::product::RadarGridParameters radar_grid =
+            isce3::product::RadarGridParameters(product, frequency)
+                    .offsetAndResize(30, 135, 128, 128);
+
+    isce3::core::Orbit orbit = product.metadata().orbit();
+    isce3::core::LUT2d<double> dop =
+            product.metadata().procInfo().dopplerCentroid(frequency);
+    dop.boundsError(false);
+
+    std::vector<std::vector<float>> results;
+    for (int nthreads : {1, 4}) {
+#ifdef _OPENMP
+        const int max_threads = omp_get_max_threads();
+        omp_set_num_threads(nthreads);
+#endif
+        isce3::io::Raster out_raster("./rtc_area_proj_threads_" +
+                                             std::to_string(nthreads) + ".bin",
+                radar_grid.width(), radar_grid.length(), 1, GDT_Float32,
+                "ENVI");
+
+        // small blocks so that neighboring blocks overlap in the radar grid
+        isce3::geometry::computeRtc(radar_grid, orbit, dop, dem, out_raster,
+                isce3::geometry::rtcInputTerrainRadiometry::BETA_NAUGHT,
+                isce3::geometry::rtcOutputTerrainRadiometry::GAMMA_NAUGHT,
+                isce3::geometry::rtcAreaMode::AREA_FACTOR,
+                isce3::geometry::rtcAlgorithm::RTC_AREA_PROJECTION,
+                isce3::geometry::rtcAreaBetaMode::AUTO, 1,
+                std::numeric_limits<float>::quiet_NaN(), nullptr,
+                isce3::core::MemoryModeBlocksY::MultipleBlocksY,
+                isce3::core::dataInterpMethod::BIQUINTIC_METHOD, 1e-8, 100,
+                1e-8, 1 << 12, 1 << 12);
+#ifdef _OPENMP
+        omp_set_num_threads(max_threads);
+#endif
+
+        std::vector<float> data(radar_grid.width() * radar_grid.length());
+        out_raster.getBlock(data.data(), 0, 0, radar_grid.width(),
+                radar_grid.length(), 1);
+        results.push_back(std::move(data));
+    }
+
+    size_t n_valid = 0;
+    for (size_t i = 0; i < results[0].size(); ++i) {
+        if (std::isnan(results[0][i])) {
+            EXPECT_TRUE(std::isnan(results[1][i]));
+            continue;
+        }
+        EXPECT_EQ(results[0][i], results[1][i]);
+        n_valid++;
+    }
+    EXPECT_GT(n_valid, 0);
+}
+
 int main(int argc, char* argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
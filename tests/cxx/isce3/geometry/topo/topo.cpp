@@ -3,11 +3,15 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
 #include <gtest/gtest.h>
 
 // isce3::core
 #include "isce3/core/Constants.h"
 
+// isce3::except
+#include "isce3/except/Error.h"
+
 // isce3::io
 #include "isce3/io/IH5.h"
 #include "isce3/io/Raster.h"
@@ -99,6 +103,85 @@ TEST(TopoTest, CheckResults) {
     }
 }
 
+// Run topo on the Envisat scene, computing only the layover/shadow mask with
+// the given decimation of its cross-track grid
+std::vector<unsigned char> runLayoverShadowMask(int decimation,
+                                                const std::string& filename)
+{
+    isce3::io::IH5File file(TESTDATA_DIR "envisat.h5");
+    isce3::product::RadarGridProduct product(file);
+
+    isce3::geometry::Topo topo(product, 'A', true);
+    topo.threshold(0.05);
+    topo.numiter(25);
+    topo.extraiter(10);
+    topo.demMethod(isce3::core::dataInterpMethod::BIQUINTIC_METHOD);
+    topo.epsgOut(4326);
+    topo.layoverShadowDecimation(decimation);
+
+    const size_t width = topo.radarGridParameters().width();
+    const size_t length = topo.radarGridParameters().length();
+
+    isce3::io::Raster demRaster(TESTDATA_DIR "srtm_cropped.tif");
+    {
+        isce3::io::Raster maskRaster(filename, width, length, 1, GDT_Byte,
+                                     "ENVI");
+        topo.topo(demRaster, nullptr, nullptr, nullptr, nullptr, nullptr,
+                  nullptr, nullptr, nullptr, &maskRaster);
+    }
+
+    std::vector<unsigned char> mask(width * length);
+    isce3::io::Raster maskRaster(filename);
+    maskRaster.getBlock(mask, 0, 0, width, length);
+    return mask;
+}
+
+TEST(TopoTest, LayoverShadowDecimation) {
+
+    // Mask written by RunTopo, with the geometry computed at every sample of
+    // the cross-track grid (default decimation)
+    isce3::io::Raster refRaster("layoverShadowMask.rdr");
+    std::vector<unsigned char> ref(refRaster.width() * refRaster.length());
+    refRaster.getBlock(ref, 0, 0, refRaster.width(), refRaster.length());
+
+    // The scene has actual layover/shadow
+    size_t numMasked = 0;
+    for (auto value : ref) {
+        numMasked += (value != 0);
+    }
+    ASSERT_GT(numMasked, 0);
+
+    // Without decimation the mask is unchanged
+    auto mask = runLayoverShadowMask(1, "layoverShadowMask_dec1.rdr");
+    ASSERT_EQ(mask.size(), ref.size());
+    EXPECT_EQ(mask, ref);
+
+    // With decimation, only layover/shadow regions falling entirely between
+    // two coarse samples may be missed: at most 0.1% of the pixels differ
+    const double maxMismatchFraction = 1e-3;
+    for (int decimation : {4, 8}) {
+        mask = runLayoverShadowMask(decimation,
+                "layoverShadowMask_dec" + std::to_string(decimation) + ".rdr");
+        ASSERT_EQ(mask.size(), ref.size());
+        size_t numMismatch = 0;
+        for (size_t i = 0; i < mask.size(); ++i) {
+            numMismatch += (mask[i] != ref[i]);
+        }
+        std::cout << "decimation " << decimation << ": " << numMismatch
+                  << " of " << mask.size() << " mask pixels differ"
+                  << std::endl;
+        EXPECT_LE(numMismatch, maxMismatchFraction * mask.size());
+    }
+
+    // Decimation must be positive
+    isce3::io::IH5File file(TESTDATA_DIR "envisat.h5");
+    isce3::product::RadarGridProduct product(file);
+    isce3::geometry::Topo topo(product, 'A', true);
+    EXPECT_THROW(topo.layoverShadowDecimation(0),
+                 isce3::except::InvalidArgument);
+    EXPECT_EQ(topo.layoverShadowDecimation(), 1);
+}
+
 int main(int argc, char * argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -16,6 +16,9 @@
 #include "isce3/core/Constants.h"
 #include "isce3/core/Serialization.h"
 
+// isce3::except
+#include "isce3/except/Error.h"
+
 // isce3::io
 #include "isce3/io/IH5.h"
 #include "isce3/io/Raster.h"
@@ -57,6 +60,49 @@ TEST(ResampSlcTest, Resamp) {
                   TESTDATA_DIR "offsets/range.off", TESTDATA_DIR "offsets/azimuth.off");
 }
 
+// Resample with separable polyphase table instead of 2D sinc chips
+TEST(ResampSlcTest, ResampPolyphase) {
+
+    const std::string filename = TESTDATA_DIR "envisat.h5";
+    isce3::io::IH5File file(filename);
+    isce3::product::RadarGridProduct product(file);
+    isce3::image::ResampSlc resamp(product);
+    const std::string & input_data = "HDF5:\"" + filename +
+        "\"://science/LSAR/SLC/swaths/frequencyA/HH";
+
+    // Negative number of phases is invalid
+    EXPECT_THROW(resamp.polyphaseFactor(-1), isce3::except::InvalidArgument);
+
+    // Same number of phases as the sinc interpolator gives the same weights
+    resamp.polyphaseFactor(isce3::core::SINC_SUB);
+    resamp.resamp(input_data, "warped_polyphase.slc",
+                  TESTDATA_DIR "offsets/range.off", TESTDATA_DIR "offsets/azimuth.off");
+
+    // Coarser table trades accuracy for a smaller table
+    resamp.polyphaseFactor(1024);
+    resamp.linesPerTile(249);
+    resamp.resamp(input_data, "warped_polyphase_1024.slc",
+                  TESTDATA_DIR "offsets/range.off", TESTDATA_DIR "offsets/azimuth.off");
+}
+
+// Compute mean absolute difference between reference image and warped image
+float meanAbsError(isce3::io::Raster & refSlc, isce3::io::Raster & testSlc) {
+    float sum{0.0};
+    size_t count = 0;
+    // Avoid edges of image
+    for (size_t i = 20; i < (refSlc.length() - 20); ++i) {
+        for (size_t j = 20; j < (refSlc.width() - 20); ++j) {
+            std::complex<float> refValue, testValue;
+            refSlc.getValue(refValue, j, i);
+            testSlc.getValue(testValue, j, i);
+            sum += std::abs(testValue - refValue);
+            ++count;
+        }
+    }
+    // Normalize by number of pixels
+    return sum / count;
+}
+
 // Compute sum of difference between reference image and warped image
 TEST(ResampSlcTest, Validate) {
     // Open SLC reference raster
@@ -64,26 +110,18 @@ TEST(ResampSlcTest, Validate) {
 
     // Iterate over single and multiple block outputs.
     std::vector<std::string> output_files = {"warped_single_block.slc",
-                                             "warped_many_blocks.slc"};
+                                             "warped_many_blocks.slc",
+                                             "warped_polyphase.slc"};
     for (auto output_file : output_files) {
         isce3::io::Raster testSlc(output_file);
-        // Compute total complex error
-        float sum{0.0};
-        size_t count = 0;
-        // Avoid edges of image
-        for (size_t i = 20; i < (refSlc.length() - 20); ++i) {
-            for (size_t j = 20; j < (refSlc.width() - 20); ++j) {
-                std::complex<float> refValue, testValue;
-                refSlc.getValue(refValue, j, i);
-                testSlc.getValue(testValue, j, i);
-                sum += std::abs(testValue - refValue);
-                ++count;
-            }
-        }
-        // Normalize by number of pixels
-        float abs_error = sum / count;
+        float abs_error = meanAbsError(refSlc, testSlc);
         ASSERT_LT(abs_error, 4.5e-5);
     }
+
+    // Phase quantization error of a 1024 phase table is at most 1/1024 of a
+    // pixel, well below the ~4 average amplitude of the data.
+    isce3::io::Raster coarseSlc("warped_polyphase_1024.slc");
+    ASSERT_LT(meanAbsError(refSlc, coarseSlc), 2e-2);
 }
 
 int main(int argc, char * argv[]) {
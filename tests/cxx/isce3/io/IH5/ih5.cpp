@@ -1,5 +1,7 @@
 //
 
+#include <atomic>
+#include <fstream>
 #include <numeric>
 #include <gtest/gtest.h>
 
@@ -1085,6 +1087,157 @@ TEST_F(IH5Test, createFloat16Dataset) {
 }
 
 
+TEST_F(IH5Test, readChunkedDataset) {
+
+    isce3::io::IH5File fic("dummyChunked.h5", 'x');
+    isce3::io::IGroup grp = fic.openGroup("/");
+
+    // 300x200 dataset with 128x128 chunks, shuffled and deflated
+    const int length = 300, width = 200;
+    std::vector<std::complex<float>> v(length * width);
+    for (int i = 0; i < length * width; i++)
+        v[i] = std::complex<float>(i % 251, -(i % 17));
+
+    std::array<int, 2> dims = {length, width};
+    isce3::io::IDataSet dset =
+            grp.createDataSet<std::complex<float>>("data", dims, 1, 1, 4);
+    dset.write(v);
+
+    // Storage order listing of all the chunks
+    auto chunks = dset.getChunks();
+    ASSERT_EQ(chunks.size(), 6);
+    for (size_t i = 1; i < chunks.size(); i++)
+        EXPECT_LT(chunks[i - 1].address, chunks[i].address);
+    for (const auto& chunk : chunks) {
+        EXPECT_EQ(chunk.count[0], std::min<hsize_t>(128, length - chunk.offset[0]));
+        EXPECT_EQ(chunk.count[1], std::min<hsize_t>(128, width - chunk.offset[1]));
+        EXPECT_GT(chunk.size, 0);
+    }
+
+    // Each chunk matches the data
+    std::atomic<int> numChunks(0);
+    const size_t numDecoded = dset.readChunks<std::complex<float>>(chunks,
+            [&](const isce3::io::ChunkInfo& chunk,
+                const std::complex<float>* data) {
+        numChunks++;
+        for (hsize_t i = 0; i < chunk.count[0]; i++) {
+            for (hsize_t j = 0; j < chunk.count[1]; j++) {
+                const size_t k = (chunk.offset[0] + i) * width
+                                 + chunk.offset[1] + j;
+                ASSERT_EQ(data[i * chunk.count[1] + j], v[k]);
+            }
+        }
+    });
+    ASSERT_EQ(numChunks, 6);
+    // All the chunks were decompressed outside of the library
+    EXPECT_EQ(numDecoded, 6);
+
+    // Full dataset
+    std::vector<std::complex<float>> vr(length * width);
+    dset.readChunked(vr.data());
+    ASSERT_EQ(vr, v);
+
+    // Block spanning several chunks
+    int start[2] = {50, 30}, count[2] = {200, 150};
+    std::vector<std::complex<float>> block(count[0] * count[1]);
+    dset.readChunked(block.data(), start, count);
+    for (int i = 0; i < count[0]; i++) {
+        for (int j = 0; j < count[1]; j++)
+            ASSERT_EQ(block[i * count[1] + j],
+                      v[(start[0] + i) * width + start[1] + j]);
+    }
+    EXPECT_EQ(dset.getChunks(start, count).size(), 4);
+    start[0] = 130;
+    count[0] = 10;
+    EXPECT_EQ(dset.getChunks(start, count).size(), 2);
+
+    // Out of bound block
+    count[0] = 200;
+    EXPECT_THROW(dset.getChunks(start, count), isce3::except::OutOfRange);
+
+    // Memory type different from file type: read through the library
+    std::vector<std::complex<double>> vd(length * width);
+    dset.readChunked(vd.data());
+    for (int i = 0; i < length * width; i++)
+        ASSERT_EQ(vd[i], std::complex<double>(v[i]));
+    EXPECT_EQ(dset.readChunks<std::complex<double>>(chunks,
+                      [](const isce3::io::ChunkInfo&,
+                         const std::complex<double>*) {}),
+              0);
+
+    dset.close();
+
+    // Reopen with a chunk cache holding one row of chunks
+    const auto cache = isce3::io::ChunkCacheConfig::forChunks(
+            2, 128 * 128 * sizeof(std::complex<float>));
+    EXPECT_EQ(cache.numSlots, 211);
+    dset = fic.openDataSet("/data", cache);
+    EXPECT_EQ(dset.getChunkCache().numSlots, cache.numSlots);
+    EXPECT_EQ(dset.getChunkCache().numBytes, cache.numBytes);
+    EXPECT_EQ(dset.getChunkCache().preemption, 1.0);
+
+    std::fill(vr.begin(), vr.end(), 0);
+    dset.readChunked(vr.data());
+    ASSERT_EQ(vr, v);
+}
+
+
+TEST_F(IH5Test, readChunkedChecksum) {
+
+    // 64x64 dataset with 32x32 chunks and Fletcher32 checksums
+    const int length = 64, width = 64;
+    std::vector<float> v(length * width);
+    std::iota(v.begin(), v.end(), 0.f);
+    {
+        H5::H5File file("dummyChecksum.h5", H5F_ACC_TRUNC);
+        const hsize_t dims[2] = {length, width}, chunkDims[2] = {32, 32};
+        H5::DSetCreatPropList plist;
+        plist.setChunk(2, chunkDims);
+        plist.setFletcher32();
+        H5::DataSet dset = file.createDataSet("data",
+                H5::PredType::NATIVE_FLOAT, H5::DataSpace(2, dims), plist);
+        dset.write(v.data(), H5::PredType::NATIVE_FLOAT);
+    }
+
+    // Checksums are verified and the chunks decoded directly
+    std::vector<isce3::io::ChunkInfo> chunks;
+    {
+        isce3::io::IH5File fic("dummyChecksum.h5");
+        isce3::io::IDataSet dset = fic.openDataSet("/data");
+        chunks = dset.getChunks();
+        ASSERT_EQ(chunks.size(), 4);
+        EXPECT_EQ(dset.readChunks<float>(chunks,
+                          [](const isce3::io::ChunkInfo&, const float*) {}),
+                  4);
+        std::vector<float> vr(length * width);
+        dset.readChunked(vr.data());
+        ASSERT_EQ(vr, v);
+    }
+
+    // Corrupt one byte of the data of the second chunk
+    {
+        std::fstream f("dummyChecksum.h5",
+                       std::ios::in | std::ios::out | std::ios::binary);
+        f.seekg(chunks[1].address + 10);
+        const char c = f.get();
+        f.seekp(chunks[1].address + 10);
+        f.put(c ^ 0x01);
+    }
+
+    isce3::io::IH5File fic("dummyChecksum.h5");
+    isce3::io::IDataSet dset = fic.openDataSet("/data");
+    std::vector<float> vr(length * width);
+    EXPECT_THROW(dset.readChunked(vr.data()), H5::Exception);
+
+    // The other chunks are still decoded directly
+    const std::vector<isce3::io::ChunkInfo> valid = {chunks[0], chunks[2],
+                                                     chunks[3]};
+    EXPECT_EQ(dset.readChunks<float>(valid,
+                      [](const isce3::io::ChunkInfo&, const float*) {}),
+              3);
+}
+
+
 int main( int argc, char * argv[] ) {
     testing::InitGoogleTest( &argc, argv );
     return RUN_ALL_TESTS();
@@ -272,6 +272,56 @@ TEST_F(RasterTest, pushBack) {
   v.push_back(lon);
 }
 
+// Access a flat binary raster through a memory map
+TEST_F(RasterTest, memmapENVIRaster) {
+  const std::string mmapFilename = "mmap.bin";
+  std::remove(mmapFilename.c_str());
+
+  std::vector<float> block(nc * nl);
+  std::iota(block.begin(), block.end(), 0.0f);
+
+  {
+    isce3::io::Raster raster( mmapFilename, nc, nl, 2, GDT_Float32, "ENVI" );
+    raster.setBlock( block, 0, 0, nc, nl, 1 );
+
+    // band 1 written with RasterIO must be visible through the mapping
+    auto view1 = raster.memmap<float>( 1, isce3::io::MemoryMapAdvice::Sequential );
+    ASSERT_EQ( view1.length(), nl );
+    ASSERT_EQ( view1.width(),  nc );
+    ASSERT_EQ( view1.colstride() % sizeof(float), 0 );
+    ASSERT_EQ( view1.rowstride() % sizeof(float), 0 );
+    for (uint y=0; y<nl; ++y) {
+      const float * row = reinterpret_cast<const float *>(
+              reinterpret_cast<const char *>(view1.data()) + y * view1.rowstride());
+      for (uint x=0; x<nc; ++x) {
+        ASSERT_EQ( row[x * view1.colstride() / sizeof(float)], block[y * nc + x] );
+      }
+    }
+
+    // write band 2 through the mapping
+    auto view2 = raster.memmap<float>( 2, isce3::io::MemoryMapAdvice::Random );
+    for (uint y=0; y<nl; ++y) {
+      float * row = reinterpret_cast<float *>(
+              reinterpret_cast<char *>(view2.data()) + y * view2.rowstride());
+      for (uint x=0; x<nc; ++x) {
+        row[x * view2.colstride() / sizeof(float)] = 2 * block[y * nc + x];
+      }
+    }
+
+    // type must match and band must exist
+    EXPECT_THROW( raster.memmap<double>(1), isce3::except::RuntimeError );
+    EXPECT_THROW( raster.memmap<float>(3),  isce3::except::OutOfRange );
+  }
+
+  // band 2 written through the mapping must be visible to RasterIO
+  isce3::io::Raster raster( mmapFilename );
+  std::vector<float> band2(nc * nl);
+  raster.getBlock( band2, 0, 0, nc, nl, 2 );
+  for (uint i=0; i<nc * nl; ++i) {
+    ASSERT_EQ( band2[i], 2 * block[i] );
+  }
+}
+
 
 // Main
 int main( int argc, char * argv[] ) {
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <cmath>
 #include <complex>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include <isce3/core/Utilities.h>
@@ -165,6 +166,134 @@ TEST(Crossmul, RunCrossmulMLook)
 }
 
 
+TEST(Crossmul, SyntheticRampReference)
+{
+    // This test crossmultiplies a synthetic pair of SLCs whose lines are
+    // complex exponentials (phase ramps with an integer number of cycles in
+    // range, so that upsampling is exact) and compares the multilooked,
+    // flattened interferogram and coherence to a direct computation.
+
+    // 32 columns (a power of two, so the lines aren't zero-padded) and 36
+    // lines processed in blocks of 8 lines, the last one partial
+    const int ncols = 32;
+    const int nrows = 36;
+    const int linesPerBlock = 8;
+    const int rngLooks = 3;
+    const int azLooks = 4;
+    const int width = ncols / rngLooks;
+    const int length = nrows / azLooks;
+
+    // range (cycles per line) & azimuth (radians per line) frequencies
+    const int k1 = 5, k2 = 2;
+    const double b1 = 0.03, b2 = -0.05;
+
+    const double wavelength = 0.24;
+    const double rangePixelSpacing = 7.0;
+    const double startingRangeShift = 0.5;
+
+    auto rampPhase = [&](int k, double b, int row, double col) {
+        return 2.0 * M_PI * k * col / ncols + b * row;
+    };
+    auto rngOffsetValue = [](int row, int col) {
+        return 0.01 * col - 0.02 * row;
+    };
+
+    std::vector<std::complex<float>> refData(nrows * ncols);
+    std::vector<std::complex<float>> secData(nrows * ncols);
+    std::vector<double> rngOffsetData(nrows * ncols);
+    for (int row = 0; row < nrows; ++row) {
+        for (int col = 0; col < ncols; ++col) {
+            refData[row * ncols + col] =
+                    std::polar(1.0, rampPhase(k1, b1, row, col));
+            secData[row * ncols + col] =
+                    std::polar(1.0, rampPhase(k2, b2, row, col));
+            rngOffsetData[row * ncols + col] = rngOffsetValue(row, col);
+        }
+    }
+
+    auto makeRaster = [](const std::string& name, int w, int l,
+                         GDALDataType dtype) {
+        return isce3::io::Raster("/vsimem/" + getTempString(name), w, l, 1,
+                                 dtype, "ENVI");
+    };
+    isce3::io::Raster refSlc = makeRaster("ramp_ref", ncols, nrows,
+                                          GDT_CFloat32);
+    isce3::io::Raster secSlc = makeRaster("ramp_sec", ncols, nrows,
+                                          GDT_CFloat32);
+    isce3::io::Raster rngOffset = makeRaster("ramp_rgoff", ncols, nrows,
+                                             GDT_Float64);
+    refSlc.setBlock(refData.data(), 0, 0, ncols, nrows);
+    secSlc.setBlock(secData.data(), 0, 0, ncols, nrows);
+    rngOffset.setBlock(rngOffsetData.data(), 0, 0, ncols, nrows);
+
+    for (int oversample : {1, 2, 3}) {
+
+        const std::string suffix = "_ov" + std::to_string(oversample);
+        isce3::io::Raster interferogram = makeRaster("ramp_ifg" + suffix,
+                width, length, GDT_CFloat32);
+        isce3::io::Raster coherence = makeRaster("ramp_coh" + suffix,
+                width, length, GDT_Float32);
+
+        isce3::signal::Crossmul crsmul;
+        crsmul.rangeLooks(rngLooks);
+        crsmul.azimuthLooks(azLooks);
+        crsmul.oversampleFactor(oversample);
+        crsmul.linesPerBlock(linesPerBlock);
+        crsmul.wavelength(wavelength);
+        crsmul.rangePixelSpacing(rangePixelSpacing);
+        crsmul.startingRangeShift(startingRangeShift);
+        crsmul.crossmul(refSlc, secSlc, interferogram, coherence, &rngOffset);
+
+        std::vector<std::complex<float>> ifgData(width * length);
+        std::vector<float> cohData(width * length);
+        interferogram.getBlock(ifgData.data(), 0, 0, width, length);
+        coherence.getBlock(cohData.data(), 0, 0, width, length);
+
+        // Upsampling a line by the oversample factor and looking it down
+        // again averages the interferogram over samples placed
+        // symmetrically about each pixel, which scales it by a real factor
+        std::complex<double> scale = 0.0;
+        const double shift = (1.0 - 1.0 / oversample) / 2.0;
+        for (int j = 0; j < oversample; ++j) {
+            const double t = double(j) / oversample - shift;
+            scale += std::polar(1.0, rampPhase(k1 - k2, 0.0, 0, t));
+        }
+        scale /= oversample;
+
+        double maxIfgErr = 0.0, maxCohErr = 0.0;
+        for (int row = 0; row < length; ++row) {
+            for (int col = 0; col < width; ++col) {
+                // average of the flattened full resolution interferogram
+                // over the looks (the SLCs have unit amplitude)
+                std::complex<double> expected = 0.0;
+                for (int i = 0; i < azLooks; ++i) {
+                    for (int j = 0; j < rngLooks; ++j) {
+                        const int r = row * azLooks + i;
+                        const int c = col * rngLooks + j;
+                        const double offset = rngOffsetValue(r, c) +
+                                startingRangeShift / rangePixelSpacing;
+                        const double phase =
+                                rampPhase(k1, b1, r, c) -
+                                rampPhase(k2, b2, r, c) -
+                                4.0 * M_PI * rangePixelSpacing * offset /
+                                        wavelength;
+                        expected += scale * std::polar(1.0, phase);
+                    }
+                }
+                expected /= rngLooks * azLooks;
+
+                const std::complex<double> ifg = ifgData[row * width + col];
+                maxIfgErr = std::max(maxIfgErr, std::abs(ifg - expected));
+                maxCohErr = std::max(maxCohErr,
+                        std::abs(cohData[row * width + col] -
+                                 std::abs(expected)));
+            }
+        }
+        EXPECT_LT(maxIfgErr, 1.0e-4) << "oversample = " << oversample;
+        EXPECT_LT(maxCohErr, 1.0e-4) << "oversample = " << oversample;
+    }
+}
+
 int main(int argc, char * argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
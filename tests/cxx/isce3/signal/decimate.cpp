@@ -66,6 +66,44 @@ TEST(Decimate, Decimate)
     ASSERT_LT(max_err, 1.0e-14);
 }
 
+TEST(Decimate, DecimateInPlace)
+{
+    size_t width = 10;
+    size_t length = 101;
+
+    size_t decimation_cols = 3;
+    size_t decimation_rows = 4;
+
+    size_t rows_offset = 1;
+    size_t cols_offset = 2;
+
+    size_t width_decimated = (width - cols_offset - 1) / decimation_cols + 1;
+    size_t length_decimated = (length - rows_offset - 1) / decimation_rows + 1;
+
+    std::valarray<double> data(width * length);
+    for (size_t line = 0; line < length; ++line) {
+        for (size_t col = 0; col < width; ++col) {
+            data[line * width + col] = create_data(line, col);
+        }
+    }
+
+    isce3::signal::decimate(data, length, width, length_decimated,
+                            width_decimated, decimation_rows, decimation_cols,
+                            rows_offset, cols_offset);
+
+    // the buffer is not resized
+    ASSERT_EQ(data.size(), width * length);
+
+    for (size_t line = 0; line < length_decimated; ++line) {
+        for (size_t col = 0; col < width_decimated; ++col) {
+            double expected =
+                    create_data(line * decimation_rows + rows_offset,
+                                col * decimation_cols + cols_offset);
+            ASSERT_EQ(data[line * width_decimated + col], expected);
+        }
+    }
+}
+
 int main(int argc, char* argv[])
 {
     testing::InitGoogleTest(&argc, argv);
@@ -4,6 +4,8 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -265,6 +267,124 @@ TEST(FilterData, FilterComplexData)
     ASSERT_LT(max_err, 1.0e-12);
 }
 
+TEST(FilterData, FilterMethods)
+{
+    // all filtering methods must give the same result, with and without
+    // a mask, over several blocks of data
+    int length = 101;
+    int width = 87;
+    int kernel_width = 9;
+    int kernel_length = 7;
+    int block_rows = 21;
+
+    std::valarray<std::complex<double>> data(length * width);
+    std::valarray<double> mask(length * width);
+    for (int line = 0; line < length; ++line) {
+        for (int col = 0; col < width; ++col) {
+            data[line * width + col] = std::complex<double>(
+                    std::cos(0.1 * line * col), std::sin(0.3 * line + col));
+            mask[line * width + col] = ((line * 7 + col * 3) % 11 != 0);
+        }
+    }
+    isce3::io::Raster dataRaster("input_data_methods", width, length, 1,
+                                 GDT_CFloat64, "ENVI");
+    isce3::io::Raster maskRaster("input_mask_methods", width, length, 1,
+                                 GDT_Float64, "ENVI");
+    dataRaster.setBlock(data, 0, 0, width, length);
+    maskRaster.setBlock(mask, 0, 0, width, length);
+
+    std::valarray<double> kernelColumns(kernel_width);
+    std::valarray<double> kernelRows(kernel_length);
+    for (int i = 0; i < kernel_width; ++i)
+        kernelColumns[i] = 1.0 + 0.1 * i;
+    for (int i = 0; i < kernel_length; ++i)
+        kernelRows[i] = 2.0 - 0.2 * i;
+
+    using isce3::signal::FilterMethod;
+    for (bool use_mask : {false, true}) {
+        std::vector<std::valarray<std::complex<double>>> results;
+        for (auto method : {FilterMethod::DirectSeparable,
+                            FilterMethod::Direct2D, FilterMethod::FFT}) {
+            isce3::io::Raster filtDataRaster("output_methods.filtered_data",
+                                             width, length, 1, GDT_CFloat64,
+                                             "ENVI");
+            isce3::signal::filter2D<std::complex<double>>(filtDataRaster,
+                    dataRaster, maskRaster, kernelColumns, kernelRows, false,
+                    use_mask, block_rows, method);
+
+            results.emplace_back(length * width);
+            filtDataRaster.getBlock(results.back(), 0, 0, width, length);
+        }
+
+        for (int i = 0; i < length * width; ++i) {
+            ASSERT_NEAR(std::abs(results[1][i] - results[0][i]), 0.0, 1e-12);
+            ASSERT_NEAR(std::abs(results[2][i] - results[0][i]), 0.0, 1e-12);
+        }
+    }
+}
+
+TEST(FilterData, SelectFilterMethod)
+{
+    using isce3::signal::FilterMethod;
+    using isce3::signal::selectFilterMethod;
+
+    const int n = 4096;
+    EXPECT_EQ(selectFilterMethod(3, 3, n, n), FilterMethod::Direct2D);
+    EXPECT_EQ(selectFilterMethod(9, 9, n, n), FilterMethod::DirectSeparable);
+    EXPECT_EQ(selectFilterMethod(65, 65, n, n), FilterMethod::FFT);
+
+    // FFT tiles are bounded by the data, which makes FFT convolution of
+    // small blocks with large kernels inefficient
+    EXPECT_EQ(selectFilterMethod(65, 65, 80, 80),
+              FilterMethod::DirectSeparable);
+
+    // direct 2D convolution is always selected when FFT is made expensive
+    isce3::signal::FilterCostModel cost;
+    cost.fft = 1e6;
+    cost.separableOverhead = 1e6;
+    EXPECT_EQ(selectFilterMethod(65, 65, n, n, false, cost),
+              FilterMethod::Direct2D);
+}
+
+TEST(FilterData, FilterCostModel)
+{
+    // the cost model passed to filter2D selects the method
+    int length = 64;
+    int width = 48;
+    std::valarray<double> data(length * width);
+    for (int i = 0; i < length * width; ++i)
+        data[i] = std::cos(0.37 * i);
+    isce3::io::Raster dataRaster("input_data_cost", width, length, 1,
+                                 GDT_Float64, "ENVI");
+    dataRaster.setBlock(data, 0, 0, width, length);
+
+    std::valarray<double> kernelColumns(5), kernelRows(5);
+    for (int i = 0; i < 5; ++i) {
+        kernelColumns[i] = 1.0 + 0.3 * i;
+        kernelRows[i] = 1.5 - 0.2 * i;
+    }
+
+    // filter2D reports the method it uses
+    auto filter = [&](const isce3::signal::FilterCostModel& cost) {
+        isce3::io::Raster filtRaster("output_cost.filtered_data", width,
+                                     length, 1, GDT_Float64, "ENVI");
+        testing::internal::CaptureStdout();
+        isce3::signal::filter2D<double>(filtRaster, dataRaster, kernelColumns,
+                kernelRows, 16, isce3::signal::FilterMethod::Auto, cost);
+        return testing::internal::GetCapturedStdout();
+    };
+
+    EXPECT_NE(filter({}).find("filtering method: direct separable"),
+              std::string::npos);
+
+    isce3::signal::FilterCostModel cheapFFT;
+    cheapFFT.fft = 0.0;
+    cheapFFT.direct2D = 1e6;
+    cheapFFT.separableOverhead = 1e6;
+    EXPECT_NE(filter(cheapFFT).find("filtering method: FFT"),
+              std::string::npos);
+}
+
 int main(int argc, char* argv[])
 {
     testing::InitGoogleTest(&argc, argv);
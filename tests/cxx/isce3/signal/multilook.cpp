@@ -8,6 +8,7 @@
 #include <gtest/gtest.h>
 
 #include <isce3/core/EMatrix.h>
+#include <isce3/core/Utilities.h>
 #include <isce3/io/Raster.h>
 #include <isce3/signal/Looks.h>
 #include <isce3/signal/multilook.h>
@@ -173,6 +174,60 @@ TEST(Looks, Multilook)
 
 }
 
+TEST(Looks, MultilookRasterStrips)
+{
+    // multi-looking rasters in strips must match multi-looking arrays
+    const size_t width = 20, length = 22;
+    const size_t rngLooks = 3, azLooks = 3;
+    const size_t widthLooked = width / rngLooks;
+    const size_t lengthLooked = length / azLooks;
+
+    std::valarray<std::complex<float>> cpxData(width * length);
+    for (size_t i = 0; i < length; ++i) {
+        for (size_t j = 0; j < width; ++j) {
+            cpxData[i * width + j] = std::complex<float>(
+                    (1.0 + i) * std::cos(i * j), std::sin(0.3 * i * j));
+        }
+    }
+
+    isce3::signal::Looks<float> lksObj(rngLooks, azLooks);
+    lksObj.nrows(length);
+    lksObj.ncols(width);
+    lksObj.nrowsLooked(lengthLooked);
+    lksObj.ncolsLooked(widthLooked);
+
+    std::valarray<std::complex<float>> cpxDataLooked(widthLooked * lengthLooked);
+    lksObj.multilook(cpxData, cpxDataLooked);
+    std::valarray<float> powLooked(widthLooked * lengthLooked);
+    lksObj.multilook(cpxData, powLooked, 2);
+
+    isce3::io::Raster input("/vsimem/" + getTempString("looks_in"), width,
+                            length, 1, GDT_CFloat32, "ENVI");
+    input.setBlock(cpxData, 0, 0, width, length);
+
+    // strips of two windows, the last one being partial
+    lksObj.linesPerBlock(2 * azLooks + 1);
+
+    isce3::io::Raster cpxOutput("/vsimem/" + getTempString("looks_cpx"),
+                                widthLooked, lengthLooked, 1, GDT_CFloat32,
+                                "ENVI");
+    lksObj.multilook(input, cpxOutput);
+    std::valarray<std::complex<float>> cpxOut(widthLooked * lengthLooked);
+    cpxOutput.getBlock(cpxOut, 0, 0, widthLooked, lengthLooked);
+
+    isce3::io::Raster powOutput("/vsimem/" + getTempString("looks_pow"),
+                                widthLooked, lengthLooked, 1, GDT_Float32,
+                                "ENVI");
+    lksObj.multilook(input, powOutput);
+    std::valarray<float> powOut(widthLooked * lengthLooked);
+    powOutput.getBlock(powOut, 0, 0, widthLooked, lengthLooked);
+
+    for (size_t i = 0; i < widthLooked * lengthLooked; ++i) {
+        EXPECT_NEAR(std::abs(cpxOut[i] - cpxDataLooked[i]), 0.0, 1.0e-6);
+        EXPECT_NEAR(powOut[i], powLooked[i], 1.0e-5 * powLooked[i]);
+    }
+}
+
 int main(int argc, char * argv[]) {
       testing::InitGoogleTest(&argc, argv);
       return RUN_ALL_TESTS();
@@ -10,6 +10,7 @@
 #include <fstream>
 #include <cmath>
 #include <complex>
+#include <algorithm>
 #include <gtest/gtest.h>
 #include "isce3/signal/Signal.h"
 #include "isce3/signal/shiftSignal.h"
@@ -81,6 +82,107 @@ TEST(shiftSignal, shiftSignal)
 
 }
 
+TEST(shiftSignal, Workspace)
+{
+    // integer shifts are circular shifts of the block of data
+    const size_t ncols = 12, nrows = 9;
+    const int shiftX = 3, shiftY = -2;
+
+    std::valarray<std::complex<double>> data(ncols * nrows);
+    std::valarray<double> dataReal(ncols * nrows);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = std::complex<double>(std::sin(0.7 * i), std::cos(1.3 * i));
+        dataReal[i] = data[i].real();
+    }
+
+    std::valarray<std::complex<double>> expected(ncols * nrows);
+    for (size_t row = 0; row < nrows; ++row) {
+        for (size_t col = 0; col < ncols; ++col) {
+            size_t rowIn = (row + nrows - shiftY) % nrows;
+            size_t colIn = (col + ncols - shiftX) % ncols;
+            expected[row * ncols + col] = data[rowIn * ncols + colIn];
+        }
+    }
+
+    isce3::signal::ShiftSignalWorkspace<double> workspace(
+            ncols, nrows, shiftX, shiftY);
+
+    // out of place
+    std::valarray<std::complex<double>> shifted(ncols * nrows);
+    isce3::signal::shiftSignal(data, shifted, workspace);
+
+    // in place, reusing the workspace
+    isce3::signal::shiftSignal(data, workspace);
+
+    // real data
+    isce3::signal::shiftSignal(dataReal, workspace);
+
+    double max_err = 0.0;
+    for (size_t i = 0; i < data.size(); ++i) {
+        max_err = std::max(max_err, std::abs(shifted[i] - expected[i]));
+        max_err = std::max(max_err, std::abs(data[i] - expected[i]));
+        max_err = std::max(max_err,
+                std::abs(dataReal[i] - expected[i].real()));
+    }
+    ASSERT_LT(max_err, 1.0e-12);
+
+    // shift along a single direction matches the Signal based version
+    const size_t nfft = 128;
+    std::valarray<std::complex<double>> slc(nfft), slcShifted(nfft),
+            spec(nfft);
+    for (size_t i = 0; i < nfft; ++i) {
+        double phase = 2 * M_PI * i * 0.001;
+        slc[i] = std::complex<double>(std::cos(phase), std::sin(phase));
+    }
+    isce3::signal::Signal<double> sigObj;
+    sigObj.forwardRangeFFT(slc, spec, nfft, 1);
+    sigObj.inverseRangeFFT(spec, slc, nfft, 1);
+    isce3::signal::shiftSignal(slc, slcShifted, spec, nfft, 1, 0.3, 0.0,
+                               sigObj);
+
+    isce3::signal::ShiftSignalWorkspace<double> rangeWorkspace(nfft, 1, 0.3,
+                                                               0.0);
+    rangeWorkspace.shift(&slc[0], &slc[0]);
+    max_err = 0.0;
+    for (size_t i = 0; i < nfft; ++i) {
+        max_err = std::max(max_err, std::abs(slc[i] - slcShifted[i]));
+    }
+    ASSERT_LT(max_err, 1.0e-12);
+}
+
+TEST(shiftSignal, WorkspaceShiftY)
+{
+    // integer shift in y only (FFTs over columns) is a circular shift of
+    // the rows
+    const size_t ncols = 7, nrows = 10;
+    const int shiftY = 3;
+
+    std::valarray<std::complex<double>> data(ncols * nrows);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = std::complex<double>(std::cos(0.9 * i), std::sin(0.4 * i));
+    }
+
+    std::valarray<std::complex<double>> expected(ncols * nrows);
+    for (size_t row = 0; row < nrows; ++row) {
+        size_t rowIn = (row + nrows - shiftY) % nrows;
+        for (size_t col = 0; col < ncols; ++col) {
+            expected[row * ncols + col] = data[rowIn * ncols + col];
+        }
+    }
+
+    isce3::signal::ShiftSignalWorkspace<double> workspace(
+            ncols, nrows, 0.0, shiftY);
+
+    std::valarray<std::complex<double>> shifted(ncols * nrows);
+    isce3::signal::shiftSignal(data, shifted, workspace);
+
+    double max_err = 0.0;
+    for (size_t i = 0; i < data.size(); ++i) {
+        max_err = std::max(max_err, std::abs(shifted[i] - expected[i]));
+    }
+    ASSERT_LT(max_err, 1.0e-12);
+}
+
 int main(int argc, char * argv[]) {
       testing::InitGoogleTest(&argc, argv);
       return RUN_ALL_TESTS();
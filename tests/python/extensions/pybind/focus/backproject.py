@@ -70,6 +70,39 @@ def load_h5(filename):
             "target_azimuth": target_azimuth,
             "target_range": target_range}
 
+
+def setup_target_chip(nchip=33):
+    """
+    Load the point target simulation and set up an nchip x nchip output
+    chip centered on the target.
+
+    Returns the simulation data, interpolation kernel, input & output
+    geometries and chip size.
+    """
+    filename = Path(test_data_dir) / "point-target-sim-rc.h5"
+    d = load_h5(filename)
+
+    radar_grid = d["radar_grid"]
+    orbit = d["orbit"]
+    doppler = d["doppler"]
+
+    dt = radar_grid.az_time_interval
+    dr = radar_grid.range_pixel_spacing
+    t0 = d["target_azimuth"] - 0.5 * (nchip - 1) * dt
+    r0 = d["target_range"] - 0.5 * (nchip - 1) * dr
+    out_grid = isce.product.RadarGridParameters(
+            t0, radar_grid.wavelength, radar_grid.prf, r0, dr,
+            radar_grid.lookside, nchip, nchip, orbit.reference_epoch)
+
+    B = 20e6
+    kernel = isce.core.KnabKernel(9., B / d["range_sampling_rate"])
+    kernel = isce.core.TabulatedKernelF32(kernel, 2048)
+
+    in_geometry = isce.container.RadarGeometry(radar_grid, orbit, doppler)
+    out_geometry = isce.container.RadarGeometry(out_grid, orbit, doppler)
+
+    return d, kernel, in_geometry, out_geometry, nchip
+
 def test_backproject():
     # load point target simulation data
     filename = Path(test_data_dir) / "point-target-sim-rc.h5"
@@ -168,3 +201,71 @@ def test_backproject():
     # threshold is slightly higher - see
     # https://github.jpl.nasa.gov/bhawkins/nisar-notebooks/blob/master/Azimuth%20Resolution.ipynb
     assert(azimuth_width <= 6.62)
+
+def test_backproject_single_precision():
+    d, kernel, in_geometry, out_geometry, nchip = setup_target_chip()
+
+    outputs = {}
+    for precision in ("double", "single"):
+        out = np.empty((nchip, nchip), np.complex64)
+        err = isce.focus.backproject(out, out_geometry, d["signal_data"],
+                in_geometry, d["dem"], d["center_frequency"], 6., kernel,
+                d["dry_tropo_model"], precision=precision)
+        assert not err
+        outputs[precision] = out
+
+    # The error of the single-precision sum is bounded by ~1e-5 times the
+    # sum of the magnitudes of the samples along the aperture, which for a
+    # point target is the magnitude of the focused peak.
+    peak = np.max(np.abs(outputs["double"]))
+    npt.assert_array_less(np.abs(outputs["single"] - outputs["double"]),
+                          1e-5 * peak)
+
+
+def test_factorized_backproject():
+    d, kernel, in_geometry, out_geometry, nchip = setup_target_chip()
+
+    direct = np.empty((nchip, nchip), np.complex64)
+    err = isce.focus.backproject(direct, out_geometry, d["signal_data"],
+            in_geometry, d["dem"], d["center_frequency"], 6., kernel,
+            d["dry_tropo_model"])
+    assert not err
+
+    fast = np.empty((nchip, nchip), np.complex64)
+    err = isce.focus.factorized_backproject(fast, out_geometry,
+            d["signal_data"], in_geometry, d["dem"], d["center_frequency"],
+            6., kernel, d["dry_tropo_model"], leaf_size=16, depth=4,
+            angular_oversampling=2.)
+    assert not err
+
+    # Interpolation of the subaperture images introduces errors of about a
+    # percent of the focused peak.
+    peak = np.max(np.abs(direct))
+    npt.assert_array_less(np.abs(fast - direct), 0.03 * peak)
+
+
+def test_backprojector_streaming():
+    d, kernel, in_geometry, out_geometry, nchip = setup_target_chip()
+
+    expected = np.empty((nchip, nchip), np.complex64)
+    err = isce.focus.backproject(expected, out_geometry, d["signal_data"],
+            in_geometry, d["dem"], d["center_frequency"], 6., kernel,
+            d["dry_tropo_model"])
+    assert not err
+
+    # feed the pulses in uneven batches
+    bp = isce.focus.Backprojector(out_geometry, in_geometry, d["dem"],
+            d["center_frequency"], 6., kernel, d["dry_tropo_model"])
+    signal_data = d["signal_data"]
+    npulses = signal_data.shape[0]
+    batch = 97
+    for k in range(0, npulses, batch):
+        bp.add_pulses(np.ascontiguousarray(signal_data[k:k + batch]), k)
+    assert bp.num_pulses_added == npulses
+
+    out = np.empty((nchip, nchip), np.complex64)
+    err = bp.finalize(out)
+    assert not err
+
+    peak = np.max(np.abs(expected))
+    npt.assert_allclose(out, expected, rtol=0, atol=1e-6 * peak)
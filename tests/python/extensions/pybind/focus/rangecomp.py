@@ -24,3 +24,25 @@ def test_rangecomp():
     y = np.zeros_like(x)
     rc.rangecompress(y, x)
     assert np.allclose(y, x)
+
+
+def test_rangecomp_parallel_segmented():
+    rng = np.random.default_rng(1234)
+    nchirp, ndata, nlines = 64, 2000, 9
+    h = np.exp(1j * np.pi * np.linspace(-8, 8, nchirp)**2).astype('c8')
+    x = (rng.normal(size=(nlines, ndata)) +
+         1j * rng.normal(size=(nlines, ndata))).astype('c8')
+
+    for mode in (focus.RangeComp.Mode.Full, focus.RangeComp.Mode.Valid,
+                 focus.RangeComp.Mode.Same):
+        rc = focus.RangeComp(h, ndata, maxbatch=nlines, mode=mode)
+        expected = np.zeros((nlines, rc.output_size), dtype='c8')
+        rc.rangecompress(expected, x)
+
+        seg = focus.RangeComp(h, ndata, mode=mode, segmentsize=512)
+        assert seg.is_segmented
+        assert seg.num_segments > 1
+        assert seg.output_size == rc.output_size
+        y = np.zeros_like(expected)
+        seg.rangecompress_parallel(y, x)
+        np.testing.assert_allclose(y, expected, atol=1e-3)